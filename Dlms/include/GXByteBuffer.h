@@ -40,6 +40,9 @@
 #include "GXEnums.h"
 
 const unsigned char VECTOR_CAPACITY = 50;
+//Amount of bytes that are kept inside of the buffer before memory is allocated.
+const unsigned char BYTE_BUFFER_INLINE_SIZE = 64;
+
 class CGXByteBuffer
 {
     friend class CGXCipher;
@@ -47,6 +50,17 @@ class CGXByteBuffer
     unsigned long m_Capacity;
     unsigned long m_Size;
     unsigned long m_Position;
+    //Small buffers are saved here without allocating memory.
+    unsigned char m_Inline[BYTE_BUFFER_INLINE_SIZE];
+    //Data is not owned by the buffer. See Attach.
+    bool m_Attached;
+
+    //Make sure that given amount of bytes fits to the buffer and it can be modified.
+    //Capacity is at least doubled so appending is amortized constant time.
+    int Reserve(unsigned long size);
+
+    //Take data of the given buffer and leave it empty.
+    void MoveFrom(CGXByteBuffer& value);
 public:
     //Constructor.
     CGXByteBuffer();
@@ -57,6 +71,9 @@ public:
     //Copy constructor.
     CGXByteBuffer(const CGXByteBuffer& value);
 
+    //Move constructor.
+    CGXByteBuffer(CGXByteBuffer&& value) noexcept;
+
     //Destructor.
     ~CGXByteBuffer();
 
@@ -124,6 +141,22 @@ public:
 
     int AttachString(char* value);
 
+    /**
+    * Use given memory as a read-only view without copying it.
+    * Data is copied to the buffer's own memory before it's modified.
+    * Memory must be valid until buffer is cleared or detached.
+    *
+    * @param value Data.
+    * @param count Size of the data in bytes.
+    */
+    void Attach(const unsigned char* value, unsigned long count);
+
+    //Is data owned by someone else.
+    bool IsAttached();
+
+    //Copy attached data to the buffer's own memory.
+    int Detach();
+
     void Clear();
 
     int GetUInt8(unsigned char* value);
@@ -209,6 +242,8 @@ public:
 
     CGXByteBuffer& operator=(CGXByteBuffer& value);
 
+    CGXByteBuffer& operator=(CGXByteBuffer&& value) noexcept;
+
     //Push the given hex string as byte array into this buffer at the current position, and then increments the position.
     void SetHexString(std::string& value);
 
@@ -38,9 +38,35 @@
 #include "GXByteBuffer.h"
 #include <cstdint>
 
+//Maximum size of the ciphering header: tag, system title, length,
+//security control and frame counter.
+const unsigned char CIPHERING_MAX_HEADER_SIZE = 20;
+
+//Size of the authentication tag.
+const unsigned char CIPHERING_TAG_SIZE = 12;
+
 class CGXCipher
 {
 private:
+    /**
+    * Expanded AES-128 key.
+    */
+    struct CGXAesKey
+    {
+        //Key. Expanded key is used only when key is same.
+        unsigned char m_Key[16];
+        //Round keys for the software implementation.
+        uint32_t m_RoundKeys[61];
+        //Round keys in byte order for the AES instructions.
+        unsigned char m_RoundKeyBytes[176];
+        //Hash subkey.
+        unsigned char m_H[16];
+        //Multiples of the hash subkey for the 4-bit GHASH tables.
+        uint64_t m_HL[16];
+        uint64_t m_HH[16];
+        bool m_Valid;
+    };
+
     DLMS_SECURITY m_Security;
     /**
     * System title.
@@ -69,8 +95,35 @@ private:
      */
     unsigned long m_FrameCounter;
 
+    /**
+     * Frames are not ciphered when frame counter reaches this.
+     */
+    unsigned long long m_InvocationCounterLimit;
+
     DLMS_SECURITY_SUITE m_SecuritySuite;
 
+    /**
+    * Expanded keys. Block cipher key and dedicated key are both kept so
+    * the key schedule is not counted again for each PDU.
+    */
+    CGXAesKey m_Keys[2];
+
+    /**
+    * Index of the expanded key that is replaced next.
+    */
+    unsigned char m_NextKey;
+
+    /**
+    * Returns expanded key. Key is expanded if it's not used before.
+    */
+    int GetKey(
+        CGXByteBuffer& key,
+        CGXAesKey*& value);
+
+    /**
+    * Remove expanded keys.
+    */
+    void ClearKeys();
 
     static int GetAuthenticatedData(
         DLMS_SECURITY security,
@@ -93,18 +146,32 @@ private:
         unsigned char* dst,
         const unsigned char* src);
 
-    static void shift_right_block(unsigned char* v);
+    /*
+    * Count multiples of the hash subkey.
+    */
+    static void InitGHash(CGXAesKey& key);
 
+    /*
+    * Multiply y with the hash subkey.
+    */
     static void MultiplyH(
+        const CGXAesKey& key,
+        unsigned char* y);
+
+    /*
+    * Count GHash of full blocks.
+    */
+    static void GHashBlocks(
+        const CGXAesKey& key,
         const unsigned char* x,
-        const unsigned char* y,
-        unsigned char* z);
+        int count,
+        unsigned char* y);
 
     /*
     * Count GHash.
     */
     static void GetGHash(
-        const unsigned char* h,
+        const CGXAesKey& key,
         const unsigned char* x,
         int xlen,
         unsigned char* y);
@@ -112,27 +179,27 @@ private:
     static void Init_j0(
         const unsigned char* iv,
         unsigned char len,
-        const unsigned char* H,
+        const CGXAesKey& key,
         unsigned char* J0);
 
     static void Inc32(unsigned char* block);
 
     static void Gctr(
-        unsigned int* aes,
+        const CGXAesKey& key,
         const unsigned char* icb,
         unsigned char* in,
         int len,
         unsigned char* out);
 
     static void AesGcmGctr(
-        unsigned int* aes,
+        const CGXAesKey& key,
         const unsigned char* J0,
         unsigned char* in,
         int len,
         unsigned char* out);
 
     static void AesGcmGhash(
-        const unsigned char* H,
+        const CGXAesKey& key,
         const unsigned char* aad,
         int aad_len,
         const unsigned char* crypt,
@@ -144,6 +211,40 @@ private:
         unsigned int Nr,
         const unsigned char* pt,
         unsigned char* ct);
+
+    /**
+    * Encrypt one block. AES instructions are used if processor supports them.
+    */
+    static void AesEncrypt(
+        const CGXAesKey& key,
+        const unsigned char* pt,
+        unsigned char* ct);
+
+    /**
+    * Encrypt or decrypt data in place. Authentication tag is written
+    * when data is encrypted and checked before data is decrypted.
+    */
+    int CipherInPlace(
+        DLMS_SECURITY security,
+        unsigned long frameCounter,
+        const unsigned char* systemTitle,
+        const CGXAesKey& key,
+        unsigned char* data,
+        unsigned long size,
+        unsigned char* tag,
+        bool encrypt);
+
+    /**
+    * Encrypt APDU in place with expanded key.
+    */
+    int EncryptApdu(
+        const CGXAesKey& key,
+        DLMS_SECURITY security,
+        unsigned long frameCounter,
+        unsigned char tag,
+        CGXByteBuffer& systemTitle,
+        CGXByteBuffer& data,
+        unsigned long offset);
 public:
     /**
     * Constructor.
@@ -207,6 +308,72 @@ public:
         DLMS_SECURITY_SUITE& suite,
         uint64_t& InvocationCounter);
 
+    /**
+    * Encrypt APDU in place.
+    *
+    * APDU is in data from offset to the end of the buffer. Ciphering
+    * header is written just before the APDU and authentication tag after
+    * it. Data is not moved if CIPHERING_MAX_HEADER_SIZE bytes are
+    * reserved before the APDU and buffer is not reallocated if it has
+    * capacity for the tag.
+    *
+    * security: Used security.
+    * frameCounter: Frame counter.
+    * tag: Ciphered command.
+    * systemTitle: System title.
+    * key: Block cipher key.
+    * data: APDU. Position is set to the beginning of the header.
+    * offset: Position of the APDU.
+    */
+    int EncryptInPlace(
+        DLMS_SECURITY security,
+        unsigned long frameCounter,
+        unsigned char tag,
+        CGXByteBuffer& systemTitle,
+        CGXByteBuffer& key,
+        CGXByteBuffer& data,
+        unsigned long offset);
+
+    /**
+    * Decrypt ciphered APDU in place. Authentication tag is checked before
+    * data is decrypted.
+    *
+    * title: System title of the sender.
+    * key: Block cipher key.
+    * data: Ciphered APDU from the position to the end of the buffer.
+    *       Position is set to the beginning of the plain text and size to
+    *       the end of it.
+    * security: Used security level.
+    * suite: Used security suite.
+    * invocationCounter: Invocation counter value.
+    */
+    int DecryptInPlace(
+        CGXByteBuffer& title,
+        CGXByteBuffer& key,
+        CGXByteBuffer& data,
+        DLMS_SECURITY& security,
+        DLMS_SECURITY_SUITE& suite,
+        uint64_t& invocationCounter);
+
+    /**
+    * Check that AES instructions are available and they give the same
+    * result as the software implementation.
+    */
+    static bool IsAesInstructionsUsable();
+
+    /**
+    * Check that carry-less multiplication instructions are available and
+    * they give the same GHASH as the table implementation.
+    */
+    static bool IsClmulUsable();
+
+    /**
+    * Processor instructions are used when they are available. Table
+    * implementations are used when value is false. This is used to check
+    * the implementations against each other.
+    */
+    static void SetProcessorInstructions(bool value);
+
     /*
      * Encrypt data using AES.
      *
@@ -299,6 +466,15 @@ public:
 
     void SetInvocationCounter(unsigned long value);
 
+    /**
+     * Returns Invocation counter limit. Frames are not ciphered when
+     * invocation counter reaches the limit. As default all 32 bit
+     * counters except the last one can be used so the counter never wraps.
+     */
+    unsigned long long GetInvocationCounterLimit();
+
+    void SetInvocationCounterLimit(unsigned long long value);
+
     void Reset();
 
     /**
@@ -56,9 +56,6 @@ private:
         CGXDLMSSNParameters& p,
         CGXByteBuffer& reply);
 
-    static unsigned short CountFCS16(CGXByteBuffer& buff, int index, int count);
-    static uint32_t CountFCS24(unsigned char* buff, int index, int count);
-
     /////////////////////////////////////////////////////////////////////////////
     // Get adress as GXDLMSVariant.
     /////////////////////////////////////////////////////////////////////////////
@@ -191,6 +188,16 @@ private:
 
 public:
 
+    /////////////////////////////////////////////////////////////////////////////
+    // Count HDLC frame check sequence. Reserved for internal use.
+    /////////////////////////////////////////////////////////////////////////////
+    static unsigned short CountFCS16(CGXByteBuffer& buff, int index, int count);
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Count PLC frame check sequence. Reserved for internal use.
+    /////////////////////////////////////////////////////////////////////////////
+    static uint32_t CountFCS24(unsigned char* buff, int index, int count);
+
     /////////////////////////////////////////////////////////////////////////////
     // Check client and server addresses. Reserved for internal use.
     /////////////////////////////////////////////////////////////////////////////
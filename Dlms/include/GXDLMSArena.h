@@ -0,0 +1,133 @@
+//
+// --------------------------------------------------------------------------
+//  Gurux Ltd
+//
+//
+//
+// Filename:        $HeadURL$
+//
+// Version:         $Revision$,
+//                  $Date$
+//                  $Author$
+//
+// Copyright (c) Gurux Ltd
+//
+//---------------------------------------------------------------------------
+//
+//  DESCRIPTION
+//
+// This file is a part of Gurux Device Framework.
+//
+// Gurux Device Framework is Open Source software; you can redistribute it
+// and/or modify it under the terms of the GNU General License
+// as published by the Free Software Foundation; version 2 of the License.
+// Gurux Device Framework is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General License for more details.
+//
+// More information of Gurux products: http://www.gurux.org
+//
+// This code is licensed under the GNU General License v2.
+// Full text may be retrieved at http://www.gnu.org/licenses/gpl-2.0.txt
+//---------------------------------------------------------------------------
+
+#ifndef GXDLMSARENA_H
+#define GXDLMSARENA_H
+
+#include <vector>
+#include "GXByteBuffer.h"
+
+/**
+* Memory for the temporary objects of one request.
+*
+* Memory is taken from the end of the current block and it's not released
+* one by one. Everything is released at once when Reset is called after
+* the reply is generated. Blocks and buffers are kept for the next request
+* so allocator is not called when requests are about the same size.
+*
+* Arena is used only while it's set as the current arena of the thread.
+* Arena is not thread safe and it's used by one connection at the time.
+*/
+class CGXDLMSArena
+{
+private:
+    struct CGXArenaBlock
+    {
+        CGXArenaBlock* m_Next;
+        unsigned long m_Size;
+    };
+    //Newest block. Memory is allocated from this.
+    CGXArenaBlock* m_Blocks;
+    //Used bytes of the newest block.
+    unsigned long m_Used;
+    //Minimum size of the new block.
+    unsigned long m_BlockSize;
+    //Byte buffers are kept between requests.
+    std::vector<CGXByteBuffer*> m_Buffers;
+    //Amount of byte buffers in use.
+    unsigned long m_BufferCount;
+
+    //Arena is not copied.
+    CGXDLMSArena(const CGXDLMSArena&);
+    CGXDLMSArena& operator=(const CGXDLMSArena&);
+public:
+    /**
+    * Constructor.
+    *
+    * @param blockSize
+    *            Size of the first block.
+    */
+    CGXDLMSArena(unsigned long blockSize = 4096);
+
+    /**
+    * Destructor.
+    */
+    ~CGXDLMSArena();
+
+    /**
+    * Allocate memory. Memory is valid until arena is reset.
+    *
+    * @param size
+    *            Amount of bytes.
+    * @return Allocated memory or NULL if out of memory.
+    */
+    void* Allocate(unsigned long size);
+
+    /**
+    * Check is memory allocated from this arena.
+    */
+    bool Contains(const void* value);
+
+    /**
+    * Returns an empty byte buffer that can be used until arena is reset.
+    */
+    CGXByteBuffer& GetBuffer();
+
+    /**
+    * Release all allocated memory and buffers at once.
+    * Objects allocated from the arena must be deleted before this.
+    */
+    void Reset();
+
+    /**
+    * @return Arena of the current thread or NULL if arena is not used.
+    */
+    static CGXDLMSArena* GetCurrent();
+
+    /**
+    * @param value
+    *            Arena of the current thread or NULL if arena is not used.
+    */
+    static void SetCurrent(CGXDLMSArena* value);
+
+    /**
+    * Returns an empty byte buffer from the arena of the current thread.
+    *
+    * @param value
+    *            Buffer that is used if arena is not set.
+    */
+    static CGXByteBuffer& GetCurrentBuffer(CGXByteBuffer& value);
+};
+
+#endif //GXDLMSARENA_H
\ No newline at end of file
@@ -41,6 +41,9 @@
 #include "GXDLMSContextType.h"
 #include "GXAuthenticationMechanismName.h"
 #include "GXDLMSObjectCollection.h"
+#include <memory>
+
+struct CGXEncodedObjectList;
 
 /**
 Online help:
@@ -69,14 +72,26 @@ private:
 
     std::pair<unsigned char, std::string> m_CurrentUser;
 
+    /**
+    * Object list and access rights of the last association view read.
+    */
+    std::string m_ObjectListKey;
+
+    /**
+    * Encoded association view. It's shared with the other associations
+    * that have the same objects and access rights.
+    */
+    std::shared_ptr<const CGXEncodedObjectList> m_EncodedObjects;
+
     void UpdateAccessRights(
         CGXDLMSObject* pObj,
-        CGXDLMSVariant data);
+        const CGXDLMSVariant& data);
 
-    int GetAccessRights(
+    // Add object and it's access rights to the object list key.
+    void GetAccessRights(
         CGXDLMSObject* pItem,
-        CGXDLMSServer* server,
-        CGXByteBuffer& data);
+        CGXDLMSValueEventArg& e,
+        std::string& key);
 
     // Returns LN Association View.
     int GetObjects(
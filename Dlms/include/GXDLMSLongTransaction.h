@@ -40,6 +40,7 @@
 #include "GXByteBuffer.h"
 #include "GXDLMSValueEventArg.h"
 #include "GXDLMSValueEventCollection.h"
+#include "GXDLMSArena.h"
 
 class CGXDLMSLongTransaction
 {
@@ -73,6 +74,23 @@ public:
     {
         m_Targets.insert(m_Targets.end(), targets.begin(), targets.end());
         targets.clear();
+        //Transaction is kept after the request. Targets from the arena
+        //are moved to the heap before the arena is reset.
+        CGXDLMSArena* arena = CGXDLMSArena::GetCurrent();
+        if (arena != NULL)
+        {
+            for (std::vector<CGXDLMSValueEventArg*>::iterator it = m_Targets.begin(); it != m_Targets.end(); ++it)
+            {
+                if (arena->Contains(*it))
+                {
+                    CGXDLMSArena::SetCurrent(NULL);
+                    CGXDLMSValueEventArg* e = new CGXDLMSValueEventArg(**it);
+                    CGXDLMSArena::SetCurrent(arena);
+                    delete *it;
+                    *it = e;
+                }
+            }
+        }
         m_Command = command;
         m_Data.Set(&data, data.GetPosition());
     }
@@ -44,6 +44,7 @@
 #include "IGXDLMSBase.h"
 #include "GXHelpers.h"
 #include "GXDateTime.h"
+#include "GXObisCode.h"
 
 class CGXDLMSObjectCollection;
 
@@ -61,6 +62,10 @@ class CGXDLMSObject : public IGXDLMSBase
     void Initialize(short sn, unsigned short class_id, unsigned char version, CGXByteBuffer* pLogicalName);
     std::string m_Description;
     DLMS_OBJECT_TYPE m_ObjectType;
+    //Incremented when attribute value is changed.
+    unsigned long m_ChangeCount;
+    //Encoded values of cached attributes and the change count when they were encoded.
+    std::map<int, std::pair<unsigned long, CGXByteBuffer> > m_EncodedValues;
 protected:
     unsigned short m_Version;
     std::map<int, time_t> m_ReadTimes;
@@ -113,6 +118,39 @@ public:
     //Get Object's Logical Name.
     void GetLogicalName(std::string& ln);
 
+    //Get Object's Logical Name without formatting it to the string.
+    CGXObisCode GetObisCode();
+
+    //Set Object's Logical Name.
+    void SetObisCode(const CGXObisCode& value);
+
+    //Get change count. Count is incremented when attribute is written.
+    unsigned long GetChangeCount();
+
+    //Increment change count. Call this after attribute value is changed
+    //without SetValue, or cached values are not updated.
+    void Changed();
+
+    //Is encoded value of the attribute cached.
+    bool IsCached(int index);
+
+    /////////////////////////////////////////////////////////////////////////
+    // Cache encoded value of the attribute. Attribute is encoded once and
+    // the same bytes are returned until the object is changed.
+    // Use this only with attributes that are rarely changed and that
+    // are encoded the same way for all the clients.
+    //
+    // index: Attribute index.
+    // value: Is attribute cached.
+    void SetCached(int index, bool value);
+
+    //Returns encoded value of the attribute or NULL if attribute is not
+    //cached or object is changed after value was encoded.
+    CGXByteBuffer* GetCachedValue(int index);
+
+    //Save encoded value of the cached attribute.
+    void SetCachedValue(int index, CGXByteBuffer& value);
+
     void SetVersion(unsigned short value);
     unsigned short GetVersion();
 
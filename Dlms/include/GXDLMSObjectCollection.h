@@ -36,18 +36,51 @@
 #define GXDLMSOBJECTCOLLECTION_H
 
 #include <vector>
+#include <unordered_map>
 #include "GXDLMSObject.h"
 #include "GXXmlWriterSettings.h"
 
+/**
+* Objects are found by logical or short name from an index. Index is built
+* on the first search after objects are added or removed. If the name of
+* an object is changed, index is built again when search misses it.
+*
+* Index keeps positions of the objects, not pointers. Object in the
+* position is checked before it's returned, so objects can be replaced,
+* moved or removed with any vector method without index pointing to
+* removed objects.
+*/
 class CGXDLMSObjectCollection : public std::vector<CGXDLMSObject*>
 {
+private:
+    //Positions of the objects by class id and logical name.
+    std::unordered_map<unsigned long long, size_t> m_LNIndex;
+    //Positions of the objects by logical name when class id is not known.
+    std::unordered_map<unsigned long long, size_t> m_AllLNIndex;
+    //Positions of the objects by short name.
+    std::unordered_map<unsigned short, size_t> m_SNIndex;
+    //Is index built.
+    bool m_Indexed;
+    //Amount of objects when index was built.
+    size_t m_IndexedCount;
+
+    //Build index if objects are added or removed.
+    void UpdateIndex();
 public:
+    CGXDLMSObjectCollection();
+
     ~CGXDLMSObjectCollection();
 
     CGXDLMSObject* FindByLN(DLMS_OBJECT_TYPE type, std::string& ln);
 
     CGXDLMSObject* FindByLN(DLMS_OBJECT_TYPE type, unsigned char ln[6]);
 
+    /**
+    * Find object by logical name without formatting or parsing strings.
+    * NULL is returned if logical name is not valid.
+    */
+    CGXDLMSObject* FindByLN(DLMS_OBJECT_TYPE type, const CGXObisCode& ln);
+
     CGXDLMSObject* FindBySN(unsigned short sn);
 
     void GetObjects(DLMS_OBJECT_TYPE type, CGXDLMSObjectCollection& items);
@@ -55,6 +88,12 @@ public:
     void push_back(
         CGXDLMSObject* item);
 
+    iterator erase(const_iterator pos);
+
+    iterator erase(const_iterator first, const_iterator last);
+
+    void clear();
+
     void Free();
 
     std::string ToString();
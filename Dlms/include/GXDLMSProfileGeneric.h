@@ -39,6 +39,7 @@
 #ifndef DLMS_IGNORE_PROFILE_GENERIC
 #include "GXDLMSCaptureObject.h"
 #include "GXDLMSRegister.h"
+#include "IGXDLMSProfileCursor.h"
 
 enum GX_SORT_METHOD
 {
@@ -82,6 +83,10 @@ class CGXDLMSProfileGeneric : public CGXDLMSObject
 {
 private:
     std::vector< std::vector<CGXDLMSVariant> > m_Buffer;
+    //Captured rows are kept in capture order in a ring until buffer is read.
+    bool m_BufferRing;
+    //Position of the oldest row when buffer is used as a ring.
+    unsigned long m_BufferStart;
     std::vector<std::pair<CGXDLMSObject*, CGXDLMSCaptureObject*> > m_CaptureObjects;
     int m_CapturePeriod;
     GX_SORT_METHOD m_SortMethod;
@@ -91,8 +96,16 @@ private:
 
     int m_SortObjectAttributeIndex;
     int m_SortObjectDataIndex;
+    IGXDLMSProfileCursor* m_Cursor;
 
     int GetColumns(CGXByteBuffer& data);
+
+    //Returns index of the column that is used for sorting or -1 if rows are not sorted.
+    int GetSortColumn();
+
+    //Add captured row to the buffer. Row is emptied.
+    void AddRow(std::vector<CGXDLMSVariant>& row);
+
     int GetData(
         CGXDLMSSettings& settings,
         CGXDLMSValueEventArg& e,
@@ -100,6 +113,12 @@ private:
         std::vector<std::pair<CGXDLMSObject*, CGXDLMSCaptureObject*> >& columns,
         CGXByteBuffer& data);
 
+    //Add rows from the cursor that fit to one PDU.
+    int GetCursorData(
+        CGXDLMSSettings& settings,
+        CGXDLMSValueEventArg& e,
+        CGXByteBuffer& data);
+
     int GetProfileGenericData(
         CGXDLMSSettings& settings,
         CGXDLMSValueEventArg& e,
@@ -114,7 +133,7 @@ private:
      *            Selected columns.
      */
     int GetSelectedColumns(
-        std::vector<CGXDLMSVariant>& cols,
+        const std::vector<CGXDLMSVariant>& cols,
         std::vector<std::pair<CGXDLMSObject*, CGXDLMSCaptureObject*> >& columns);
 public:
     /*
@@ -136,7 +155,7 @@ public:
     */
     int GetSelectedColumns(
         int selector,
-        CGXDLMSVariant& parameters,
+        const CGXDLMSVariant& parameters,
         std::vector<std::pair<CGXDLMSObject*, CGXDLMSCaptureObject*> >& columns);
 
     /**
@@ -210,6 +229,13 @@ public:
     int GetSortObjectDataIndex();
     void SetSortObjectDataIndex(int value);
 
+    /**
+     Cursor where rows are read when row indexes are set in PreRead.
+     Buffer is used if cursor is not set.
+    */
+    IGXDLMSProfileCursor* GetCursor();
+    void SetCursor(IGXDLMSProfileCursor* value);
+
     /**
      Clears the buffer.
     */
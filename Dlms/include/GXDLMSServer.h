@@ -89,6 +89,16 @@ private:
      */
     bool m_Initialized;
 
+    /**
+     * Arena for the temporary objects of the request.
+     */
+    CGXDLMSArena* m_Arena;
+
+    /**
+     * Client addresses that are associated without AARQ.
+     */
+    std::vector<unsigned long> m_PreEstablishedClients;
+
     /**
     * Parse SNRM Request. If server do not accept client empty byte array is
     * returned.
@@ -105,6 +115,20 @@ private:
     */
     void Reset(bool connected);
 
+    /**
+    * Associate the client without AARQ if the client address is
+    * pre-established and the command is a service request.
+    */
+    void PreEstablish(
+        DLMS_COMMAND command,
+        CGXDLMSConnectionEventArgs& connectionInfo);
+
+    /**
+    * Update application context, authentication mechanism and status of
+    * the current association.
+    */
+    void UpdateAssociation(DLMS_ASSOCIATION_STATUS status);
+
     int ReportError(
         DLMS_COMMAND command,
         DLMS_ERROR_CODE error,
@@ -135,6 +159,12 @@ private:
         CGXServerReply& sr,
         unsigned char cipheredCommand);
 
+    /**
+    * Handle data that is appended to the received data.
+    * Received data and frame payload can be attached to the request data.
+    */
+    int HandleReceivedData(CGXServerReply& sr);
+
     /**
     * Parse AARQ request that client send and returns AARE request.
     *
@@ -527,7 +557,7 @@ public:
     /**
     * Destructor.
     */
-    ~CGXDLMSServer();
+    virtual ~CGXDLMSServer();
 
     //Server is using push client address when sending push messages. Client address is used if PushAddress is zero.
     unsigned long GetPushClientAddress();
@@ -579,6 +609,31 @@ public:
     void SetUseLogicalNameReferencing(
         bool value);
 
+    /**
+     * @return Arena where temporary objects of the request are allocated
+     *         or NULL if arena is not used.
+     */
+    CGXDLMSArena* GetArena();
+
+    /**
+     * Arena is not used by default. Arena is reset after each request
+     * and it can't be shared with other servers that handle requests at
+     * the same time.
+     *
+     * @param value
+     *            Arena where temporary objects of the request are allocated.
+     */
+    void SetArena(CGXDLMSArena* value);
+
+    /**
+     * Client addresses that can send requests without AARQ. Pre-established
+     * association uses no authentication and it's not ciphered. Conformance
+     * and PDU size are the ones that the server proposes.
+     *
+     * @return Pre-established client addresses.
+     */
+    std::vector<unsigned long>& GetPreEstablishedClients();
+
     /**
      * Initialize server. This must call after server objects are set.
      */
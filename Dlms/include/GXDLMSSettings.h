@@ -122,12 +122,12 @@ class CGXDLMSSettings
     /**
      * Long data count.
      */
-    unsigned short m_Count;
+    unsigned long m_Count;
 
     /**
      * Long data index.
      */
-    unsigned short m_Index;
+    unsigned long m_Index;
 
     // DLMS version number.
     unsigned char m_DlmsVersionNumber;
@@ -436,24 +436,24 @@ public:
     /**
      * @return Long data count.
      */
-    unsigned short GetCount();
+    unsigned long GetCount();
 
     /**
      * @param count
      *            Long data count.
      */
-    void SetCount(unsigned short value);
+    void SetCount(unsigned long value);
 
     /**
      * @return Long data index.
      */
-    unsigned short GetIndex();
+    unsigned long GetIndex();
 
     /**
      * @param index
      *            Long data index
      */
-    void SetIndex(unsigned short value);
+    void SetIndex(unsigned long value);
 
     /**
     * Server will tell what functionality is available. Client will know what functionality server offers.
@@ -105,15 +105,15 @@ private:
     * Row to PDU is used with Profile Generic to tell how many rows are fit to
     * one PDU.
     */
-    unsigned short m_RowToPdu;
+    unsigned long m_RowToPdu;
     /**
     * Rows begin index.
     */
-    unsigned short m_RowBeginIndex;
+    unsigned long m_RowBeginIndex;
     /**
     * Rows end index.
     */
-    unsigned short m_RowEndIndex;
+    unsigned long m_RowEndIndex;
 
     /**
     * DLMS settings.
@@ -262,6 +262,14 @@ public:
         int selector,
         CGXDLMSVariant& parameters);
 
+    /**
+    * Event arguments are allocated from the arena of the current thread
+    * when it's set. They are released when the arena is reset.
+    */
+    static void* operator new(size_t size);
+
+    static void operator delete(void* value);
+
     /**
     * @return Occurred error.
     */
@@ -310,35 +318,35 @@ public:
     /**
     * @return How many rows are read to one PDU.
     */
-    unsigned short GetRowToPdu();
+    unsigned long GetRowToPdu();
 
     /**
     * @param value
     *            How many rows are read to one PDU.
     */
-    void SetRowToPdu(unsigned short value);
+    void SetRowToPdu(unsigned long value);
 
     /**
     * @return Rows end index.
     */
-    unsigned int GetRowEndIndex();
+    unsigned long GetRowEndIndex();
 
     /**
     * @param value
     *            Rows end index.
     */
-    void SetRowEndIndex(unsigned int value);
+    void SetRowEndIndex(unsigned long value);
 
     /**
     * @return Rows begin index.
     */
-    unsigned int GetRowBeginIndex();
+    unsigned long GetRowBeginIndex();
 
     /**
     * @param value
     *            Rows begin index.
     */
-    void SetRowBeginIndex(unsigned int value);
+    void SetRowBeginIndex(unsigned long value);
 
     /**
     * DLMS settings.
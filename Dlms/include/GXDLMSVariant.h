@@ -72,16 +72,31 @@ struct dlmsVARIANT
             } 	__VARIANT_NAME_3;
         } 	__VARIANT_NAME_2;
     } 	__VARIANT_NAME_1;
-    CGXDateTime dateTime;
     //Size of byte array.
     unsigned short size;
-    std::string strVal;
-    std::vector<CGXDLMSVariant> Arr;
+    //Date time, string and array values are allocated when they are used
+    //first time. Variant that holds a number doesn't allocate memory.
+    CGXDateTime* pDateTime;
+    std::string* pStrVal;
+    std::vector<CGXDLMSVariant>* pArr;
+
+    dlmsVARIANT()
+    {
+        pDateTime = NULL;
+        pStrVal = NULL;
+        pArr = NULL;
+    }
 };
 
 class CGXDLMSVariant : public dlmsVARIANT
 {
     static int Convert(CGXDLMSVariant* item, DLMS_DATA_TYPE type);
+
+    //Copy value. Variant must be cleared before this is called.
+    void Copy(const CGXDLMSVariant& value);
+
+    //Take value of the given variant and leave it empty.
+    void MoveFrom(CGXDLMSVariant& value);
 public:
     void Clear();
     CGXDLMSVariant();
@@ -89,6 +104,9 @@ public:
     //Copy constructor.
     CGXDLMSVariant(const CGXDLMSVariant& value);
 
+    //Move constructor.
+    CGXDLMSVariant(CGXDLMSVariant&& value) noexcept;
+
     CGXDLMSVariant(float value);
     CGXDLMSVariant(double value);
 
@@ -119,6 +137,8 @@ public:
 
     CGXDLMSVariant& operator=(const CGXDLMSVariant& value);
 
+    CGXDLMSVariant& operator=(CGXDLMSVariant&& value) noexcept;
+
     CGXDLMSVariant& operator=(std::string value);
     CGXDLMSVariant& operator=(const char* value);
     CGXDLMSVariant& operator=(CGXByteBuffer& value);
@@ -145,15 +165,33 @@ public:
     bool Equals(CGXDLMSVariant& item);
     int ChangeType(DLMS_DATA_TYPE newType);
     //Get size in bytes.
-    int GetSize();
+    int GetSize() const;
     //Get size in bytes.
     static int GetSize(DLMS_DATA_TYPE vt);
-    std::string ToString();
-    int ToInteger();
-    double ToDouble();
+    std::string ToString() const;
+    int ToInteger() const;
+    double ToDouble() const;
     int GetBytes(CGXByteBuffer& value);
 
     //Returns true if value is number.
-    bool IsNumber();
+    bool IsNumber() const;
+
+    //Non-const accessors allocate the value if variant doesn't have it.
+    //Values that are only read are read through a const variant.
+
+    //Date and time value.
+    CGXDateTime& dateTime();
+
+    const CGXDateTime& dateTime() const;
+
+    //String value.
+    std::string& strVal();
+
+    const std::string& strVal() const;
+
+    //Items of the array or structure.
+    std::vector<CGXDLMSVariant>& Arr();
+
+    const std::vector<CGXDLMSVariant>& Arr() const;
 };
 #endif //GXDLMSVARIANT_H
@@ -168,6 +168,7 @@ public:
     /////////////////////////////////////////////////////////////////////////
     // Used date time value.
     struct tm& GetValue();
+    const struct tm& GetValue() const;
     void SetValue(const struct tm& value);
 
     /////////////////////////////////////////////////////////////////////////
@@ -257,5 +258,6 @@ public:
     /////////////////////////////////////////////////////////////////////////
     //Return datetime as unix time.
     unsigned long ToUnixTime();
+    unsigned long ToUnixTime() const;
 };
 #endif //GXDATETIME_H
@@ -149,7 +149,9 @@ typedef enum
     //Client try to connect with wrong security.
     DLMS_ERROR_CODE_INVALID_DECIPHERING_ERROR,
     //Client try to connect with wrong security suite.
-    DLMS_ERROR_CODE_INVALID_SECURITY_SUITE
+    DLMS_ERROR_CODE_INVALID_SECURITY_SUITE,
+    //Invocation counter has reached the limit and nothing is ciphered with it.
+    DLMS_ERROR_CODE_INVOCATION_COUNTER_LIMIT
 }DLMS_ERROR_CODE;
 
 #endif //DLMS_ERROR_CODE_H
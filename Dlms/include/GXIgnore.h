@@ -48,6 +48,7 @@ extern "C" {
 // #define DLMS_IGNORE_HIGH_SHA1
 // #define DLMS_IGNORE_HIGH_MD5
 // #define DLMS_IGNORE_AES
+// #define DLMS_IGNORE_AES_INSTRUCTIONS
 // #define DLMS_IGNORE_HIGH_GMAC
 // #define DLMS_IGNORE_DATA
 // #define DLMS_IGNORE_REGISTER
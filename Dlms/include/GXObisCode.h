@@ -0,0 +1,199 @@
+//
+// --------------------------------------------------------------------------
+//  Gurux Ltd
+//
+//
+//
+// Filename:        $HeadURL$
+//
+// Version:         $Revision$,
+//                  $Date$
+//                  $Author$
+//
+// Copyright (c) Gurux Ltd
+//
+//---------------------------------------------------------------------------
+//
+//  DESCRIPTION
+//
+// This file is a part of Gurux Device Framework.
+//
+// Gurux Device Framework is Open Source software; you can redistribute it
+// and/or modify it under the terms of the GNU General License
+// as published by the Free Software Foundation; version 2 of the License.
+// Gurux Device Framework is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General License for more details.
+//
+// More information of Gurux products: http://www.gurux.org
+//
+// This code is licensed under the GNU General License v2.
+// Full text may be retrieved at http://www.gnu.org/licenses/gpl-2.0.txt
+//---------------------------------------------------------------------------
+
+#ifndef GXOBISCODE_H
+#define GXOBISCODE_H
+
+#include <string>
+#include <functional>
+
+/**
+* Logical name (OBIS code) packed to the lower 48 bits of an integer.
+* The first value group is in the most significant byte.
+*
+* Logical name can be parsed from a string literal at compile time:
+*
+* static constexpr CGXObisCode CLOCK("0.0.1.0.0.255");
+*
+* If string is not a valid logical name, constexpr code doesn't compile.
+* At runtime invalid logical name is marked with IsValid.
+*/
+class CGXObisCode
+{
+private:
+    //Set if logical name is not valid.
+    static constexpr unsigned long long INVALID = 0x1000000000000ULL;
+
+    unsigned long long m_Value;
+
+    //Not constexpr so invalid logical name is a compile error in
+    //constant expressions.
+    static unsigned long long Invalid()
+    {
+        return INVALID;
+    }
+
+    static constexpr unsigned long long Parse(const char* value)
+    {
+        unsigned long long ret = 0;
+        for (int group = 0; group != 6; ++group)
+        {
+            if (*value < '0' || *value > '9')
+            {
+                return Invalid();
+            }
+            unsigned int v = 0;
+            while (*value >= '0' && *value <= '9')
+            {
+                v = 10 * v + (unsigned int)(*value - '0');
+                if (v > 255)
+                {
+                    return Invalid();
+                }
+                ++value;
+            }
+            if (*value != (group == 5 ? '\0' : '.'))
+            {
+                return Invalid();
+            }
+            if (group != 5)
+            {
+                ++value;
+            }
+            ret = (ret << 8) | v;
+        }
+        return ret;
+    }
+public:
+    /**
+    * Constructor. Logical name is 0.0.0.0.0.0.
+    */
+    constexpr CGXObisCode() : m_Value(0)
+    {
+    }
+
+    /**
+    * Constructor.
+    *
+    * @param value
+    *            Logical name in "A.B.C.D.E.F" format.
+    */
+    constexpr CGXObisCode(const char* value) : m_Value(Parse(value))
+    {
+    }
+
+    /**
+    * Constructor.
+    *
+    * @param a .. f
+    *            Value groups of the logical name.
+    */
+    constexpr CGXObisCode(
+        unsigned char a,
+        unsigned char b,
+        unsigned char c,
+        unsigned char d,
+        unsigned char e,
+        unsigned char f) :
+        m_Value(((unsigned long long)a << 40) | ((unsigned long long)b << 32) |
+            ((unsigned long long)c << 24) | ((unsigned long long)d << 16) |
+            ((unsigned long long)e << 8) | f)
+    {
+    }
+
+    /**
+    * Constructor.
+    *
+    * @param value
+    *            Logical name as 6 bytes.
+    */
+    explicit constexpr CGXObisCode(const unsigned char* value) :
+        CGXObisCode(value[0], value[1], value[2], value[3], value[4], value[5])
+    {
+    }
+
+    /**
+    * @return Logical name as 48-bit integer.
+    */
+    constexpr unsigned long long GetValue() const
+    {
+        return m_Value;
+    }
+
+    /**
+    * @return Is logical name valid.
+    */
+    constexpr bool IsValid() const
+    {
+        return (m_Value & INVALID) == 0;
+    }
+
+    /**
+    * Copy logical name to 6 bytes.
+    */
+    void GetBytes(unsigned char* value) const;
+
+    /**
+    * @return Logical name in "A.B.C.D.E.F" format.
+    */
+    std::string ToString() const;
+
+    constexpr bool operator==(const CGXObisCode& value) const
+    {
+        return m_Value == value.m_Value;
+    }
+
+    constexpr bool operator!=(const CGXObisCode& value) const
+    {
+        return m_Value != value.m_Value;
+    }
+
+    constexpr bool operator<(const CGXObisCode& value) const
+    {
+        return m_Value < value.m_Value;
+    }
+};
+
+namespace std
+{
+    template<> struct hash<CGXObisCode>
+    {
+        size_t operator()(const CGXObisCode& value) const
+        {
+            return std::hash<unsigned long long>()(value.GetValue());
+        }
+    };
+}
+
+#endif //GXOBISCODE_H
\ No newline at end of file
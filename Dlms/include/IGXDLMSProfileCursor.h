@@ -0,0 +1,77 @@
+//
+// --------------------------------------------------------------------------
+//  Gurux Ltd
+//
+//
+//
+// Filename:        $HeadURL$
+//
+// Version:         $Revision$,
+//                  $Date$
+//                  $Author$
+//
+// Copyright (c) Gurux Ltd
+//
+//---------------------------------------------------------------------------
+//
+//  DESCRIPTION
+//
+// This file is a part of Gurux Device Framework.
+//
+// Gurux Device Framework is Open Source software; you can redistribute it
+// and/or modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; version 2 of the License.
+// Gurux Device Framework is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// More information of Gurux products: http://www.gurux.org
+//
+// This code is licensed under the GNU General Public License v2.
+// Full text may be retrieved at http://www.gnu.org/licenses/gpl-2.0.txt
+//---------------------------------------------------------------------------
+#ifndef IGXDLMSPROFILECURSOR_H
+#define IGXDLMSPROFILECURSOR_H
+
+#include <vector>
+#include "GXEnums.h"
+#include "GXByteBuffer.h"
+
+class CGXDLMSSettings;
+
+/////////////////////////////////////////////////////////////////////////
+// Profile generic rows that are kept in the storage of the application.
+// Rows are encoded straight to the reply and the buffer of the profile
+// generic is not used.
+/////////////////////////////////////////////////////////////////////////
+struct IGXDLMSProfileCursor
+{
+public:
+    virtual ~IGXDLMSProfileCursor()
+    {
+    }
+
+    /**
+    * Add rows to the reply. Each row is added as a structure.
+    *
+    * @param settings DLMS settings.
+    * @param types Data types of the columns. Type is DLMS_DATA_TYPE_NONE
+    *            if it's not known.
+    * @param columns Zero based indexes of the selected columns. Other
+    *            columns are not added.
+    * @param index Zero based index of the first row.
+    * @param count Maximum amount of rows to add.
+    * @param data Reply where rows are added.
+    * @param rows Amount of added rows.
+    */
+    virtual int GetRows(
+        CGXDLMSSettings& settings,
+        std::vector<DLMS_DATA_TYPE>& types,
+        std::vector<int>& columns,
+        unsigned long index,
+        unsigned long count,
+        CGXByteBuffer& data,
+        unsigned long& rows) = 0;
+};
+#endif //IGXDLMSPROFILECURSOR_H
@@ -25,15 +25,20 @@
 #include <string.h>
 #include <stdio.h>
 #include <assert.h>
+#include <type_traits>
 #include "GXErrorCodes.h"
 #include "GXByteBuffer.h"
 #include "GXHelpers.h"
 
+//Vectors move the buffers when they grow only if move can't throw.
+static_assert(std::is_nothrow_move_constructible<CGXByteBuffer>::value, "CGXByteBuffer move must be noexcept.");
+
 //Constructor.
 CGXByteBuffer::CGXByteBuffer()
 {
-    m_Capacity = 0;
-    m_Data = NULL;
+    m_Capacity = BYTE_BUFFER_INLINE_SIZE;
+    m_Data = m_Inline;
+    m_Attached = false;
     m_Position = 0;
     m_Size = 0;
 }
@@ -41,8 +46,9 @@ CGXByteBuffer::CGXByteBuffer()
 //Constructor.
 CGXByteBuffer::CGXByteBuffer(int capacity)
 {
-    m_Capacity = 0;
-    m_Data = NULL;
+    m_Capacity = BYTE_BUFFER_INLINE_SIZE;
+    m_Data = m_Inline;
+    m_Attached = false;
     m_Position = 0;
     m_Size = 0;
     Capacity(capacity);
@@ -51,8 +57,9 @@ CGXByteBuffer::CGXByteBuffer(int capacity)
 //Copy constructor.
 CGXByteBuffer::CGXByteBuffer(const CGXByteBuffer& value)
 {
-    m_Capacity = 0;
-    m_Data = NULL;
+    m_Capacity = BYTE_BUFFER_INLINE_SIZE;
+    m_Data = m_Inline;
+    m_Attached = false;
     m_Position = 0;
     m_Size = 0;
     if (value.m_Size - value.m_Position != 0)
@@ -61,6 +68,37 @@ CGXByteBuffer::CGXByteBuffer(const CGXByteBuffer& value)
     }
 }
 
+//Move constructor.
+CGXByteBuffer::CGXByteBuffer(CGXByteBuffer&& value) noexcept
+{
+    MoveFrom(value);
+}
+
+void CGXByteBuffer::MoveFrom(CGXByteBuffer& value)
+{
+    if (value.m_Data == value.m_Inline)
+    {
+        //Inline data must be copied.
+        memcpy(m_Inline, value.m_Inline, value.m_Size);
+        m_Data = m_Inline;
+        m_Capacity = BYTE_BUFFER_INLINE_SIZE;
+        m_Attached = false;
+    }
+    else
+    {
+        m_Data = value.m_Data;
+        m_Capacity = value.m_Capacity;
+        m_Attached = value.m_Attached;
+        value.m_Data = value.m_Inline;
+        value.m_Capacity = BYTE_BUFFER_INLINE_SIZE;
+        value.m_Attached = false;
+    }
+    m_Size = value.m_Size;
+    m_Position = value.m_Position;
+    value.m_Size = 0;
+    value.m_Position = 0;
+}
+
 //Destructor.
 CGXByteBuffer::~CGXByteBuffer()
 {
@@ -112,29 +150,47 @@ void CGXByteBuffer::SetPosition(unsigned long value)
 }
 
 // Allocate new size for the array in bytes.
+// Small buffers are kept inline and memory is allocated only when
+// capacity is bigger than BYTE_BUFFER_INLINE_SIZE.
 int CGXByteBuffer::Capacity(unsigned long capacity)
 {
-    m_Capacity = capacity;
     if (capacity == 0)
     {
-        if (m_Data != NULL)
-        {
-            free(m_Data);
-            m_Data = NULL;
-        }
         m_Size = 0;
         m_Position = 0;
     }
+    if (m_Size > capacity)
+    {
+        m_Size = capacity;
+    }
+    if (capacity <= BYTE_BUFFER_INLINE_SIZE)
+    {
+        if (m_Data != m_Inline)
+        {
+            memcpy(m_Inline, m_Data, m_Size);
+            if (!m_Attached)
+            {
+                free(m_Data);
+            }
+            m_Data = m_Inline;
+            m_Capacity = BYTE_BUFFER_INLINE_SIZE;
+            m_Attached = false;
+        }
+    }
     else
     {
         unsigned char* tmp;
-        if (m_Data == NULL)
+        if (m_Data == m_Inline || m_Attached)
         {
-            tmp = (unsigned char*)malloc(m_Capacity);
+            tmp = (unsigned char*)malloc(capacity);
+            if (tmp != NULL)
+            {
+                memcpy(tmp, m_Data, m_Size);
+            }
         }
         else
         {
-            tmp = (unsigned char*)realloc(m_Data, m_Capacity);
+            tmp = (unsigned char*)realloc(m_Data, capacity);
         }
         //If not enought memory available.
         if (tmp == NULL)
@@ -142,12 +198,29 @@ int CGXByteBuffer::Capacity(unsigned long capacity)
             return DLMS_ERROR_CODE_OUTOFMEMORY;
         }
         m_Data = tmp;
-        if (m_Size > capacity)
+        m_Capacity = capacity;
+        m_Attached = false;
+    }
+    return 0;
+}
+
+int CGXByteBuffer::Reserve(unsigned long size)
+{
+    if (size <= m_Capacity)
+    {
+        if (!m_Attached)
         {
-            m_Size = capacity;
+            return 0;
         }
+        //Attached data is copied before it's modified.
+        return Capacity(m_Capacity);
     }
-    return 0;
+    unsigned long capacity = 2 * m_Capacity;
+    if (capacity < size)
+    {
+        capacity = size;
+    }
+    return Capacity(capacity);
 }
 
 unsigned long CGXByteBuffer::Capacity()
@@ -158,9 +231,9 @@ unsigned long CGXByteBuffer::Capacity()
 // Fill buffer it with zeros.
 void CGXByteBuffer::Zero(unsigned long index, unsigned long count)
 {
-    if (index + count > m_Capacity)
+    if (Reserve(index + count) != 0)
     {
-        CGXByteBuffer::Capacity(index + count);
+        return;
     }
     if (m_Size < index + count)
     {
@@ -182,16 +255,10 @@ int CGXByteBuffer::SetUInt8(unsigned char item)
 
 int CGXByteBuffer::SetUInt8(unsigned long index, unsigned char item)
 {
-    if (m_Capacity == 0 || index + 1 > m_Capacity)
+    int ret;
+    if ((ret = Reserve(index + 1)) != 0)
     {
-        m_Capacity += VECTOR_CAPACITY;
-        unsigned char* tmp = (unsigned char*)realloc(m_Data, m_Capacity);
-        //If not enought memory available.
-        if (tmp == NULL)
-        {
-            return DLMS_ERROR_CODE_OUTOFMEMORY;
-        }
-        m_Data = tmp;
+        return ret;
     }
     m_Data[index] = item;
     return 0;
@@ -209,16 +276,10 @@ int CGXByteBuffer::SetUInt16(unsigned short item)
 
 int CGXByteBuffer::SetUInt16(unsigned long index, unsigned short item)
 {
-    if (m_Capacity == 0 || index + 2 > m_Capacity)
+    int ret;
+    if ((ret = Reserve(index + 2)) != 0)
     {
-        m_Capacity += VECTOR_CAPACITY;
-        unsigned char* tmp = (unsigned char*)realloc(m_Data, m_Capacity);
-        //If not enought memory available.
-        if (tmp == NULL)
-        {
-            return DLMS_ERROR_CODE_OUTOFMEMORY;
-        }
-        m_Data = tmp;
+        return ret;
     }
     m_Data[index] = (item >> 8) & 0xFF;
     m_Data[index + 1] = item & 0xFF;
@@ -237,16 +298,10 @@ int CGXByteBuffer::SetUInt32(unsigned long item)
 
 int CGXByteBuffer::SetUInt32ByIndex(unsigned long index, unsigned long item)
 {
-    if (m_Capacity == 0 || index + 4 > m_Capacity)
+    int ret;
+    if ((ret = Reserve(index + 4)) != 0)
     {
-        m_Capacity += VECTOR_CAPACITY;
-        unsigned char* tmp = (unsigned char*)realloc(m_Data, m_Capacity);
-        //If not enought memory available.
-        if (tmp == NULL)
-        {
-            return DLMS_ERROR_CODE_OUTOFMEMORY;
-        }
-        m_Data = tmp;
+        return ret;
     }
     m_Data[index] = (item >> 24) & 0xFF;
     m_Data[index + 1] = (item >> 16) & 0xFF;
@@ -257,16 +312,10 @@ int CGXByteBuffer::SetUInt32ByIndex(unsigned long index, unsigned long item)
 
 int CGXByteBuffer::SetUInt64(unsigned long long item)
 {
-    if (m_Capacity == 0 || m_Size + 8 > m_Capacity)
+    int ret;
+    if ((ret = Reserve(m_Size + 8)) != 0)
     {
-        m_Capacity += VECTOR_CAPACITY;
-        unsigned char* tmp = (unsigned char*)realloc(m_Data, m_Capacity);
-        //If not enought memory available.
-        if (tmp == NULL)
-        {
-            return DLMS_ERROR_CODE_OUTOFMEMORY;
-        }
-        m_Data = tmp;
+        return ret;
     }
     m_Data[m_Size] = (unsigned char)((item >> 56) & 0xFF);
     m_Data[m_Size + 1] = (item >> 48) & 0xFF;
@@ -290,16 +339,10 @@ int CGXByteBuffer::SetFloat(float value)
 
     HELPER tmp;
     tmp.value = value;
-    if (m_Capacity == 0 || m_Size + 4 > m_Capacity)
+    int ret;
+    if ((ret = Reserve(m_Size + 4)) != 0)
     {
-        m_Capacity += VECTOR_CAPACITY;
-        unsigned char* tmp = (unsigned char*)realloc(m_Data, m_Capacity);
-        //If not enought memory available.
-        if (tmp == NULL)
-        {
-            return DLMS_ERROR_CODE_OUTOFMEMORY;
-        }
-        m_Data = tmp;
+        return ret;
     }
     m_Data[m_Size] = tmp.b[3];
     m_Data[m_Size + 1] = tmp.b[2];
@@ -319,16 +362,10 @@ int CGXByteBuffer::SetDouble(double value)
 
     HELPER tmp;
     tmp.value = value;
-    if (m_Capacity == 0 || m_Size + 8 > m_Capacity)
+    int ret;
+    if ((ret = Reserve(m_Size + 8)) != 0)
     {
-        m_Capacity += VECTOR_CAPACITY;
-        unsigned char* tmp = (unsigned char*)realloc(m_Data, m_Capacity);
-        //If not enought memory available.
-        if (tmp == NULL)
-        {
-            return DLMS_ERROR_CODE_OUTOFMEMORY;
-        }
-        m_Data = tmp;
+        return ret;
     }
     m_Data[m_Size] = tmp.b[7];
     m_Data[m_Size + 1] = tmp.b[6];
@@ -366,24 +403,10 @@ int CGXByteBuffer::Set(const void* pSource, unsigned long count)
 {
     if (pSource != NULL && count != 0)
     {
-        if (m_Size + count > m_Capacity)
+        int ret;
+        if ((ret = Reserve(m_Size + count)) != 0)
         {
-            //First time data is reserved only for the added data.
-            if (m_Capacity == 0)
-            {
-                m_Capacity = count;
-            }
-            else
-            {
-                m_Capacity += count + VECTOR_CAPACITY;
-            }
-            unsigned char* tmp = (unsigned char*)realloc(m_Data, m_Capacity);
-            //If not enought memory available.
-            if (tmp == NULL)
-            {
-                return DLMS_ERROR_CODE_OUTOFMEMORY;
-            }
-            m_Data = tmp;
+            return ret;
         }
         memcpy(m_Data + m_Size, pSource, count);
         m_Size += count;
@@ -434,6 +457,32 @@ int CGXByteBuffer::AttachString(char* value)
     return ret;
 }
 
+void CGXByteBuffer::Attach(const unsigned char* value, unsigned long count)
+{
+    Clear();
+    if (count != 0)
+    {
+        m_Data = (unsigned char*)value;
+        m_Capacity = count;
+        m_Size = count;
+        m_Attached = true;
+    }
+}
+
+bool CGXByteBuffer::IsAttached()
+{
+    return m_Attached;
+}
+
+int CGXByteBuffer::Detach()
+{
+    if (m_Attached)
+    {
+        return Capacity(m_Size);
+    }
+    return 0;
+}
+
 void CGXByteBuffer::Clear()
 {
     Capacity(0);
@@ -738,13 +787,10 @@ int CGXByteBuffer::Move(unsigned long srcPos, unsigned long destPos, unsigned lo
 {
     if (count != 0)
     {
-        if (destPos + count > m_Capacity)
+        int ret = Reserve(destPos + count);
+        if (ret != 0)
         {
-            int ret = Capacity(destPos + count);
-            if (ret != 0)
-            {
-                return ret;
-            }
+            return ret;
         }
         //Do not use memcpy here!
         memmove(m_Data + destPos, m_Data + srcPos, count);
@@ -803,6 +849,16 @@ void CGXByteBuffer::ToArray(unsigned char*& value, unsigned long& count)
     memcpy(value, m_Data, count);
 }
 
+CGXByteBuffer& CGXByteBuffer::operator=(CGXByteBuffer&& value) noexcept
+{
+    if (this != &value)
+    {
+        Clear();
+        MoveFrom(value);
+    }
+    return *this;
+}
+
 CGXByteBuffer& CGXByteBuffer::operator=(CGXByteBuffer& value)
 {
     Capacity(value.GetSize());
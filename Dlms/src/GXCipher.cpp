@@ -33,10 +33,26 @@
 //---------------------------------------------------------------------------
 
 #include <string.h>
+#include "GXIgnore.h"
 #include "GXCipher.h"
 #include "GXChipperingEnums.h"
 #include "GXHelpers.h"
 
+#if !defined(DLMS_IGNORE_AES_INSTRUCTIONS) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define GX_AES_INSTRUCTIONS
+#define GX_AES_TARGET __attribute__((target("aes,sse2")))
+#define GX_CLMUL_TARGET __attribute__((target("pclmul,ssse3,sse2")))
+#include <wmmintrin.h>
+#include <tmmintrin.h>
+#elif !defined(DLMS_IGNORE_AES_INSTRUCTIONS) && defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#define GX_AES_INSTRUCTIONS
+#define GX_AES_TARGET
+#define GX_CLMUL_TARGET
+#include <intrin.h>
+#include <wmmintrin.h>
+#include <tmmintrin.h>
+#endif
+
 void CGXCipher::Init(
     unsigned char* systemTitle,
     unsigned char count)
@@ -52,11 +68,13 @@ void CGXCipher::Init(
         0xD8,  0xD9,  0xDA,  0xDB,  0xDC, 0xDD,  0xDE,  0xDF
     };
     m_FrameCounter = 0;
+    m_InvocationCounterLimit = 0xFFFFFFFF;
     m_Security = DLMS_SECURITY_NONE;
     m_SystemTitle.Set(systemTitle, count);
     m_BlockCipherKey.Set(BLOCKCIPHERKEY, sizeof(BLOCKCIPHERKEY));
     m_AuthenticationKey.Set(AUTHENTICATIONKEY, sizeof(AUTHENTICATIONKEY));
     m_SecuritySuite = DLMS_SECURITY_SUITE_V1;
+    ClearKeys();
 }
 
 CGXCipher::CGXCipher(CGXByteBuffer& systemTitle)
@@ -344,6 +362,144 @@ d##3 = TE0(s##3) ^ TE1(s##0) ^ TE2(s##1) ^ TE3(s##2) ^ rk[4 * i + 3]
     PUT32(ct + 12, s3);
 }
 
+//Processor instructions can be disabled to compare them with the tables.
+static bool PROCESSOR_INSTRUCTIONS = true;
+
+void CGXCipher::SetProcessorInstructions(bool value)
+{
+    PROCESSOR_INSTRUCTIONS = value;
+}
+
+#ifdef GX_AES_INSTRUCTIONS
+//Encrypt one block with AES instructions. Round keys are in byte order.
+static GX_AES_TARGET void AesEncryptBlock(
+    const unsigned char* roundKeys,
+    const unsigned char* pt,
+    unsigned char* ct)
+{
+    const __m128i* rk = (const __m128i*)roundKeys;
+    __m128i m = _mm_xor_si128(_mm_loadu_si128((const __m128i*)pt), _mm_loadu_si128(rk));
+    for (int r = 1; r != 10; ++r)
+    {
+        m = _mm_aesenc_si128(m, _mm_loadu_si128(rk + r));
+    }
+    m = _mm_aesenclast_si128(m, _mm_loadu_si128(rk + 10));
+    _mm_storeu_si128((__m128i*)ct, m);
+}
+
+//Check does processor support AES instructions.
+static bool IsAesInstructionsSupported()
+{
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    return (info[2] & (1 << 25)) != 0;
+#else
+    return __builtin_cpu_supports("aes") != 0;
+#endif
+}
+#endif //GX_AES_INSTRUCTIONS
+
+bool CGXCipher::IsAesInstructionsUsable()
+{
+#ifdef GX_AES_INSTRUCTIONS
+    //Known answer test from FIPS-197 appendix C.1.
+    const unsigned char KEY[] =
+    {
+        0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+        0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F
+    };
+    const unsigned char PLAIN_TEXT[] =
+    {
+        0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77,
+        0x88, 0x99, 0xAA, 0xBB, 0xCC, 0xDD, 0xEE, 0xFF
+    };
+    const unsigned char CIPHER_TEXT[] =
+    {
+        0x69, 0xC4, 0xE0, 0xD8, 0x6A, 0x7B, 0x04, 0x30,
+        0xD8, 0xCD, 0xB7, 0x80, 0x70, 0xB4, 0xC5, 0x5A
+    };
+    uint32_t rk[61];
+    unsigned char roundKeys[176];
+    unsigned char ct[16];
+    if (!IsAesInstructionsSupported())
+    {
+        return false;
+    }
+    Int(rk, KEY, 128);
+    for (int pos = 0; pos != 44; ++pos)
+    {
+        PUT32(roundKeys + 4 * pos, rk[pos]);
+    }
+    AesEncrypt(rk, 10, PLAIN_TEXT, ct);
+    if (memcmp(ct, CIPHER_TEXT, 16) != 0)
+    {
+        return false;
+    }
+    AesEncryptBlock(roundKeys, PLAIN_TEXT, ct);
+    return memcmp(ct, CIPHER_TEXT, 16) == 0;
+#else
+    return false;
+#endif //GX_AES_INSTRUCTIONS
+}
+
+void CGXCipher::AesEncrypt(
+    const CGXAesKey& key,
+    const unsigned char* pt,
+    unsigned char* ct)
+{
+#ifdef GX_AES_INSTRUCTIONS
+    //Processor is checked only once.
+    static const bool AES_INSTRUCTIONS = IsAesInstructionsUsable();
+    if (AES_INSTRUCTIONS && PROCESSOR_INSTRUCTIONS)
+    {
+        AesEncryptBlock(key.m_RoundKeyBytes, pt, ct);
+        return;
+    }
+#endif //GX_AES_INSTRUCTIONS
+    AesEncrypt(key.m_RoundKeys, key.m_RoundKeys[60], pt, ct);
+}
+
+int CGXCipher::GetKey(
+    CGXByteBuffer& key,
+    CGXAesKey*& value)
+{
+    if (key.GetSize() < 16)
+    {
+        return DLMS_ERROR_CODE_INVALID_PARAMETER;
+    }
+    for (int pos = 0; pos != 2; ++pos)
+    {
+        if (m_Keys[pos].m_Valid && memcmp(m_Keys[pos].m_Key, key.m_Data, 16) == 0)
+        {
+            value = &m_Keys[pos];
+            return 0;
+        }
+    }
+    //Replace the key that was expanded earlier.
+    value = &m_Keys[m_NextKey];
+    m_NextKey = (unsigned char)(1 - m_NextKey);
+    memcpy(value->m_Key, key.m_Data, 16);
+    Int(value->m_RoundKeys, value->m_Key, 128);
+    value->m_RoundKeys[60] = 10;
+    for (int pos = 0; pos != 44; ++pos)
+    {
+        PUT32(value->m_RoundKeyBytes + 4 * pos, value->m_RoundKeys[pos]);
+    }
+    //Hash subkey.
+    memset(value->m_H, 0, 16);
+    AesEncrypt(*value, value->m_H, value->m_H);
+    InitGHash(*value);
+    value->m_Valid = true;
+    return 0;
+}
+
+void CGXCipher::ClearKeys()
+{
+    memset(m_Keys, 0, sizeof(m_Keys));
+    m_NextKey = 0;
+}
+
 void CGXCipher::Xor(
     unsigned char* dst,
     const unsigned char* src)
@@ -356,97 +512,244 @@ void CGXCipher::Xor(
     *d++ ^= *s++;
 }
 
-void CGXCipher::shift_right_block(unsigned char* v)
+//Reduction of the four bits that are shifted out in the 4-bit GHASH.
+static const uint64_t GHASH_LAST4[16] =
 {
-    unsigned long val = GETU32(v + 12);
-    val >>= 1;
-    if (v[11] & 0x01)
+    0x0000, 0x1c20, 0x3840, 0x2460, 0x7080, 0x6ca0, 0x48c0, 0x54e0,
+    0xe100, 0xfd20, 0xd940, 0xc560, 0x9180, 0x8da0, 0xa9c0, 0xb5e0
+};
+
+void CGXCipher::InitGHash(CGXAesKey& key)
+{
+    int i, j;
+    uint64_t vh = ((uint64_t)GETU32(key.m_H) << 32) | GETU32(key.m_H + 4);
+    uint64_t vl = ((uint64_t)GETU32(key.m_H + 8) << 32) | GETU32(key.m_H + 12);
+    //Bits are in reflected order so index 8 is H.
+    key.m_HL[8] = vl;
+    key.m_HH[8] = vh;
+    key.m_HL[0] = 0;
+    key.m_HH[0] = 0;
+    for (i = 4; i > 0; i >>= 1)
     {
-        val |= 0x80000000;
+        uint32_t T = (uint32_t)(vl & 1) * 0xe1000000U;
+        vl = (vh << 63) | (vl >> 1);
+        vh = (vh >> 1) ^ ((uint64_t)T << 32);
+        key.m_HL[i] = vl;
+        key.m_HH[i] = vh;
     }
-    PUT32(v + 12, val);
-
-    val = GETU32(v + 8);
-    val >>= 1;
-    if (v[7] & 0x01)
-        val |= 0x80000000;
-    PUT32(v + 8, val);
+    for (i = 2; i <= 8; i *= 2)
+    {
+        vh = key.m_HH[i];
+        vl = key.m_HL[i];
+        for (j = 1; j < i; j++)
+        {
+            key.m_HH[i + j] = vh ^ key.m_HH[j];
+            key.m_HL[i + j] = vl ^ key.m_HL[j];
+        }
+    }
+}
 
-    val = GETU32(v + 4);
-    val >>= 1;
-    if (v[3] & 0x01)
-        val |= 0x80000000;
-    PUT32(v + 4, val);
+void CGXCipher::MultiplyH(const CGXAesKey& key, unsigned char* y)
+{
+    int i;
+    unsigned char lo, hi, rem;
+    uint64_t zh, zl;
+    lo = y[15] & 0xf;
+    zh = key.m_HH[lo];
+    zl = key.m_HL[lo];
+    //Four bits are handled at the time starting from the last byte.
+    for (i = 15; i >= 0; i--)
+    {
+        lo = y[i] & 0xf;
+        hi = (y[i] >> 4) & 0xf;
+        if (i != 15)
+        {
+            rem = (unsigned char)zl & 0xf;
+            zl = (zh << 60) | (zl >> 4);
+            zh = (zh >> 4) ^ (GHASH_LAST4[rem] << 48);
+            zh ^= key.m_HH[lo];
+            zl ^= key.m_HL[lo];
+        }
+        rem = (unsigned char)zl & 0xf;
+        zl = (zh << 60) | (zl >> 4);
+        zh = (zh >> 4) ^ (GHASH_LAST4[rem] << 48);
+        zh ^= key.m_HH[hi];
+        zl ^= key.m_HL[hi];
+    }
+    PUT32(y, (unsigned long)(zh >> 32));
+    PUT32(y + 4, (unsigned long)zh);
+    PUT32(y + 8, (unsigned long)(zl >> 32));
+    PUT32(y + 12, (unsigned long)zl);
+}
 
-    val = GETU32(v);
-    val >>= 1;
-    PUT32(v, val);
+#ifdef GX_AES_INSTRUCTIONS
+//Count GHASH of full blocks with carry-less multiplication.
+//Blocks are byte reversed so bit order is the same as in the instructions.
+static GX_CLMUL_TARGET void GHashClmul(
+    const unsigned char* h,
+    const unsigned char* x,
+    int count,
+    unsigned char* y)
+{
+    const __m128i BSWAP = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    __m128i H = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)h), BSWAP);
+    __m128i Y = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)y), BSWAP);
+    __m128i t2, t3, t4, t5, t6, t7, t8, t9;
+    for (int pos = 0; pos != count; ++pos)
+    {
+        Y = _mm_xor_si128(Y, _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(x + 16 * pos)), BSWAP));
+        //256-bit product.
+        t3 = _mm_clmulepi64_si128(Y, H, 0x00);
+        t4 = _mm_clmulepi64_si128(Y, H, 0x10);
+        t5 = _mm_clmulepi64_si128(Y, H, 0x01);
+        t6 = _mm_clmulepi64_si128(Y, H, 0x11);
+        t4 = _mm_xor_si128(t4, t5);
+        t5 = _mm_slli_si128(t4, 8);
+        t4 = _mm_srli_si128(t4, 8);
+        t3 = _mm_xor_si128(t3, t5);
+        t6 = _mm_xor_si128(t6, t4);
+        //Shift product left by one bit because bits are reflected.
+        t7 = _mm_srli_epi32(t3, 31);
+        t8 = _mm_srli_epi32(t6, 31);
+        t3 = _mm_slli_epi32(t3, 1);
+        t6 = _mm_slli_epi32(t6, 1);
+        t9 = _mm_srli_si128(t7, 12);
+        t8 = _mm_slli_si128(t8, 4);
+        t7 = _mm_slli_si128(t7, 4);
+        t3 = _mm_or_si128(t3, t7);
+        t6 = _mm_or_si128(t6, t8);
+        t6 = _mm_or_si128(t6, t9);
+        //Reduce modulo x^128 + x^7 + x^2 + x + 1.
+        t7 = _mm_slli_epi32(t3, 31);
+        t8 = _mm_slli_epi32(t3, 30);
+        t9 = _mm_slli_epi32(t3, 25);
+        t7 = _mm_xor_si128(t7, t8);
+        t7 = _mm_xor_si128(t7, t9);
+        t8 = _mm_srli_si128(t7, 4);
+        t7 = _mm_slli_si128(t7, 12);
+        t3 = _mm_xor_si128(t3, t7);
+        t2 = _mm_srli_epi32(t3, 1);
+        t4 = _mm_srli_epi32(t3, 2);
+        t5 = _mm_srli_epi32(t3, 7);
+        t2 = _mm_xor_si128(t2, t4);
+        t2 = _mm_xor_si128(t2, t5);
+        t2 = _mm_xor_si128(t2, t8);
+        t3 = _mm_xor_si128(t3, t2);
+        Y = _mm_xor_si128(t6, t3);
+    }
+    _mm_storeu_si128((__m128i*)y, _mm_shuffle_epi8(Y, BSWAP));
 }
 
-void CGXCipher::MultiplyH(const unsigned char* x, const unsigned char* y, unsigned char* z)
+//Check does processor support carry-less multiplication.
+static bool IsClmulSupported()
 {
-    unsigned char tmp[16];
-    int i, j;
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    //PCLMULQDQ and SSSE3.
+    return (info[2] & 0x2) != 0 && (info[2] & 0x200) != 0;
+#else
+    return __builtin_cpu_supports("pclmul") != 0 &&
+        __builtin_cpu_supports("ssse3") != 0;
+#endif
+}
+#endif //GX_AES_INSTRUCTIONS
 
-    memset(z, 0, 16);
-    memcpy(tmp, y, 16);
+bool CGXCipher::IsClmulUsable()
+{
+#ifdef GX_AES_INSTRUCTIONS
+    //Hash subkey and cipher text of the GCM test case 2 and GHASH of it.
+    const unsigned char H[] =
+    {
+        0x66, 0xE9, 0x4B, 0xD4, 0xEF, 0x8A, 0x2C, 0x3B,
+        0x88, 0x4C, 0xFA, 0x59, 0xCA, 0x34, 0x2B, 0x2E
+    };
+    const unsigned char X[] =
+    {
+        0x03, 0x88, 0xDA, 0xCE, 0x60, 0xB6, 0xA3, 0x92,
+        0xF3, 0x28, 0xC2, 0xB9, 0x71, 0xB2, 0xFE, 0x78,
+        //Length block.
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80
+    };
+    const unsigned char GHASH[] =
+    {
+        0xF3, 0x8C, 0xBB, 0x1A, 0xD6, 0x92, 0x23, 0xDC,
+        0xC3, 0x45, 0x7A, 0xE5, 0xB6, 0xB0, 0xF8, 0x85
+    };
+    CGXAesKey key;
+    unsigned char y[16] = { 0 };
+    if (!IsClmulSupported())
+    {
+        return false;
+    }
+    memcpy(key.m_H, H, 16);
+    InitGHash(key);
+    for (int pos = 0; pos != 2; ++pos)
+    {
+        Xor(y, X + 16 * pos);
+        MultiplyH(key, y);
+    }
+    if (memcmp(y, GHASH, 16) != 0)
+    {
+        return false;
+    }
+    memset(y, 0, 16);
+    GHashClmul(H, X, 2, y);
+    return memcmp(y, GHASH, 16) == 0;
+#else
+    return false;
+#endif //GX_AES_INSTRUCTIONS
+}
 
-    for (i = 0; i < 16; i++)
+void CGXCipher::GHashBlocks(
+    const CGXAesKey& key,
+    const unsigned char* x,
+    int count,
+    unsigned char* y)
+{
+#ifdef GX_AES_INSTRUCTIONS
+    //Processor is checked only once.
+    static const bool CLMUL = IsClmulUsable();
+    if (CLMUL && PROCESSOR_INSTRUCTIONS)
     {
-        for (j = 0; j < 8; j++)
-        {
-            if (x[i] & 1 << (7 - j))
-            {
-                Xor(z, tmp);
-            }
-            //If last bit.
-            if (tmp[15] & 0x01)
-            {
-                shift_right_block(tmp);
-                tmp[0] ^= 0xe1;
-            }
-            else
-            {
-                shift_right_block(tmp);
-            }
-        }
+        GHashClmul(key.m_H, x, count, y);
+        return;
+    }
+#endif //GX_AES_INSTRUCTIONS
+    for (int pos = 0; pos != count; ++pos)
+    {
+        Xor(y, x + 16 * pos);
+        MultiplyH(key, y);
     }
 }
 
 void CGXCipher::GetGHash(
-    const unsigned char* h,
+    const CGXAesKey& key,
     const unsigned char* x,
     int xlen,
     unsigned char* y)
 {
-    int m, i;
-    const unsigned char* xpos = x;
+    int m = xlen / 16;
     unsigned char tmp[16];
-    m = xlen / 16;
-    for (i = 0; i < m; i++)
+    if (xlen <= 0)
     {
-        Xor(y, xpos);
-        xpos += 16;
-        MultiplyH(y, h, tmp);
-        memcpy(y, tmp, 16);
+        return;
     }
-    if (x + xlen > xpos)
+    GHashBlocks(key, x, m, y);
+    if (xlen % 16 != 0)
     {
-        size_t last = x + xlen - xpos;
-        memcpy(tmp, xpos, last);
+        size_t last = xlen % 16;
+        memcpy(tmp, x + 16 * m, last);
         memset(tmp + last, 0, sizeof(tmp) - last);
-
-        Xor(y, tmp);
-
-        MultiplyH(y, h, tmp);
-        memcpy(y, tmp, 16);
+        GHashBlocks(key, tmp, 1, y);
     }
 }
 
 void CGXCipher::Init_j0(
     const unsigned char* iv,
     unsigned char len,
-    const unsigned char* H,
+    const CGXAesKey& key,
     unsigned char* J0)
 {
     unsigned char tmp[16];
@@ -460,14 +763,14 @@ void CGXCipher::Init_j0(
     else
     {
         memset(J0, 0, 16);
-        GetGHash(H, iv, len, J0);
+        GetGHash(key, iv, len, J0);
         PUT32(tmp, (unsigned long)0);
         PUT32(tmp + 4, (unsigned long)0);
         //Here is expected that data is newer longger than 32 bit.
         //This is done because microcontrollers show warning here.
         PUT32(tmp + 8, (unsigned long)0);
         PUT32(tmp + 12, (unsigned long)(len * 8));
-        GetGHash(H, tmp, sizeof(tmp), J0);
+        GetGHash(key, tmp, sizeof(tmp), J0);
     }
 }
 
@@ -479,7 +782,7 @@ void CGXCipher::Inc32(unsigned char* block)
     PUT32(block + 16 - 4, val);
 }
 
-void CGXCipher::Gctr(unsigned int* aes, const unsigned char* icb, unsigned char* in, int len, unsigned char* out)
+void CGXCipher::Gctr(const CGXAesKey& key, const unsigned char* icb, unsigned char* in, int len, unsigned char* out)
 {
     size_t i, n, last;
     unsigned char cb[16], tmp[16] = { 0 };
@@ -498,12 +801,12 @@ void CGXCipher::Gctr(unsigned int* aes, const unsigned char* icb, unsigned char*
 
         if (out == NULL)
         {
-            AesEncrypt(aes, aes[60], cb, tmp);
+            AesEncrypt(key, cb, tmp);
             Xor(pin, tmp);
         }
         else
         {
-            AesEncrypt(aes, aes[60], cb, pout);
+            AesEncrypt(key, cb, pout);
             Xor(pout, pin);
             pout += 16;
         }
@@ -514,7 +817,7 @@ void CGXCipher::Gctr(unsigned int* aes, const unsigned char* icb, unsigned char*
     //Last, partial block.
     if (last)
     {
-        AesEncrypt(aes, aes[60], cb, tmp);
+        AesEncrypt(key, cb, tmp);
         for (i = 0; i < last; i++)
         {
             if (out == NULL)
@@ -531,7 +834,7 @@ void CGXCipher::Gctr(unsigned int* aes, const unsigned char* icb, unsigned char*
     }
 }
 
-void CGXCipher::AesGcmGctr(unsigned int* aes, const unsigned char* J0, unsigned char* in, int len, unsigned char* out)
+void CGXCipher::AesGcmGctr(const CGXAesKey& key, const unsigned char* J0, unsigned char* in, int len, unsigned char* out)
 {
     unsigned char J0inc[16];
     if (len == 0)
@@ -541,22 +844,22 @@ void CGXCipher::AesGcmGctr(unsigned int* aes, const unsigned char* J0, unsigned
 
     memcpy(J0inc, J0, 16);
     Inc32(J0inc);
-    Gctr(aes, J0inc, in, len, out);
+    Gctr(key, J0inc, in, len, out);
 }
 
-void CGXCipher::AesGcmGhash(const unsigned char* H, const unsigned char* aad, int aad_len,
+void CGXCipher::AesGcmGhash(const CGXAesKey& key, const unsigned char* aad, int aad_len,
     const unsigned char* crypt, int crypt_len, unsigned char* S)
 {
     unsigned char len_buf[16];
-    GetGHash(H, aad, aad_len, S);
-    GetGHash(H, crypt, crypt_len, S);
+    GetGHash(key, aad, aad_len, S);
+    GetGHash(key, crypt, crypt_len, S);
     //Here is expected that data is newer longger than 32 bit.
     //This is done because microcontrollers show warning here.
     PUT32(len_buf, (unsigned long)0);
     PUT32(len_buf + 4, (unsigned long)(aad_len * 8));
     PUT32(len_buf + 8, (unsigned long)0);
     PUT32(len_buf + 12, (unsigned long)(crypt_len * 8));
-    GetGHash(H, len_buf, sizeof(len_buf), S);
+    GetGHash(key, len_buf, sizeof(len_buf), S);
 }
 
 int CGXCipher::Encrypt(
@@ -575,8 +878,7 @@ int CGXCipher::Encrypt(
     //    printf("Authentication Key: %s\r\n", m_AuthenticationKey.ToHexString().c_str());
 #endif //defined(_WIN32) || defined(_WIN64) || defined(__linux__)//If Windows or Linux
     int ret;
-    uint32_t aes[61] = { 0 };
-    unsigned char H[16] = { 0 };
+    CGXAesKey* aes;
     unsigned char J0[16] = { 0 };
     unsigned char S[16] = { 0 };
     CGXByteBuffer nonse;
@@ -585,18 +887,26 @@ int CGXCipher::Encrypt(
     {
         return DLMS_ERROR_CODE_INVALID_PARAMETER;
     }
+    //Invocation counter is never used twice with the same key.
+    if (encrypt && m_FrameCounter >= m_InvocationCounterLimit)
+    {
+        return DLMS_ERROR_CODE_INVOCATION_COUNTER_LIMIT;
+    }
     if ((ret = GetNonse(frameCounter, systemTitle, nonse)) != 0)
     {
         return ret;
     }
-    if ((ret = Int(aes, key.m_Data, 16 * 8)) != 0)
+    //Key schedule and hash subkey are counted only when key changes.
+    if ((ret = GetKey(key, aes)) != 0)
+    {
+        return ret;
+    }
+    Init_j0(nonse.m_Data, (unsigned char)nonse.GetSize(), *aes, J0);
+    //Data is modified in place so it can't be attached.
+    if ((ret = input.Detach()) != 0)
     {
         return ret;
     }
-    aes[60] = 10;
-    //Hash subkey.
-    AesEncrypt(aes, aes[60], H, H);
-    Init_j0(nonse.m_Data, (unsigned char)nonse.GetSize(), H, J0);
 
     //Allocate space for authentication tag.
     if (security != DLMS_SECURITY_ENCRYPTION && !encrypt)
@@ -612,7 +922,7 @@ int CGXCipher::Encrypt(
         input.m_Position = 0;
         input.SetUInt8(0, security);
         memcpy(input.m_Data + 1, m_AuthenticationKey.m_Data, 16);
-        AesGcmGhash(H, input.m_Data, input.m_Size, input.m_Data, 0, S);
+        AesGcmGhash(*aes, input.m_Data, input.m_Size, input.m_Data, 0, S);
         if (type == DLMS_COUNT_TYPE_TAG)
         {
             input.m_Size = 0;
@@ -621,7 +931,7 @@ int CGXCipher::Encrypt(
         {
             input.Move(17, 0, input.m_Size - 17);
         }
-        Gctr(aes, J0, S, sizeof(S), input.m_Data + input.m_Size);
+        Gctr(*aes, J0, S, sizeof(S), input.m_Data + input.m_Size);
         if (encrypt)
         {
             input.m_Size += 12;
@@ -637,29 +947,29 @@ int CGXCipher::Encrypt(
     else if (security == DLMS_SECURITY_ENCRYPTION)
     {
         //Encrypt the data.
-        AesGcmGctr(aes, J0, input.m_Data + input.GetPosition(), input.Available(), NULL);
+        AesGcmGctr(*aes, J0, input.m_Data + input.GetPosition(), input.Available(), NULL);
     }
     else if (security == DLMS_SECURITY_AUTHENTICATION_ENCRYPTION)
     {
         if (encrypt)
         {
             //Encrypt the data.
-            AesGcmGctr(aes, J0, input.m_Data + input.m_Position, input.Available(), NULL);
+            AesGcmGctr(*aes, J0, input.m_Data + input.m_Position, input.Available(), NULL);
         }
         //Count authentication.
         input.Move(input.m_Position, 17, input.Available());
         input.m_Position = 0;
         input.SetUInt8(0, security);
         memcpy(input.m_Data + 1, m_AuthenticationKey.m_Data, 16);
-        AesGcmGhash(H, input.m_Data, 17, input.m_Data + 17, input.m_Size - 17, S);
+        AesGcmGhash(*aes, input.m_Data, 17, input.m_Data + 17, input.m_Size - 17, S);
         input.Move(17, 0, input.m_Size - 17);
-        Gctr(aes, J0, S, sizeof(S), input.m_Data + input.m_Size);
+        Gctr(*aes, J0, S, sizeof(S), input.m_Data + input.m_Size);
         if (!encrypt)
         {
             //Decrypt the data.
-            AesGcmGctr(aes, J0, input.m_Data + input.m_Position, input.Available(), NULL);
+            AesGcmGctr(*aes, J0, input.m_Data + input.m_Position, input.Available(), NULL);
         }
-        Gctr(aes, J0, S, sizeof(S), input.m_Data + input.m_Size);
+        Gctr(*aes, J0, S, sizeof(S), input.m_Data + input.m_Size);
         if (encrypt)
         {
             input.m_Size += 12;
@@ -699,6 +1009,37 @@ int CGXCipher::Encrypt(
     return 0;
 }
 
+//Check is command ciphered with the global or dedicated key.
+static bool IsCipheredCommand(unsigned char cmd)
+{
+    switch (cmd)
+    {
+    case DLMS_COMMAND_GLO_INITIATE_REQUEST:
+    case DLMS_COMMAND_GLO_INITIATE_RESPONSE:
+    case DLMS_COMMAND_GLO_READ_REQUEST:
+    case DLMS_COMMAND_GLO_READ_RESPONSE:
+    case DLMS_COMMAND_GLO_WRITE_REQUEST:
+    case DLMS_COMMAND_GLO_WRITE_RESPONSE:
+    case DLMS_COMMAND_GLO_GET_REQUEST:
+    case DLMS_COMMAND_GLO_GET_RESPONSE:
+    case DLMS_COMMAND_GLO_SET_REQUEST:
+    case DLMS_COMMAND_GLO_SET_RESPONSE:
+    case DLMS_COMMAND_GLO_METHOD_REQUEST:
+    case DLMS_COMMAND_GLO_METHOD_RESPONSE:
+    case DLMS_COMMAND_GLO_EVENT_NOTIFICATION_REQUEST:
+    case DLMS_COMMAND_DED_GET_REQUEST:
+    case DLMS_COMMAND_DED_GET_RESPONSE:
+    case DLMS_COMMAND_DED_SET_REQUEST:
+    case DLMS_COMMAND_DED_SET_RESPONSE:
+    case DLMS_COMMAND_DED_METHOD_REQUEST:
+    case DLMS_COMMAND_DED_METHOD_RESPONSE:
+    case DLMS_COMMAND_DED_EVENT_NOTIFICATION:
+        return true;
+    default:
+        return false;
+    }
+}
+
 int CGXCipher::Decrypt(
     CGXByteBuffer& title,
     CGXByteBuffer& key,
@@ -723,10 +1064,9 @@ int CGXCipher::Decrypt(
         return ret;
     }
     cmd = (DLMS_COMMAND)ch;
-    switch (cmd)
+    if (cmd == DLMS_COMMAND_GENERAL_GLO_CIPHERING ||
+        cmd == DLMS_COMMAND_GENERAL_DED_CIPHERING)
     {
-    case DLMS_COMMAND_GENERAL_GLO_CIPHERING:
-    case DLMS_COMMAND_GENERAL_DED_CIPHERING:
         if ((ret = GXHelpers::GetObjectCount(data, length)) != 0)
         {
             return ret;
@@ -736,29 +1076,9 @@ int CGXCipher::Decrypt(
             systemTitle.Set(&data, data.m_Position, length);
             pTitle = &systemTitle;
         }
-        break;
-    case DLMS_COMMAND_GLO_INITIATE_REQUEST:
-    case DLMS_COMMAND_GLO_INITIATE_RESPONSE:
-    case DLMS_COMMAND_GLO_READ_REQUEST:
-    case DLMS_COMMAND_GLO_READ_RESPONSE:
-    case DLMS_COMMAND_GLO_WRITE_REQUEST:
-    case DLMS_COMMAND_GLO_WRITE_RESPONSE:
-    case DLMS_COMMAND_GLO_GET_REQUEST:
-    case DLMS_COMMAND_GLO_GET_RESPONSE:
-    case DLMS_COMMAND_GLO_SET_REQUEST:
-    case DLMS_COMMAND_GLO_SET_RESPONSE:
-    case DLMS_COMMAND_GLO_METHOD_REQUEST:
-    case DLMS_COMMAND_GLO_METHOD_RESPONSE:
-    case DLMS_COMMAND_GLO_EVENT_NOTIFICATION_REQUEST:
-    case DLMS_COMMAND_DED_GET_REQUEST:
-    case DLMS_COMMAND_DED_GET_RESPONSE:
-    case DLMS_COMMAND_DED_SET_REQUEST:
-    case DLMS_COMMAND_DED_SET_RESPONSE:
-    case DLMS_COMMAND_DED_METHOD_REQUEST:
-    case DLMS_COMMAND_DED_METHOD_RESPONSE:
-    case DLMS_COMMAND_DED_EVENT_NOTIFICATION:
-        break;
-    default:
+    }
+    else if (!IsCipheredCommand(cmd))
+    {
         return DLMS_ERROR_CODE_INVALID_PARAMETER;
     }
     if ((ret = GXHelpers::GetObjectCount(data, length)) != 0)
@@ -795,6 +1115,269 @@ int CGXCipher::Decrypt(
     return 0;
 }
 
+/**
+* Encrypt or decrypt data in place with AES-GCM. Authentication tag is
+* written after encryption and checked before decryption.
+*/
+int CGXCipher::CipherInPlace(
+    DLMS_SECURITY security,
+    unsigned long frameCounter,
+    const unsigned char* systemTitle,
+    const CGXAesKey& key,
+    unsigned char* data,
+    unsigned long size,
+    unsigned char* tag,
+    bool encrypt)
+{
+    unsigned char iv[12], J0[16], S[16] = { 0 }, aad[17], tmp[32];
+    if (security != DLMS_SECURITY_AUTHENTICATION &&
+        security != DLMS_SECURITY_ENCRYPTION &&
+        security != DLMS_SECURITY_AUTHENTICATION_ENCRYPTION)
+    {
+        return 0;
+    }
+    memcpy(iv, systemTitle, 8);
+    PUT32(iv + 8, frameCounter);
+    Init_j0(iv, sizeof(iv), key, J0);
+    if (security == DLMS_SECURITY_ENCRYPTION)
+    {
+        AesGcmGctr(key, J0, data, size, NULL);
+        return 0;
+    }
+    if (m_AuthenticationKey.GetSize() < 16)
+    {
+        return DLMS_ERROR_CODE_INVALID_PARAMETER;
+    }
+    aad[0] = (unsigned char)security;
+    memcpy(aad + 1, m_AuthenticationKey.m_Data, 16);
+    if (security == DLMS_SECURITY_AUTHENTICATION)
+    {
+        //Plain text is part of the additional data. Blocks are counted
+        //from the beginning of the additional data.
+        unsigned long cnt = size < 15 ? size : 15;
+        memcpy(tmp, aad, sizeof(aad));
+        memcpy(tmp + sizeof(aad), data, cnt);
+        GetGHash(key, tmp, sizeof(aad) + cnt, S);
+        GetGHash(key, data + cnt, size - cnt, S);
+        PUT32(tmp, (unsigned long)0);
+        PUT32(tmp + 4, (unsigned long)((sizeof(aad) + size) * 8));
+        PUT32(tmp + 8, (unsigned long)0);
+        PUT32(tmp + 12, (unsigned long)0);
+        GetGHash(key, tmp, 16, S);
+    }
+    else
+    {
+        if (encrypt)
+        {
+            AesGcmGctr(key, J0, data, size, NULL);
+        }
+        AesGcmGhash(key, aad, sizeof(aad), data, size, S);
+    }
+    Gctr(key, J0, S, sizeof(S), tmp);
+    if (encrypt)
+    {
+        memcpy(tag, tmp, CIPHERING_TAG_SIZE);
+        return 0;
+    }
+    if (memcmp(tag, tmp, CIPHERING_TAG_SIZE) != 0)
+    {
+        return DLMS_ERROR_CODE_INVALID_TAG;
+    }
+    if (security == DLMS_SECURITY_AUTHENTICATION_ENCRYPTION)
+    {
+        AesGcmGctr(key, J0, data, size, NULL);
+    }
+    return 0;
+}
+
+int CGXCipher::EncryptApdu(
+    const CGXAesKey& key,
+    DLMS_SECURITY security,
+    unsigned long frameCounter,
+    unsigned char tag,
+    CGXByteBuffer& systemTitle,
+    CGXByteBuffer& data,
+    unsigned long offset)
+{
+    int ret;
+    //Header is small enough for the inline buffer.
+    CGXByteBuffer header;
+    unsigned long size = data.GetSize() - offset;
+    unsigned char tagSize = 0;
+    //Invocation counter is never used twice with the same key.
+    if (m_FrameCounter >= m_InvocationCounterLimit)
+    {
+        return DLMS_ERROR_CODE_INVOCATION_COUNTER_LIMIT;
+    }
+    if (security == DLMS_SECURITY_AUTHENTICATION ||
+        security == DLMS_SECURITY_AUTHENTICATION_ENCRYPTION)
+    {
+        tagSize = CIPHERING_TAG_SIZE;
+    }
+    header.SetUInt8(tag);
+    if (tag == DLMS_COMMAND_GENERAL_GLO_CIPHERING ||
+        tag == DLMS_COMMAND_GENERAL_DED_CIPHERING)
+    {
+        GXHelpers::SetObjectCount(8, header);
+        header.Set(systemTitle.GetData(), 8);
+    }
+    GXHelpers::SetObjectCount(5 + size + tagSize, header);
+    header.SetUInt8(security);
+    header.SetUInt32(frameCounter);
+    //Data is modified in place so it can't be attached.
+    if ((ret = data.Detach()) != 0)
+    {
+        return ret;
+    }
+    if (offset < header.GetSize())
+    {
+        //APDU is moved only if there is not enough space for the header.
+        if ((ret = data.Capacity(header.GetSize() + size + tagSize)) != 0 ||
+            (ret = data.Move(offset, header.GetSize(), size)) != 0)
+        {
+            return ret;
+        }
+        offset = header.GetSize();
+    }
+    else if ((ret = data.Capacity(offset + size + tagSize)) != 0)
+    {
+        return ret;
+    }
+    memcpy(data.m_Data + offset - header.GetSize(), header.GetData(), header.GetSize());
+    if ((ret = CipherInPlace(security, frameCounter, systemTitle.GetData(), key,
+        data.m_Data + offset, size, data.m_Data + offset + size, true)) != 0)
+    {
+        return ret;
+    }
+    data.m_Size = offset + size + tagSize;
+    data.m_Position = offset - header.GetSize();
+    ++m_FrameCounter;
+    return 0;
+}
+
+int CGXCipher::EncryptInPlace(
+    DLMS_SECURITY security,
+    unsigned long frameCounter,
+    unsigned char tag,
+    CGXByteBuffer& systemTitle,
+    CGXByteBuffer& key,
+    CGXByteBuffer& data,
+    unsigned long offset)
+{
+    int ret;
+    CGXAesKey* aes;
+    if (systemTitle.GetSize() != 8 || offset > data.GetSize())
+    {
+        return DLMS_ERROR_CODE_INVALID_PARAMETER;
+    }
+    if ((ret = GetKey(key, aes)) != 0)
+    {
+        return ret;
+    }
+    return EncryptApdu(*aes, security, frameCounter, tag, systemTitle, data, offset);
+}
+
+int CGXCipher::DecryptInPlace(
+    CGXByteBuffer& title,
+    CGXByteBuffer& key,
+    CGXByteBuffer& data,
+    DLMS_SECURITY& security,
+    DLMS_SECURITY_SUITE& suite,
+    uint64_t& invocationCounter)
+{
+    unsigned long length;
+    int ret;
+    unsigned char ch;
+    unsigned long frameCounter;
+    unsigned long size;
+    const unsigned char* systemTitle = title.GetData();
+    CGXAesKey* aes;
+    if ((ret = data.GetUInt8(&ch)) != 0)
+    {
+        return ret;
+    }
+    if (ch == DLMS_COMMAND_GENERAL_GLO_CIPHERING ||
+        ch == DLMS_COMMAND_GENERAL_DED_CIPHERING)
+    {
+        if ((ret = GXHelpers::GetObjectCount(data, length)) != 0)
+        {
+            return ret;
+        }
+        if (length != 0)
+        {
+            if (length != 8 || data.Available() < 8)
+            {
+                return DLMS_ERROR_CODE_INVALID_PARAMETER;
+            }
+            //System title is used from the data.
+            systemTitle = data.GetData() + data.GetPosition();
+            data.SetPosition(data.GetPosition() + 8);
+        }
+        else if (title.GetSize() != 8)
+        {
+            return DLMS_ERROR_CODE_INVALID_PARAMETER;
+        }
+    }
+    else if (!IsCipheredCommand(ch) || title.GetSize() != 8)
+    {
+        return DLMS_ERROR_CODE_INVALID_PARAMETER;
+    }
+    if ((ret = GXHelpers::GetObjectCount(data, length)) != 0)
+    {
+        return ret;
+    }
+    if (data.Available() < length)
+    {
+        return DLMS_ERROR_CODE_OUTOFMEMORY;
+    }
+    if ((ret = data.GetUInt8(&ch)) != 0)
+    {
+        return ret;
+    }
+    security = (DLMS_SECURITY)(ch & 0x30);
+    suite = (DLMS_SECURITY_SUITE)(ch & 0x3);
+    if ((ret = data.GetUInt32(&frameCounter)) != 0)
+    {
+        return ret;
+    }
+    invocationCounter = frameCounter;
+    //Length includes security control byte and frame counter. Bytes
+    //after the ciphered APDU are not part of it.
+    if (length < 5)
+    {
+        return DLMS_ERROR_CODE_INVALID_PARAMETER;
+    }
+    size = length - 5;
+    if (security == DLMS_SECURITY_AUTHENTICATION ||
+        security == DLMS_SECURITY_AUTHENTICATION_ENCRYPTION)
+    {
+        if (size < CIPHERING_TAG_SIZE)
+        {
+            return DLMS_ERROR_CODE_INVALID_PARAMETER;
+        }
+        size -= CIPHERING_TAG_SIZE;
+    }
+    if ((ret = GetKey(key, aes)) != 0)
+    {
+        return ret;
+    }
+    //System title can be in the data so it's copied before detach.
+    unsigned char st[8];
+    memcpy(st, systemTitle, 8);
+    //Data is modified in place so it can't be attached.
+    if ((ret = data.Detach()) != 0)
+    {
+        return ret;
+    }
+    unsigned char* p = data.GetData() + data.GetPosition();
+    if ((ret = CipherInPlace(security, frameCounter, st, *aes, p, size, p + size, false)) != 0)
+    {
+        return ret;
+    }
+    data.SetSize(data.GetPosition() + size);
+    return 0;
+}
+
 /**
 * multiply by 2 in the Galois field
 *
@@ -1034,6 +1617,7 @@ CGXByteBuffer& CGXCipher::GetBlockCipherKey()
 
 void CGXCipher::SetBlockCipherKey(CGXByteBuffer& value)
 {
+    ClearKeys();
     m_BlockCipherKey.Clear();
     m_BlockCipherKey.Set(value.m_Data, value.m_Size - value.m_Position);
 }
@@ -1069,6 +1653,16 @@ void CGXCipher::SetInvocationCounter(unsigned long value)
     m_FrameCounter = value;
 }
 
+unsigned long long CGXCipher::GetInvocationCounterLimit()
+{
+    return m_InvocationCounterLimit;
+}
+
+void CGXCipher::SetInvocationCounterLimit(unsigned long long value)
+{
+    m_InvocationCounterLimit = value;
+}
+
 void CGXCipher::Reset()
 {
 
@@ -1081,5 +1675,6 @@ CGXByteBuffer& CGXCipher::GetDedicatedKey()
 
 void CGXCipher::SetDedicatedKey(CGXByteBuffer& value)
 {
+    ClearKeys();
     m_DedicatedKey = value;
 }
@@ -78,6 +78,96 @@ static unsigned short FCS16Table[256] =
     0x7BC7, 0x6A4E, 0x58D5, 0x495C, 0x3DE3, 0x2C6A, 0x1EF1, 0x0F78
 };
 
+/////////////////////////////////////////////////////////////////////////////
+//Tables for counting FCS16 eight bytes at the time.
+//Table N is the CRC of the byte followed by N zero bytes.
+/////////////////////////////////////////////////////////////////////////////
+struct CGXFCS16Tables
+{
+    unsigned short m_Table[8][256];
+
+    CGXFCS16Tables()
+    {
+        for (int pos = 0; pos != 256; ++pos)
+        {
+            m_Table[0][pos] = FCS16Table[pos];
+        }
+        for (int table = 1; table != 8; ++table)
+        {
+            for (int pos = 0; pos != 256; ++pos)
+            {
+                unsigned short crc = m_Table[table - 1][pos];
+                m_Table[table][pos] = (crc >> 8) ^ FCS16Table[crc & 0xFF];
+            }
+        }
+    }
+};
+
+static const CGXFCS16Tables& GetFCS16Tables()
+{
+    static const CGXFCS16Tables tables;
+    return tables;
+}
+
+//FCS24 table for PLC. Register is shifted right and bits are moved in from
+//the top so the table is indexed with the lowest byte of the register.
+static const uint32_t FCS24Table[256] =
+{
+    0x000000, 0x33D776, 0x67AEEC, 0x54799A, 0xCF5DD8, 0xFC8AAE, 0xA8F334, 0x9B2442,
+    0x39D6C5, 0x0A01B3, 0x5E7829, 0x6DAF5F, 0xF68B1D, 0xC55C6B, 0x9125F1, 0xA2F287,
+    0x73AD8A, 0x407AFC, 0x140366, 0x27D410, 0xBCF052, 0x8F2724, 0xDB5EBE, 0xE889C8,
+    0x4A7B4F, 0x79AC39, 0x2DD5A3, 0x1E02D5, 0x852697, 0xB6F1E1, 0xE2887B, 0xD15F0D,
+    0xE75B14, 0xD48C62, 0x80F5F8, 0xB3228E, 0x2806CC, 0x1BD1BA, 0x4FA820, 0x7C7F56,
+    0xDE8DD1, 0xED5AA7, 0xB9233D, 0x8AF44B, 0x11D009, 0x22077F, 0x767EE5, 0x45A993,
+    0x94F69E, 0xA721E8, 0xF35872, 0xC08F04, 0x5BAB46, 0x687C30, 0x3C05AA, 0x0FD2DC,
+    0xAD205B, 0x9EF72D, 0xCA8EB7, 0xF959C1, 0x627D83, 0x51AAF5, 0x05D36F, 0x360419,
+    0x69DB5D, 0x5A0C2B, 0x0E75B1, 0x3DA2C7, 0xA68685, 0x9551F3, 0xC12869, 0xF2FF1F,
+    0x500D98, 0x63DAEE, 0x37A374, 0x047402, 0x9F5040, 0xAC8736, 0xF8FEAC, 0xCB29DA,
+    0x1A76D7, 0x29A1A1, 0x7DD83B, 0x4E0F4D, 0xD52B0F, 0xE6FC79, 0xB285E3, 0x815295,
+    0x23A012, 0x107764, 0x440EFE, 0x77D988, 0xECFDCA, 0xDF2ABC, 0x8B5326, 0xB88450,
+    0x8E8049, 0xBD573F, 0xE92EA5, 0xDAF9D3, 0x41DD91, 0x720AE7, 0x26737D, 0x15A40B,
+    0xB7568C, 0x8481FA, 0xD0F860, 0xE32F16, 0x780B54, 0x4BDC22, 0x1FA5B8, 0x2C72CE,
+    0xFD2DC3, 0xCEFAB5, 0x9A832F, 0xA95459, 0x32701B, 0x01A76D, 0x55DEF7, 0x660981,
+    0xC4FB06, 0xF72C70, 0xA355EA, 0x90829C, 0x0BA6DE, 0x3871A8, 0x6C0832, 0x5FDF44,
+    0xD3B6BA, 0xE061CC, 0xB41856, 0x87CF20, 0x1CEB62, 0x2F3C14, 0x7B458E, 0x4892F8,
+    0xEA607F, 0xD9B709, 0x8DCE93, 0xBE19E5, 0x253DA7, 0x16EAD1, 0x42934B, 0x71443D,
+    0xA01B30, 0x93CC46, 0xC7B5DC, 0xF462AA, 0x6F46E8, 0x5C919E, 0x08E804, 0x3B3F72,
+    0x99CDF5, 0xAA1A83, 0xFE6319, 0xCDB46F, 0x56902D, 0x65475B, 0x313EC1, 0x02E9B7,
+    0x34EDAE, 0x073AD8, 0x534342, 0x609434, 0xFBB076, 0xC86700, 0x9C1E9A, 0xAFC9EC,
+    0x0D3B6B, 0x3EEC1D, 0x6A9587, 0x5942F1, 0xC266B3, 0xF1B1C5, 0xA5C85F, 0x961F29,
+    0x474024, 0x749752, 0x20EEC8, 0x1339BE, 0x881DFC, 0xBBCA8A, 0xEFB310, 0xDC6466,
+    0x7E96E1, 0x4D4197, 0x19380D, 0x2AEF7B, 0xB1CB39, 0x821C4F, 0xD665D5, 0xE5B2A3,
+    0xBA6DE7, 0x89BA91, 0xDDC30B, 0xEE147D, 0x75303F, 0x46E749, 0x129ED3, 0x2149A5,
+    0x83BB22, 0xB06C54, 0xE415CE, 0xD7C2B8, 0x4CE6FA, 0x7F318C, 0x2B4816, 0x189F60,
+    0xC9C06D, 0xFA171B, 0xAE6E81, 0x9DB9F7, 0x069DB5, 0x354AC3, 0x613359, 0x52E42F,
+    0xF016A8, 0xC3C1DE, 0x97B844, 0xA46F32, 0x3F4B70, 0x0C9C06, 0x58E59C, 0x6B32EA,
+    0x5D36F3, 0x6EE185, 0x3A981F, 0x094F69, 0x926B2B, 0xA1BC5D, 0xF5C5C7, 0xC612B1,
+    0x64E036, 0x573740, 0x034EDA, 0x3099AC, 0xABBDEE, 0x986A98, 0xCC1302, 0xFFC474,
+    0x2E9B79, 0x1D4C0F, 0x493595, 0x7AE2E3, 0xE1C6A1, 0xD211D7, 0x86684D, 0xB5BF3B,
+    0x174DBC, 0x249ACA, 0x70E350, 0x433426, 0xD81064, 0xEBC712, 0xBFBE88, 0x8C69FE
+};
+
+//Bits of the byte in reverse order.
+static const unsigned char BitReverseTable[256] =
+{
+    0x00, 0x80, 0x40, 0xC0, 0x20, 0xA0, 0x60, 0xE0, 0x10, 0x90, 0x50, 0xD0, 0x30, 0xB0, 0x70, 0xF0,
+    0x08, 0x88, 0x48, 0xC8, 0x28, 0xA8, 0x68, 0xE8, 0x18, 0x98, 0x58, 0xD8, 0x38, 0xB8, 0x78, 0xF8,
+    0x04, 0x84, 0x44, 0xC4, 0x24, 0xA4, 0x64, 0xE4, 0x14, 0x94, 0x54, 0xD4, 0x34, 0xB4, 0x74, 0xF4,
+    0x0C, 0x8C, 0x4C, 0xCC, 0x2C, 0xAC, 0x6C, 0xEC, 0x1C, 0x9C, 0x5C, 0xDC, 0x3C, 0xBC, 0x7C, 0xFC,
+    0x02, 0x82, 0x42, 0xC2, 0x22, 0xA2, 0x62, 0xE2, 0x12, 0x92, 0x52, 0xD2, 0x32, 0xB2, 0x72, 0xF2,
+    0x0A, 0x8A, 0x4A, 0xCA, 0x2A, 0xAA, 0x6A, 0xEA, 0x1A, 0x9A, 0x5A, 0xDA, 0x3A, 0xBA, 0x7A, 0xFA,
+    0x06, 0x86, 0x46, 0xC6, 0x26, 0xA6, 0x66, 0xE6, 0x16, 0x96, 0x56, 0xD6, 0x36, 0xB6, 0x76, 0xF6,
+    0x0E, 0x8E, 0x4E, 0xCE, 0x2E, 0xAE, 0x6E, 0xEE, 0x1E, 0x9E, 0x5E, 0xDE, 0x3E, 0xBE, 0x7E, 0xFE,
+    0x01, 0x81, 0x41, 0xC1, 0x21, 0xA1, 0x61, 0xE1, 0x11, 0x91, 0x51, 0xD1, 0x31, 0xB1, 0x71, 0xF1,
+    0x09, 0x89, 0x49, 0xC9, 0x29, 0xA9, 0x69, 0xE9, 0x19, 0x99, 0x59, 0xD9, 0x39, 0xB9, 0x79, 0xF9,
+    0x05, 0x85, 0x45, 0xC5, 0x25, 0xA5, 0x65, 0xE5, 0x15, 0x95, 0x55, 0xD5, 0x35, 0xB5, 0x75, 0xF5,
+    0x0D, 0x8D, 0x4D, 0xCD, 0x2D, 0xAD, 0x6D, 0xED, 0x1D, 0x9D, 0x5D, 0xDD, 0x3D, 0xBD, 0x7D, 0xFD,
+    0x03, 0x83, 0x43, 0xC3, 0x23, 0xA3, 0x63, 0xE3, 0x13, 0x93, 0x53, 0xD3, 0x33, 0xB3, 0x73, 0xF3,
+    0x0B, 0x8B, 0x4B, 0xCB, 0x2B, 0xAB, 0x6B, 0xEB, 0x1B, 0x9B, 0x5B, 0xDB, 0x3B, 0xBB, 0x7B, 0xFB,
+    0x07, 0x87, 0x47, 0xC7, 0x27, 0xA7, 0x67, 0xE7, 0x17, 0x97, 0x57, 0xD7, 0x37, 0xB7, 0x77, 0xF7,
+    0x0F, 0x8F, 0x4F, 0xCF, 0x2F, 0xAF, 0x6F, 0xEF, 0x1F, 0x9F, 0x5F, 0xDF, 0x3F, 0xBF, 0x7F, 0xFF
+};
+
 bool CGXDLMS::UseHdlc(DLMS_INTERFACE_TYPE type)
 {
     return type == DLMS_INTERFACE_TYPE_HDLC ||
@@ -254,7 +344,8 @@ int CGXDLMS::GetWrapperFrame(
     CGXByteBuffer& data,
     CGXByteBuffer& reply)
 {
-    reply.Clear();
+    //Capacity is kept so reply buffer can be reused.
+    reply.SetSize(0);
     // Add version.
     reply.SetUInt16(1);
     if (settings.IsServer())
@@ -275,7 +366,7 @@ int CGXDLMS::GetWrapperFrame(
         reply.SetUInt16((unsigned short)settings.GetServerAddress());
     }
     // Data length.
-    reply.SetUInt16((unsigned short)data.GetSize());
+    reply.SetUInt16((unsigned short)data.Available());
     // Data
     reply.Set(&data, data.GetPosition(), -1);
 
@@ -284,7 +375,7 @@ int CGXDLMS::GetWrapperFrame(
     {
         if (data.GetSize() == data.GetPosition())
         {
-            data.Clear();
+            data.SetSize(0);
         }
         else
         {
@@ -738,8 +829,16 @@ long GetLongInvokeIDPriority(CGXDLMSSettings& settings)
      */
 void AddLLCBytes(CGXDLMSSettings* settings, CGXByteBuffer& data)
 {
+    const unsigned char* llc = settings->IsServer() ? LLC_REPLY_BYTES : LLC_SEND_BYTES;
+    //LLC bytes are written to the space that is left before the message.
+    if (data.GetPosition() >= 3)
+    {
+        data.SetPosition(data.GetPosition() - 3);
+        memcpy(data.GetData() + data.GetPosition(), llc, 3);
+        return;
+    }
     CGXByteBuffer tmp;
-    tmp.Set(&data);
+    tmp.Set(&data, data.GetPosition());
     data.Clear();
     if (settings->IsServer())
     {
@@ -752,6 +851,38 @@ void AddLLCBytes(CGXDLMSSettings* settings, CGXByteBuffer& data)
     data.Set(&tmp);
 }
 
+/**
+* Reserve space for the ciphering header and LLC bytes before the APDU
+* so the APDU is encrypted without moving it.
+*
+* @param reply
+*            Empty reply buffer. Position is set after the reserved space.
+* @param hdlc
+*            Is HDLC used.
+* @return Offset of the APDU.
+*/
+static unsigned long ReserveCipheringHeader(
+    CGXByteBuffer& reply,
+    bool hdlc)
+{
+    unsigned long offset = CIPHERING_MAX_HEADER_SIZE;
+    if (reply.GetSize() != 0)
+    {
+        return 0;
+    }
+    if (hdlc)
+    {
+        offset += 3;
+    }
+    if (reply.Capacity() < offset && reply.Capacity(offset) != 0)
+    {
+        return 0;
+    }
+    reply.SetSize(offset);
+    reply.SetPosition(offset);
+    return offset;
+}
+
 /**
      * Check is all data fit to one data block.
      *
@@ -778,17 +909,17 @@ void MultipleBlocks(
     if (!p.IsMultipleBlocks())
     {
         // Add command type and invoke and priority.
-        p.SetMultipleBlocks(2 + reply.GetSize() + len > p.GetSettings()->GetMaxPduSize());
+        p.SetMultipleBlocks(2 + reply.Available() + len > p.GetSettings()->GetMaxPduSize());
     }
     if (p.IsMultipleBlocks())
     {
         // Add command type and invoke and priority.
-        p.SetLastBlock(!(8 + reply.GetSize() + len > p.GetSettings()->GetMaxPduSize()));
+        p.SetLastBlock(!(8 + reply.Available() + len > p.GetSettings()->GetMaxPduSize()));
     }
     if (p.IsLastBlock())
     {
         // Add command type and invoke and priority.
-        p.SetLastBlock(!(8 + reply.GetSize() + len > p.GetSettings()->GetMaxPduSize()));
+        p.SetLastBlock(!(8 + reply.Available() + len > p.GetSettings()->GetMaxPduSize()));
     }
 }
 
@@ -800,7 +931,8 @@ unsigned char IsGloMessage(unsigned char cmd)
 }
 
 int Cipher0(CGXDLMSLNParameters& p,
-    CGXByteBuffer& reply)
+    CGXByteBuffer& reply,
+    unsigned long offset)
 {
     int ret;
     CGXByteBuffer tmp;
@@ -861,15 +993,14 @@ int Cipher0(CGXDLMSLNParameters& p,
         }
     }
     CGXByteBuffer& title = p.GetSettings()->GetCipher()->GetSystemTitle();
-    ret = p.GetSettings()->GetCipher()->Encrypt(
+    ret = p.GetSettings()->GetCipher()->EncryptInPlace(
         p.GetSettings()->GetCipher()->GetSecurity(),
-        DLMS_COUNT_TYPE_PACKET,
         p.GetSettings()->GetCipher()->GetFrameCounter(),
         cmd,
         title,
         *key,
         reply,
-        true);
+        offset);
     if (ret != 0)
     {
         return ret;
@@ -886,6 +1017,11 @@ int CGXDLMS::GetLNPdu(
         && p.GetSettings()->GetCipher() != NULL
         && p.GetSettings()->GetCipher()->GetSecurity() != DLMS_SECURITY_NONE;
     int len = 0;
+    unsigned long offset = 0;
+    if (ciphering)
+    {
+        offset = ReserveCipheringHeader(reply, UseHdlc(p.GetSettings()->GetInterfaceType()));
+    }
     if (p.GetCommand() == DLMS_COMMAND_AARQ)
     {
         reply.Set(p.GetAttributeDescriptor());
@@ -1069,7 +1205,7 @@ int CGXDLMS::GetLNPdu(
             {
                 len = 0;
             }
-            int totalLength = len + reply.GetSize();
+            int totalLength = len + reply.Available();
             if (ciphering)
             {
                 totalLength += CIPHERING_HEADER_SIZE;
@@ -1077,7 +1213,7 @@ int CGXDLMS::GetLNPdu(
 
             if (totalLength > p.GetSettings()->GetMaxPduSize())
             {
-                len = p.GetSettings()->GetMaxPduSize() - reply.GetSize();
+                len = p.GetSettings()->GetMaxPduSize() - reply.Available();
                 if (ciphering)
                 {
                     len -= CIPHERING_HEADER_SIZE;
@@ -1105,15 +1241,15 @@ int CGXDLMS::GetLNPdu(
                 //Get request size can be bigger than PDU size.
                 if ((p.GetSettings()->GetNegotiatedConformance() & DLMS_CONFORMANCE_GENERAL_BLOCK_TRANSFER) != 0)
                 {
-                    if (7 + len + reply.GetSize() > p.GetSettings()->GetMaxPduSize())
+                    if (7 + len + reply.Available() > p.GetSettings()->GetMaxPduSize())
                     {
-                        len = p.GetSettings()->GetMaxPduSize() - reply.GetSize() - 7;
+                        len = p.GetSettings()->GetMaxPduSize() - reply.Available() - 7;
                     }
                     //Cipher data only once.
                     if (ciphering && p.GetCommand() != DLMS_COMMAND_GENERAL_BLOCK_TRANSFER)
                     {
                         reply.Set(p.GetData());
-                        if ((ret = Cipher0(p, reply)) != 0)
+                        if ((ret = Cipher0(p, reply, offset)) != 0)
                         {
                             return ret;
                         }
@@ -1122,19 +1258,19 @@ int CGXDLMS::GetLNPdu(
                 }
                 // Get request size can be bigger than PDU size.
                 if (p.GetCommand() != DLMS_COMMAND_GET_REQUEST && len
-                    + reply.GetSize() > p.GetSettings()->GetMaxPduSize())
+                    + reply.Available() > p.GetSettings()->GetMaxPduSize())
                 {
-                    len = p.GetSettings()->GetMaxPduSize() - reply.GetSize()
+                    len = p.GetSettings()->GetMaxPduSize() - reply.Available()
                         - p.GetData()->GetPosition();
                 }
                 reply.Set(p.GetData(), p.GetData()->GetPosition(), len);
             }
         }
 
-        if (ciphering && reply.GetSize() != 0 && p.GetCommand() != DLMS_COMMAND_RELEASE_REQUEST &&
+        if (ciphering && reply.Available() != 0 && p.GetCommand() != DLMS_COMMAND_RELEASE_REQUEST &&
             ((p.GetSettings()->GetNegotiatedConformance() & DLMS_CONFORMANCE_GENERAL_BLOCK_TRANSFER) == 0))
         {
-            if ((ret = Cipher0(p, reply)) != 0)
+            if ((ret = Cipher0(p, reply, offset)) != 0)
             {
                 return ret;
             }
@@ -1143,7 +1279,7 @@ int CGXDLMS::GetLNPdu(
         if (p.GetCommand() == DLMS_COMMAND_GENERAL_BLOCK_TRANSFER || (p.IsMultipleBlocks() && (p.GetSettings()->GetNegotiatedConformance() & DLMS_CONFORMANCE_GENERAL_BLOCK_TRANSFER) != 0))
         {
             CGXByteBuffer bb;
-            bb.Set(&reply);
+            bb.Set(&reply, reply.GetPosition());
             reply.Clear();
             reply.SetUInt8(DLMS_COMMAND_GENERAL_BLOCK_TRANSFER);
             unsigned char value = 0;
@@ -1229,8 +1365,7 @@ int CGXDLMS::GetLnMessages(
                 }
                 break;
             case DLMS_INTERFACE_TYPE_PDU:
-                tmp = reply;
-                reply.SetPosition(reply.GetSize());
+                tmp.Set(&reply, reply.GetPosition());
                 break;
             case DLMS_INTERFACE_TYPE_PLC:
                 ret = GetPlcFrame(*p.GetSettings(), 0x90, &reply, tmp);
@@ -1259,7 +1394,7 @@ int CGXDLMS::AppendMultipleSNBlocks(
     CGXByteBuffer& reply)
 {
     bool ciphering = p.GetSettings()->GetCipher() != NULL && p.GetSettings()->GetCipher()->GetSecurity() != DLMS_SECURITY_NONE;
-    unsigned long hSize = reply.GetSize() + 3;
+    unsigned long hSize = reply.Available() + 3;
     // Add LLC bytes.
     if (p.GetCommand() == DLMS_COMMAND_WRITE_REQUEST
         || p.GetCommand() == DLMS_COMMAND_READ_REQUEST)
@@ -1312,7 +1447,12 @@ int CGXDLMS::GetSNPdu(
     unsigned char ciphering = p.GetCommand() != DLMS_COMMAND_AARQ && p.GetCommand() != DLMS_COMMAND_AARE
         && p.GetSettings()->GetCipher() != NULL
         && p.GetSettings()->GetCipher()->GetSecurity() != DLMS_SECURITY_NONE;
-    if (!ciphering && UseHdlc(p.GetSettings()->GetInterfaceType()))
+    unsigned long offset = 0;
+    if (ciphering)
+    {
+        offset = ReserveCipheringHeader(reply, UseHdlc(p.GetSettings()->GetInterfaceType()));
+    }
+    else if (UseHdlc(p.GetSettings()->GetInterfaceType()))
     {
         AddLLCBytes(p.GetSettings(), reply);
     }
@@ -1363,11 +1503,11 @@ int CGXDLMS::GetSNPdu(
 
         if (!p.IsMultipleBlocks())
         {
-            p.SetMultipleBlocks(reply.GetSize() + cipherSize + cnt > p.GetSettings()->GetMaxPduSize());
+            p.SetMultipleBlocks(reply.Available() + cipherSize + cnt > p.GetSettings()->GetMaxPduSize());
             // If reply data is not fit to one PDU.
             if (p.IsMultipleBlocks())
             {
-                reply.SetSize(0);
+                reply.SetSize(offset);
                 if (!ciphering && UseHdlc(p.GetSettings()->GetInterfaceType()))
                 {
                     AddLLCBytes(p.GetSettings(), reply);
@@ -1420,16 +1560,14 @@ int CGXDLMS::GetSNPdu(
     if (ciphering && p.GetCommand() != DLMS_COMMAND_AARQ
         && p.GetCommand() != DLMS_COMMAND_AARE)
     {
-        CGXByteBuffer tmp;
-        ret = p.GetSettings()->GetCipher()->Encrypt(
+        ret = p.GetSettings()->GetCipher()->EncryptInPlace(
             p.GetSettings()->GetCipher()->GetSecurity(),
-            DLMS_COUNT_TYPE_PACKET,
             p.GetSettings()->GetCipher()->GetFrameCounter(),
             GetGloMessage(p.GetCommand()),
             p.GetSettings()->GetCipher()->GetSystemTitle(),
             p.GetSettings()->GetCipher()->GetAuthenticationKey(),
             reply,
-            true);
+            offset);
         if (ret != 0)
         {
             return ret;
@@ -2319,7 +2457,7 @@ int CGXDLMS::HandleAccessResponse(
         {
             return ret;
         }
-        struct tm p = val.dateTime.GetValue();
+        struct tm p = val.dateTime().GetValue();
         reply.SetTime(&p);
     }
 #ifndef DLMS_IGNORE_XML_TRANSLATOR
@@ -2449,7 +2587,7 @@ int CGXDLMS::HandleDataNotification(
         {
             return ret;
         }
-        reply.SetTime(&t.dateTime.GetValue());
+        reply.SetTime(&t.dateTime().GetValue());
     }
 #ifndef DLMS_IGNORE_XML_TRANSLATOR
     if (reply.GetXml() != NULL)
@@ -2813,7 +2951,7 @@ int CGXDLMS::HandleGloDedRequest(CGXDLMSSettings& settings,
             if (settings.GetCipher()->GetDedicatedKey().GetSize() != 0 &&
                 (settings.GetConnected() & DLMS_CONNECTION_STATE_DLMS) != 0)
             {
-                if ((ret = settings.GetCipher()->Decrypt(settings.GetSourceSystemTitle(),
+                if ((ret = settings.GetCipher()->DecryptInPlace(settings.GetSourceSystemTitle(),
                     settings.GetCipher()->GetDedicatedKey(), data.GetData(), security, suite, InvocationCounter)) != 0)
                 {
                     return ret;
@@ -2826,7 +2964,7 @@ int CGXDLMS::HandleGloDedRequest(CGXDLMSSettings& settings,
             }
             else
             {
-                if ((ret = settings.GetCipher()->Decrypt(settings.GetSourceSystemTitle(),
+                if ((ret = settings.GetCipher()->DecryptInPlace(settings.GetSourceSystemTitle(),
                     settings.GetCipher()->GetBlockCipherKey(), data.GetData(), security, suite, InvocationCounter)) != 0)
                 {
                     return ret;
@@ -3437,7 +3575,7 @@ int CGXDLMS::HandleGetResponseWithList(
             reply.SetReadPosition(reply.GetData().GetPosition());
             GetValueFromData(settings, reply);
             reply.GetData().SetPosition(reply.GetReadPosition());
-            values.Arr.push_back(reply.GetValue());
+            values.Arr().push_back(reply.GetValue());
             reply.GetValue().Clear();
         }
     }
@@ -3890,7 +4028,7 @@ int CGXDLMS::HandleReadResponse(
                     reply.SetReadPosition(reply.GetData().GetPosition());
                     GetValueFromData(settings, reply);
                     reply.GetData().SetPosition(reply.GetReadPosition());
-                    values.Arr.push_back(reply.GetValue());
+                    values.Arr().push_back(reply.GetValue());
                     reply.GetValue().Clear();
                 }
             break;
@@ -3957,7 +4095,7 @@ int CGXDLMS::HandleReadResponse(
         return 0;
     }
 #endif //DLMS_IGNORE_XML_TRANSLATOR
-    if (values.Arr.size() != 0)
+    if (values.Arr().size() != 0)
     {
         reply.SetValue(values);
     }
@@ -4100,7 +4238,7 @@ int CGXDLMS::GetValueFromData(CGXDLMSSettings& settings, CGXReplyData& reply)
         }
         else
         {
-            if (value.Arr.size() != 0)
+            if (value.Arr().size() != 0)
             {
                 if (reply.GetValue().vt == DLMS_DATA_TYPE_NONE)
                 {
@@ -4109,7 +4247,7 @@ int CGXDLMS::GetValueFromData(CGXDLMSSettings& settings, CGXReplyData& reply)
                 else
                 {
                     CGXDLMSVariant tmp = reply.GetValue();
-                    tmp.Arr.insert(tmp.Arr.end(), value.Arr.begin(), value.Arr.end());
+                    tmp.Arr().insert(tmp.Arr().end(), value.Arr().begin(), value.Arr().end());
                     reply.SetValue(tmp);
                 }
             }
@@ -4145,8 +4283,18 @@ void CGXDLMS::GetDataFromFrame(CGXByteBuffer& reply, CGXReplyData& info, bool hd
     int cnt = info.GetPacketLength() - reply.GetPosition();
     if (cnt != 0)
     {
-        data.Capacity(offset + cnt);
-        data.Set(&reply, reply.GetPosition(), cnt);
+        //If received data is attached, payload of the first frame is
+        //parsed in place. Data is copied if more frames are appended.
+        if (offset == 0 && reply.IsAttached())
+        {
+            data.Attach(reply.GetData() + reply.GetPosition(), cnt);
+            reply.SetPosition(reply.GetPosition() + cnt);
+        }
+        else
+        {
+            data.Capacity(offset + cnt);
+            data.Set(&reply, reply.GetPosition(), cnt);
+        }
         if (hdlc)
         {
             reply.SetPosition(reply.GetPosition() + 3);
@@ -4696,46 +4844,42 @@ int CGXDLMS::CheckWrapperAddress(
 
 unsigned short CGXDLMS::CountFCS16(CGXByteBuffer& buff, int index, int count)
 {
-    int ret;
-    unsigned char ch;
     unsigned short fcs16 = 0xFFFF;
-    for (short pos = 0; pos < count; ++pos)
+    if (count <= 0)
     {
-        if ((ret = buff.GetUInt8(index + pos, &ch)) != 0)
-        {
-            return ret;
-        }
-        fcs16 = (fcs16 >> 8) ^ FCS16Table[(fcs16 ^ ch) & 0xFF];
+        count = 0;
+    }
+    else if (index < 0 || (unsigned long)index + count > buff.GetSize())
+    {
+        return DLMS_ERROR_CODE_OUTOFMEMORY;
+    }
+    const unsigned char* p = buff.GetData() + index;
+    const unsigned short(*table)[256] = GetFCS16Tables().m_Table;
+    for (; count >= 8; count -= 8, p += 8)
+    {
+        fcs16 = table[7][(fcs16 ^ p[0]) & 0xFF] ^ table[6][((fcs16 >> 8) ^ p[1]) & 0xFF] ^
+            table[5][p[2]] ^ table[4][p[3]] ^ table[3][p[4]] ^
+            table[2][p[5]] ^ table[1][p[6]] ^ table[0][p[7]];
+    }
+    for (; count != 0; --count, ++p)
+    {
+        fcs16 = (fcs16 >> 8) ^ FCS16Table[(fcs16 ^ *p) & 0xFF];
     }
     fcs16 = ~fcs16;
     fcs16 = ((fcs16 >> 8) & 0xFF) | (fcs16 << 8);
     return fcs16;
 }
 
-// Reserved for internal use.
-const uint32_t CRCPOLY = 0xD3B6BA00;
 uint32_t CGXDLMS::CountFCS24(unsigned char* buff, int index, int count)
 {
-    unsigned char i, j;
     uint32_t crcreg = 0;
-    for (j = 0; j < count; ++j)
+    const unsigned char* p = buff + index;
+    for (int pos = 0; pos < count; ++pos)
     {
-        unsigned char b = buff[index + j];
-        for (i = 0; i < 8; ++i)
-        {
-            crcreg >>= 1;
-            if ((b & 0x80) != 0)
-            {
-                crcreg |= 0x80000000;
-            }
-            if ((crcreg & 0x80) != 0)
-            {
-                crcreg = crcreg ^ CRCPOLY;
-            }
-            b <<= 1;
-        }
+        //Most significant bit of the byte is moved in first.
+        crcreg = (crcreg >> 8) ^ FCS24Table[crcreg & 0xFF] ^ ((uint32_t)BitReverseTable[p[pos]] << 16);
     }
-    return crcreg >> 8;
+    return crcreg;
 }
 
 int CGXDLMS::GetActionInfo(DLMS_OBJECT_TYPE objectType, unsigned char& value, unsigned char& count)
@@ -532,8 +532,8 @@ int CGXDLMSAccount::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEventArg& e)
         return SetLogicalName(this, e.GetValue());
         break;
     case 2:
-        m_PaymentMode = (DLMS_ACCOUNT_PAYMENT_MODE)e.GetValue().Arr[0].ToInteger();
-        m_AccountStatus = (DLMS_ACCOUNT_STATUS)e.GetValue().Arr[1].ToInteger();
+        m_PaymentMode = (DLMS_ACCOUNT_PAYMENT_MODE)e.GetValue().Arr()[0].ToInteger();
+        m_AccountStatus = (DLMS_ACCOUNT_STATUS)e.GetValue().Arr()[1].ToInteger();
         break;
     case 3:
         m_CurrentCreditInUse = e.GetValue().ToInteger();
@@ -562,7 +562,7 @@ int CGXDLMSAccount::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEventArg& e)
         break;
     case 9:
         m_CreditReferences.clear();
-        for (std::vector<CGXDLMSVariant>::iterator it = e.GetValue().Arr.begin(); it != e.GetValue().Arr.end(); ++it)
+        for (std::vector<CGXDLMSVariant>::iterator it = e.GetValue().Arr().begin(); it != e.GetValue().Arr().end(); ++it)
         {
             GXHelpers::GetLogicalName(it->byteArr, ln);
             m_CreditReferences.push_back(ln);
@@ -570,7 +570,7 @@ int CGXDLMSAccount::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEventArg& e)
         break;
     case 10:
         m_ChargeReferences.clear();
-        for (std::vector<CGXDLMSVariant>::iterator it = e.GetValue().Arr.begin(); it != e.GetValue().Arr.end(); ++it)
+        for (std::vector<CGXDLMSVariant>::iterator it = e.GetValue().Arr().begin(); it != e.GetValue().Arr().end(); ++it)
         {
             GXHelpers::GetLogicalName(it->byteArr, ln);
             m_ChargeReferences.push_back(ln);
@@ -578,25 +578,25 @@ int CGXDLMSAccount::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEventArg& e)
         break;
     case 11:
         m_CreditChargeConfigurations.clear();
-        for (std::vector<CGXDLMSVariant>::iterator it = e.GetValue().Arr.begin(); it != e.GetValue().Arr.end(); ++it)
+        for (std::vector<CGXDLMSVariant>::iterator it = e.GetValue().Arr().begin(); it != e.GetValue().Arr().end(); ++it)
         {
             CGXCreditChargeConfiguration item;
-            GXHelpers::GetLogicalName(it->Arr[0].byteArr, ln);
+            GXHelpers::GetLogicalName(it->Arr()[0].byteArr, ln);
             item.SetCreditReference(ln);
-            GXHelpers::GetLogicalName(it->Arr[1].byteArr, ln);
+            GXHelpers::GetLogicalName(it->Arr()[1].byteArr, ln);
             item.SetChargeReference(ln);
-            item.SetCollectionConfiguration((DLMS_CREDIT_COLLECTION_CONFIGURATION)it->Arr[2].ToInteger());
+            item.SetCollectionConfiguration((DLMS_CREDIT_COLLECTION_CONFIGURATION)it->Arr()[2].ToInteger());
             m_CreditChargeConfigurations.push_back(item);
         }
         break;
     case 12:
         m_TokenGatewayConfigurations.clear();
-        for (std::vector<CGXDLMSVariant>::iterator it = e.GetValue().Arr.begin(); it != e.GetValue().Arr.end(); ++it)
+        for (std::vector<CGXDLMSVariant>::iterator it = e.GetValue().Arr().begin(); it != e.GetValue().Arr().end(); ++it)
         {
             CGXTokenGatewayConfiguration item;
-            GXHelpers::GetLogicalName(it->Arr[0].byteArr, ln);
+            GXHelpers::GetLogicalName(it->Arr()[0].byteArr, ln);
             item.SetCreditReference(ln);
-            item.SetTokenProportion(it->Arr[1].ToInteger());
+            item.SetTokenProportion(it->Arr()[1].ToInteger());
             m_TokenGatewayConfigurations.push_back(item);
         }
         break;
@@ -612,11 +612,11 @@ int CGXDLMSAccount::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEventArg& e)
                 {
                     return ret;
                 }
-                m_AccountActivationTime = tmp.dateTime;
+                m_AccountActivationTime = tmp.dateTime();
             }
             else
             {
-                m_AccountActivationTime = e.GetValue().dateTime;
+                m_AccountActivationTime = e.GetValue().dateTime();
             }
         }
         break;
@@ -632,18 +632,18 @@ int CGXDLMSAccount::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEventArg& e)
                 {
                     return ret;
                 }
-                m_AccountClosureTime = tmp.dateTime;
+                m_AccountClosureTime = tmp.dateTime();
             }
             else
             {
-                m_AccountClosureTime = e.GetValue().dateTime;
+                m_AccountClosureTime = e.GetValue().dateTime();
             }
         }
         break;
     case 15:
-        m_Currency.SetName(e.GetValue().Arr[0].strVal);
-        m_Currency.SetScale(e.GetValue().Arr[1].ToInteger());
-        m_Currency.SetUnit((DLMS_CURRENCY)e.GetValue().Arr[2].ToInteger());
+        m_Currency.SetName(e.GetValue().Arr()[0].strVal());
+        m_Currency.SetScale(e.GetValue().Arr()[1].ToInteger());
+        m_Currency.SetUnit((DLMS_CURRENCY)e.GetValue().Arr()[2].ToInteger());
         break;
     case 16:
         m_LowCreditThreshold = e.GetValue().ToInteger();
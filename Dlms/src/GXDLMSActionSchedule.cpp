@@ -255,8 +255,8 @@ int CGXDLMSActionSchedule::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEvent
     }
     else if (e.GetIndex() == 2)
     {
-        GXHelpers::GetLogicalName(e.GetValue().Arr[0].byteArr, m_ExecutedScriptLogicalName);
-        SetExecutedScriptSelector(e.GetValue().Arr[1].ToInteger());
+        GXHelpers::GetLogicalName(e.GetValue().Arr()[0].byteArr, m_ExecutedScriptLogicalName);
+        SetExecutedScriptSelector(e.GetValue().Arr()[1].ToInteger());
         return DLMS_ERROR_CODE_OK;
     }
     else if (e.GetIndex() == 3)
@@ -269,24 +269,24 @@ int CGXDLMSActionSchedule::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEvent
         int ret;
         m_ExecutionTime.clear();
         CGXDLMSVariant time, date;
-        for (std::vector<CGXDLMSVariant>::iterator it = e.GetValue().Arr.begin();
-            it != e.GetValue().Arr.end(); ++it)
+        for (std::vector<CGXDLMSVariant>::iterator it = e.GetValue().Arr().begin();
+            it != e.GetValue().Arr().end(); ++it)
         {
-            if ((ret = CGXDLMSClient::ChangeType((*it).Arr[0], DLMS_DATA_TYPE_TIME, time)) != 0 ||
-                (ret = CGXDLMSClient::ChangeType((*it).Arr[1], DLMS_DATA_TYPE_DATE, date)) != 0)
+            if ((ret = CGXDLMSClient::ChangeType((*it).Arr()[0], DLMS_DATA_TYPE_TIME, time)) != 0 ||
+                (ret = CGXDLMSClient::ChangeType((*it).Arr()[1], DLMS_DATA_TYPE_DATE, date)) != 0)
             {
                 return ret;
             }
-            time.dateTime.SetSkip((DATETIME_SKIPS)(time.dateTime.GetSkip() & ~(DATETIME_SKIPS_YEAR | DATETIME_SKIPS_MONTH | DATETIME_SKIPS_DAY | DATETIME_SKIPS_DAYOFWEEK)));
-            date.dateTime.SetSkip((DATETIME_SKIPS)(date.dateTime.GetSkip() & ~(DATETIME_SKIPS_HOUR | DATETIME_SKIPS_MINUTE | DATETIME_SKIPS_SECOND | DATETIME_SKIPS_MS)));
-            struct tm val = time.dateTime.GetValue();
-            struct tm val2 = date.dateTime.GetValue();
+            time.dateTime().SetSkip((DATETIME_SKIPS)(time.dateTime().GetSkip() & ~(DATETIME_SKIPS_YEAR | DATETIME_SKIPS_MONTH | DATETIME_SKIPS_DAY | DATETIME_SKIPS_DAYOFWEEK)));
+            date.dateTime().SetSkip((DATETIME_SKIPS)(date.dateTime().GetSkip() & ~(DATETIME_SKIPS_HOUR | DATETIME_SKIPS_MINUTE | DATETIME_SKIPS_SECOND | DATETIME_SKIPS_MS)));
+            struct tm val = time.dateTime().GetValue();
+            struct tm val2 = date.dateTime().GetValue();
             val2.tm_hour = val.tm_hour;
             val2.tm_min = val.tm_min;
             val2.tm_sec = val.tm_sec;
             CGXDateTime tmp(val2);
-            tmp.SetSkip((DATETIME_SKIPS)(time.dateTime.GetSkip() | date.dateTime.GetSkip()));
-            tmp.SetExtra((DATE_TIME_EXTRA_INFO)(time.dateTime.GetExtra() | date.dateTime.GetExtra()));
+            tmp.SetSkip((DATETIME_SKIPS)(time.dateTime().GetSkip() | date.dateTime().GetSkip()));
+            tmp.SetExtra((DATE_TIME_EXTRA_INFO)(time.dateTime().GetExtra() | date.dateTime().GetExtra()));
             m_ExecutionTime.push_back(tmp);
         }
         return DLMS_ERROR_CODE_OK;
@@ -579,14 +579,14 @@ void AddSeasonProfile(std::vector<CGXDLMSSeasonProfile*>& items, std::vector<CGX
     {
         CGXDLMSSeasonProfile *it = new CGXDLMSSeasonProfile();
         bb.Clear();
-        bb.Set(item->Arr[0].byteArr, item->Arr[0].GetSize());
+        bb.Set(item->Arr()[0].byteArr, item->Arr()[0].GetSize());
         it->SetName(bb);
         tmp.Clear();
-        CGXDLMSClient::ChangeType((*item).Arr[1], DLMS_DATA_TYPE_DATETIME, tmp);
-        it->SetStart(tmp.dateTime);
+        CGXDLMSClient::ChangeType((*item).Arr()[1], DLMS_DATA_TYPE_DATETIME, tmp);
+        it->SetStart(tmp.dateTime());
         tmp.Clear();
         bb.Clear();
-        bb.Set(item->Arr[2].byteArr, item->Arr[2].GetSize());
+        bb.Set(item->Arr()[2].byteArr, item->Arr()[2].GetSize());
         it->SetWeekName(bb);
         items.push_back(it);
     }
@@ -605,15 +605,15 @@ void AddWeekProfileTable(std::vector<CGXDLMSWeekProfile*>& items, std::vector<CG
         CGXDLMSVariant tmp;
         CGXDLMSWeekProfile *it = new CGXDLMSWeekProfile();
         bb.Clear();
-        bb.Set(item->Arr[0].byteArr, item->Arr[0].GetSize());
+        bb.Set(item->Arr()[0].byteArr, item->Arr()[0].GetSize());
         it->SetName(bb);
-        it->SetMonday((*item).Arr[1].lVal);
-        it->SetTuesday((*item).Arr[2].lVal);
-        it->SetWednesday((*item).Arr[3].lVal);
-        it->SetThursday((*item).Arr[4].lVal);
-        it->SetFriday((*item).Arr[5].lVal);
-        it->SetSaturday((*item).Arr[6].lVal);
-        it->SetSunday((*item).Arr[7].lVal);
+        it->SetMonday((*item).Arr()[1].lVal);
+        it->SetTuesday((*item).Arr()[2].lVal);
+        it->SetWednesday((*item).Arr()[3].lVal);
+        it->SetThursday((*item).Arr()[4].lVal);
+        it->SetFriday((*item).Arr()[5].lVal);
+        it->SetSaturday((*item).Arr()[6].lVal);
+        it->SetSunday((*item).Arr()[7].lVal);
         items.push_back(it);
     }
 }
@@ -629,17 +629,17 @@ void AddDayProfileTable(std::vector<CGXDLMSDayProfile*>& items, std::vector<CGXD
     for (std::vector<CGXDLMSVariant>::iterator item = list.begin(); item != list.end(); ++item)
     {
         CGXDLMSDayProfile* it = new CGXDLMSDayProfile();
-        it->SetDayId((*item).Arr[0].iVal);
+        it->SetDayId((*item).Arr()[0].iVal);
         std::string ln;
-        for (std::vector<CGXDLMSVariant>::iterator it2 = (*item).Arr[1].Arr.begin(); it2 != (*item).Arr[1].Arr.end(); ++it2)
+        for (std::vector<CGXDLMSVariant>::iterator it2 = (*item).Arr()[1].Arr().begin(); it2 != (*item).Arr()[1].Arr().end(); ++it2)
         {
             CGXDLMSDayProfileAction * ac = new CGXDLMSDayProfileAction();
             CGXDLMSVariant tmp;
-            CGXDLMSClient::ChangeType(it2->Arr[0], DLMS_DATA_TYPE_TIME, tmp);
-            ac->SetStartTime((CGXTime&)tmp.dateTime);
-            GXHelpers::GetLogicalName((*it2).Arr[1].byteArr, ln);
+            CGXDLMSClient::ChangeType(it2->Arr()[0], DLMS_DATA_TYPE_TIME, tmp);
+            ac->SetStartTime((CGXTime&)tmp.dateTime());
+            GXHelpers::GetLogicalName((*it2).Arr()[1].byteArr, ln);
             ac->SetScriptLogicalName(ln);
-            ac->SetScriptSelector((*it2).Arr[2].lVal);
+            ac->SetScriptSelector((*it2).Arr()[2].lVal);
             it->GetDaySchedules().push_back(ac);
         }
         items.push_back(it);
@@ -661,15 +661,15 @@ int CGXDLMSActivityCalendar::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEve
     }
     else if (e.GetIndex() == 3)
     {
-        AddSeasonProfile(m_SeasonProfileActive, e.GetValue().Arr);
+        AddSeasonProfile(m_SeasonProfileActive, e.GetValue().Arr());
     }
     else if (e.GetIndex() == 4)
     {
-        AddWeekProfileTable(m_WeekProfileTableActive, e.GetValue().Arr);
+        AddWeekProfileTable(m_WeekProfileTableActive, e.GetValue().Arr());
     }
     else if (e.GetIndex() == 5)
     {
-        AddDayProfileTable(m_DayProfileTableActive, e.GetValue().Arr);
+        AddDayProfileTable(m_DayProfileTableActive, e.GetValue().Arr());
     }
     else if (e.GetIndex() == 6)
     {
@@ -679,15 +679,15 @@ int CGXDLMSActivityCalendar::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEve
     }
     else if (e.GetIndex() == 7)
     {
-        AddSeasonProfile(m_SeasonProfilePassive, e.GetValue().Arr);
+        AddSeasonProfile(m_SeasonProfilePassive, e.GetValue().Arr());
     }
     else if (e.GetIndex() == 8)
     {
-        AddWeekProfileTable(m_WeekProfileTablePassive, e.GetValue().Arr);
+        AddWeekProfileTable(m_WeekProfileTablePassive, e.GetValue().Arr());
     }
     else if (e.GetIndex() == 9)
     {
-        AddDayProfileTable(m_DayProfileTablePassive, e.GetValue().Arr);
+        AddDayProfileTable(m_DayProfileTablePassive, e.GetValue().Arr());
     }
     else if (e.GetIndex() == 10)
     {
@@ -697,7 +697,7 @@ int CGXDLMSActivityCalendar::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEve
         {
             return ret;
         }
-        SetTime(tmp.dateTime);
+        SetTime(tmp.dateTime());
     }
     else
     {
@@ -332,10 +332,10 @@ int CGXDLMSArbitrator::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEventArg&
     case 2:
     {
         m_Actions.clear();
-        for (std::vector<CGXDLMSVariant>::iterator it = e.GetValue().Arr.begin(); it != e.GetValue().Arr.end(); ++it)
+        for (std::vector<CGXDLMSVariant>::iterator it = e.GetValue().Arr().begin(); it != e.GetValue().Arr().end(); ++it)
         {
             CGXDLMSActionItem item;
-            if ((ret = CreateAction(it->Arr, item)) != 0)
+            if ((ret = CreateAction(it->Arr(), item)) != 0)
             {
                 break;
             }
@@ -346,7 +346,7 @@ int CGXDLMSArbitrator::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEventArg&
     case 3:
     {
         m_PermissionsTable.clear();
-        for (std::vector<CGXDLMSVariant>::iterator it = e.GetValue().Arr.begin(); it != e.GetValue().Arr.end(); ++it)
+        for (std::vector<CGXDLMSVariant>::iterator it = e.GetValue().Arr().begin(); it != e.GetValue().Arr().end(); ++it)
         {
             m_PermissionsTable.push_back(it->ToString());
         }
@@ -355,10 +355,10 @@ int CGXDLMSArbitrator::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEventArg&
     case 4:
     {
         m_WeightingsTable.clear();
-        for (std::vector<CGXDLMSVariant>::iterator it = e.GetValue().Arr.begin(); it != e.GetValue().Arr.end(); ++it)
+        for (std::vector<CGXDLMSVariant>::iterator it = e.GetValue().Arr().begin(); it != e.GetValue().Arr().end(); ++it)
         {
             std::vector<uint16_t> list;
-            for (std::vector<CGXDLMSVariant>::iterator it2 = it->Arr.begin(); it2 != it->Arr.end(); ++it2)
+            for (std::vector<CGXDLMSVariant>::iterator it2 = it->Arr().begin(); it2 != it->Arr().end(); ++it2)
             {
                 list.push_back(it2->ToInteger());
             }
@@ -369,7 +369,7 @@ int CGXDLMSArbitrator::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEventArg&
     case 5:
     {
         m_MostRecentRequestsTable.clear();
-        for (std::vector<CGXDLMSVariant>::iterator it = e.GetValue().Arr.begin(); it != e.GetValue().Arr.end(); ++it)
+        for (std::vector<CGXDLMSVariant>::iterator it = e.GetValue().Arr().begin(); it != e.GetValue().Arr().end(); ++it)
         {
             m_MostRecentRequestsTable.push_back(it->ToString());
         }
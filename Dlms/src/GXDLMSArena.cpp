@@ -0,0 +1,164 @@
+//
+// --------------------------------------------------------------------------
+//  Gurux Ltd
+//
+//
+//
+// Filename:        $HeadURL$
+//
+// Version:         $Revision$,
+//                  $Date$
+//                  $Author$
+//
+// Copyright (c) Gurux Ltd
+//
+//---------------------------------------------------------------------------
+//
+//  DESCRIPTION
+//
+// This file is a part of Gurux Device Framework.
+//
+// Gurux Device Framework is Open Source software; you can redistribute it
+// and/or modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; version 2 of the License.
+// Gurux Device Framework is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// More information of Gurux products: http://www.gurux.org
+//
+// This code is licensed under the GNU General Public License v2.
+// Full text may be retrieved at http://www.gnu.org/licenses/gpl-2.0.txt
+//---------------------------------------------------------------------------
+
+
+#include <stdlib.h>
+#include "../include/GXDLMSArena.h"
+
+//Allocated memory is aligned for any type.
+#define ARENA_ALIGNMENT 16
+#define ARENA_ALIGN(size) (((size) + ARENA_ALIGNMENT - 1) & ~(unsigned long)(ARENA_ALIGNMENT - 1))
+
+//Block header is followed by the data.
+#define ARENA_HEADER_SIZE ARENA_ALIGN(sizeof(CGXArenaBlock))
+
+static thread_local CGXDLMSArena* g_CurrentArena = NULL;
+
+CGXDLMSArena::CGXDLMSArena(unsigned long blockSize)
+{
+    m_Blocks = NULL;
+    m_Used = 0;
+    m_BlockSize = ARENA_ALIGN(blockSize);
+    m_BufferCount = 0;
+}
+
+CGXDLMSArena::~CGXDLMSArena()
+{
+    while (m_Blocks != NULL)
+    {
+        CGXArenaBlock* next = m_Blocks->m_Next;
+        free(m_Blocks);
+        m_Blocks = next;
+    }
+    for (std::vector<CGXByteBuffer*>::iterator it = m_Buffers.begin(); it != m_Buffers.end(); ++it)
+    {
+        delete *it;
+    }
+    if (g_CurrentArena == this)
+    {
+        g_CurrentArena = NULL;
+    }
+}
+
+void* CGXDLMSArena::Allocate(unsigned long size)
+{
+    size = ARENA_ALIGN(size);
+    if (m_Blocks == NULL || m_Used + size > m_Blocks->m_Size)
+    {
+        //Block sizes are doubled so only a few blocks are needed.
+        unsigned long blockSize = m_Blocks == NULL ? m_BlockSize : 2 * m_Blocks->m_Size;
+        if (blockSize < size)
+        {
+            blockSize = size;
+        }
+        CGXArenaBlock* block = (CGXArenaBlock*)malloc(ARENA_HEADER_SIZE + blockSize);
+        if (block == NULL)
+        {
+            return NULL;
+        }
+        block->m_Next = m_Blocks;
+        block->m_Size = blockSize;
+        m_Blocks = block;
+        m_Used = 0;
+    }
+    void* ret = (unsigned char*)m_Blocks + ARENA_HEADER_SIZE + m_Used;
+    m_Used += size;
+    return ret;
+}
+
+bool CGXDLMSArena::Contains(const void* value)
+{
+    for (CGXArenaBlock* it = m_Blocks; it != NULL; it = it->m_Next)
+    {
+        const unsigned char* data = (const unsigned char*)it + ARENA_HEADER_SIZE;
+        if ((const unsigned char*)value >= data && (const unsigned char*)value < data + it->m_Size)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+CGXByteBuffer& CGXDLMSArena::GetBuffer()
+{
+    if (m_BufferCount == m_Buffers.size())
+    {
+        m_Buffers.push_back(new CGXByteBuffer());
+    }
+    return *m_Buffers[m_BufferCount++];
+}
+
+void CGXDLMSArena::Reset()
+{
+    if (m_Blocks != NULL && m_Blocks->m_Next != NULL)
+    {
+        //Blocks are replaced with one block that is large enough for all
+        //the memory that was used.
+        unsigned long size = 0;
+        while (m_Blocks != NULL)
+        {
+            CGXArenaBlock* next = m_Blocks->m_Next;
+            size += m_Blocks->m_Size;
+            free(m_Blocks);
+            m_Blocks = next;
+        }
+        m_BlockSize = size;
+    }
+    m_Used = 0;
+    for (unsigned long pos = 0; pos != m_BufferCount; ++pos)
+    {
+        m_Buffers[pos]->SetSize(0);
+        m_Buffers[pos]->SetPosition(0);
+    }
+    m_BufferCount = 0;
+}
+
+CGXDLMSArena* CGXDLMSArena::GetCurrent()
+{
+    return g_CurrentArena;
+}
+
+void CGXDLMSArena::SetCurrent(CGXDLMSArena* value)
+{
+    g_CurrentArena = value;
+}
+
+CGXByteBuffer& CGXDLMSArena::GetCurrentBuffer(CGXByteBuffer& value)
+{
+    if (g_CurrentArena != NULL)
+    {
+        return g_CurrentArena->GetBuffer();
+    }
+    return value;
+}
\ No newline at end of file
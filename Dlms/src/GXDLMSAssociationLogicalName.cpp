@@ -37,80 +37,175 @@
 #include "../include/GXDLMSAssociationLogicalName.h"
 #include "../include/GXDLMSServer.h"
 #include "../include/GXBitString.h"
+#include <mutex>
+#include <unordered_map>
 
 #ifndef DLMS_IGNORE_ASSOCIATION_LOGICAL_NAME
 
-void CGXDLMSAssociationLogicalName::UpdateAccessRights(CGXDLMSObject* pObj, CGXDLMSVariant data)
+/////////////////////////////////////////////////////////////////////////////
+//Encoded association view. Encoded list is never changed. New list is
+//made when objects or access rights change.
+/////////////////////////////////////////////////////////////////////////////
+struct CGXEncodedObjectList
+{
+    //Objects and access rights that were encoded.
+    std::string m_Key;
+    CGXByteBuffer m_Data;
+    //Start position of each object. Last item is the size of the data.
+    std::vector<unsigned long> m_Offsets;
+};
+
+//Encoded lists are shared by all the associations with the same objects and
+//access rights. Lists that are not used are removed when there are too many.
+#define MAX_ENCODED_OBJECT_LISTS 32
+static std::mutex g_EncodedObjectListLock;
+static std::unordered_map<std::string, std::shared_ptr<const CGXEncodedObjectList> > g_EncodedObjectLists;
+
+/////////////////////////////////////////////////////////////////////////////
+//Encode association view from the object list key.
+/////////////////////////////////////////////////////////////////////////////
+static std::shared_ptr<const CGXEncodedObjectList> EncodeObjects(const std::string& key)
+{
+    std::shared_ptr<CGXEncodedObjectList> list = std::make_shared<CGXEncodedObjectList>();
+    list->m_Key = key;
+    CGXByteBuffer& data = list->m_Data;
+    const unsigned char* p = (const unsigned char*)key.data();
+    const unsigned char* end = p + key.size();
+    while (p != end)
+    {
+        list->m_Offsets.push_back(data.GetSize());
+        data.SetUInt8(DLMS_DATA_TYPE_STRUCTURE);
+        data.SetUInt8(4);
+        //Class ID.
+        data.SetUInt8(DLMS_DATA_TYPE_UINT16);
+        data.Set(p, 2);
+        //Version.
+        data.SetUInt8(DLMS_DATA_TYPE_UINT8);
+        data.SetUInt8(p[2]);
+        //LN.
+        data.SetUInt8(DLMS_DATA_TYPE_OCTET_STRING);
+        data.SetUInt8(6);
+        data.Set(p + 3, 6);
+        p += 9;
+        //Access rights.
+        data.SetUInt8(DLMS_DATA_TYPE_STRUCTURE);
+        data.SetUInt8(2);
+        for (int method = 0; method != 2; ++method)
+        {
+            unsigned char cnt = *p++;
+            data.SetUInt8(DLMS_DATA_TYPE_ARRAY);
+            GXHelpers::SetObjectCount(cnt, data);
+            for (unsigned char pos = 0; pos != cnt; ++pos)
+            {
+                //attribute_access_item or method_access_item.
+                data.SetUInt8(DLMS_DATA_TYPE_STRUCTURE);
+                data.SetUInt8(method ? 2 : 3);
+                data.SetUInt8(DLMS_DATA_TYPE_INT8);
+                data.SetUInt8(pos + 1);
+                data.SetUInt8(DLMS_DATA_TYPE_ENUM);
+                data.SetUInt8(*p++);
+                if (!method)
+                {
+                    //Access selectors are not used.
+                    data.SetUInt8(DLMS_DATA_TYPE_NONE);
+                }
+            }
+        }
+    }
+    list->m_Offsets.push_back(data.GetSize());
+    return list;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//Returns encoded association view for the object list key.
+/////////////////////////////////////////////////////////////////////////////
+static std::shared_ptr<const CGXEncodedObjectList> GetEncodedObjects(const std::string& key)
 {
-    for (std::vector<CGXDLMSVariant >::iterator it = data.Arr[0].Arr.begin(); it != data.Arr[0].Arr.end(); ++it)
     {
-        int id = it->Arr[0].ToInteger();
-        DLMS_ACCESS_MODE mode = (DLMS_ACCESS_MODE)it->Arr[1].ToInteger();
+        std::lock_guard<std::mutex> lock(g_EncodedObjectListLock);
+        std::unordered_map<std::string, std::shared_ptr<const CGXEncodedObjectList> >::iterator it = g_EncodedObjectLists.find(key);
+        if (it != g_EncodedObjectLists.end())
+        {
+            return it->second;
+        }
+    }
+    //List is encoded without the lock.
+    std::shared_ptr<const CGXEncodedObjectList> list = EncodeObjects(key);
+    std::lock_guard<std::mutex> lock(g_EncodedObjectListLock);
+    if (g_EncodedObjectLists.size() >= MAX_ENCODED_OBJECT_LISTS)
+    {
+        for (std::unordered_map<std::string, std::shared_ptr<const CGXEncodedObjectList> >::iterator it = g_EncodedObjectLists.begin(); it != g_EncodedObjectLists.end();)
+        {
+            if (it->second.use_count() == 1)
+            {
+                it = g_EncodedObjectLists.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+    //If other thread has added the same list it's used.
+    return g_EncodedObjectLists.emplace(key, list).first->second;
+}
+
+void CGXDLMSAssociationLogicalName::UpdateAccessRights(CGXDLMSObject* pObj, const CGXDLMSVariant& data)
+{
+    for (std::vector<CGXDLMSVariant >::const_iterator it = data.Arr()[0].Arr().begin(); it != data.Arr()[0].Arr().end(); ++it)
+    {
+        int id = it->Arr()[0].ToInteger();
+        DLMS_ACCESS_MODE mode = (DLMS_ACCESS_MODE)it->Arr()[1].ToInteger();
         pObj->SetAccess(id, mode);
     }
-    for (std::vector<CGXDLMSVariant >::iterator it = data.Arr[1].Arr.begin(); it != data.Arr[1].Arr.end(); ++it)
+    for (std::vector<CGXDLMSVariant >::const_iterator it = data.Arr()[1].Arr().begin(); it != data.Arr()[1].Arr().end(); ++it)
     {
-        int id = it->Arr[0].ToInteger();
-        DLMS_METHOD_ACCESS_MODE mode = (DLMS_METHOD_ACCESS_MODE)it->Arr[1].ToInteger();
+        int id = it->Arr()[0].ToInteger();
+        DLMS_METHOD_ACCESS_MODE mode = (DLMS_METHOD_ACCESS_MODE)it->Arr()[1].ToInteger();
         pObj->SetMethodAccess(id, mode);
     }
 }
 
-int CGXDLMSAssociationLogicalName::GetAccessRights(CGXDLMSObject* pItem, CGXDLMSServer* server, CGXByteBuffer& data)
+void CGXDLMSAssociationLogicalName::GetAccessRights(
+    CGXDLMSObject* pItem,
+    CGXDLMSValueEventArg& e,
+    std::string& key)
 {
-    int ret;
+    CGXDLMSServer* server = e.GetServer();
+    unsigned short type = (unsigned short)pItem->GetObjectType();
+    key.push_back((char)(type >> 8));
+    key.push_back((char)type);
+    key.push_back((char)pItem->GetVersion());
+    key.append((const char*)pItem->m_LN, 6);
+    e.SetTarget(pItem);
     int cnt = pItem->GetAttributeCount();
-    data.SetUInt8(DLMS_DATA_TYPE_STRUCTURE);
-    data.SetUInt8(2);
-    data.SetUInt8(DLMS_DATA_TYPE_ARRAY);
-    GXHelpers::SetObjectCount(cnt, data);
-    CGXDLMSValueEventArg e(server, pItem, 0);
-
-    CGXDLMSVariant index, access, empty;
+    key.push_back((char)cnt);
     for (int pos = 0; pos != cnt; ++pos)
     {
         e.SetIndex(pos + 1);
-        index = pos + 1;
         if (server != NULL)
         {
-            access = server->GetAttributeAccess(&e);
+            key.push_back((char)server->GetAttributeAccess(&e));
         }
         else
         {
-            access = DLMS_ACCESS_MODE_READ_WRITE;
-        }
-        //attribute_access_item
-        data.SetUInt8(DLMS_DATA_TYPE_STRUCTURE);
-        data.SetUInt8(3);
-        if ((ret = GXHelpers::SetData(NULL, data, DLMS_DATA_TYPE_INT8, index)) != 0 ||
-            (ret = GXHelpers::SetData(NULL, data, DLMS_DATA_TYPE_ENUM, access)) != 0 ||
-            (ret = GXHelpers::SetData(NULL, data, DLMS_DATA_TYPE_NONE, empty)) != 0)
-        {
-            return ret;
+            key.push_back((char)DLMS_ACCESS_MODE_READ_WRITE);
         }
     }
     cnt = pItem->GetMethodCount();
-    data.SetUInt8(DLMS_DATA_TYPE_ARRAY);
-    GXHelpers::SetObjectCount(cnt, data);
+    key.push_back((char)cnt);
     for (int pos = 0; pos != cnt; ++pos)
     {
         e.SetIndex(pos + 1);
-        index = pos + 1;
         if (server != NULL)
         {
-            access = server->GetMethodAccess(&e);
+            key.push_back((char)server->GetMethodAccess(&e));
         }
         else
         {
-            access = DLMS_METHOD_ACCESS_MODE_ACCESS;
+            key.push_back((char)DLMS_METHOD_ACCESS_MODE_ACCESS);
         }
-        //attribute_access_item
-        data.SetUInt8(DLMS_DATA_TYPE_STRUCTURE);
-        data.SetUInt8(2);
-        GXHelpers::SetData(NULL, data, DLMS_DATA_TYPE_INT8, index);
-        GXHelpers::SetData(NULL, data, DLMS_DATA_TYPE_ENUM, access);
     }
-    return DLMS_ERROR_CODE_OK;
 }
 
 
@@ -176,8 +271,6 @@ int CGXDLMSAssociationLogicalName::GetObjects(
     CGXDLMSValueEventArg& e,
     CGXByteBuffer& data)
 {
-    int ret;
-    unsigned long pos = 0;
     //Add count only for first time.
     if (settings.GetIndex() == 0)
     {
@@ -186,34 +279,45 @@ int CGXDLMSAssociationLogicalName::GetObjects(
         //Add count
         GXHelpers::SetObjectCount((unsigned long)m_ObjectList.size(), data);
     }
-    unsigned char gbt = (settings.GetNegotiatedConformance() & DLMS_CONFORMANCE_GENERAL_BLOCK_TRANSFER) != 0;
+    //Access rights are asked from the server every time because they can
+    //depend on the association. Objects are encoded only when the key changes.
+    m_ObjectListKey.clear();
+    CGXDLMSValueEventArg arg(e.GetServer(), this, 0);
     for (CGXDLMSObjectCollection::iterator it = m_ObjectList.begin(); it != m_ObjectList.end(); ++it)
     {
-        ++pos;
-        if (!(pos <= settings.GetIndex()))
+        GetAccessRights(*it, arg, m_ObjectListKey);
+    }
+    if (!m_EncodedObjects || m_EncodedObjects->m_Key != m_ObjectListKey)
+    {
+        m_EncodedObjects = GetEncodedObjects(m_ObjectListKey);
+    }
+    const std::vector<unsigned long>& offsets = m_EncodedObjects->m_Offsets;
+    const unsigned char* encoded = ((CGXByteBuffer&)m_EncodedObjects->m_Data).GetData();
+    unsigned long count = (unsigned long)offsets.size() - 1;
+    unsigned long pos = settings.GetIndex();
+    if (pos >= count)
+    {
+        return DLMS_ERROR_CODE_OK;
+    }
+    unsigned char gbt = (settings.GetNegotiatedConformance() & DLMS_CONFORMANCE_GENERAL_BLOCK_TRANSFER) != 0;
+    if (!settings.IsServer() || gbt || e.GetSkipMaxPduSize())
+    {
+        //All objects are added at once.
+        data.Set(encoded + offsets[pos], offsets[count] - offsets[pos]);
+        if (settings.IsServer())
         {
-            data.SetUInt8(DLMS_DATA_TYPE_STRUCTURE);
-            data.SetUInt8(4);//Count
-            CGXDLMSVariant type = (*it)->GetObjectType();
-            CGXDLMSVariant version = (*it)->GetVersion();
-            GXHelpers::SetData(&settings, data, DLMS_DATA_TYPE_UINT16, type);//ClassID
-            GXHelpers::SetData(&settings, data, DLMS_DATA_TYPE_UINT8, version);//Version
-            CGXDLMSVariant ln((*it)->m_LN, 6, DLMS_DATA_TYPE_OCTET_STRING);
-            GXHelpers::SetData(&settings, data, DLMS_DATA_TYPE_OCTET_STRING, ln);//LN
-            //Access rights.
-            if ((ret = GetAccessRights(*it, e.GetServer(), data)) != 0)
-            {
-                return ret;
-            };
-            if (settings.IsServer())
-            {
-                settings.SetIndex(settings.GetIndex() + 1);
-                //If PDU is full.
-                if (!gbt && !e.GetSkipMaxPduSize() && data.GetSize() >= settings.GetMaxPduSize())
-                {
-                    break;
-                }
-            }
+            settings.SetIndex((unsigned short)count);
+        }
+        return DLMS_ERROR_CODE_OK;
+    }
+    for (; pos != count; ++pos)
+    {
+        data.Set(encoded + offsets[pos], offsets[pos + 1] - offsets[pos]);
+        settings.SetIndex((unsigned short)(pos + 1));
+        //If PDU is full.
+        if (data.GetSize() >= settings.GetMaxPduSize())
+        {
+            break;
         }
     }
     return DLMS_ERROR_CODE_OK;
@@ -658,18 +762,18 @@ int CGXDLMSAssociationLogicalName::Invoke(CGXDLMSSettings& settings, CGXDLMSValu
     }
     else if (e.GetIndex() == 5)
     {
-        if (e.GetParameters().Arr.size() != 2)
+        if (e.GetParameters().Arr().size() != 2)
         {
             e.SetError(DLMS_ERROR_CODE_READ_WRITE_DENIED);
         }
         else
         {
-            m_UserList.push_back(std::pair<unsigned char, std::string>(e.GetParameters().Arr[0].bVal, e.GetParameters().Arr[1].strVal));
+            m_UserList.push_back(std::pair<unsigned char, std::string>(e.GetParameters().Arr()[0].bVal, e.GetParameters().Arr()[1].strVal()));
         }
     }
     else if (e.GetIndex() == 6)
     {
-        if (e.GetParameters().Arr.size() != 2)
+        if (e.GetParameters().Arr().size() != 2)
         {
             e.SetError(DLMS_ERROR_CODE_READ_WRITE_DENIED);
         }
@@ -677,7 +781,7 @@ int CGXDLMSAssociationLogicalName::Invoke(CGXDLMSSettings& settings, CGXDLMSValu
         {
             for (std::vector<std::pair<unsigned char, std::string> >::iterator it = m_UserList.begin(); it != m_UserList.end(); ++it)
             {
-                if (it->first == e.GetParameters().Arr[0].bVal)
+                if (it->first == e.GetParameters().Arr()[0].bVal)
                 {
                     m_UserList.erase(it);
                     break;
@@ -854,12 +958,12 @@ int CGXDLMSAssociationLogicalName::SetValue(CGXDLMSSettings& settings, CGXDLMSVa
         m_ObjectList.clear();
         if (e.GetValue().vt != DLMS_DATA_TYPE_NONE)
         {
-            for (std::vector<CGXDLMSVariant >::iterator it = e.GetValue().Arr.begin(); it != e.GetValue().Arr.end(); ++it)
+            for (std::vector<CGXDLMSVariant >::iterator it = e.GetValue().Arr().begin(); it != e.GetValue().Arr().end(); ++it)
             {
-                DLMS_OBJECT_TYPE type = (DLMS_OBJECT_TYPE)(*it).Arr[0].ToInteger();
-                int version = (*it).Arr[1].ToInteger();
+                DLMS_OBJECT_TYPE type = (DLMS_OBJECT_TYPE)(*it).Arr()[0].ToInteger();
+                int version = (*it).Arr()[1].ToInteger();
                 std::string ln;
-                GXHelpers::GetLogicalName((*it).Arr[2].byteArr, ln);
+                GXHelpers::GetLogicalName((*it).Arr()[2].byteArr, ln);
                 CGXDLMSObject* pObj = settings.GetObjects().FindByLN(type, ln);
                 if (pObj == NULL)
                 {
@@ -872,7 +976,7 @@ int CGXDLMSAssociationLogicalName::SetValue(CGXDLMSSettings& settings, CGXDLMSVa
                 }
                 if (pObj != NULL)
                 {
-                    UpdateAccessRights(pObj, (*it).Arr[3]);
+                    UpdateAccessRights(pObj, (*it).Arr()[3]);
                     m_ObjectList.push_back(pObj);
                 }
             }
@@ -880,10 +984,10 @@ int CGXDLMSAssociationLogicalName::SetValue(CGXDLMSSettings& settings, CGXDLMSVa
     }
     else if (e.GetIndex() == 3)
     {
-        if (e.GetValue().Arr.size() == 2)
+        if (e.GetValue().Arr().size() == 2)
         {
-            m_ClientSAP = e.GetValue().Arr[0].ToInteger();
-            m_ServerSAP = e.GetValue().Arr[1].ToInteger();
+            m_ClientSAP = e.GetValue().Arr()[0].ToInteger();
+            m_ServerSAP = e.GetValue().Arr()[1].ToInteger();
         }
         else
         {
@@ -1051,13 +1155,13 @@ int CGXDLMSAssociationLogicalName::SetValue(CGXDLMSSettings& settings, CGXDLMSVa
         }
         else
         {
-            m_ApplicationContextName.SetJointIsoCtt(e.GetValue().Arr[0].ToInteger());
-            m_ApplicationContextName.SetCountry(e.GetValue().Arr[1].ToInteger());
-            m_ApplicationContextName.SetCountryName(e.GetValue().Arr[2].ToInteger());
-            m_ApplicationContextName.SetIdentifiedOrganization(e.GetValue().Arr[3].ToInteger());
-            m_ApplicationContextName.SetDlmsUA(e.GetValue().Arr[4].ToInteger());
-            m_ApplicationContextName.SetApplicationContext(e.GetValue().Arr[5].ToInteger());
-            m_ApplicationContextName.SetContextId((DLMS_APPLICATION_CONTEXT_NAME)e.GetValue().Arr[6].ToInteger());
+            m_ApplicationContextName.SetJointIsoCtt(e.GetValue().Arr()[0].ToInteger());
+            m_ApplicationContextName.SetCountry(e.GetValue().Arr()[1].ToInteger());
+            m_ApplicationContextName.SetCountryName(e.GetValue().Arr()[2].ToInteger());
+            m_ApplicationContextName.SetIdentifiedOrganization(e.GetValue().Arr()[3].ToInteger());
+            m_ApplicationContextName.SetDlmsUA(e.GetValue().Arr()[4].ToInteger());
+            m_ApplicationContextName.SetApplicationContext(e.GetValue().Arr()[5].ToInteger());
+            m_ApplicationContextName.SetContextId((DLMS_APPLICATION_CONTEXT_NAME)e.GetValue().Arr()[6].ToInteger());
         }
     }
     else if (e.GetIndex() == 5)
@@ -1065,12 +1169,12 @@ int CGXDLMSAssociationLogicalName::SetValue(CGXDLMSSettings& settings, CGXDLMSVa
         if (e.GetValue().vt == DLMS_DATA_TYPE_STRUCTURE)
         {
             CGXByteBuffer tmp;
-            m_XDLMSContextInfo.SetConformance((DLMS_CONFORMANCE)e.GetValue().Arr[0].ToInteger());
-            m_XDLMSContextInfo.SetMaxReceivePduSize(e.GetValue().Arr[1].ToInteger());
-            m_XDLMSContextInfo.SetMaxSendPduSize(e.GetValue().Arr[2].ToInteger());
-            m_XDLMSContextInfo.SetDlmsVersionNumber(e.GetValue().Arr[3].ToInteger());
-            m_XDLMSContextInfo.SetQualityOfService(e.GetValue().Arr[4].ToInteger());
-            tmp.Set(e.GetValue().Arr[5].byteArr, e.GetValue().Arr[5].GetSize());
+            m_XDLMSContextInfo.SetConformance((DLMS_CONFORMANCE)e.GetValue().Arr()[0].ToInteger());
+            m_XDLMSContextInfo.SetMaxReceivePduSize(e.GetValue().Arr()[1].ToInteger());
+            m_XDLMSContextInfo.SetMaxSendPduSize(e.GetValue().Arr()[2].ToInteger());
+            m_XDLMSContextInfo.SetDlmsVersionNumber(e.GetValue().Arr()[3].ToInteger());
+            m_XDLMSContextInfo.SetQualityOfService(e.GetValue().Arr()[4].ToInteger());
+            tmp.Set(e.GetValue().Arr()[5].byteArr, e.GetValue().Arr()[5].GetSize());
             m_XDLMSContextInfo.SetCypheringInfo(tmp);
         }
     }
@@ -1238,13 +1342,13 @@ int CGXDLMSAssociationLogicalName::SetValue(CGXDLMSSettings& settings, CGXDLMSVa
             }
             else
             {
-                m_AuthenticationMechanismName.SetJointIsoCtt(e.GetValue().Arr[0].ToInteger());
-                m_AuthenticationMechanismName.SetCountry(e.GetValue().Arr[1].ToInteger());
-                m_AuthenticationMechanismName.SetCountryName(e.GetValue().Arr[2].ToInteger());
-                m_AuthenticationMechanismName.SetIdentifiedOrganization(e.GetValue().Arr[3].ToInteger());
-                m_AuthenticationMechanismName.SetDlmsUA(e.GetValue().Arr[4].ToInteger());
-                m_AuthenticationMechanismName.SetAuthenticationMechanismName(e.GetValue().Arr[5].ToInteger());
-                m_AuthenticationMechanismName.SetMechanismId((DLMS_AUTHENTICATION)e.GetValue().Arr[6].ToInteger());
+                m_AuthenticationMechanismName.SetJointIsoCtt(e.GetValue().Arr()[0].ToInteger());
+                m_AuthenticationMechanismName.SetCountry(e.GetValue().Arr()[1].ToInteger());
+                m_AuthenticationMechanismName.SetCountryName(e.GetValue().Arr()[2].ToInteger());
+                m_AuthenticationMechanismName.SetIdentifiedOrganization(e.GetValue().Arr()[3].ToInteger());
+                m_AuthenticationMechanismName.SetDlmsUA(e.GetValue().Arr()[4].ToInteger());
+                m_AuthenticationMechanismName.SetAuthenticationMechanismName(e.GetValue().Arr()[5].ToInteger());
+                m_AuthenticationMechanismName.SetMechanismId((DLMS_AUTHENTICATION)e.GetValue().Arr()[6].ToInteger());
             }
         }
     }
@@ -1264,16 +1368,16 @@ int CGXDLMSAssociationLogicalName::SetValue(CGXDLMSSettings& settings, CGXDLMSVa
     else if (e.GetIndex() == 10)
     {
         m_UserList.clear();
-        for (std::vector<CGXDLMSVariant >::iterator it = e.GetValue().Arr.begin(); it != e.GetValue().Arr.end(); ++it)
+        for (std::vector<CGXDLMSVariant >::iterator it = e.GetValue().Arr().begin(); it != e.GetValue().Arr().end(); ++it)
         {
-            m_UserList.push_back(std::pair<unsigned char, std::string>(it->Arr[0].bVal, it->Arr[1].strVal));
+            m_UserList.push_back(std::pair<unsigned char, std::string>(it->Arr()[0].bVal, it->Arr()[1].strVal()));
         }
     }
     else if (e.GetIndex() == 11)
     {
-        if (e.GetValue().Arr.size() == 2)
+        if (e.GetValue().Arr().size() == 2)
         {
-            m_CurrentUser = std::pair<unsigned char, std::string>(e.GetValue().Arr[0].bVal, e.GetValue().Arr[1].strVal);
+            m_CurrentUser = std::pair<unsigned char, std::string>(e.GetValue().Arr()[0].bVal, e.GetValue().Arr()[1].strVal());
         }
         else
         {
@@ -98,24 +98,24 @@ int CGXDLMSAssociationShortName::GetAccessRights(CGXDLMSObject* pObj, CGXDLMSSer
 
 void CGXDLMSAssociationShortName::UpdateAccessRights(CGXDLMSVariant& buff)
 {
-    for (std::vector<CGXDLMSVariant>::iterator access = buff.Arr.begin(); access != buff.Arr.end(); ++access)
+    for (std::vector<CGXDLMSVariant>::iterator access = buff.Arr().begin(); access != buff.Arr().end(); ++access)
     {
-        int sn = access->Arr[0].ToInteger();
+        int sn = access->Arr()[0].ToInteger();
         CGXDLMSObject* pObj = m_ObjectList.FindBySN(sn);
         if (pObj != NULL)
         {
-            for (std::vector<CGXDLMSVariant>::iterator attributeAccess = access->Arr[1].Arr.begin();
-                attributeAccess != access->Arr[1].Arr.end(); ++attributeAccess)
+            for (std::vector<CGXDLMSVariant>::iterator attributeAccess = access->Arr()[1].Arr().begin();
+                attributeAccess != access->Arr()[1].Arr().end(); ++attributeAccess)
             {
-                int id = attributeAccess->Arr[0].ToInteger();
-                int tmp = attributeAccess->Arr[1].ToInteger();
+                int id = attributeAccess->Arr()[0].ToInteger();
+                int tmp = attributeAccess->Arr()[1].ToInteger();
                 pObj->SetAccess(id, (DLMS_ACCESS_MODE)tmp);
             }
-            for (std::vector<CGXDLMSVariant>::iterator methodAccess = access->Arr[2].Arr.begin();
-                methodAccess != access->Arr[2].Arr.end(); ++methodAccess)
+            for (std::vector<CGXDLMSVariant>::iterator methodAccess = access->Arr()[2].Arr().begin();
+                methodAccess != access->Arr()[2].Arr().end(); ++methodAccess)
             {
-                int id = methodAccess->Arr[0].ToInteger();
-                int tmp = methodAccess->Arr[1].ToInteger();
+                int id = methodAccess->Arr()[0].ToInteger();
+                int tmp = methodAccess->Arr()[1].ToInteger();
                 pObj->SetMethodAccess(id, (DLMS_METHOD_ACCESS_MODE)tmp);
             }
         }
@@ -438,16 +438,16 @@ int CGXDLMSAssociationShortName::SetValue(CGXDLMSSettings& settings, CGXDLMSValu
         m_ObjectList.clear();
         if (e.GetValue().vt == DLMS_DATA_TYPE_ARRAY)
         {
-            for (std::vector<CGXDLMSVariant>::iterator item = e.GetValue().Arr.begin(); item != e.GetValue().Arr.end(); ++item)
+            for (std::vector<CGXDLMSVariant>::iterator item = e.GetValue().Arr().begin(); item != e.GetValue().Arr().end(); ++item)
             {
-                int sn = item->Arr[0].ToInteger();
+                int sn = item->Arr()[0].ToInteger();
                 CGXDLMSObject* pObj = settings.GetObjects().FindBySN(sn);
                 if (pObj == NULL)
                 {
-                    DLMS_OBJECT_TYPE type = (DLMS_OBJECT_TYPE)item->Arr[1].ToInteger();
-                    int version = item->Arr[2].ToInteger();
+                    DLMS_OBJECT_TYPE type = (DLMS_OBJECT_TYPE)item->Arr()[1].ToInteger();
+                    int version = item->Arr()[2].ToInteger();
                     std::string ln;
-                    GXHelpers::GetLogicalName((*item).Arr[3].byteArr, ln);
+                    GXHelpers::GetLogicalName((*item).Arr()[3].byteArr, ln);
                     pObj = CGXDLMSObjectFactory::CreateObject(type, ln);
                     if (pObj != NULL)
                     {
@@ -321,12 +321,12 @@ int CGXDLMSAutoAnswer::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEventArg&
     if (e.GetIndex() == 3)
     {
         m_ListeningWindow.clear();
-        for (std::vector<CGXDLMSVariant>::iterator item = e.GetValue().Arr.begin(); item != e.GetValue().Arr.end(); ++item)
+        for (std::vector<CGXDLMSVariant>::iterator item = e.GetValue().Arr().begin(); item != e.GetValue().Arr().end(); ++item)
         {
             CGXDLMSVariant start, end;
-            CGXDLMSClient::ChangeType((*item).Arr[0], DLMS_DATA_TYPE_DATETIME, start);
-            CGXDLMSClient::ChangeType((*item).Arr[1], DLMS_DATA_TYPE_DATETIME, end);
-            m_ListeningWindow.push_back(std::pair< CGXDateTime, CGXDateTime>(start.dateTime, end.dateTime));
+            CGXDLMSClient::ChangeType((*item).Arr()[0], DLMS_DATA_TYPE_DATETIME, start);
+            CGXDLMSClient::ChangeType((*item).Arr()[1], DLMS_DATA_TYPE_DATETIME, end);
+            m_ListeningWindow.push_back(std::pair< CGXDateTime, CGXDateTime>(start.dateTime(), end.dateTime()));
         }
         return DLMS_ERROR_CODE_OK;
     }
@@ -345,8 +345,8 @@ int CGXDLMSAutoAnswer::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEventArg&
         m_NumberOfRingsInListeningWindow = m_NumberOfRingsOutListeningWindow = 0;
         if (e.GetValue().vt != DLMS_DATA_TYPE_NONE)
         {
-            m_NumberOfRingsInListeningWindow = e.GetValue().Arr[0].ToInteger();
-            m_NumberOfRingsOutListeningWindow = e.GetValue().Arr[1].ToInteger();
+            m_NumberOfRingsInListeningWindow = e.GetValue().Arr()[0].ToInteger();
+            m_NumberOfRingsOutListeningWindow = e.GetValue().Arr()[1].ToInteger();
         }
         return DLMS_ERROR_CODE_OK;
     }
@@ -342,13 +342,13 @@ int CGXDLMSAutoConnect::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEventArg
     else if (e.GetIndex() == 5)
     {
         m_CallingWindow.clear();
-        for (std::vector<CGXDLMSVariant>::iterator item = e.GetValue().Arr.begin(); item != e.GetValue().Arr.end(); ++item)
+        for (std::vector<CGXDLMSVariant>::iterator item = e.GetValue().Arr().begin(); item != e.GetValue().Arr().end(); ++item)
         {
             CGXDLMSVariant tmp;
-            CGXDLMSClient::ChangeType(item->Arr[0], DLMS_DATA_TYPE_DATETIME, tmp);
-            CGXDateTime start = tmp.dateTime;
-            CGXDLMSClient::ChangeType(item->Arr[1], DLMS_DATA_TYPE_DATETIME, tmp);
-            CGXDateTime end = tmp.dateTime;
+            CGXDLMSClient::ChangeType(item->Arr()[0], DLMS_DATA_TYPE_DATETIME, tmp);
+            CGXDateTime start = tmp.dateTime();
+            CGXDLMSClient::ChangeType(item->Arr()[1], DLMS_DATA_TYPE_DATETIME, tmp);
+            CGXDateTime end = tmp.dateTime();
             m_CallingWindow.push_back(std::make_pair(start, end));
         }
         return DLMS_ERROR_CODE_OK;
@@ -357,7 +357,7 @@ int CGXDLMSAutoConnect::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEventArg
     {
         m_Destinations.clear();
         std::vector< std::string > items;
-        for (std::vector<CGXDLMSVariant>::iterator item = e.GetValue().Arr.begin(); item != e.GetValue().Arr.end(); ++item)
+        for (std::vector<CGXDLMSVariant>::iterator item = e.GetValue().Arr().begin(); item != e.GetValue().Arr().end(); ++item)
         {
             CGXDLMSVariant value;
             CGXDLMSClient::ChangeType(*item, DLMS_DATA_TYPE_STRING, value);
@@ -340,18 +340,18 @@ int CGXDLMSCharge::GetValue(CGXDLMSSettings& settings, CGXDLMSValueEventArg& e)
 
 int CGXDLMSCharge::SetUnitCharge(CGXDLMSSettings& settings, CGXUnitCharge& charge, CGXDLMSValueEventArg& e)
 {
-    std::vector<CGXDLMSVariant>& tmp = e.GetValue().Arr;
-    charge.GetChargePerUnitScaling().SetCommodityScale(tmp[0].Arr[0].ToInteger());
-    charge.GetChargePerUnitScaling().SetPriceScale(tmp[0].Arr[1].ToInteger());
-    charge.GetCommodity().SetType((DLMS_OBJECT_TYPE)tmp[1].Arr[0].ToInteger());
-    charge.GetCommodity().SetLogicalName(tmp[1].Arr[1].byteArr);
-    charge.GetCommodity().SetIndex(tmp[1].Arr[2].ToInteger());
+    std::vector<CGXDLMSVariant>& tmp = e.GetValue().Arr();
+    charge.GetChargePerUnitScaling().SetCommodityScale(tmp[0].Arr()[0].ToInteger());
+    charge.GetChargePerUnitScaling().SetPriceScale(tmp[0].Arr()[1].ToInteger());
+    charge.GetCommodity().SetType((DLMS_OBJECT_TYPE)tmp[1].Arr()[0].ToInteger());
+    charge.GetCommodity().SetLogicalName(tmp[1].Arr()[1].byteArr);
+    charge.GetCommodity().SetIndex(tmp[1].Arr()[2].ToInteger());
     charge.GetChargeTables().clear();
-    for (std::vector<CGXDLMSVariant>::iterator it = tmp[2].Arr.begin(); it != tmp[2].Arr.end(); ++it)
+    for (std::vector<CGXDLMSVariant>::iterator it = tmp[2].Arr().begin(); it != tmp[2].Arr().end(); ++it)
     {
         CGXChargeTable item;
-        item.SetIndex(it->Arr[0].strVal);
-        item.SetChargePerUnit(it->Arr[1].ToInteger());
+        item.SetIndex(it->Arr()[0].strVal());
+        item.SetChargePerUnit(it->Arr()[1].ToInteger());
         charge.GetChargeTables().push_back(item);
     }
     return 0;
@@ -391,11 +391,11 @@ int CGXDLMSCharge::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEventArg& e)
             {
                 return ret;
             }
-            m_UnitChargeActivationTime = tmp.dateTime;
+            m_UnitChargeActivationTime = tmp.dateTime();
         }
         else if (e.GetValue().vt == DLMS_DATA_TYPE_DATETIME)
         {
-            m_UnitChargeActivationTime = e.GetValue().dateTime;
+            m_UnitChargeActivationTime = e.GetValue().dateTime();
         }
         else
         {
@@ -420,11 +420,11 @@ int CGXDLMSCharge::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEventArg& e)
             {
                 return ret;
             }
-            m_LastCollectionTime = tmp.dateTime;
+            m_LastCollectionTime = tmp.dateTime();
         }
         else
         {
-            m_LastCollectionTime = e.GetValue().dateTime;
+            m_LastCollectionTime = e.GetValue().dateTime();
         }
         break;
     case 11:
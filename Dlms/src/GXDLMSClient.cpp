@@ -383,21 +383,21 @@ int CGXDLMSClient::ParseSNObjectItem(
     CGXDLMSVariant& value,
     bool ignoreInactiveObjects)
 {
-    if (value.vt != DLMS_DATA_TYPE_STRUCTURE || value.Arr.size() != 4)
+    if (value.vt != DLMS_DATA_TYPE_STRUCTURE || value.Arr().size() != 4)
     {
         return DLMS_ERROR_CODE_INVALID_PARAMETER;
     }
-    if (value.Arr[0].vt != DLMS_DATA_TYPE_INT16 ||
-        value.Arr[1].vt != DLMS_DATA_TYPE_UINT16 ||
-        value.Arr[2].vt != DLMS_DATA_TYPE_UINT8 ||
-        value.Arr[3].vt != DLMS_DATA_TYPE_OCTET_STRING)
+    if (value.Arr()[0].vt != DLMS_DATA_TYPE_INT16 ||
+        value.Arr()[1].vt != DLMS_DATA_TYPE_UINT16 ||
+        value.Arr()[2].vt != DLMS_DATA_TYPE_UINT8 ||
+        value.Arr()[3].vt != DLMS_DATA_TYPE_OCTET_STRING)
     {
         return DLMS_ERROR_CODE_INVALID_PARAMETER;
     }
-    short sn = value.Arr[0].ToInteger() & 0xFFFF;
-    unsigned short class_id = (unsigned short)value.Arr[1].ToInteger();
-    unsigned char version = (unsigned char)value.Arr[2].ToInteger();
-    CGXDLMSVariant ln = value.Arr[3];
+    short sn = value.Arr()[0].ToInteger() & 0xFFFF;
+    unsigned short class_id = (unsigned short)value.Arr()[1].ToInteger();
+    unsigned char version = (unsigned char)value.Arr()[2].ToInteger();
+    CGXDLMSVariant ln = value.Arr()[3];
     CGXDLMSObject* pObj = CGXDLMSObjectFactory::CreateObject((DLMS_OBJECT_TYPE)class_id);
     if (pObj != NULL)
     {
@@ -462,35 +462,35 @@ int CGXDLMSClient::ParseLNObjectItem(
     bool ignoreInactiveObjects)
 {
     int ret;
-    if (value.Arr.size() != 4)
+    if (value.Arr().size() != 4)
     {
         //Invalid structure format.
         return DLMS_ERROR_CODE_INVALID_PARAMETER;
     }
-    int classID = value.Arr[0].ToInteger() & 0xFFFF;
+    int classID = value.Arr()[0].ToInteger() & 0xFFFF;
     if (classID > 0)
     {
         CGXDLMSObject* pObj = CGXDLMSObjectFactory::CreateObject((DLMS_OBJECT_TYPE)classID);
         if (pObj != NULL)
         {
-            if (value.vt != DLMS_DATA_TYPE_STRUCTURE || value.Arr.size() != 4)
+            if (value.vt != DLMS_DATA_TYPE_STRUCTURE || value.Arr().size() != 4)
             {
                 return DLMS_ERROR_CODE_INVALID_PARAMETER;
             }
-            if (value.Arr[0].vt != DLMS_DATA_TYPE_UINT16)
+            if (value.Arr()[0].vt != DLMS_DATA_TYPE_UINT16)
             {
                 return DLMS_ERROR_CODE_INVALID_PARAMETER;
             }
-            if (value.Arr[1].vt != DLMS_DATA_TYPE_UINT8)
+            if (value.Arr()[1].vt != DLMS_DATA_TYPE_UINT8)
             {
                 return DLMS_ERROR_CODE_INVALID_PARAMETER;
             }
-            unsigned char version = value.Arr[1].ToInteger();
-            if (value.Arr[2].vt != DLMS_DATA_TYPE_OCTET_STRING)
+            unsigned char version = value.Arr()[1].ToInteger();
+            if (value.Arr()[2].vt != DLMS_DATA_TYPE_OCTET_STRING)
             {
                 return DLMS_ERROR_CODE_INVALID_PARAMETER;
             }
-            CGXDLMSVariant ln = value.Arr[2];
+            CGXDLMSVariant ln = value.Arr()[2];
             if ((ret = CGXDLMSObject::SetLogicalName(pObj, ln)) != 0)
             {
                 return ret;
@@ -503,47 +503,47 @@ int CGXDLMSClient::ParseLNObjectItem(
                 return 0;
             }
             //Get Access rights...
-            if (value.Arr[3].vt != DLMS_DATA_TYPE_STRUCTURE || value.Arr[3].Arr.size() != 2)
+            if (value.Arr()[3].vt != DLMS_DATA_TYPE_STRUCTURE || value.Arr()[3].Arr().size() != 2)
             {
                 return DLMS_ERROR_CODE_INVALID_PARAMETER;
             }
             pObj->SetVersion(version);
             int cnt;
             // attribute_access_descriptor Start
-            if (value.Arr[3].Arr[0].vt != DLMS_DATA_TYPE_ARRAY)
+            if (value.Arr()[3].Arr()[0].vt != DLMS_DATA_TYPE_ARRAY)
             {
                 delete pObj;
                 return DLMS_ERROR_CODE_INVALID_PARAMETER;
             }
-            if (value.Arr[3].Arr.size() == 2)
+            if (value.Arr()[3].Arr().size() == 2)
             {
-                for (unsigned int pos = 0; pos != value.Arr[3].Arr[0].Arr.size(); ++pos)
+                for (unsigned int pos = 0; pos != value.Arr()[3].Arr()[0].Arr().size(); ++pos)
                 {
-                    if (value.Arr[3].Arr[0].Arr[pos].vt != DLMS_DATA_TYPE_STRUCTURE ||
-                        value.Arr[3].Arr[0].Arr[pos].Arr.size() != 3)
+                    if (value.Arr()[3].Arr()[0].Arr()[pos].vt != DLMS_DATA_TYPE_STRUCTURE ||
+                        value.Arr()[3].Arr()[0].Arr()[pos].Arr().size() != 3)
                     {
                         delete pObj;
                         return DLMS_ERROR_CODE_INVALID_PARAMETER;
                     }
-                    int id = value.Arr[3].Arr[0].Arr[pos].Arr[0].ToInteger();
+                    int id = value.Arr()[3].Arr()[0].Arr()[pos].Arr()[0].ToInteger();
                     //Get access_mode
-                    DLMS_DATA_TYPE tp = value.Arr[3].Arr[0].Arr[pos].Arr[1].vt;
+                    DLMS_DATA_TYPE tp = value.Arr()[3].Arr()[0].Arr()[pos].Arr()[1].vt;
                     if (tp != DLMS_DATA_TYPE_ENUM)
                     {
                         delete pObj;
                         return DLMS_ERROR_CODE_INVALID_PARAMETER;
                     }
-                    pObj->SetAccess(id, (DLMS_ACCESS_MODE)value.Arr[3].Arr[0].Arr[pos].Arr[1].ToInteger());
+                    pObj->SetAccess(id, (DLMS_ACCESS_MODE)value.Arr()[3].Arr()[0].Arr()[pos].Arr()[1].ToInteger());
                     //Get access_selectors
-                    if (value.Arr[3].Arr[0].Arr[pos].Arr[2].vt == DLMS_DATA_TYPE_ARRAY)
+                    if (value.Arr()[3].Arr()[0].Arr()[pos].Arr()[2].vt == DLMS_DATA_TYPE_ARRAY)
                     {
-                        int cnt2 = (unsigned long)value.Arr[3].Arr[0].Arr[pos].Arr[2].Arr.size();
+                        int cnt2 = (unsigned long)value.Arr()[3].Arr()[0].Arr()[pos].Arr()[2].Arr().size();
                         for (int pos2 = 0; pos2 != cnt2; ++pos2)
                         {
                             //Get access_mode
                         }
                     }
-                    else if (value.Arr[3].Arr[0].Arr[pos].Arr[2].vt != DLMS_DATA_TYPE_NONE)
+                    else if (value.Arr()[3].Arr()[0].Arr()[pos].Arr()[2].vt != DLMS_DATA_TYPE_NONE)
                     {
                         delete pObj;
                         return DLMS_ERROR_CODE_INVALID_PARAMETER;
@@ -551,29 +551,29 @@ int CGXDLMSClient::ParseLNObjectItem(
                 }
                 // attribute_access_descriptor End
                 // method_access_item Start
-                if (value.Arr[3].Arr[1].vt != DLMS_DATA_TYPE_ARRAY)
+                if (value.Arr()[3].Arr()[1].vt != DLMS_DATA_TYPE_ARRAY)
                 {
                     delete pObj;
                     return DLMS_ERROR_CODE_INVALID_PARAMETER;
                 }
-                for (unsigned int pos = 0; pos != value.Arr[3].Arr[1].Arr.size(); ++pos)
+                for (unsigned int pos = 0; pos != value.Arr()[3].Arr()[1].Arr().size(); ++pos)
                 {
-                    CGXDLMSVariant tmp = value.Arr[3].Arr[1].Arr[pos];
+                    CGXDLMSVariant tmp = value.Arr()[3].Arr()[1].Arr()[pos];
                     if (tmp.vt != DLMS_DATA_TYPE_STRUCTURE ||
-                        tmp.Arr.size() != 2)
+                        tmp.Arr().size() != 2)
                     {
                         delete pObj;
                         return DLMS_ERROR_CODE_INVALID_PARAMETER;
                     }
-                    int id = tmp.Arr[0].ToInteger();
+                    int id = tmp.Arr()[0].ToInteger();
                     //Get access_mode
                     //In version 0 data type is boolean.
-                    if (tmp.Arr[1].vt != DLMS_DATA_TYPE_ENUM && tmp.Arr[1].vt != DLMS_DATA_TYPE_BOOLEAN)
+                    if (tmp.Arr()[1].vt != DLMS_DATA_TYPE_ENUM && tmp.Arr()[1].vt != DLMS_DATA_TYPE_BOOLEAN)
                     {
                         delete pObj;
                         return DLMS_ERROR_CODE_INVALID_PARAMETER;
                     }
-                    pObj->SetMethodAccess(id, (DLMS_METHOD_ACCESS_MODE)tmp.Arr[1].ToInteger());
+                    pObj->SetMethodAccess(id, (DLMS_METHOD_ACCESS_MODE)tmp.Arr()[1].ToInteger());
                 }
             }
             // method_access_item End
@@ -1207,7 +1207,7 @@ int CGXDLMSClient::Read(CGXDLMSVariant& name, DLMS_OBJECT_TYPE objectType, int a
         attributeDescriptor.SetUInt16(objectType);
         // Add LN
         unsigned char ln[6];
-        GXHelpers::SetLogicalName(name.strVal.c_str(), ln);
+        GXHelpers::SetLogicalName(name.strVal().c_str(), ln);
         attributeDescriptor.Set(ln, 6);
         // Attribute ID.
         attributeDescriptor.SetUInt8(attributeOrdinal);
@@ -1522,7 +1522,7 @@ int CGXDLMSClient::Write(
             bb.SetUInt16(pObject->GetObjectType());
             // Add LN.
             unsigned char ln[6];
-            GXHelpers::SetLogicalName(name.strVal.c_str(), ln);
+            GXHelpers::SetLogicalName(name.strVal().c_str(), ln);
             bb.Set(ln, 6);
             // Attribute ID.
             bb.SetUInt8(index);
@@ -1584,7 +1584,7 @@ int CGXDLMSClient::Write(CGXDLMSVariant& name, DLMS_OBJECT_TYPE objectType,
         bb.SetUInt16(objectType);
         // Add LN.
         unsigned char ln[6];
-        GXHelpers::SetLogicalName(name.strVal.c_str(), ln);
+        GXHelpers::SetLogicalName(name.strVal().c_str(), ln);
         bb.Set(ln, 6);
         // Attribute ID.
         bb.SetUInt8(index);
@@ -1689,7 +1689,7 @@ int CGXDLMSClient::Method(
         bb.SetUInt16(objectType);
         // Add LN.
         unsigned char ln[6];
-        GXHelpers::SetLogicalName(name.strVal.c_str(), ln);
+        GXHelpers::SetLogicalName(name.strVal().c_str(), ln);
         bb.Set(ln, 6);
         // Attribute ID.
         bb.SetUInt8(index);
@@ -1982,21 +1982,21 @@ int CGXDLMSClient::ParsePushObjects(std::vector<CGXDLMSVariant>& data, std::vect
     CGXDLMSVariant ln;
     for (std::vector<CGXDLMSVariant>::iterator it = data.begin(); it != data.end(); ++it)
     {
-        int classID = it->Arr[0].ToInteger() & 0xFFFF;
+        int classID = it->Arr()[0].ToInteger() & 0xFFFF;
         if (classID > 0)
         {
             ln.Clear();
-            if ((ret = CGXDLMSClient::ChangeType(it->Arr[1], DLMS_DATA_TYPE_OCTET_STRING, ln)) != 0)
+            if ((ret = CGXDLMSClient::ChangeType(it->Arr()[1], DLMS_DATA_TYPE_OCTET_STRING, ln)) != 0)
             {
                 return ret;
             }
-            obj = GetObjects().FindByLN((DLMS_OBJECT_TYPE)classID, ln.strVal);
+            obj = GetObjects().FindByLN((DLMS_OBJECT_TYPE)classID, ln.strVal());
             if (obj == NULL)
             {
-                obj = CGXDLMSObjectFactory::CreateObject((DLMS_OBJECT_TYPE)classID, ln.strVal);
+                obj = CGXDLMSObjectFactory::CreateObject((DLMS_OBJECT_TYPE)classID, ln.strVal());
                 GetObjects().push_back(obj);
             }
-            items.push_back(std::pair<CGXDLMSObject*, unsigned char>(obj, it->Arr[2].ToInteger()));
+            items.push_back(std::pair<CGXDLMSObject*, unsigned char>(obj, it->Arr()[2].ToInteger()));
         }
     }
     return 0;
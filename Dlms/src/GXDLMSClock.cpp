@@ -352,11 +352,11 @@ int CGXDLMSClock::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEventArg& e)
         {
             CGXDLMSVariant tmp;
             CGXDLMSClient::ChangeType(e.GetValue(), DLMS_DATA_TYPE_DATETIME, tmp);
-            SetTime(tmp.dateTime);
+            SetTime(tmp.dateTime());
         }
         else
         {
-            SetTime(e.GetValue().dateTime);
+            SetTime(e.GetValue().dateTime());
         }
     }
     else if (e.GetIndex() == 3)
@@ -373,11 +373,11 @@ int CGXDLMSClock::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEventArg& e)
         {
             CGXDLMSVariant tmp;
             CGXDLMSClient::ChangeType(e.GetValue(), DLMS_DATA_TYPE_DATETIME, tmp);
-            SetBegin(tmp.dateTime);
+            SetBegin(tmp.dateTime());
         }
         else
         {
-            SetBegin(e.GetValue().dateTime);
+            SetBegin(e.GetValue().dateTime());
         }
     }
     else if (e.GetIndex() == 6)
@@ -386,11 +386,11 @@ int CGXDLMSClock::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEventArg& e)
         {
             CGXDLMSVariant tmp;
             CGXDLMSClient::ChangeType(e.GetValue(), DLMS_DATA_TYPE_DATETIME, tmp);
-            SetEnd(tmp.dateTime);
+            SetEnd(tmp.dateTime());
         }
         else
         {
-            SetEnd(e.GetValue().dateTime);
+            SetEnd(e.GetValue().dateTime());
         }
     }
     else if (e.GetIndex() == 7)
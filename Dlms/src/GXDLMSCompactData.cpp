@@ -292,7 +292,7 @@ int CGXDLMSCompactData::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEventArg
         }
         else if (e.GetValue().vt == DLMS_DATA_TYPE_STRING)
         {
-            m_Buffer.AddString(e.GetValue().strVal);
+            m_Buffer.AddString(e.GetValue().strVal());
         }
         break;
     case 3:
@@ -303,16 +303,16 @@ int CGXDLMSCompactData::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEventArg
         m_CaptureObjects.clear();
         if (e.GetValue().vt == DLMS_DATA_TYPE_ARRAY)
         {
-            for (std::vector<CGXDLMSVariant >::iterator it = e.GetValue().Arr.begin(); it != e.GetValue().Arr.end(); ++it)
+            for (std::vector<CGXDLMSVariant >::iterator it = e.GetValue().Arr().begin(); it != e.GetValue().Arr().end(); ++it)
             {
-                if ((*it).Arr.size() != 4)
+                if ((*it).Arr().size() != 4)
                 {
                     //Invalid structure format.
                     return DLMS_ERROR_CODE_INVALID_PARAMETER;
                 }
-                DLMS_OBJECT_TYPE type = (DLMS_OBJECT_TYPE)(*it).Arr[0].ToInteger();
+                DLMS_OBJECT_TYPE type = (DLMS_OBJECT_TYPE)(*it).Arr()[0].ToInteger();
                 std::string ln;
-                GXHelpers::GetLogicalName((*it).Arr[1].byteArr, ln);
+                GXHelpers::GetLogicalName((*it).Arr()[1].byteArr, ln);
                 CGXDLMSObject* pObj = settings.GetObjects().FindByLN(type, ln);
                 if (pObj == NULL)
                 {
@@ -323,7 +323,7 @@ int CGXDLMSCompactData::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEventArg
                         settings.AddAllocateObject(pObj);
                     }
                 }
-                CGXDLMSCaptureObject* pCO = new CGXDLMSCaptureObject(it->Arr[2].ToInteger(), it->Arr[3].ToInteger());
+                CGXDLMSCaptureObject* pCO = new CGXDLMSCaptureObject(it->Arr()[2].ToInteger(), it->Arr()[3].ToInteger());
                 m_CaptureObjects.push_back(std::pair<CGXDLMSObject*, CGXDLMSCaptureObject*>(pObj, pCO));
             }
         }
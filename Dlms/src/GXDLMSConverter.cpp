@@ -243,6 +243,9 @@ const char* CGXDLMSConverter::GetErrorMessage(int error)
         case DLMS_ERROR_CODE_INVALID_SECURITY_SUITE:
             str = "Client try to connect with wrong security suite.";
             break;
+        case DLMS_ERROR_CODE_INVOCATION_COUNTER_LIMIT:
+            str = "Invocation counter limit is reached.";
+            break;
         default:
             str = "Unknown error.";
             break;
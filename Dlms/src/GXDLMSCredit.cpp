@@ -334,11 +334,11 @@ int CGXDLMSCredit::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEventArg& e)
                 {
                     return ret;
                 }
-                m_Period = tmp.dateTime;
+                m_Period = tmp.dateTime();
             }
             else
             {
-                m_Period = e.GetValue().dateTime;
+                m_Period = e.GetValue().dateTime();
             }
         }
         break;
@@ -475,8 +475,8 @@ int CGXDLMSDemandRegister::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEvent
     }
     else if (e.GetIndex() == 4 && e.GetValue().vt == DLMS_DATA_TYPE_STRUCTURE)
     {
-        m_Scaler = e.GetValue().Arr[0].ToInteger();
-        m_Unit = e.GetValue().Arr[1].ToInteger();
+        m_Scaler = e.GetValue().Arr()[0].ToInteger();
+        m_Unit = e.GetValue().Arr()[1].ToInteger();
     }
     else if (e.GetIndex() == 5)
     {
@@ -486,13 +486,13 @@ int CGXDLMSDemandRegister::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEvent
     {
         CGXDLMSVariant tmp;
         CGXDLMSClient::ChangeType(e.GetValue(), DLMS_DATA_TYPE_DATETIME, tmp);
-        SetCaptureTime(tmp.dateTime);
+        SetCaptureTime(tmp.dateTime());
     }
     else if (e.GetIndex() == 7)
     {
         CGXDLMSVariant tmp;
         CGXDLMSClient::ChangeType(e.GetValue(), DLMS_DATA_TYPE_DATETIME, tmp);
-        SetStartTimeCurrent(tmp.dateTime);
+        SetStartTimeCurrent(tmp.dateTime());
     }
     else if (e.GetIndex() == 8)
     {
@@ -215,11 +215,11 @@ int CGXDLMSExtendedRegister::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEve
         {
             CGXDLMSVariant tmp;
             CGXDLMSClient::ChangeType(e.GetValue(), DLMS_DATA_TYPE_DATETIME, tmp);
-            m_CaptureTime = tmp.dateTime;
+            m_CaptureTime = tmp.dateTime();
         }
         else
         {
-            m_CaptureTime = e.GetValue().dateTime;
+            m_CaptureTime = e.GetValue().dateTime();
         }
     }
     else
@@ -251,17 +251,17 @@ int CGXDLMSGPRSSetup::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEventArg&
     }
     else if (e.GetIndex() == 4)
     {
-        m_DefaultQualityOfService.SetPrecedence(e.GetValue().Arr[0].Arr[0].iVal);
-        m_DefaultQualityOfService.SetDelay(e.GetValue().Arr[0].Arr[1].iVal);
-        m_DefaultQualityOfService.SetReliability(e.GetValue().Arr[0].Arr[2].iVal);
-        m_DefaultQualityOfService.SetPeakThroughput(e.GetValue().Arr[0].Arr[3].iVal);
-        m_DefaultQualityOfService.SetMeanThroughput(e.GetValue().Arr[0].Arr[4].iVal);
+        m_DefaultQualityOfService.SetPrecedence(e.GetValue().Arr()[0].Arr()[0].iVal);
+        m_DefaultQualityOfService.SetDelay(e.GetValue().Arr()[0].Arr()[1].iVal);
+        m_DefaultQualityOfService.SetReliability(e.GetValue().Arr()[0].Arr()[2].iVal);
+        m_DefaultQualityOfService.SetPeakThroughput(e.GetValue().Arr()[0].Arr()[3].iVal);
+        m_DefaultQualityOfService.SetMeanThroughput(e.GetValue().Arr()[0].Arr()[4].iVal);
 
-        m_RequestedQualityOfService.SetPrecedence(e.GetValue().Arr[1].Arr[0].iVal);
-        m_RequestedQualityOfService.SetDelay(e.GetValue().Arr[1].Arr[1].iVal);
-        m_RequestedQualityOfService.SetReliability(e.GetValue().Arr[1].Arr[2].iVal);
-        m_RequestedQualityOfService.SetPeakThroughput(e.GetValue().Arr[1].Arr[3].iVal);
-        m_RequestedQualityOfService.SetMeanThroughput(e.GetValue().Arr[1].Arr[4].iVal);
+        m_RequestedQualityOfService.SetPrecedence(e.GetValue().Arr()[1].Arr()[0].iVal);
+        m_RequestedQualityOfService.SetDelay(e.GetValue().Arr()[1].Arr()[1].iVal);
+        m_RequestedQualityOfService.SetReliability(e.GetValue().Arr()[1].Arr()[2].iVal);
+        m_RequestedQualityOfService.SetPeakThroughput(e.GetValue().Arr()[1].Arr()[3].iVal);
+        m_RequestedQualityOfService.SetMeanThroughput(e.GetValue().Arr()[1].Arr()[4].iVal);
     }
     else
     {
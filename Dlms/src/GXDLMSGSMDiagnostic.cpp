@@ -344,7 +344,7 @@ int CGXDLMSGSMDiagnostic::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEventA
         }
         else
         {
-            m_Operator = e.GetValue().strVal;
+            m_Operator = e.GetValue().strVal();
         }
         break;
     case 3:
@@ -357,9 +357,9 @@ int CGXDLMSGSMDiagnostic::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEventA
         m_PacketSwitchStatus = (DLMS_GSM_PACKET_SWITCH_STATUS)e.GetValue().ToInteger();
         break;
     case 6:
-        if (e.GetValue().Arr.size() == 4 || e.GetValue().Arr.size() == 7)
+        if (e.GetValue().Arr().size() == 4 || e.GetValue().Arr().size() == 7)
         {
-            std::vector<CGXDLMSVariant> tmp = (std::vector<CGXDLMSVariant>) e.GetValue().Arr;
+            std::vector<CGXDLMSVariant> tmp = (std::vector<CGXDLMSVariant>) e.GetValue().Arr();
             m_CellInfo.SetCellId(tmp[0].ToInteger());
             m_CellInfo.SetLocationId(tmp[1].ToInteger());
             m_CellInfo.SetSignalQuality(tmp[2].ToInteger());
@@ -374,9 +374,9 @@ int CGXDLMSGSMDiagnostic::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEventA
         break;
     case 7:
         m_AdjacentCells.clear();
-        for (std::vector<CGXDLMSVariant>::iterator it = e.GetValue().Arr.begin(); it != e.GetValue().Arr.end(); ++it)
+        for (std::vector<CGXDLMSVariant>::iterator it = e.GetValue().Arr().begin(); it != e.GetValue().Arr().end(); ++it)
         {
-            std::vector<CGXDLMSVariant> tmp = (std::vector<CGXDLMSVariant>) it->Arr;
+            std::vector<CGXDLMSVariant> tmp = (std::vector<CGXDLMSVariant>) it->Arr();
             GXAdjacentCell* ac = new GXAdjacentCell();
             ac->SetCellId(tmp[0].ToInteger());
             ac->SetSignalQuality(tmp[1].ToInteger());
@@ -391,11 +391,11 @@ int CGXDLMSGSMDiagnostic::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEventA
             {
                 return ret;
             }
-            m_CaptureTime = tmp.dateTime;
+            m_CaptureTime = tmp.dateTime();
         }
         else
         {
-            m_CaptureTime = e.GetValue().dateTime;
+            m_CaptureTime = e.GetValue().dateTime();
         }
         break;
     default:
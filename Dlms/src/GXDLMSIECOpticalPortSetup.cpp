@@ -341,28 +341,28 @@ int CGXDLMSIECLocalPortSetup::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEv
     {
         CGXDLMSVariant tmp;
         CGXDLMSClient::ChangeType(e.GetValue(), DLMS_DATA_TYPE_STRING, tmp);
-        SetDeviceAddress(tmp.strVal);
+        SetDeviceAddress(tmp.strVal());
         return DLMS_ERROR_CODE_OK;
     }
     else if (e.GetIndex() == 7)
     {
         CGXDLMSVariant tmp;
         CGXDLMSClient::ChangeType(e.GetValue(), DLMS_DATA_TYPE_STRING, tmp);
-        SetPassword1(tmp.strVal);
+        SetPassword1(tmp.strVal());
         return DLMS_ERROR_CODE_OK;
     }
     else if (e.GetIndex() == 8)
     {
         CGXDLMSVariant tmp;
         CGXDLMSClient::ChangeType(e.GetValue(), DLMS_DATA_TYPE_STRING, tmp);
-        SetPassword2(tmp.strVal);
+        SetPassword2(tmp.strVal());
         return DLMS_ERROR_CODE_OK;
     }
     else if (e.GetIndex() == 9)
     {
         CGXDLMSVariant tmp;
         CGXDLMSClient::ChangeType(e.GetValue(), DLMS_DATA_TYPE_STRING, tmp);
-        SetPassword5(tmp.strVal);
+        SetPassword5(tmp.strVal());
         return DLMS_ERROR_CODE_OK;
     }
     return DLMS_ERROR_CODE_INVALID_PARAMETER;
@@ -273,7 +273,7 @@ int CGXDLMSIecTwistedPairSetup::SetValue(CGXDLMSSettings& settings, CGXDLMSValue
         m_PrimaryAddresses.clear();
         if (e.GetValue().vt == DLMS_DATA_TYPE_ARRAY)
         {
-            for (std::vector<CGXDLMSVariant>::iterator it = e.GetValue().Arr.begin(); it != e.GetValue().Arr.end(); ++it)
+            for (std::vector<CGXDLMSVariant>::iterator it = e.GetValue().Arr().begin(); it != e.GetValue().Arr().end(); ++it)
             {
                 m_PrimaryAddresses.push_back(it->ToInteger());
             }
@@ -285,7 +285,7 @@ int CGXDLMSIecTwistedPairSetup::SetValue(CGXDLMSSettings& settings, CGXDLMSValue
         m_Tabis.clear();
         if (e.GetValue().vt == DLMS_DATA_TYPE_ARRAY)
         {
-            for (std::vector<CGXDLMSVariant>::iterator it = e.GetValue().Arr.begin(); it != e.GetValue().Arr.end(); ++it)
+            for (std::vector<CGXDLMSVariant>::iterator it = e.GetValue().Arr().begin(); it != e.GetValue().Arr().end(); ++it)
             {
                 m_Tabis.push_back(it->ToInteger());
             }
@@ -331,9 +331,9 @@ int CGXDLMSImageTransfer::Invoke(CGXDLMSSettings& settings, CGXDLMSValueEventArg
     {
         m_ImageFirstNotTransferredBlockNumber = 0;
         m_ImageTransferredBlocksStatus = "";
-        unsigned long size = (unsigned long) e.GetParameters().Arr[0].GetSize();
-        unsigned char * imageIdentifier = e.GetParameters().Arr[0].byteArr;
-        int ImageSize = e.GetParameters().Arr[1].ToInteger();
+        unsigned long size = (unsigned long) e.GetParameters().Arr()[0].GetSize();
+        unsigned char * imageIdentifier = e.GetParameters().Arr()[0].byteArr;
+        int ImageSize = e.GetParameters().Arr()[1].ToInteger();
         m_ImageTransferStatus = DLMS_IMAGE_TRANSFER_STATUS_INITIATED;
         CGXDLMSImageActivateInfo *item = NULL;
         for (std::vector<CGXDLMSImageActivateInfo*>::iterator it = m_ImageActivateInfo.begin(); it != m_ImageActivateInfo.end(); ++it)
@@ -367,7 +367,7 @@ int CGXDLMSImageTransfer::Invoke(CGXDLMSSettings& settings, CGXDLMSValueEventArg
     //Image block transfer
     else if (e.GetIndex() == 2)
     {
-        int imageIndex = e.GetParameters().Arr[0].ToInteger();
+        int imageIndex = e.GetParameters().Arr()[0].ToInteger();
         m_ImageTransferredBlocksStatus[imageIndex] = '1';
         m_ImageFirstNotTransferredBlockNumber = imageIndex + 1;
         m_ImageTransferStatus = DLMS_IMAGE_TRANSFER_STATUS_INITIATED;
@@ -545,13 +545,13 @@ int CGXDLMSImageTransfer::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEventA
         if (e.GetValue().vt == DLMS_DATA_TYPE_ARRAY)
         {
             CGXDLMSVariant tmp;
-            for (std::vector<CGXDLMSVariant>::iterator it = e.GetValue().Arr.begin(); it != e.GetValue().Arr.end(); ++it)
+            for (std::vector<CGXDLMSVariant>::iterator it = e.GetValue().Arr().begin(); it != e.GetValue().Arr().end(); ++it)
             {
                 CGXDLMSImageActivateInfo* item = new CGXDLMSImageActivateInfo();
-                item->SetSize((*it).Arr[0].ToInteger());
+                item->SetSize((*it).Arr()[0].ToInteger());
                 CGXByteBuffer id, sic;
-                id.Set((*it).Arr[1].byteArr, (*it).Arr[1].GetSize());
-                sic.Set((*it).Arr[2].byteArr, (*it).Arr[2].GetSize());
+                id.Set((*it).Arr()[1].byteArr, (*it).Arr()[1].GetSize());
+                sic.Set((*it).Arr()[2].byteArr, (*it).Arr()[2].GetSize());
                 item->SetIdentification(id);
                 item->SetSignature(sic);
                 m_ImageActivateInfo.push_back(item);
@@ -540,7 +540,7 @@ int CGXDLMSIp4Setup::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEventArg& e
         m_MulticastIPAddress.clear();
         if (e.GetValue().vt == DLMS_DATA_TYPE_ARRAY)
         {
-            for (std::vector<CGXDLMSVariant>::iterator it = e.GetValue().Arr.begin(); it != e.GetValue().Arr.end(); ++it)
+            for (std::vector<CGXDLMSVariant>::iterator it = e.GetValue().Arr().begin(); it != e.GetValue().Arr().end(); ++it)
             {
                 m_MulticastIPAddress.push_back((*it).ToInteger());
             }
@@ -551,13 +551,13 @@ int CGXDLMSIp4Setup::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEventArg& e
         m_IPOptions.clear();
         if (e.GetValue().vt == DLMS_DATA_TYPE_ARRAY)
         {
-            for (std::vector<CGXDLMSVariant>::iterator it = e.GetValue().Arr.begin(); it != e.GetValue().Arr.end(); ++it)
+            for (std::vector<CGXDLMSVariant>::iterator it = e.GetValue().Arr().begin(); it != e.GetValue().Arr().end(); ++it)
             {
                 CGXDLMSIp4SetupIpOption item;
-                item.SetType((IP_OPTION_TYPE)it->Arr[0].ToInteger());
-                item.SetLength(it->Arr[1].ToInteger());
+                item.SetType((IP_OPTION_TYPE)it->Arr()[0].ToInteger());
+                item.SetLength(it->Arr()[1].ToInteger());
                 CGXByteBuffer tmp;
-                tmp.Set(it->Arr[2].byteArr, it->Arr[2].size);
+                tmp.Set(it->Arr()[2].byteArr, it->Arr()[2].size);
                 item.SetData(tmp);
                 m_IPOptions.push_back(item);
             }
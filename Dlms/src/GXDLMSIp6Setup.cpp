@@ -393,7 +393,7 @@ int CGXDLMSIp6Setup::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEventArg& e
         m_UnicastIPAddress.clear();
         if (e.GetValue().vt == DLMS_DATA_TYPE_ARRAY)
         {
-            for (std::vector<CGXDLMSVariant>::iterator it = e.GetValue().Arr.begin(); it != e.GetValue().Arr.end(); ++it)
+            for (std::vector<CGXDLMSVariant>::iterator it = e.GetValue().Arr().begin(); it != e.GetValue().Arr().end(); ++it)
             {
                 if (it->GetSize() != 16)
                 {
@@ -408,7 +408,7 @@ int CGXDLMSIp6Setup::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEventArg& e
         m_MulticastIPAddress.clear();
         if (e.GetValue().vt == DLMS_DATA_TYPE_ARRAY)
         {
-            for (std::vector<CGXDLMSVariant>::iterator it = e.GetValue().Arr.begin(); it != e.GetValue().Arr.end(); ++it)
+            for (std::vector<CGXDLMSVariant>::iterator it = e.GetValue().Arr().begin(); it != e.GetValue().Arr().end(); ++it)
             {
                 if (it->GetSize() != 16)
                 {
@@ -423,7 +423,7 @@ int CGXDLMSIp6Setup::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEventArg& e
         m_GatewayIPAddress.clear();
         if (e.GetValue().vt == DLMS_DATA_TYPE_ARRAY)
         {
-            for (std::vector<CGXDLMSVariant>::iterator it = e.GetValue().Arr.begin(); it != e.GetValue().Arr.end(); ++it)
+            for (std::vector<CGXDLMSVariant>::iterator it = e.GetValue().Arr().begin(); it != e.GetValue().Arr().end(); ++it)
             {
                 if (it->GetSize() != 16)
                 {
@@ -458,12 +458,12 @@ int CGXDLMSIp6Setup::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEventArg& e
         m_NeighborDiscoverySetup.clear();
         if (e.GetValue().vt == DLMS_DATA_TYPE_ARRAY)
         {
-            for (std::vector<CGXDLMSVariant>::iterator it = e.GetValue().Arr.begin(); it != e.GetValue().Arr.end(); ++it)
+            for (std::vector<CGXDLMSVariant>::iterator it = e.GetValue().Arr().begin(); it != e.GetValue().Arr().end(); ++it)
             {
                 CGXNeighborDiscoverySetup* v = new CGXNeighborDiscoverySetup();
-                v->SetMaxRetry(it->Arr[0].ToInteger());
-                v->SetRetryWaitTime(it->Arr[1].ToInteger());
-                v->SetSendPeriod(it->Arr[2].ToInteger());
+                v->SetMaxRetry(it->Arr()[0].ToInteger());
+                v->SetRetryWaitTime(it->Arr()[1].ToInteger());
+                v->SetSendPeriod(it->Arr()[2].ToInteger());
                 m_NeighborDiscoverySetup.push_back(v);
             }
         }
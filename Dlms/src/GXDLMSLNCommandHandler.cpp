@@ -36,6 +36,7 @@
 #include "../include/GXDLMSLNCommandHandler.h"
 #include "../include/GXDLMS.h"
 #include "../include/GXDLMSValueEventCollection.h"
+#include "../include/GXDLMSArena.h"
 #include "../include/GXDLMSClient.h"
 #include "../include/GXDLMSObjectFactory.h"
 #include "../include/GXDLMSSecuritySetup.h"
@@ -91,7 +92,8 @@ int CGXDLMSLNCommandHandler::GetRequestNormal(
     unsigned char cipheredCommand)
 {
     int ret;
-    CGXByteBuffer bb;
+    CGXByteBuffer tmpBuffer;
+    CGXByteBuffer& bb = CGXDLMSArena::GetCurrentBuffer(tmpBuffer);
     DLMS_ERROR_CODE status = DLMS_ERROR_CODE_OK;
     settings.SetCount(0);
     settings.SetIndex(0);
@@ -167,7 +169,10 @@ int CGXDLMSLNCommandHandler::GetRequestNormal(
         GXHelpers::GetLogicalName(ln, name);
         obj = server->FindObject(ci, 0, name);
     }
-    CGXDLMSValueEventArg* e = new CGXDLMSValueEventArg(server, obj, attributeIndex, selector, parameters);
+    CGXDLMSValueEventArg* e = new CGXDLMSValueEventArg(server, obj, attributeIndex);
+    e->SetSelector(selector);
+    //Parameters are not needed after this.
+    e->GetParameters() = std::move(parameters);
     e->SetInvokeId(invokeID);
     arr.push_back(e);
     if (obj == NULL)
@@ -189,28 +194,48 @@ int CGXDLMSLNCommandHandler::GetRequestNormal(
                 e->SetRowToPdu(server->GetRowsToPdu((CGXDLMSProfileGeneric*)obj));
             }
             server->PreRead(arr);
-            if (!e->GetHandled())
-            {
-                settings.SetCount(e->GetRowEndIndex() - e->GetRowBeginIndex());
-                if ((ret = obj->GetValue(settings, *e)) != 0)
-                {
-                    status = DLMS_ERROR_CODE_HARDWARE_FAULT;
-                }
-                server->PostRead(arr);
-            }
-            if (status == 0)
+            //Encoded value is used if attribute is cached and object is not changed.
+            CGXByteBuffer* cached = NULL;
+            if (!e->GetHandled() && selection == 0)
             {
-                status = e->GetError();
+                cached = obj->GetCachedValue(attributeIndex);
             }
-            CGXDLMSVariant& value = e->GetValue();
-            if (e->IsByteArray() && value.vt == DLMS_DATA_TYPE_OCTET_STRING)
+            if (cached != NULL)
             {
-                // If byte array is added do not add type.
-                bb.Set(value.byteArr, value.GetSize());
+                bb.Set(cached->GetData(), cached->GetSize());
+                server->PostRead(arr);
             }
-            else if ((ret = CGXDLMS::AppendData(&settings, obj, attributeIndex, bb, value)) != 0)
+            else
             {
-                status = DLMS_ERROR_CODE_HARDWARE_FAULT;
+                if (!e->GetHandled())
+                {
+                    settings.SetCount(e->GetRowEndIndex() - e->GetRowBeginIndex());
+                    if ((ret = obj->GetValue(settings, *e)) != 0)
+                    {
+                        status = DLMS_ERROR_CODE_HARDWARE_FAULT;
+                    }
+                    server->PostRead(arr);
+                }
+                if (status == 0)
+                {
+                    status = e->GetError();
+                }
+                CGXDLMSVariant& value = e->GetValue();
+                if (e->IsByteArray() && value.vt == DLMS_DATA_TYPE_OCTET_STRING)
+                {
+                    // If byte array is added do not add type.
+                    bb.Set(value.byteArr, value.GetSize());
+                }
+                else if ((ret = CGXDLMS::AppendData(&settings, obj, attributeIndex, bb, value)) != 0)
+                {
+                    status = DLMS_ERROR_CODE_HARDWARE_FAULT;
+                }
+                //Only complete values are cached.
+                if (status == 0 && !e->GetHandled() && selection == 0 &&
+                    settings.GetCount() == settings.GetIndex() && obj->IsCached(attributeIndex))
+                {
+                    obj->SetCachedValue(attributeIndex, bb);
+                }
             }
         }
     }
@@ -453,12 +478,24 @@ int CGXDLMSLNCommandHandler::GetRequestWithList(
     pos = 0;
     for (std::vector<CGXDLMSValueEventArg*>::iterator it = list.begin(); it != list.end(); ++it)
     {
+        //Encoded value is used if attribute is cached and object is not changed.
+        bool cache = !(*it)->GetHandled() && (*it)->GetError() == 0 && (*it)->GetSelector() == 0 &&
+            (*it)->GetParameters().vt == DLMS_DATA_TYPE_NONE;
+        CGXByteBuffer* cached = cache ? (*it)->GetTarget()->GetCachedValue((*it)->GetIndex()) : NULL;
+        if (cached != NULL)
+        {
+            bb.SetUInt8(0);
+            bb.Set(cached->GetData(), cached->GetSize());
+            ++pos;
+            continue;
+        }
         if (!(*it)->GetHandled())
         {
             ret = (*it)->GetTarget()->GetValue(settings, *(*it));
         }
         CGXDLMSVariant& value = (*it)->GetValue();
         bb.SetUInt8((*it)->GetError());
+        unsigned long start = bb.GetSize();
         if ((*it)->IsByteArray() && value.vt == DLMS_DATA_TYPE_OCTET_STRING)
         {
             // If byte array is added do not add type.
@@ -468,6 +505,14 @@ int CGXDLMSLNCommandHandler::GetRequestWithList(
         {
             return DLMS_ERROR_CODE_HARDWARE_FAULT;
         }
+        //Only complete values are cached.
+        if (cache && ret == 0 && (*it)->GetError() == 0 && settings.GetIndex() == settings.GetCount() &&
+            (*it)->GetTarget()->IsCached((*it)->GetIndex()))
+        {
+            CGXByteBuffer tmp;
+            tmp.Set(&bb, start, bb.GetSize() - start);
+            (*it)->GetTarget()->SetCachedValue((*it)->GetIndex(), tmp);
+        }
         if (settings.GetIndex() != settings.GetCount())
         {
             if (server->m_Transaction != NULL)
@@ -723,6 +768,8 @@ int CGXDLMSLNCommandHandler::HandleSetRequestNormal(
                 server->m_Transaction = new CGXDLMSLongTransaction(list, DLMS_COMMAND_GET_REQUEST, data);
             }
             server->PreWrite(list);
+            //Server might change the target before it's written.
+            obj = e->GetTarget();
             if (e->GetError() != 0)
             {
                 p.SetStatus(e->GetError());
@@ -730,8 +777,14 @@ int CGXDLMSLNCommandHandler::HandleSetRequestNormal(
             else if (!e->GetHandled() && !p.IsMultipleBlocks())
             {
                 obj->SetValue(settings, *e);
+                obj->Changed();
                 server->PostWrite(list);
             }
+            else
+            {
+                //Value might be changed by the server.
+                obj->Changed();
+            }
         }
     }
     return ret;
@@ -818,6 +871,7 @@ int CGXDLMSLNCommandHandler::HanleSetRequestWithDataBlock(
             if (!target->GetHandled() && !p.IsMultipleBlocks())
             {
                 target->GetTarget()->SetValue(settings, *target);
+                target->GetTarget()->Changed();
                 server->PostWrite(server->m_Transaction->GetTargets());
             }
             if (server->m_Transaction != NULL)
@@ -1178,6 +1232,8 @@ int CGXDLMSLNCommandHandler::MethodRequestNormal(
         else
         {
             server->PreAction(arr);
+            //Server might change the target before it's invoked.
+            obj = e->GetTarget();
             if (!e->GetHandled())
             {
                 if ((ret = obj->Invoke(settings, *e)) != 0)
@@ -1186,6 +1242,8 @@ int CGXDLMSLNCommandHandler::MethodRequestNormal(
                 }
                 server->PostAction(arr);
             }
+            //Action might change attribute values.
+            obj->Changed();
             CGXDLMSVariant& actionReply = e->GetValue();
             // Set default action reply if not given.
             if (actionReply.vt != DLMS_DATA_TYPE_NONE && e->GetError() == DLMS_ERROR_CODE_OK)
@@ -1705,7 +1763,7 @@ int CGXDLMSLNCommandHandler::HandleEventNotification(
         {
             return ret;
         }
-        reply.SetTime(&value.dateTime.GetValue());
+        reply.SetTime(&value.dateTime().GetValue());
     }
 #ifndef DLMS_IGNORE_XML_TRANSLATOR
     if (reply.GetXml() != NULL)
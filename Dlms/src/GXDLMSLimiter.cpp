@@ -511,11 +511,11 @@ int CGXDLMSLimiter::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEventArg& e)
     }
     else if (e.GetIndex() == 2)
     {
-        DLMS_OBJECT_TYPE ot = (DLMS_OBJECT_TYPE)e.GetValue().Arr[0].ToInteger();
+        DLMS_OBJECT_TYPE ot = (DLMS_OBJECT_TYPE)e.GetValue().Arr()[0].ToInteger();
         std::string ln;
-        GXHelpers::GetLogicalName(e.GetValue().Arr[1].byteArr, ln);
+        GXHelpers::GetLogicalName(e.GetValue().Arr()[1].byteArr, ln);
         m_MonitoredValue = settings.GetObjects().FindByLN(ot, ln);
-        m_MonitoredAttributeIndex = e.GetValue().Arr[2].ToInteger();
+        m_MonitoredAttributeIndex = e.GetValue().Arr()[2].ToInteger();
     }
     else if (e.GetIndex() == 3)
     {
@@ -539,16 +539,16 @@ int CGXDLMSLimiter::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEventArg& e)
     }
     else if (e.GetIndex() == 8)
     {
-        m_EmergencyProfile.SetID(e.GetValue().Arr[0].ToInteger());
+        m_EmergencyProfile.SetID(e.GetValue().Arr()[0].ToInteger());
         CGXDLMSVariant tmp;
-        CGXDLMSClient::ChangeType(e.GetValue().Arr[1], DLMS_DATA_TYPE_DATETIME, tmp);
-        m_EmergencyProfile.SetActivationTime(tmp.dateTime);
-        m_EmergencyProfile.SetDuration(e.GetValue().Arr[2].ToInteger());
+        CGXDLMSClient::ChangeType(e.GetValue().Arr()[1], DLMS_DATA_TYPE_DATETIME, tmp);
+        m_EmergencyProfile.SetActivationTime(tmp.dateTime());
+        m_EmergencyProfile.SetDuration(e.GetValue().Arr()[2].ToInteger());
     }
     else if (e.GetIndex() == 9)
     {
         m_EmergencyProfileGroupIDs.clear();
-        for (std::vector<CGXDLMSVariant>::iterator it = e.GetValue().Arr.begin(); it != e.GetValue().Arr.end(); ++it)
+        for (std::vector<CGXDLMSVariant>::iterator it = e.GetValue().Arr().begin(); it != e.GetValue().Arr().end(); ++it)
         {
             m_EmergencyProfileGroupIDs.push_back((*it).ToInteger());
         }
@@ -560,12 +560,12 @@ int CGXDLMSLimiter::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEventArg& e)
     else if (e.GetIndex() == 11)
     {
         std::string ln;
-        GXHelpers::GetLogicalName(e.GetValue().Arr[0].Arr[0].byteArr, ln);
+        GXHelpers::GetLogicalName(e.GetValue().Arr()[0].Arr()[0].byteArr, ln);
         m_ActionOverThreshold.SetLogicalName(ln);
-        m_ActionOverThreshold.SetScriptSelector(e.GetValue().Arr[0].Arr[1].ToInteger());
-        GXHelpers::GetLogicalName(e.GetValue().Arr[1].Arr[0].byteArr, ln);
+        m_ActionOverThreshold.SetScriptSelector(e.GetValue().Arr()[0].Arr()[1].ToInteger());
+        GXHelpers::GetLogicalName(e.GetValue().Arr()[1].Arr()[0].byteArr, ln);
         m_ActionUnderThreshold.SetLogicalName(ln);
-        m_ActionUnderThreshold.SetScriptSelector(e.GetValue().Arr[1].Arr[1].ToInteger());
+        m_ActionUnderThreshold.SetScriptSelector(e.GetValue().Arr()[1].Arr()[1].ToInteger());
     }
     else
     {
@@ -571,10 +571,10 @@ int CGXDLMSMBusClient::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEventArg&
     {
         m_CaptureDefinition.clear();
         CGXDLMSVariant tmp1, tmp2;
-        for (std::vector<CGXDLMSVariant>::iterator it = e.GetValue().Arr.begin(); it != e.GetValue().Arr.end(); ++it)
+        for (std::vector<CGXDLMSVariant>::iterator it = e.GetValue().Arr().begin(); it != e.GetValue().Arr().end(); ++it)
         {
-            CGXDLMSClient::ChangeType((*it).Arr[0], DLMS_DATA_TYPE_OCTET_STRING, tmp1);
-            CGXDLMSClient::ChangeType((*it).Arr[1], DLMS_DATA_TYPE_OCTET_STRING, tmp2);
+            CGXDLMSClient::ChangeType((*it).Arr()[0], DLMS_DATA_TYPE_OCTET_STRING, tmp1);
+            CGXDLMSClient::ChangeType((*it).Arr()[1], DLMS_DATA_TYPE_OCTET_STRING, tmp2);
             m_CaptureDefinition.push_back(std::pair<std::string, std::string>(tmp1.ToString(), tmp2.ToString()));
         }
     }
@@ -237,13 +237,13 @@ int CGXDLMSMessageHandler::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEvent
         m_ListeningWindow.clear();
         if (e.GetValue().vt == DLMS_DATA_TYPE_ARRAY)
         {
-            for (std::vector<CGXDLMSVariant>::iterator it = e.GetValue().Arr.begin(); it != e.GetValue().Arr.end(); ++it)
+            for (std::vector<CGXDLMSVariant>::iterator it = e.GetValue().Arr().begin(); it != e.GetValue().Arr().end(); ++it)
             {
                 CGXDLMSVariant tmp;
-                CGXDLMSClient::ChangeType(it->Arr[0], DLMS_DATA_TYPE_DATETIME, tmp);
-                CGXDateTime start = tmp.dateTime;
-                CGXDLMSClient::ChangeType(it->Arr[1], DLMS_DATA_TYPE_DATETIME, tmp);
-                CGXDateTime end = tmp.dateTime;
+                CGXDLMSClient::ChangeType(it->Arr()[0], DLMS_DATA_TYPE_DATETIME, tmp);
+                CGXDateTime start = tmp.dateTime();
+                CGXDLMSClient::ChangeType(it->Arr()[1], DLMS_DATA_TYPE_DATETIME, tmp);
+                CGXDateTime end = tmp.dateTime();
                 m_ListeningWindow.push_back(std::pair<CGXDateTime, CGXDateTime>(start, end));
             }
         }
@@ -254,7 +254,7 @@ int CGXDLMSMessageHandler::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEvent
         m_AllowedSenders.clear();
         if (e.GetValue().vt == DLMS_DATA_TYPE_ARRAY)
         {
-            for (std::vector<CGXDLMSVariant>::iterator it = e.GetValue().Arr.begin(); it != e.GetValue().Arr.end(); ++it)
+            for (std::vector<CGXDLMSVariant>::iterator it = e.GetValue().Arr().begin(); it != e.GetValue().Arr().end(); ++it)
             {
                 std::string str;
                 str.append(reinterpret_cast<char const*>(it->byteArr), it->size);
@@ -267,9 +267,9 @@ int CGXDLMSMessageHandler::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEvent
         m_SendersAndActions.clear();
         if (e.GetValue().vt == DLMS_DATA_TYPE_ARRAY)
         {
-            for (std::vector<CGXDLMSVariant>::iterator it = e.GetValue().Arr.begin(); it != e.GetValue().Arr.end(); ++it)
+            for (std::vector<CGXDLMSVariant>::iterator it = e.GetValue().Arr().begin(); it != e.GetValue().Arr().end(); ++it)
             {
-                //std::string id = it->Arr[0].byteArr.ToString();
+                //std::string id = it->Arr()[0].byteArr.ToString();
                 //Object[] tmp2 = (Object[]) tmp[1];
                 /*TODO:
                 KeyValuePair<int, GXDLMSScriptAction> executed_script = new KeyValuePair<int, GXDLMSScriptAction>(Convert.ToInt32(tmp2[1], tmp2[2]));
@@ -282,23 +282,23 @@ int CGXDLMSModemConfiguration::SetValue(CGXDLMSSettings& settings, CGXDLMSValueE
     {
         m_InitialisationStrings.clear();
         int ret;
-        for (std::vector<CGXDLMSVariant>::iterator it = e.GetValue().Arr.begin(); it != e.GetValue().Arr.end(); ++it)
+        for (std::vector<CGXDLMSVariant>::iterator it = e.GetValue().Arr().begin(); it != e.GetValue().Arr().end(); ++it)
         {
             CGXDLMSModemInitialisation item;
             CGXDLMSVariant tmp;
-            if ((ret = CGXDLMSClient::ChangeType(it->Arr[0], DLMS_DATA_TYPE_STRING, tmp)) != DLMS_ERROR_CODE_OK)
+            if ((ret = CGXDLMSClient::ChangeType(it->Arr()[0], DLMS_DATA_TYPE_STRING, tmp)) != DLMS_ERROR_CODE_OK)
             {
                 return ret;
             }
             item.SetRequest(tmp.ToString());
-            if ((ret = CGXDLMSClient::ChangeType(it->Arr[1], DLMS_DATA_TYPE_STRING, tmp)) != DLMS_ERROR_CODE_OK)
+            if ((ret = CGXDLMSClient::ChangeType(it->Arr()[1], DLMS_DATA_TYPE_STRING, tmp)) != DLMS_ERROR_CODE_OK)
             {
                 return ret;
             }
             item.SetResponse(tmp.ToString());
-            if (it->Arr.size() > 2)
+            if (it->Arr().size() > 2)
             {
-                item.SetDelay(it->Arr[2].uiVal);
+                item.SetDelay(it->Arr()[2].uiVal);
             }
             m_InitialisationStrings.push_back(item);
         }
@@ -308,7 +308,7 @@ int CGXDLMSModemConfiguration::SetValue(CGXDLMSSettings& settings, CGXDLMSValueE
     {
         m_ModemProfile.clear();
         int ret;
-        for (std::vector<CGXDLMSVariant>::iterator it = e.GetValue().Arr.begin(); it != e.GetValue().Arr.end(); ++it)
+        for (std::vector<CGXDLMSVariant>::iterator it = e.GetValue().Arr().begin(); it != e.GetValue().Arr().end(); ++it)
         {
             CGXDLMSVariant tmp;
             if ((ret = CGXDLMSClient::ChangeType(*it, DLMS_DATA_TYPE_STRING, tmp)) != DLMS_ERROR_CODE_OK)
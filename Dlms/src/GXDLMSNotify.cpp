@@ -216,23 +216,23 @@ int CGXDLMSNotify::ParsePush(std::vector<CGXDLMSVariant>& data, std::vector<std:
     DLMS_DATA_TYPE dt;
     CGXDLMSVariant tmp, value;
     CGXDLMSVariant ln;
-    for (std::vector<CGXDLMSVariant>::iterator it = data.at(0).Arr.begin(); it != data.at(0).Arr.end(); ++it)
+    for (std::vector<CGXDLMSVariant>::iterator it = data.at(0).Arr().begin(); it != data.at(0).Arr().end(); ++it)
     {
-        int classID = it->Arr[0].ToInteger() & 0xFFFF;
+        int classID = it->Arr()[0].ToInteger() & 0xFFFF;
         if (classID > 0)
         {
             ln.Clear();
-            if ((ret = CGXDLMSClient::ChangeType(it->Arr[1], DLMS_DATA_TYPE_OCTET_STRING, ln)) != 0)
+            if ((ret = CGXDLMSClient::ChangeType(it->Arr()[1], DLMS_DATA_TYPE_OCTET_STRING, ln)) != 0)
             {
                 return ret;
             }
-            obj = GetObjects().FindByLN((DLMS_OBJECT_TYPE)classID, ln.strVal);
+            obj = GetObjects().FindByLN((DLMS_OBJECT_TYPE)classID, ln.strVal());
             if (obj == NULL)
             {
-                obj = CGXDLMSObjectFactory::CreateObject((DLMS_OBJECT_TYPE)classID, ln.strVal);
+                obj = CGXDLMSObjectFactory::CreateObject((DLMS_OBJECT_TYPE)classID, ln.strVal());
                 GetObjects().push_back(obj);
             }
-            items.push_back(std::pair<CGXDLMSObject*, unsigned char>(obj, it->Arr[2].ToInteger()));
+            items.push_back(std::pair<CGXDLMSObject*, unsigned char>(obj, it->Arr()[2].ToInteger()));
         }
     }
     pos = 0;
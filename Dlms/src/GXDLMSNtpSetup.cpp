@@ -315,14 +315,14 @@ int CGXDLMSNtpSetup::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEventArg& e
     case 6:
     {
         m_Keys.clear();
-        for (std::vector<CGXDLMSVariant>::iterator it = e.GetValue().Arr.begin(); it != e.GetValue().Arr.end(); ++it)
+        for (std::vector<CGXDLMSVariant>::iterator it = e.GetValue().Arr().begin(); it != e.GetValue().Arr().end(); ++it)
         {
             CGXByteBuffer tmp;
-            if ((ret = tmp.Set(it->Arr.at(1).byteArr, it->Arr.at(1).size)) != 0)
+            if ((ret = tmp.Set(it->Arr().at(1).byteArr, it->Arr().at(1).size)) != 0)
             {
                 break;
             }
-            m_Keys[it->Arr.at(0).ulVal] = tmp;
+            m_Keys[it->Arr().at(0).ulVal] = tmp;
         }
         break;
     }
@@ -378,8 +378,8 @@ int CGXDLMSNtpSetup::Invoke(CGXDLMSSettings& settings, CGXDLMSValueEventArg& e)
         {
             return DLMS_ERROR_CODE_INCONSISTENT_CLASS_OR_OBJECT;
         }
-        bb.Set(e.GetParameters().Arr[1].byteArr, e.GetParameters().Arr[1].GetSize());
-        m_Keys[e.GetParameters().Arr[0].ulVal] = bb;
+        bb.Set(e.GetParameters().Arr()[1].byteArr, e.GetParameters().Arr()[1].GetSize());
+        m_Keys[e.GetParameters().Arr()[0].ulVal] = bb;
     }
     else if (e.GetIndex() == 3)
     {
@@ -83,7 +83,7 @@ int CGXDLMSObject::SetLogicalName(CGXDLMSObject * target, CGXDLMSVariant& value)
 {
     if (value.vt == DLMS_DATA_TYPE_STRING)
     {
-        return GXHelpers::SetLogicalName(value.strVal.c_str(), target->m_LN);
+        return GXHelpers::SetLogicalName(value.strVal().c_str(), target->m_LN);
     }
     if (value.vt != DLMS_DATA_TYPE_OCTET_STRING || value.GetSize() != 6)
     {
@@ -103,6 +103,7 @@ void CGXDLMSObject::Initialize(short sn, unsigned short class_id, unsigned char
     m_SN = sn;
     m_ObjectType = (DLMS_OBJECT_TYPE)class_id;
     m_Version = version;
+    m_ChangeCount = 0;
     if (ln == NULL)
     {
         memset(m_LN, 0, 6);
@@ -136,7 +137,7 @@ CGXDLMSVariant CGXDLMSObject::GetName()
         return CGXDLMSVariant(m_SN);
     }
     CGXDLMSVariant ln;
-    GXHelpers::GetLogicalName(m_LN, ln.strVal);
+    GXHelpers::GetLogicalName(m_LN, ln.strVal());
     ln.vt = DLMS_DATA_TYPE_STRING;
     return ln;
 }
@@ -150,7 +151,7 @@ int CGXDLMSObject::SetName(CGXDLMSVariant& value)
     }
     if (value.vt == DLMS_DATA_TYPE_STRING)
     {
-        GXHelpers::SetLogicalName(value.strVal.c_str(), m_LN);
+        GXHelpers::SetLogicalName(value.strVal().c_str(), m_LN);
         return DLMS_ERROR_CODE_OK;
     }
     return DLMS_ERROR_CODE_INVALID_PARAMETER;
@@ -298,6 +299,66 @@ void CGXDLMSObject::GetLogicalName(std::string& ln)
     GXHelpers::GetLogicalName(m_LN, ln);
 }
 
+CGXObisCode CGXDLMSObject::GetObisCode()
+{
+    return CGXObisCode(m_LN);
+}
+
+void CGXDLMSObject::SetObisCode(const CGXObisCode& value)
+{
+    value.GetBytes(m_LN);
+    Changed();
+}
+
+unsigned long CGXDLMSObject::GetChangeCount()
+{
+    return m_ChangeCount;
+}
+
+void CGXDLMSObject::Changed()
+{
+    ++m_ChangeCount;
+}
+
+bool CGXDLMSObject::IsCached(int index)
+{
+    return m_EncodedValues.find(index) != m_EncodedValues.end();
+}
+
+void CGXDLMSObject::SetCached(int index, bool value)
+{
+    if (!value)
+    {
+        m_EncodedValues.erase(index);
+    }
+    else if (!IsCached(index))
+    {
+        //Value is encoded when it's read next time.
+        m_EncodedValues[index].first = m_ChangeCount - 1;
+    }
+}
+
+CGXByteBuffer* CGXDLMSObject::GetCachedValue(int index)
+{
+    std::map<int, std::pair<unsigned long, CGXByteBuffer> >::iterator it = m_EncodedValues.find(index);
+    if (it == m_EncodedValues.end() || it->second.first != m_ChangeCount)
+    {
+        return NULL;
+    }
+    return &it->second.second;
+}
+
+void CGXDLMSObject::SetCachedValue(int index, CGXByteBuffer& value)
+{
+    std::map<int, std::pair<unsigned long, CGXByteBuffer> >::iterator it = m_EncodedValues.find(index);
+    if (it != m_EncodedValues.end())
+    {
+        it->second.first = m_ChangeCount;
+        it->second.second.SetSize(0);
+        it->second.second.Set(value.GetData(), value.GetSize());
+    }
+}
+
 void CGXDLMSObject::SetVersion(unsigned short value)
 {
     m_Version = value;
@@ -40,35 +40,102 @@
 #include "../include/GXXmlReader.h"
 #include "../include/GXDLMSObjectFactory.h"
 
+CGXDLMSObjectCollection::CGXDLMSObjectCollection()
+{
+    m_Indexed = false;
+    m_IndexedCount = 0;
+}
+
 CGXDLMSObjectCollection::~CGXDLMSObjectCollection()
 {
 }
 
+/////////////////////////////////////////////////////////////////////////////
+//Class id is saved to the upper bits of the logical name.
+/////////////////////////////////////////////////////////////////////////////
+static unsigned long long GetLNKey(DLMS_OBJECT_TYPE type, const CGXObisCode& ln)
+{
+    return ((unsigned long long)(unsigned short)type << 48) | ln.GetValue();
+}
+
+void CGXDLMSObjectCollection::UpdateIndex()
+{
+    if (m_Indexed && m_IndexedCount == size())
+    {
+        return;
+    }
+    m_LNIndex.clear();
+    m_AllLNIndex.clear();
+    m_SNIndex.clear();
+    m_LNIndex.reserve(size());
+    m_AllLNIndex.reserve(size());
+    m_SNIndex.reserve(size());
+    for (size_t pos = 0; pos != size(); ++pos)
+    {
+        //Existing item is not replaced so the first object is found
+        //like when objects are searched in order.
+        CGXDLMSObject* obj = at(pos);
+        CGXObisCode ln(obj->m_LN);
+        m_LNIndex.emplace(GetLNKey(obj->GetObjectType(), ln), pos);
+        m_AllLNIndex.emplace(ln.GetValue(), pos);
+        m_SNIndex.emplace(obj->m_SN, pos);
+    }
+    m_Indexed = true;
+    m_IndexedCount = size();
+}
+
 CGXDLMSObject* CGXDLMSObjectCollection::FindByLN(DLMS_OBJECT_TYPE type, std::string& ln)
 {
     unsigned char tmp[6];
     GXHelpers::SetLogicalName(ln.c_str(), tmp);
-    for (CGXDLMSObjectCollection::iterator it = this->begin(); it != end(); ++it)
+    return FindByLN(type, tmp);
+}
+
+CGXDLMSObject* CGXDLMSObjectCollection::FindByLN(DLMS_OBJECT_TYPE type, unsigned char ln[6])
+{
+    return FindByLN(type, CGXObisCode(ln));
+}
+
+CGXDLMSObject* CGXDLMSObjectCollection::FindByLN(DLMS_OBJECT_TYPE type, const CGXObisCode& ln)
+{
+    if (!ln.IsValid())
     {
-        if ((type == DLMS_OBJECT_TYPE_ALL || (*it)->GetObjectType() == type))
+        return NULL;
+    }
+    UpdateIndex();
+    std::unordered_map<unsigned long long, size_t>::iterator found;
+    if (type == DLMS_OBJECT_TYPE_ALL)
+    {
+        found = m_AllLNIndex.find(ln.GetValue());
+        if (found != m_AllLNIndex.end() && found->second < size())
         {
-            if (memcmp(tmp, (*it)->m_LN, 6) == 0)
+            CGXDLMSObject* obj = at(found->second);
+            if (CGXObisCode(obj->m_LN) == ln)
             {
-                return *it;
+                return obj;
             }
         }
     }
-    return NULL;
-}
-
-CGXDLMSObject* CGXDLMSObjectCollection::FindByLN(DLMS_OBJECT_TYPE type, unsigned char ln[6])
-{
+    else
+    {
+        found = m_LNIndex.find(GetLNKey(type, ln));
+        if (found != m_LNIndex.end() && found->second < size())
+        {
+            CGXDLMSObject* obj = at(found->second);
+            if (obj->GetObjectType() == type && CGXObisCode(obj->m_LN) == ln)
+            {
+                return obj;
+            }
+        }
+    }
+    //Logical name is changed or objects are moved after index was built.
     for (CGXDLMSObjectCollection::iterator it = this->begin(); it != end(); ++it)
     {
         if (type == DLMS_OBJECT_TYPE_ALL || (*it)->GetObjectType() == type)
         {
-            if (memcmp(ln, (*it)->m_LN, 6) == 0)
+            if (CGXObisCode((*it)->m_LN) == ln)
             {
+                m_Indexed = false;
                 return *it;
             }
         }
@@ -78,10 +145,18 @@ CGXDLMSObject* CGXDLMSObjectCollection::FindByLN(DLMS_OBJECT_TYPE type, unsigned
 
 CGXDLMSObject* CGXDLMSObjectCollection::FindBySN(unsigned short sn)
 {
+    UpdateIndex();
+    std::unordered_map<unsigned short, size_t>::iterator found = m_SNIndex.find(sn);
+    if (found != m_SNIndex.end() && found->second < size() && at(found->second)->GetShortName() == sn)
+    {
+        return at(found->second);
+    }
+    //Short name is changed or objects are moved after index was built.
     for (CGXDLMSObjectCollection::iterator it = begin(); it != end(); ++it)
     {
         if ((*it)->GetShortName() == sn)
         {
+            m_Indexed = false;
             return *it;
         }
     }
@@ -104,13 +179,31 @@ void CGXDLMSObjectCollection::push_back(CGXDLMSObject* item)
     std::vector<CGXDLMSObject*>::push_back(item);
 }
 
+CGXDLMSObjectCollection::iterator CGXDLMSObjectCollection::erase(const_iterator pos)
+{
+    m_Indexed = false;
+    return std::vector<CGXDLMSObject*>::erase(pos);
+}
+
+CGXDLMSObjectCollection::iterator CGXDLMSObjectCollection::erase(const_iterator first, const_iterator last)
+{
+    m_Indexed = false;
+    return std::vector<CGXDLMSObject*>::erase(first, last);
+}
+
+void CGXDLMSObjectCollection::clear()
+{
+    m_Indexed = false;
+    std::vector<CGXDLMSObject*>::clear();
+}
+
 void CGXDLMSObjectCollection::Free()
 {
     for (CGXDLMSObjectCollection::iterator it = begin(); it != end(); ++it)
     {
         delete (*it);
     }
-    std::vector<CGXDLMSObject*>::clear();
+    clear();
 }
 
 std::string CGXDLMSObjectCollection::ToString()
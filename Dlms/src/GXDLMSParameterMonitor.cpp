@@ -283,23 +283,23 @@ int CGXDLMSParameterMonitor::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEve
         return SetLogicalName(this, e.GetValue());
     case 2:
     {
-        if (e.GetValue().Arr.size() != 4)
+        if (e.GetValue().Arr().size() != 4)
         {
             return DLMS_ERROR_CODE_INVALID_PARAMETER;
         }
         m_ChangedParameter.Clear();
-        DLMS_OBJECT_TYPE type = (DLMS_OBJECT_TYPE)e.GetValue().Arr[0].ToInteger();
-        unsigned char* ln = e.GetValue().Arr[1].byteArr;
+        DLMS_OBJECT_TYPE type = (DLMS_OBJECT_TYPE)e.GetValue().Arr()[0].ToInteger();
+        unsigned char* ln = e.GetValue().Arr()[1].byteArr;
         m_ChangedParameter.SetTarget(settings.GetObjects().FindByLN(type, ln));
         if (m_ChangedParameter.GetTarget() == NULL)
         {
             CGXDLMSObject* tmp = CGXDLMSObjectFactory::CreateObject(type);
             settings.AddAllocateObject(tmp);
             m_ChangedParameter.SetTarget(tmp);
-            CGXDLMSObject::SetLogicalName(m_ChangedParameter.GetTarget(), e.GetValue().Arr[1]);
+            CGXDLMSObject::SetLogicalName(m_ChangedParameter.GetTarget(), e.GetValue().Arr()[1]);
         }
-        m_ChangedParameter.SetAttributeIndex(e.GetValue().Arr[2].ToInteger());
-        m_ChangedParameter.SetValue(e.GetValue().Arr[3]);
+        m_ChangedParameter.SetAttributeIndex(e.GetValue().Arr()[2].ToInteger());
+        m_ChangedParameter.SetValue(e.GetValue().Arr()[3]);
         break;
     }
     case 3:
@@ -312,11 +312,11 @@ int CGXDLMSParameterMonitor::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEve
             {
                 return ret;
             }
-            m_CaptureTime = tmp.dateTime;
+            m_CaptureTime = tmp.dateTime();
         }
         else
         {
-            m_CaptureTime = e.GetValue().dateTime;
+            m_CaptureTime = e.GetValue().dateTime();
         }
         break;
     case 4:
@@ -326,14 +326,14 @@ int CGXDLMSParameterMonitor::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEve
             delete (*it);
         }
         m_Parameters.clear();
-        for (std::vector<CGXDLMSVariant>::iterator it = e.GetValue().Arr.begin(); it != e.GetValue().Arr.end(); ++it)
+        for (std::vector<CGXDLMSVariant>::iterator it = e.GetValue().Arr().begin(); it != e.GetValue().Arr().end(); ++it)
         {
-            if (it->Arr.size() != 3)
+            if (it->Arr().size() != 3)
             {
                 return DLMS_ERROR_CODE_INVALID_PARAMETER;
             }
-            DLMS_OBJECT_TYPE type = (DLMS_OBJECT_TYPE)it->Arr[0].ToInteger();
-            unsigned char* ln = it->Arr[1].byteArr;
+            DLMS_OBJECT_TYPE type = (DLMS_OBJECT_TYPE)it->Arr()[0].ToInteger();
+            unsigned char* ln = it->Arr()[1].byteArr;
             CGXDLMSTarget* pObj = new CGXDLMSTarget();
             pObj->SetTarget(settings.GetObjects().FindByLN(type, ln));
             if (pObj->GetTarget() == NULL)
@@ -341,9 +341,9 @@ int CGXDLMSParameterMonitor::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEve
                 CGXDLMSObject* tmp = CGXDLMSObjectFactory::CreateObject(type);
                 settings.AddAllocateObject(tmp);
                 pObj->SetTarget(tmp);
-                CGXDLMSObject::SetLogicalName(pObj->GetTarget(), it->Arr[1]);
+                CGXDLMSObject::SetLogicalName(pObj->GetTarget(), it->Arr()[1]);
             }
-            pObj->SetAttributeIndex(it->Arr[2].ToInteger());
+            pObj->SetAttributeIndex(it->Arr()[2].ToInteger());
             m_Parameters.push_back(pObj);
         }
         break;
@@ -346,12 +346,12 @@ int CGXDLMSPppSetup::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEventArg& e
         m_LCPOptions.clear();
         if (e.GetValue().vt == DLMS_DATA_TYPE_ARRAY)
         {
-            for (std::vector<CGXDLMSVariant>::iterator item = e.GetValue().Arr.begin(); item != e.GetValue().Arr.end(); ++item)
+            for (std::vector<CGXDLMSVariant>::iterator item = e.GetValue().Arr().begin(); item != e.GetValue().Arr().end(); ++item)
             {
                 CGXDLMSPppSetupLcpOption it;
-                it.SetType((PPP_SETUP_LCP_OPTION_TYPE)(*item).Arr[0].ToInteger());
-                it.SetLength((*item).Arr[1].ToInteger());
-                it.SetData((*item).Arr[2]);
+                it.SetType((PPP_SETUP_LCP_OPTION_TYPE)(*item).Arr()[0].ToInteger());
+                it.SetLength((*item).Arr()[1].ToInteger());
+                it.SetData((*item).Arr()[2]);
                 m_LCPOptions.push_back(it);
             }
         }
@@ -361,12 +361,12 @@ int CGXDLMSPppSetup::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEventArg& e
         m_IPCPOptions.clear();
         if (e.GetValue().vt == DLMS_DATA_TYPE_ARRAY)
         {
-            for (std::vector<CGXDLMSVariant>::iterator item = e.GetValue().Arr.begin(); item != e.GetValue().Arr.end(); ++item)
+            for (std::vector<CGXDLMSVariant>::iterator item = e.GetValue().Arr().begin(); item != e.GetValue().Arr().end(); ++item)
             {
                 CGXDLMSPppSetupIPCPOption it;
-                it.SetType((PPP_SETUP_IPCP_OPTION_TYPE)(*item).Arr[0].ToInteger());
-                it.SetLength((*item).Arr[1].ToInteger());
-                it.SetData((*item).Arr[2]);
+                it.SetType((PPP_SETUP_IPCP_OPTION_TYPE)(*item).Arr()[0].ToInteger());
+                it.SetLength((*item).Arr()[1].ToInteger());
+                it.SetData((*item).Arr()[2]);
                 m_IPCPOptions.push_back(it);
             }
         }
@@ -375,12 +375,12 @@ int CGXDLMSPppSetup::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEventArg& e
     {
         m_UserName.Clear();
         m_Password.Clear();
-        if (e.GetValue().Arr.size() == 2)
+        if (e.GetValue().Arr().size() == 2)
         {
-            m_UserName.Set(e.GetValue().Arr[0].byteArr, e.GetValue().Arr[0].size);
-            m_Password.Set(e.GetValue().Arr[1].byteArr, e.GetValue().Arr[1].size);
+            m_UserName.Set(e.GetValue().Arr()[0].byteArr, e.GetValue().Arr()[0].size);
+            m_Password.Set(e.GetValue().Arr()[1].byteArr, e.GetValue().Arr()[1].size);
         }
-        else if (e.GetValue().Arr.size() != 0)
+        else if (e.GetValue().Arr().size() != 0)
         {
             return DLMS_ERROR_CODE_INVALID_PARAMETER;
         }
@@ -485,8 +485,8 @@ int CGXDLMSPrimeNbOfdmPlcMacNetworkAdministrationData::SetMulticastEntry(std::ve
     for (std::vector<CGXDLMSVariant>::iterator it = list.begin(); it != list.end(); ++it)
     {
         CGXMacMulticastEntry* v = new CGXMacMulticastEntry();
-        v->SetId(it->Arr.at(0).ToInteger());
-        v->SetMembers(it->Arr.at(1).ToInteger());
+        v->SetId(it->Arr().at(0).ToInteger());
+        v->SetMembers(it->Arr().at(1).ToInteger());
         m_MulticastEntries.push_back(v);
     }
     return ret;
@@ -509,13 +509,13 @@ int CGXDLMSPrimeNbOfdmPlcMacNetworkAdministrationData::SetDirectTable(std::vecto
     {
         CGXByteBuffer tmp;
         CGXMacDirectTable* v = new CGXMacDirectTable();
-        v->SetSourceSId(it->Arr.at(0).ToInteger());
-        v->SetSourceLnId(it->Arr.at(1).ToInteger());
-        v->SetSourceLcId(it->Arr.at(2).ToInteger());
-        v->SetDestinationSId(it->Arr.at(3).ToInteger());
-        v->SetDestinationLnId(it->Arr.at(4).ToInteger());
-        v->SetDestinationLcId(it->Arr.at(5).ToInteger());
-        tmp.Set(it->Arr.at(6).byteArr, it->Arr.at(6).GetSize());
+        v->SetSourceSId(it->Arr().at(0).ToInteger());
+        v->SetSourceLnId(it->Arr().at(1).ToInteger());
+        v->SetSourceLcId(it->Arr().at(2).ToInteger());
+        v->SetDestinationSId(it->Arr().at(3).ToInteger());
+        v->SetDestinationLnId(it->Arr().at(4).ToInteger());
+        v->SetDestinationLcId(it->Arr().at(5).ToInteger());
+        tmp.Set(it->Arr().at(6).byteArr, it->Arr().at(6).GetSize());
         v->SetDid(tmp);
         m_DirectTable.push_back(v);
     }
@@ -528,13 +528,13 @@ int CGXDLMSPrimeNbOfdmPlcMacNetworkAdministrationData::SetAvailableSwitches(std:
     for (std::vector<CGXDLMSVariant>::iterator it = list.begin(); it != list.end(); ++it)
     {
         CGXByteBuffer tmp;
-        tmp.Set(it->Arr.at(0).byteArr, it->Arr.at(0).GetSize());
+        tmp.Set(it->Arr().at(0).byteArr, it->Arr().at(0).GetSize());
         CGXMacAvailableSwitch* v = new CGXMacAvailableSwitch();
         v->SetSna(tmp);
-        v->SetLsId(it->Arr.at(1).ToInteger());
-        v->SetLevel(it->Arr.at(2).ToInteger());
-        v->SetRxLevel(it->Arr.at(3).ToInteger());
-        v->SetRxSnr(it->Arr.at(4).ToInteger());
+        v->SetLsId(it->Arr().at(1).ToInteger());
+        v->SetLevel(it->Arr().at(2).ToInteger());
+        v->SetRxLevel(it->Arr().at(3).ToInteger());
+        v->SetRxSnr(it->Arr().at(4).ToInteger());
         m_AvailableSwitches.push_back(v);
     }
     return 0;
@@ -546,17 +546,17 @@ int CGXDLMSPrimeNbOfdmPlcMacNetworkAdministrationData::SetCommunications(std::ve
     for (std::vector<CGXDLMSVariant>::iterator it = list.begin(); it != list.end(); ++it)
     {
         CGXByteBuffer tmp;
-        tmp.Set(it->Arr.at(0).byteArr, it->Arr.at(0).GetSize());
+        tmp.Set(it->Arr().at(0).byteArr, it->Arr().at(0).GetSize());
         CGXMacPhyCommunication* v = new CGXMacPhyCommunication();
         v->SetEui(tmp);
-        v->SetTxPower(it->Arr.at(1).ToInteger());
-        v->SetTxCoding(it->Arr.at(2).ToInteger());
-        v->SetRxCoding(it->Arr.at(3).ToInteger());
-        v->SetRxLvl(it->Arr.at(4).ToInteger());
-        v->SetSnr(it->Arr.at(5).ToInteger());
-        v->SetTxPowerModified(it->Arr.at(6).ToInteger());
-        v->SetTxCodingModified(it->Arr.at(7).ToInteger());
-        v->SetRxCodingModified(it->Arr.at(8).ToInteger());
+        v->SetTxPower(it->Arr().at(1).ToInteger());
+        v->SetTxCoding(it->Arr().at(2).ToInteger());
+        v->SetRxCoding(it->Arr().at(3).ToInteger());
+        v->SetRxLvl(it->Arr().at(4).ToInteger());
+        v->SetSnr(it->Arr().at(5).ToInteger());
+        v->SetTxPowerModified(it->Arr().at(6).ToInteger());
+        v->SetTxCodingModified(it->Arr().at(7).ToInteger());
+        v->SetRxCodingModified(it->Arr().at(8).ToInteger());
         m_Communications.push_back(v);
     }
     return 0;
@@ -572,19 +572,19 @@ int CGXDLMSPrimeNbOfdmPlcMacNetworkAdministrationData::SetValue(CGXDLMSSettings&
         ret = SetLogicalName(this, e.GetValue());
         break;
     case 2:
-        ret = SetMulticastEntry(e.GetValue().Arr);
+        ret = SetMulticastEntry(e.GetValue().Arr());
         break;
     case 3:
-        ret = SetSwitchTable(e.GetValue().Arr);
+        ret = SetSwitchTable(e.GetValue().Arr());
         break;
     case 4:
-        ret = SetDirectTable(e.GetValue().Arr);
+        ret = SetDirectTable(e.GetValue().Arr());
         break;
     case 5:
-        ret = SetAvailableSwitches(e.GetValue().Arr);
+        ret = SetAvailableSwitches(e.GetValue().Arr());
         break;
     case 6:
-        ret = SetCommunications(e.GetValue().Arr);
+        ret = SetCommunications(e.GetValue().Arr());
         break;
     default:
         ret = DLMS_ERROR_CODE_INVALID_PARAMETER;
@@ -53,6 +53,7 @@
 #include "../include/GXDLMSObjectFactory.h"
 #include "../include/GXDLMSDemandRegister.h"
 #include "../include/GXDLMSServer.h"
+#include "../include/GXDLMSArena.h"
 
 #ifndef DLMS_IGNORE_PROFILE_GENERIC
 CGXDLMSProfileGeneric::~CGXDLMSProfileGeneric()
@@ -68,7 +69,7 @@ CGXDLMSProfileGeneric::~CGXDLMSProfileGeneric()
 
 int CGXDLMSProfileGeneric::GetSelectedColumns(
     int selector,
-    CGXDLMSVariant& parameters,
+    const CGXDLMSVariant& parameters,
     std::vector<std::pair<CGXDLMSObject*, CGXDLMSCaptureObject*> >& columns)
 {
     columns.clear();
@@ -80,24 +81,38 @@ int CGXDLMSProfileGeneric::GetSelectedColumns(
     }
     else if (selector == 1)
     {
-        return CGXDLMSProfileGeneric::GetSelectedColumns(parameters.Arr.at(3).Arr, columns);
+        if (parameters.Arr().size() > 3)
+        {
+            return CGXDLMSProfileGeneric::GetSelectedColumns(parameters.Arr()[3].Arr(), columns);
+        }
+        // Return all rows.
+        columns.insert(columns.end(), m_CaptureObjects.begin(), m_CaptureObjects.end());
+        return 0;
     }
     else if (selector == 2)
     {
         int colStart = 1;
         int colCount = 0;
-        if (parameters.Arr.size() > 2)
+        if (parameters.Arr().size() > 2)
         {
-            colStart = parameters.Arr[2].ToInteger();
+            colStart = parameters.Arr()[2].ToInteger();
         }
-        if (parameters.Arr.size() > 3)
+        if (parameters.Arr().size() > 3)
         {
-            colCount = parameters.Arr[3].ToInteger();
+            colCount = parameters.Arr()[3].ToInteger();
         }
-        else if (colStart != 1)
+        if (colCount == 0 && colStart != 1)
         {
             colCount = (int)m_CaptureObjects.size();
         }
+        if (colStart < 1 || colStart > (int)m_CaptureObjects.size())
+        {
+            return DLMS_ERROR_CODE_INVALID_PARAMETER;
+        }
+        if (colCount > (int)m_CaptureObjects.size() - colStart + 1)
+        {
+            colCount = (int)m_CaptureObjects.size() - colStart + 1;
+        }
         if (colStart != 1 || colCount != 0)
         {
             // Return all rows.
@@ -216,11 +231,96 @@ int CGXDLMSProfileGeneric::GetData(
     }
     if (e.GetRowEndIndex() != 0)
     {
-        e.SetRowBeginIndex(e.GetRowBeginIndex() + (unsigned short)table.size());
+        e.SetRowBeginIndex(e.GetRowBeginIndex() + (unsigned long)table.size());
     }
     return DLMS_ERROR_CODE_OK;
 }
 
+int CGXDLMSProfileGeneric::GetCursorData(
+    CGXDLMSSettings& settings,
+    CGXDLMSValueEventArg& e,
+    CGXByteBuffer& data)
+{
+    unsigned long count = 0;
+    if (e.GetRowEndIndex() > e.GetRowBeginIndex())
+    {
+        count = e.GetRowEndIndex() - e.GetRowBeginIndex();
+    }
+    if (settings.GetIndex() == 0)
+    {
+        data.SetUInt8(DLMS_DATA_TYPE_ARRAY);
+        GXHelpers::SetObjectCount(count, data);
+    }
+    std::vector<DLMS_DATA_TYPE> types;
+    types.reserve(m_CaptureObjects.size());
+    DLMS_DATA_TYPE type;
+    int ret;
+    for (std::vector<std::pair<CGXDLMSObject*, CGXDLMSCaptureObject*> >::iterator it = m_CaptureObjects.begin();
+        it != m_CaptureObjects.end(); ++it)
+    {
+        if ((ret = (*it).first->GetDataType((*it).second->GetAttributeIndex(), type)) != 0)
+        {
+            return ret;
+        }
+        types.push_back(type);
+    }
+    // Only selected columns are read from the cursor.
+    std::vector<std::pair<CGXDLMSObject*, CGXDLMSCaptureObject*> > columns;
+    if (e.GetParameters().vt != DLMS_DATA_TYPE_NONE &&
+        (ret = GetSelectedColumns(e.GetSelector(), e.GetParameters(), columns)) != 0)
+    {
+        return ret;
+    }
+    std::vector<int> indexes;
+    indexes.reserve(m_CaptureObjects.size());
+    for (std::vector<std::pair<CGXDLMSObject*, CGXDLMSCaptureObject*> >::iterator it = columns.begin();
+        it != columns.end(); ++it)
+    {
+        for (unsigned int pos = 0; pos != m_CaptureObjects.size(); ++pos)
+        {
+            if (m_CaptureObjects[pos].second == it->second)
+            {
+                indexes.push_back(pos);
+                break;
+            }
+        }
+    }
+    if (indexes.empty())
+    {
+        for (unsigned int pos = 0; pos != m_CaptureObjects.size(); ++pos)
+        {
+            indexes.push_back(pos);
+        }
+    }
+    // Rows to PDU is counted from all the columns. If only some columns are
+    // selected rows are added until PDU is full or block transfer is not started.
+    unsigned long rows;
+    while (count != 0 && data.GetSize() < settings.GetMaxPduSize())
+    {
+        unsigned long cnt = count;
+        // Read only rows that can fit to one PDU.
+        if (e.GetRowToPdu() != 0 && cnt > e.GetRowToPdu())
+        {
+            cnt = e.GetRowToPdu();
+        }
+        rows = 0;
+        ret = m_Cursor->GetRows(settings, types, indexes, e.GetRowBeginIndex(), cnt, data, rows);
+        settings.SetIndex(settings.GetIndex() + rows);
+        e.SetRowBeginIndex(e.GetRowBeginIndex() + rows);
+        if (ret != 0)
+        {
+            return ret;
+        }
+        // Array count is already sent so all the rows must be found.
+        if (rows != cnt)
+        {
+            return DLMS_ERROR_CODE_DATA_BLOCK_UNAVAILABLE;
+        }
+        count -= rows;
+    }
+    return 0;
+}
+
 /*
 * Add new capture object (column) to the profile generic.
 */
@@ -254,18 +354,18 @@ int CGXDLMSProfileGeneric::AddCaptureObject(CGXDLMSObject* pObj, int attributeIn
      * @return Selected columns.
      */
 int CGXDLMSProfileGeneric::GetSelectedColumns(
-    std::vector<CGXDLMSVariant>& cols,
+    const std::vector<CGXDLMSVariant>& cols,
     std::vector<std::pair<CGXDLMSObject*, CGXDLMSCaptureObject*> >& columns)
 {
     int dataIndex;
     unsigned char attributeIndex;
     std::string ln, ln2;
-    for (std::vector<CGXDLMSVariant>::iterator it = cols.begin(); it != cols.end(); ++it)
+    for (std::vector<CGXDLMSVariant>::const_iterator it = cols.begin(); it != cols.end(); ++it)
     {
-        DLMS_OBJECT_TYPE ot = (DLMS_OBJECT_TYPE)it->Arr[0].ToInteger();
-        GXHelpers::GetLogicalName(it->Arr[1].byteArr, ln);
-        attributeIndex = it->Arr[2].ToInteger();
-        dataIndex = it->Arr[3].ToInteger();
+        DLMS_OBJECT_TYPE ot = (DLMS_OBJECT_TYPE)it->Arr()[0].ToInteger();
+        GXHelpers::GetLogicalName(it->Arr()[1].byteArr, ln);
+        attributeIndex = it->Arr()[2].ToInteger();
+        dataIndex = it->Arr()[3].ToInteger();
         // Find columns and update only them.
         for (std::vector<std::pair<CGXDLMSObject*, CGXDLMSCaptureObject*> >::iterator c = m_CaptureObjects.begin(); c != m_CaptureObjects.end(); ++c)
         {
@@ -287,6 +387,11 @@ int CGXDLMSProfileGeneric::GetProfileGenericData(
     CGXDLMSSettings& settings, CGXDLMSValueEventArg& e, CGXByteBuffer& reply)
 {
     std::vector<std::pair<CGXDLMSObject*, CGXDLMSCaptureObject*> > columns;
+    //If rows are read from the storage of the application.
+    if (m_Cursor != NULL && e.GetRowEndIndex() != 0)
+    {
+        return GetCursorData(settings, e, reply);
+    }
     //If all data is read.
     if (e.GetSelector() == 0 || e.GetParameters().vt == DLMS_DATA_TYPE_NONE || e.GetRowEndIndex() != 0)
     {
@@ -298,28 +403,28 @@ int CGXDLMSProfileGeneric::GetProfileGenericData(
     {
         int ret;
         CGXDLMSVariant value;
-        if ((ret = CGXDLMSClient::ChangeType(e.GetParameters().Arr[1], DLMS_DATA_TYPE_DATETIME, value)) != 0)
+        if ((ret = CGXDLMSClient::ChangeType(e.GetParameters().Arr()[1], DLMS_DATA_TYPE_DATETIME, value)) != 0)
         {
             return ret;
         }
-        struct tm tmp = value.dateTime.GetValue();
+        struct tm tmp = value.dateTime().GetValue();
         time_t start = mktime(&tmp);
         value.Clear();
-        if ((ret = CGXDLMSClient::ChangeType(e.GetParameters().Arr[2], DLMS_DATA_TYPE_DATETIME, value)) != 0)
+        if ((ret = CGXDLMSClient::ChangeType(e.GetParameters().Arr()[2], DLMS_DATA_TYPE_DATETIME, value)) != 0)
         {
             return ret;
         }
-        tmp = value.dateTime.GetValue();
+        tmp = value.dateTime().GetValue();
         time_t end = mktime(&tmp);
         value.Clear();
 
-        if (e.GetParameters().Arr.size() > 3)
+        if (e.GetParameters().Arr().size() > 3)
         {
-            ret = GetSelectedColumns(e.GetParameters().Arr[3].Arr, columns);
+            ret = GetSelectedColumns(e.GetParameters().Arr()[3].Arr(), columns);
         }
         for (std::vector< std::vector<CGXDLMSVariant> >::iterator row = table.begin(); row != table.end(); ++row)
         {
-            tmp = (*row)[0].dateTime.GetValue();
+            tmp = (*row)[0].dateTime().GetValue();
             time_t tm = mktime(&tmp);
             if (tm >= start && tm <= end)
             {
@@ -329,8 +434,8 @@ int CGXDLMSProfileGeneric::GetProfileGenericData(
     }
     else if (e.GetSelector() == 2) //Read by entry.
     {
-        int start = e.GetParameters().Arr[0].ToInteger();
-        int count = e.GetParameters().Arr[1].ToInteger();
+        int start = e.GetParameters().Arr()[0].ToInteger();
+        int count = e.GetParameters().Arr()[1].ToInteger();
         if (start == 0)
         {
             start = 1;
@@ -346,13 +451,13 @@ int CGXDLMSProfileGeneric::GetProfileGenericData(
 
         int colStart = 1;
         int colCount = 0;
-        if (e.GetParameters().Arr.size() > 2)
+        if (e.GetParameters().Arr().size() > 2)
         {
-            colStart = e.GetParameters().Arr[2].ToInteger();
+            colStart = e.GetParameters().Arr()[2].ToInteger();
         }
-        if (e.GetParameters().Arr.size() > 3)
+        if (e.GetParameters().Arr().size() > 3)
         {
-            colCount = e.GetParameters().Arr[3].ToInteger();
+            colCount = e.GetParameters().Arr()[3].ToInteger();
         }
         else if (colStart != 1)
         {
@@ -399,6 +504,9 @@ CGXDLMSProfileGeneric::CGXDLMSProfileGeneric(std::string ln, unsigned short sn)
     m_CapturePeriod = 3600;
     m_EntriesInUse = m_ProfileEntries = 0;
     m_SortMethod = DLMS_SORT_METHOD_FIFO;
+    m_BufferRing = false;
+    m_BufferStart = 0;
+    m_Cursor = NULL;
 }
 
 /**
@@ -416,6 +524,17 @@ CGXDLMSProfileGeneric::CGXDLMSProfileGeneric(std::string ln) :
 */
 std::vector< std::vector<CGXDLMSVariant> >& CGXDLMSProfileGeneric::GetBuffer()
 {
+    if (m_BufferRing)
+    {
+        //Return rows in the order they are read.
+        std::rotate(m_Buffer.begin(), m_Buffer.begin() + m_BufferStart, m_Buffer.end());
+        if (m_SortMethod == DLMS_SORT_METHOD_LIFO)
+        {
+            std::reverse(m_Buffer.begin(), m_Buffer.end());
+        }
+        m_BufferStart = 0;
+        m_BufferRing = false;
+    }
     return m_Buffer;
 }
 
@@ -448,6 +567,8 @@ GX_SORT_METHOD CGXDLMSProfileGeneric::GetSortMethod()
 }
 void CGXDLMSProfileGeneric::SetSortMethod(GX_SORT_METHOD value)
 {
+    //Ring is ordered with the old sort method.
+    GetBuffer();
     m_SortMethod = value;
 }
 
@@ -499,12 +620,158 @@ void CGXDLMSProfileGeneric::SetSortObjectDataIndex(int value)
     m_SortObjectDataIndex = value;
 }
 
+IGXDLMSProfileCursor* CGXDLMSProfileGeneric::GetCursor()
+{
+    return m_Cursor;
+}
+
+void CGXDLMSProfileGeneric::SetCursor(IGXDLMSProfileCursor* value)
+{
+    m_Cursor = value;
+}
+
 void CGXDLMSProfileGeneric::Reset()
 {
     m_Buffer.erase(m_Buffer.begin(), m_Buffer.end());
+    m_BufferRing = false;
+    m_BufferStart = 0;
     m_EntriesInUse = 0;
 }
 
+int CGXDLMSProfileGeneric::GetSortColumn()
+{
+    if (m_SortMethod == DLMS_SORT_METHOD_FIFO || m_SortMethod == DLMS_SORT_METHOD_LIFO || m_SortObject == NULL)
+    {
+        return -1;
+    }
+    int pos = 0;
+    for (std::vector<std::pair<CGXDLMSObject*, CGXDLMSCaptureObject*> >::iterator it = m_CaptureObjects.begin();
+        it != m_CaptureObjects.end(); ++it, ++pos)
+    {
+        if (it->first == m_SortObject &&
+            it->second->GetAttributeIndex() == m_SortObjectAttributeIndex &&
+            it->second->GetDataIndex() == m_SortObjectDataIndex)
+        {
+            return pos;
+        }
+    }
+    return -1;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//Returns true if row with value a is placed before row with value b.
+/////////////////////////////////////////////////////////////////////////////
+static bool IsBefore(GX_SORT_METHOD method, double a, double b)
+{
+    switch (method)
+    {
+    case DLMS_SORT_METHOD_LARGEST:
+        return a > b;
+    case DLMS_SORT_METHOD_SMALLEST:
+        return a < b;
+    case DLMS_SORT_METHOD_NEAREST_TO_ZERO:
+        return fabs(a) < fabs(b);
+    default:
+        return fabs(a) > fabs(b);
+    }
+}
+
+void CGXDLMSProfileGeneric::AddRow(std::vector<CGXDLMSVariant>& row)
+{
+    int column = GetSortColumn();
+    if (m_ProfileEntries != 0 && m_Buffer.size() > m_ProfileEntries)
+    {
+        //Profile entries is made smaller. Remove the rows that would be removed first.
+        std::vector< std::vector<CGXDLMSVariant> >& rows = GetBuffer();
+        unsigned long extra = (unsigned long)(rows.size() - m_ProfileEntries);
+        if (column == -1 && m_SortMethod != DLMS_SORT_METHOD_LIFO)
+        {
+            rows.erase(rows.begin(), rows.begin() + extra);
+        }
+        else
+        {
+            rows.erase(rows.end() - extra, rows.end());
+        }
+    }
+    bool full = m_ProfileEntries != 0 && m_Buffer.size() == m_ProfileEntries;
+    if (column == -1)
+    {
+        // Rows are kept in a ring in capture order. When buffer is full
+        // the oldest row is overwritten. It is the first row with FIFO
+        // and the last row with LIFO.
+        if (!m_BufferRing)
+        {
+            if (m_SortMethod == DLMS_SORT_METHOD_LIFO)
+            {
+                std::reverse(m_Buffer.begin(), m_Buffer.end());
+            }
+            m_BufferStart = 0;
+            m_BufferRing = true;
+            if (m_ProfileEntries != 0 && m_Buffer.capacity() < m_ProfileEntries)
+            {
+                m_Buffer.reserve(m_ProfileEntries);
+            }
+        }
+        if (full)
+        {
+            m_Buffer[m_BufferStart].swap(row);
+            if (++m_BufferStart == m_Buffer.size())
+            {
+                m_BufferStart = 0;
+            }
+        }
+        else
+        {
+            if (m_BufferStart != 0)
+            {
+                //Profile entries is made larger after the ring is wrapped.
+                //Oldest row is moved first so the new row is added after the newest row.
+                std::rotate(m_Buffer.begin(), m_Buffer.begin() + m_BufferStart, m_Buffer.end());
+                m_BufferStart = 0;
+            }
+            m_Buffer.push_back(std::vector<CGXDLMSVariant>());
+            m_Buffer.back().swap(row);
+        }
+    }
+    else
+    {
+        // Rows are kept sorted. When buffer is full the last row is removed.
+        std::vector< std::vector<CGXDLMSVariant> >& rows = GetBuffer();
+        double value = row[column].ToDouble();
+        // Binary search keeps rows with the same value in capture order.
+        size_t low = 0, high = rows.size();
+        while (low < high)
+        {
+            size_t mid = low + (high - low) / 2;
+            if (IsBefore(m_SortMethod, value, rows[mid][column].ToDouble()))
+            {
+                high = mid;
+            }
+            else
+            {
+                low = mid + 1;
+            }
+        }
+        if (full)
+        {
+            if (low == rows.size())
+            {
+                //New row would be removed first.
+                m_EntriesInUse = (unsigned long)m_Buffer.size();
+                return;
+            }
+            rows.back().swap(row);
+        }
+        else
+        {
+            rows.push_back(std::vector<CGXDLMSVariant>());
+            rows.back().swap(row);
+        }
+        std::rotate(rows.begin() + low, rows.end() - 1, rows.end());
+    }
+    m_EntriesInUse = (unsigned long)m_Buffer.size();
+}
+
 /*
 * Copies the values of the objects to capture into the buffer by reading
 * capture objects.
@@ -529,12 +796,7 @@ int CGXDLMSProfileGeneric::Capture(CGXDLMSServer* server)
             }
             values.push_back(tmp.GetValue());
         }
-        // Remove first items if buffer is full.
-        if (!m_Buffer.empty() && GetProfileEntries() == GetBuffer().size())
-        {
-            m_Buffer.pop_back();
-        }
-        m_Buffer.push_back(values);
+        AddRow(values);
         m_EntriesInUse = (unsigned long)m_Buffer.size();
     }
     server->PostGet(args);
@@ -561,7 +823,8 @@ void CGXDLMSProfileGeneric::GetValues(std::vector<std::string>& values)
     values.push_back(ln);
     std::stringstream sb;
     bool empty = true;
-    for (std::vector< std::vector<CGXDLMSVariant> >::iterator row = m_Buffer.begin(); row != m_Buffer.end(); ++row)
+    std::vector< std::vector<CGXDLMSVariant> >& rows = GetBuffer();
+    for (std::vector< std::vector<CGXDLMSVariant> >::iterator row = rows.begin(); row != rows.end(); ++row)
     {
         for (std::vector<CGXDLMSVariant>::iterator cell = row->begin(); cell != row->end(); ++cell)
         {
@@ -748,7 +1011,8 @@ int CGXDLMSProfileGeneric::GetValue(CGXDLMSSettings& settings, CGXDLMSValueEvent
     }
     else if (e.GetIndex() == 2)
     {
-        CGXByteBuffer tmp;
+        CGXByteBuffer data;
+        CGXByteBuffer& tmp = CGXDLMSArena::GetCurrentBuffer(data);
         int ret = GetProfileGenericData(settings, e, tmp);
         e.SetByteArray(true);
         e.SetValue(tmp);
@@ -864,48 +1128,48 @@ int CGXDLMSProfileGeneric::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEvent
             }
 
             CGXDateTime lastDate;
-            for (std::vector<CGXDLMSVariant >::iterator row = e.GetValue().Arr.begin(); row != e.GetValue().Arr.end(); ++row)
+            for (std::vector<CGXDLMSVariant >::iterator row = e.GetValue().Arr().begin(); row != e.GetValue().Arr().end(); ++row)
             {
-                if ((*row).Arr.size() != m_CaptureObjects.size())
+                if ((*row).Arr().size() != m_CaptureObjects.size())
                 {
                     //Number of columns do not match.
                     return DLMS_ERROR_CODE_INVALID_PARAMETER;
                 }
                 CGXDLMSVariant data;
-                for (unsigned int pos = 0; pos < (*row).Arr.size(); ++pos)
+                for (unsigned int pos = 0; pos < (*row).Arr().size(); ++pos)
                 {
                     std::pair<CGXDLMSObject*, CGXDLMSCaptureObject*> item = m_CaptureObjects[pos];
                     DLMS_DATA_TYPE type = types[pos];
-                    if (row->Arr[pos].vt == DLMS_DATA_TYPE_NONE || row->Arr[pos].vt == DLMS_DATA_TYPE_OCTET_STRING || row->Arr[pos].vt == DLMS_DATA_TYPE_UINT32)
+                    if (row->Arr()[pos].vt == DLMS_DATA_TYPE_NONE || row->Arr()[pos].vt == DLMS_DATA_TYPE_OCTET_STRING || row->Arr()[pos].vt == DLMS_DATA_TYPE_UINT32)
                     {
                         if (item.first->GetObjectType() == DLMS_OBJECT_TYPE_CLOCK && item.second->GetAttributeIndex() == 2)
                         {
-                            if (row->Arr[pos].vt == DLMS_DATA_TYPE_OCTET_STRING)
+                            if (row->Arr()[pos].vt == DLMS_DATA_TYPE_OCTET_STRING)
                             {
-                                if ((ret = CGXDLMSClient::ChangeType(row->Arr[pos], DLMS_DATA_TYPE_DATETIME, data)) != 0)
+                                if ((ret = CGXDLMSClient::ChangeType(row->Arr()[pos], DLMS_DATA_TYPE_DATETIME, data)) != 0)
                                 {
                                     return ret;
                                 }
-                                row->Arr[pos] = data;
-                                lastDate = data.dateTime;
+                                row->Arr()[pos] = data;
+                                lastDate = data.dateTime();
                             }
                             //Some meters returns NULL date time to save bytes.
-                            else if (row->Arr[pos].vt == DLMS_DATA_TYPE_NONE)
+                            else if (row->Arr()[pos].vt == DLMS_DATA_TYPE_NONE)
                             {
                                 if ((ret = lastDate.AddSeconds(m_SortMethod == DLMS_SORT_METHOD_FIFO || m_SortMethod == DLMS_SORT_METHOD_SMALLEST ?
                                     m_CapturePeriod : -m_CapturePeriod)) != 0)
                                 {
                                     return ret;
                                 }
-                                row->Arr[pos] = lastDate;
+                                row->Arr()[pos] = lastDate;
                             }
                         }
-                        else if (row->Arr[pos].vt == DLMS_DATA_TYPE_UINT32 && 
+                        else if (row->Arr()[pos].vt == DLMS_DATA_TYPE_UINT32 && 
                             item.first->GetObjectType() == DLMS_OBJECT_TYPE_DATA && item.first->GetObjectType() == 2 &&
                             memcmp(item.first->m_LN, UNIX_TIME, 6) == 0)
                         {
-                            lastDate = CGXDateTime(row->Arr[pos].ulVal);
-                            row->Arr[pos] = lastDate;
+                            lastDate = CGXDateTime(row->Arr()[pos].ulVal);
+                            row->Arr()[pos] = lastDate;
                         }
                     }
                     if ((item.first->GetObjectType() == DLMS_OBJECT_TYPE_REGISTER || item.first->GetObjectType() == DLMS_OBJECT_TYPE_EXTENDED_REGISTER)
@@ -914,7 +1178,7 @@ int CGXDLMSProfileGeneric::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEvent
                         double scaler = ((CGXDLMSRegister*)item.first)->GetScaler();
                         if (scaler != 1)
                         {
-                            row->Arr[pos] = row->Arr[pos].ToDouble() * scaler;
+                            row->Arr()[pos] = row->Arr()[pos].ToDouble() * scaler;
                         }
                     }
 #ifndef DLMS_IGNORE_DEMAND_REGISTER
@@ -924,12 +1188,12 @@ int CGXDLMSProfileGeneric::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEvent
                         double scaler = ((CGXDLMSDemandRegister*)item.first)->GetScaler();
                         if (scaler != 1)
                         {
-                            row->Arr[pos] = row->Arr[pos].ToDouble() * scaler;
+                            row->Arr()[pos] = row->Arr()[pos].ToDouble() * scaler;
                         }
                     }
 #endif //DLMS_IGNORE_DEMAND_REGISTER
                 }
-                m_Buffer.push_back(row->Arr);
+                GetBuffer().push_back(row->Arr());
             }
         }
         m_EntriesInUse = (unsigned long)m_Buffer.size();
@@ -937,27 +1201,26 @@ int CGXDLMSProfileGeneric::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEvent
     else if (e.GetIndex() == 3)
     {
         m_CaptureObjects.clear();
-        m_Buffer.clear();
-        m_EntriesInUse = 0;
+        Reset();
         if (e.GetValue().vt == DLMS_DATA_TYPE_ARRAY)
         {
-            for (std::vector<CGXDLMSVariant >::iterator it = e.GetValue().Arr.begin(); it != e.GetValue().Arr.end(); ++it)
+            for (std::vector<CGXDLMSVariant >::iterator it = e.GetValue().Arr().begin(); it != e.GetValue().Arr().end(); ++it)
             {
-                if ((*it).Arr.size() != 4)
+                if ((*it).Arr().size() != 4)
                 {
                     //Invalid structure format.
                     return DLMS_ERROR_CODE_INVALID_PARAMETER;
                 }
-                DLMS_OBJECT_TYPE type = (DLMS_OBJECT_TYPE)(*it).Arr[0].ToInteger();
+                DLMS_OBJECT_TYPE type = (DLMS_OBJECT_TYPE)(*it).Arr()[0].ToInteger();
                 std::string ln;
-                GXHelpers::GetLogicalName((*it).Arr[1].byteArr, ln);
+                GXHelpers::GetLogicalName((*it).Arr()[1].byteArr, ln);
                 CGXDLMSObject* pObj = settings.GetObjects().FindByLN(type, ln);
                 if (pObj == NULL)
                 {
                     pObj = CGXDLMSObjectFactory::CreateObject(type, ln);
                     settings.AddAllocateObject(pObj);
                 }
-                AddCaptureObject(pObj, (*it).Arr[2].ToInteger(), (*it).Arr[3].ToInteger());
+                AddCaptureObject(pObj, (*it).Arr()[2].ToInteger(), (*it).Arr()[3].ToInteger());
             }
         }
     }
@@ -967,7 +1230,7 @@ int CGXDLMSProfileGeneric::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEvent
     }
     else if (e.GetIndex() == 5)
     {
-        m_SortMethod = (GX_SORT_METHOD)e.GetValue().ToInteger();
+        SetSortMethod((GX_SORT_METHOD)e.GetValue().ToInteger());
     }
     else if (e.GetIndex() == 6)
     {
@@ -977,16 +1240,16 @@ int CGXDLMSProfileGeneric::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEvent
         }
         else
         {
-            if (e.GetValue().Arr.size() != 4)
+            if (e.GetValue().Arr().size() != 4)
             {
                 //Invalid structure format.
                 return DLMS_ERROR_CODE_INVALID_PARAMETER;
             }
-            DLMS_OBJECT_TYPE type = (DLMS_OBJECT_TYPE)e.GetValue().Arr[0].ToInteger();
+            DLMS_OBJECT_TYPE type = (DLMS_OBJECT_TYPE)e.GetValue().Arr()[0].ToInteger();
             std::string ln;
-            GXHelpers::GetLogicalName(e.GetValue().Arr[1].byteArr, ln);
-            m_SortObjectAttributeIndex = e.GetValue().Arr[2].ToInteger();
-            m_SortObjectDataIndex = e.GetValue().Arr[3].ToInteger();
+            GXHelpers::GetLogicalName(e.GetValue().Arr()[1].byteArr, ln);
+            m_SortObjectAttributeIndex = e.GetValue().Arr()[2].ToInteger();
+            m_SortObjectDataIndex = e.GetValue().Arr()[3].ToInteger();
             m_SortObject = settings.GetObjects().FindByLN(type, ln);
             if (m_SortObject == NULL)
             {
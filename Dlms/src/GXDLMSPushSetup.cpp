@@ -367,10 +367,10 @@ int CGXDLMSPushSetup::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEventArg&
         m_PushObjectList.clear();
         if (e.GetValue().vt == DLMS_DATA_TYPE_ARRAY)
         {
-            for (std::vector<CGXDLMSVariant>::iterator it = e.GetValue().Arr.begin(); it != e.GetValue().Arr.end(); ++it)
+            for (std::vector<CGXDLMSVariant>::iterator it = e.GetValue().Arr().begin(); it != e.GetValue().Arr().end(); ++it)
             {
-                DLMS_OBJECT_TYPE type = (DLMS_OBJECT_TYPE)it->Arr[0].ToInteger();
-                GXHelpers::GetLogicalName(it->Arr[1].byteArr, ln);
+                DLMS_OBJECT_TYPE type = (DLMS_OBJECT_TYPE)it->Arr()[0].ToInteger();
+                GXHelpers::GetLogicalName(it->Arr()[1].byteArr, ln);
                 CGXDLMSObject* obj = settings.GetObjects().FindByLN(type, ln);
                 if (obj == NULL)
                 {
@@ -378,12 +378,12 @@ int CGXDLMSPushSetup::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEventArg&
                     if (obj != NULL)
                     {
                         settings.AddAllocateObject(obj);
-                        CGXDLMSObject::SetLogicalName(obj, it->Arr[1]);
+                        CGXDLMSObject::SetLogicalName(obj, it->Arr()[1]);
                     }
                 }
                 if (obj != NULL)
                 {
-                    CGXDLMSCaptureObject co(it->Arr[2].ToInteger(), it->Arr[3].ToInteger());
+                    CGXDLMSCaptureObject co(it->Arr()[2].ToInteger(), it->Arr()[3].ToInteger());
                     m_PushObjectList.push_back(std::pair<CGXDLMSObject*, CGXDLMSCaptureObject>(obj, co));
                 }
             }
@@ -393,11 +393,11 @@ int CGXDLMSPushSetup::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEventArg&
     {
         if (e.GetValue().vt == DLMS_DATA_TYPE_STRUCTURE)
         {
-            SetService((DLMS_SERVICE_TYPE)e.GetValue().Arr[0].ToInteger());
+            SetService((DLMS_SERVICE_TYPE)e.GetValue().Arr()[0].ToInteger());
             std::string str;
-            str.append(reinterpret_cast<char const*>(e.GetValue().Arr[1].byteArr), e.GetValue().Arr[1].size);
+            str.append(reinterpret_cast<char const*>(e.GetValue().Arr()[1].byteArr), e.GetValue().Arr()[1].size);
             SetDestination(str);
-            SetMessageType((DLMS_MESSAGE_TYPE)e.GetValue().Arr[2].ToInteger());
+            SetMessageType((DLMS_MESSAGE_TYPE)e.GetValue().Arr()[2].ToInteger());
         }
     }
     else if (e.GetIndex() == 4)
@@ -406,19 +406,19 @@ int CGXDLMSPushSetup::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEventArg&
         if (e.GetValue().vt == DLMS_DATA_TYPE_ARRAY)
         {
             int ret;
-            for (std::vector<CGXDLMSVariant>::iterator it = e.GetValue().Arr.begin(); it != e.GetValue().Arr.end(); ++it)
+            for (std::vector<CGXDLMSVariant>::iterator it = e.GetValue().Arr().begin(); it != e.GetValue().Arr().end(); ++it)
             {
                 CGXDLMSVariant tmp;
-                if ((ret = CGXDLMSClient::ChangeType(it->Arr[0], DLMS_DATA_TYPE_DATETIME, tmp)) != 0)
+                if ((ret = CGXDLMSClient::ChangeType(it->Arr()[0], DLMS_DATA_TYPE_DATETIME, tmp)) != 0)
                 {
                     return ret;
                 }
-                CGXDateTime start = tmp.dateTime;
-                if ((ret = CGXDLMSClient::ChangeType(it->Arr[1], DLMS_DATA_TYPE_DATETIME, tmp)) != 0)
+                CGXDateTime start = tmp.dateTime();
+                if ((ret = CGXDLMSClient::ChangeType(it->Arr()[1], DLMS_DATA_TYPE_DATETIME, tmp)) != 0)
                 {
                     return ret;
                 }
-                CGXDateTime end = tmp.dateTime;
+                CGXDateTime end = tmp.dateTime();
                 m_CommunicationWindow.push_back(std::pair<CGXDateTime, CGXDateTime>(start, end));
             }
         }
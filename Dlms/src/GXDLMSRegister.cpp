@@ -290,8 +290,8 @@ int CGXDLMSRegister::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEventArg& e
     }
     else if (e.GetIndex() == 3 && e.GetValue().vt == DLMS_DATA_TYPE_STRUCTURE)
     {
-        m_Scaler = e.GetValue().Arr[0].ToInteger();
-        m_Unit = e.GetValue().Arr[1].ToInteger();
+        m_Scaler = e.GetValue().Arr()[0].ToInteger();
+        m_Unit = e.GetValue().Arr()[1].ToInteger();
     }
     else
     {
@@ -268,12 +268,12 @@ int CGXDLMSRegisterActivation::SetValue(CGXDLMSSettings& settings, CGXDLMSValueE
         m_RegisterAssignment.clear();
         if (e.GetValue().vt == DLMS_DATA_TYPE_ARRAY)
         {
-            for (std::vector<CGXDLMSVariant>::iterator it = e.GetValue().Arr.begin(); it != e.GetValue().Arr.end(); ++it)
+            for (std::vector<CGXDLMSVariant>::iterator it = e.GetValue().Arr().begin(); it != e.GetValue().Arr().end(); ++it)
             {
                 CGXDLMSObjectDefinition item;
-                item.SetObjectType((DLMS_OBJECT_TYPE)it->Arr[0].ToInteger());
+                item.SetObjectType((DLMS_OBJECT_TYPE)it->Arr()[0].ToInteger());
                 std::string ln;
-                GXHelpers::GetLogicalName(it->Arr[1].byteArr, ln);
+                GXHelpers::GetLogicalName(it->Arr()[1].byteArr, ln);
                 item.SetLogicalName(ln);
                 m_RegisterAssignment.push_back(item);
             }
@@ -284,11 +284,11 @@ int CGXDLMSRegisterActivation::SetValue(CGXDLMSSettings& settings, CGXDLMSValueE
         m_MaskList.clear();
         if (e.GetValue().vt == DLMS_DATA_TYPE_ARRAY)
         {
-            for (std::vector<CGXDLMSVariant>::iterator it = e.GetValue().Arr.begin(); it != e.GetValue().Arr.end(); ++it)
+            for (std::vector<CGXDLMSVariant>::iterator it = e.GetValue().Arr().begin(); it != e.GetValue().Arr().end(); ++it)
             {
                 CGXByteBuffer key, arr;
-                key.Set(it->Arr[0].byteArr, it->Arr[0].size);
-                for (std::vector<CGXDLMSVariant>::iterator v = it->Arr[1].Arr.begin(); v != it->Arr[1].Arr.end(); ++v)
+                key.Set(it->Arr()[0].byteArr, it->Arr()[0].size);
+                for (std::vector<CGXDLMSVariant>::iterator v = it->Arr()[1].Arr().begin(); v != it->Arr()[1].Arr().end(); ++v)
                 {
                     arr.SetUInt8(v->ToInteger());
                 }
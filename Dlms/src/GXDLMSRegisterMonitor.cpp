@@ -290,16 +290,16 @@ int CGXDLMSRegisterMonitor::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEven
     }
     if (e.GetIndex() == 2)
     {
-        SetThresholds(e.GetValue().Arr);
+        SetThresholds(e.GetValue().Arr());
         return DLMS_ERROR_CODE_OK;
     }
     if (e.GetIndex() == 3)
     {
-        GetMonitoredValue().SetObjectType((DLMS_OBJECT_TYPE)e.GetValue().Arr[0].ToInteger());
+        GetMonitoredValue().SetObjectType((DLMS_OBJECT_TYPE)e.GetValue().Arr()[0].ToInteger());
         std::string ln;
-        GXHelpers::GetLogicalName(e.GetValue().Arr[1].byteArr, ln);
+        GXHelpers::GetLogicalName(e.GetValue().Arr()[1].byteArr, ln);
         m_MonitoredValue.SetLogicalName(ln);
-        m_MonitoredValue.SetAttributeIndex(e.GetValue().Arr[2].ToInteger());
+        m_MonitoredValue.SetAttributeIndex(e.GetValue().Arr()[2].ToInteger());
         return DLMS_ERROR_CODE_OK;
     }
     if (e.GetIndex() == 4)
@@ -310,17 +310,17 @@ int CGXDLMSRegisterMonitor::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEven
         }
         m_Actions.clear();
         std::string ln;
-        for (std::vector<CGXDLMSVariant>::iterator action_set = e.GetValue().Arr.begin(); action_set != e.GetValue().Arr.end(); ++action_set)
+        for (std::vector<CGXDLMSVariant>::iterator action_set = e.GetValue().Arr().begin(); action_set != e.GetValue().Arr().end(); ++action_set)
         {
             CGXDLMSActionSet *set = new CGXDLMSActionSet();
-            CGXDLMSVariant& up = action_set->Arr[0];
-            GXHelpers::GetLogicalName(up.Arr[0].byteArr, ln);
+            CGXDLMSVariant& up = action_set->Arr()[0];
+            GXHelpers::GetLogicalName(up.Arr()[0].byteArr, ln);
             set->GetActionUp().SetLogicalName(ln);
-            set->GetActionUp().SetScriptSelector(up.Arr[1].ToInteger());
-            CGXDLMSVariant& down = action_set->Arr[1];
-            GXHelpers::GetLogicalName(down.Arr[0].byteArr, ln);
+            set->GetActionUp().SetScriptSelector(up.Arr()[1].ToInteger());
+            CGXDLMSVariant& down = action_set->Arr()[1];
+            GXHelpers::GetLogicalName(down.Arr()[0].byteArr, ln);
             set->GetActionDown().SetLogicalName(ln);
-            set->GetActionDown().SetScriptSelector(down.Arr[1].ToInteger());
+            set->GetActionDown().SetScriptSelector(down.Arr()[1].ToInteger());
             m_Actions.push_back(set);
         }
         return DLMS_ERROR_CODE_OK;
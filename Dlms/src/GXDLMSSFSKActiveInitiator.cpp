@@ -187,9 +187,9 @@ int CGXDLMSSFSKActiveInitiator::SetValue(CGXDLMSSettings& settings, CGXDLMSValue
         if (e.GetValue().vt == DLMS_DATA_TYPE_STRUCTURE)
         {
             m_SystemTitle.Clear();
-            e.GetValue().Arr[0].GetBytes(m_SystemTitle);
-            m_MacAddress = e.GetValue().Arr[1].ToInteger();
-            m_LSapSelector = e.GetValue().Arr[2].ToInteger();
+            e.GetValue().Arr()[0].GetBytes(m_SystemTitle);
+            m_MacAddress = e.GetValue().Arr()[1].ToInteger();
+            m_LSapSelector = e.GetValue().Arr()[2].ToInteger();
         }
         else
         {
@@ -387,9 +387,9 @@ int CGXDLMSSFSKMacCounters::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEven
         m_SynchronizationRegister.clear();
         if (e.GetValue().vt == DLMS_DATA_TYPE_ARRAY)
         {
-            for (std::vector<CGXDLMSVariant>::iterator it = e.GetValue().Arr.begin(); it != e.GetValue().Arr.end(); ++it)
+            for (std::vector<CGXDLMSVariant>::iterator it = e.GetValue().Arr().begin(); it != e.GetValue().Arr().end(); ++it)
             {
-                m_SynchronizationRegister.push_back(std::pair<uint16_t, uint32_t>(it->Arr[0].ToInteger(), it->Arr[1].ToInteger()));
+                m_SynchronizationRegister.push_back(std::pair<uint16_t, uint32_t>(it->Arr()[0].ToInteger(), it->Arr()[1].ToInteger()));
             }
         }
     }
@@ -398,11 +398,11 @@ int CGXDLMSSFSKMacCounters::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEven
     {
         if (e.GetValue().vt == DLMS_DATA_TYPE_STRUCTURE)
         {
-            m_PhysicalLayerDesynchronization = e.GetValue().Arr[0].ToInteger();
-            m_TimeOutNotAddressedDesynchronization = e.GetValue().Arr[1].ToInteger();
-            m_TimeOutFrameNotOkDesynchronization = e.GetValue().Arr[2].ToInteger();
-            m_WriteRequestDesynchronization = e.GetValue().Arr[3].ToInteger();
-            m_WrongInitiatorDesynchronization = e.GetValue().Arr[4].ToInteger();
+            m_PhysicalLayerDesynchronization = e.GetValue().Arr()[0].ToInteger();
+            m_TimeOutNotAddressedDesynchronization = e.GetValue().Arr()[1].ToInteger();
+            m_TimeOutFrameNotOkDesynchronization = e.GetValue().Arr()[2].ToInteger();
+            m_WriteRequestDesynchronization = e.GetValue().Arr()[3].ToInteger();
+            m_WrongInitiatorDesynchronization = e.GetValue().Arr()[4].ToInteger();
         }
         else
         {
@@ -419,9 +419,9 @@ int CGXDLMSSFSKMacCounters::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEven
         m_BroadcastFramesCounter.clear();
         if (e.GetValue().vt == DLMS_DATA_TYPE_ARRAY)
         {
-            for (std::vector<CGXDLMSVariant>::iterator it = e.GetValue().Arr.begin(); it != e.GetValue().Arr.end(); ++it)
+            for (std::vector<CGXDLMSVariant>::iterator it = e.GetValue().Arr().begin(); it != e.GetValue().Arr().end(); ++it)
             {
-                m_BroadcastFramesCounter.push_back(std::pair<uint16_t, uint32_t>(it->Arr[0].ToInteger(), it->Arr[1].ToInteger()));
+                m_BroadcastFramesCounter.push_back(std::pair<uint16_t, uint32_t>(it->Arr()[0].ToInteger(), it->Arr()[1].ToInteger()));
             }
         }
     }
@@ -487,10 +487,10 @@ int CGXDLMSSFSKPhyMacSetUp::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEven
         m_SearchInitiatorThreshold = e.GetValue().ToInteger();
         break;
     case 7: {
-        if (e.GetValue().Arr[0].vt == DLMS_DATA_TYPE_STRUCTURE)
+        if (e.GetValue().Arr()[0].vt == DLMS_DATA_TYPE_STRUCTURE)
         {
-            m_MarkFrequency = e.GetValue().Arr[0].ToInteger();
-            m_SpaceFrequency = e.GetValue().Arr[0].ToInteger();
+            m_MarkFrequency = e.GetValue().Arr()[0].ToInteger();
+            m_SpaceFrequency = e.GetValue().Arr()[0].ToInteger();
         }
         else
         {
@@ -506,7 +506,7 @@ int CGXDLMSSFSKPhyMacSetUp::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEven
         m_MacGroupAddresses.clear();
         if (e.GetValue().vt == DLMS_DATA_TYPE_ARRAY)
         {
-            for (std::vector<CGXDLMSVariant>::iterator it = e.GetValue().Arr.begin(); it != e.GetValue().Arr.end(); ++it)
+            for (std::vector<CGXDLMSVariant>::iterator it = e.GetValue().Arr().begin(); it != e.GetValue().Arr().end(); ++it)
             {
                 m_MacGroupAddresses.push_back(it->ToInteger());
             }
@@ -172,7 +172,7 @@ int CGXDLMSSFSKReportingSystemList::SetValue(CGXDLMSSettings& settings, CGXDLMSV
         if (e.GetValue().vt == DLMS_DATA_TYPE_ARRAY)
         {
             CGXByteBuffer bb;
-            for (std::vector<CGXDLMSVariant>::iterator it = e.GetValue().Arr.begin(); it != e.GetValue().Arr.end(); ++it)
+            for (std::vector<CGXDLMSVariant>::iterator it = e.GetValue().Arr().begin(); it != e.GetValue().Arr().end(); ++it)
             {
                 if ((ret = it->GetBytes(bb)) != 0)
                 {
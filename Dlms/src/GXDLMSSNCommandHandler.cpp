@@ -341,8 +341,14 @@ int CGXDLMSSNCommandHandler::HandleWriteRequest(
                     else if (!e->GetHandled())
                     {
                         target.GetItem()->SetValue(settings, *e);
+                        target.GetItem()->Changed();
                         server->PostWrite(arr);
                     }
+                    else
+                    {
+                        //Value might be changed by the server.
+                        target.GetItem()->Changed();
+                    }
                 }
             }
         }
@@ -444,6 +450,8 @@ int CGXDLMSSNCommandHandler::GetReadData(CGXDLMSSettings& settings,
             if ((*e)->IsAction())
             {
                 ret = (*e)->GetTarget()->Invoke(settings, *(*e));
+                //Action might change attribute values.
+                (*e)->GetTarget()->Changed();
             }
             else
             {
@@ -860,7 +868,7 @@ int CGXDLMSSNCommandHandler::HandleInformationReport(
         {
             return ret;
         }
-        reply.SetTime(&value.dateTime.GetValue());
+        reply.SetTime(&value.dateTime().GetValue());
     }
     if ((ret = GXHelpers::GetObjectCount(reply.GetData(), count)) != 0)
     {
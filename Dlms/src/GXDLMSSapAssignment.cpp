@@ -193,21 +193,21 @@ int CGXDLMSSapAssignment::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEventA
     if (e.GetIndex() == 2)
     {
         m_SapAssignmentList.clear();
-        for (std::vector<CGXDLMSVariant>::iterator item = e.GetValue().Arr.begin();
-            item != e.GetValue().Arr.end(); ++item)
+        for (std::vector<CGXDLMSVariant>::iterator item = e.GetValue().Arr().begin();
+            item != e.GetValue().Arr().end(); ++item)
         {
             std::string str;
-            if ((*item).Arr[1].vt == DLMS_DATA_TYPE_OCTET_STRING)
+            if ((*item).Arr()[1].vt == DLMS_DATA_TYPE_OCTET_STRING)
             {
                 CGXDLMSVariant tmp;
-                CGXDLMSClient::ChangeType((*item).Arr[1], DLMS_DATA_TYPE_STRING, tmp);
-                str = tmp.strVal;
+                CGXDLMSClient::ChangeType((*item).Arr()[1], DLMS_DATA_TYPE_STRING, tmp);
+                str = tmp.strVal();
             }
             else
             {
-                str = (*item).Arr[1].ToString();
+                str = (*item).Arr()[1].ToString();
             }
-            m_SapAssignmentList[(*item).Arr[0].ToInteger()] = str;
+            m_SapAssignmentList[(*item).Arr()[0].ToInteger()] = str;
         }
         return DLMS_ERROR_CODE_OK;
     }
@@ -244,15 +244,15 @@ int CGXDLMSSapAssignment::Invoke(CGXDLMSSettings& settings, CGXDLMSValueEventArg
 {
     if (e.GetIndex() == 1)
     {
-        uint16_t id = e.GetParameters().Arr[0].ToInteger();
+        uint16_t id = e.GetParameters().Arr()[0].ToInteger();
         std::string str;
-        if (e.GetParameters().Arr[1].vt == DLMS_DATA_TYPE_OCTET_STRING)
+        if (e.GetParameters().Arr()[1].vt == DLMS_DATA_TYPE_OCTET_STRING)
         {
-           str.append(reinterpret_cast<char const*>(e.GetParameters().Arr[1].byteArr), e.GetParameters().Arr[1].GetSize());
+           str.append(reinterpret_cast<char const*>(e.GetParameters().Arr()[1].byteArr), e.GetParameters().Arr()[1].GetSize());
         }
         else
         {
-            str = e.GetParameters().Arr[1].ToString();
+            str = e.GetParameters().Arr()[1].ToString();
         }
         if (id == 0)
         {
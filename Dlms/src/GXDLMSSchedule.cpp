@@ -170,24 +170,24 @@ int CreateEntry(CGXDLMSSettings& settings, std::vector<CGXDLMSVariant>& arr, CGX
         delete item;
         return ret;
     }
-    t = tmp.dateTime;
+    t = tmp.dateTime();
     item->SetSwitchTime(t);
     item->SetValidityWindow(arr[5].ToInteger());
     item->SetExecWeekdays((DLMS_WEEKDAYS)arr[6].ToInteger());
-    item->SetExecSpecDays(arr[7].strVal);
+    item->SetExecSpecDays(arr[7].strVal());
     if ((ret = CGXDLMSClient::ChangeType(arr[8], DLMS_DATA_TYPE_DATE, tmp)) != 0)
     {
         delete item;
         return ret;
     }
-    d = tmp.dateTime;
+    d = tmp.dateTime();
     item->SetBeginDate(d);
     if ((ret = CGXDLMSClient::ChangeType(arr[9], DLMS_DATA_TYPE_DATE, tmp)) != 0)
     {
         delete item;
         return ret;
     }
-    d = tmp.dateTime;
+    d = tmp.dateTime();
     item->SetEndDate(d);
     return ret;
 }
@@ -311,7 +311,7 @@ int CGXDLMSSchedule::Invoke(CGXDLMSSettings& settings, CGXDLMSValueEventArg& e)
     case 1:
     {
         //Enable
-        for (index = e.GetParameters().Arr[0].uiVal; index <= e.GetParameters().Arr[1].uiVal; ++index)
+        for (index = e.GetParameters().Arr()[0].uiVal; index <= e.GetParameters().Arr()[1].uiVal; ++index)
         {
             if (index != 0)
             {
@@ -326,7 +326,7 @@ int CGXDLMSSchedule::Invoke(CGXDLMSSettings& settings, CGXDLMSValueEventArg& e)
             }
         }
         //Disable
-        for (index = e.GetParameters().Arr[2].uiVal; index <= e.GetParameters().Arr[3].uiVal; ++index)
+        for (index = e.GetParameters().Arr()[2].uiVal; index <= e.GetParameters().Arr()[3].uiVal; ++index)
         {
             if (index != 0)
             {
@@ -346,7 +346,7 @@ int CGXDLMSSchedule::Invoke(CGXDLMSSettings& settings, CGXDLMSValueEventArg& e)
     case 2:
     {
         CGXDLMSScheduleEntry* entry;
-        if ((ret = CreateEntry(settings, e.GetParameters().Arr, entry)) == 0)
+        if ((ret = CreateEntry(settings, e.GetParameters().Arr(), entry)) == 0)
         {
             if ((ret = RemoveEntry(entry->GetIndex())) != 0)
             {
@@ -359,7 +359,7 @@ int CGXDLMSSchedule::Invoke(CGXDLMSSettings& settings, CGXDLMSValueEventArg& e)
     //Delete entry
     case 3:
     {
-        for (index = e.GetParameters().Arr[0].uiVal; index <= e.GetParameters().Arr[1].uiVal; ++index)
+        for (index = e.GetParameters().Arr()[0].uiVal; index <= e.GetParameters().Arr()[1].uiVal; ++index)
         {
             if ((ret = RemoveEntry(index)) != 0)
             {
@@ -455,9 +455,9 @@ int CGXDLMSSchedule::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEventArg& e
         }
         m_Entries.clear();
         CGXDLMSScheduleEntry* item;
-        for (std::vector<CGXDLMSVariant >::iterator it = e.GetValue().Arr.begin(); it != e.GetValue().Arr.end(); ++it)
+        for (std::vector<CGXDLMSVariant >::iterator it = e.GetValue().Arr().begin(); it != e.GetValue().Arr().end(); ++it)
         {
-            if ((ret = CreateEntry(settings, it->Arr, item)) != 0)
+            if ((ret = CreateEntry(settings, it->Arr(), item)) != 0)
             {
                 break;
             }
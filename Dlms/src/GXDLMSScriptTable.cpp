@@ -233,28 +233,28 @@ int CGXDLMSScriptTable::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEventArg
         m_Scripts.clear();
         //Fix Xemex bug here.
         //Xemex meters do not return array as they shoul be according standard.
-        if (e.GetValue().Arr.size() != 0)
+        if (e.GetValue().Arr().size() != 0)
         {
-            if (e.GetValue().Arr[0].vt == DLMS_DATA_TYPE_STRUCTURE)
+            if (e.GetValue().Arr()[0].vt == DLMS_DATA_TYPE_STRUCTURE)
             {
                 std::string ln;
-                for (std::vector<CGXDLMSVariant>::iterator item = e.GetValue().Arr.begin(); item != e.GetValue().Arr.end(); ++item)
+                for (std::vector<CGXDLMSVariant>::iterator item = e.GetValue().Arr().begin(); item != e.GetValue().Arr().end(); ++item)
                 {
                     CGXDLMSScript* script = new CGXDLMSScript();
-                    script->SetID((*item).Arr[0].ToInteger());
+                    script->SetID((*item).Arr()[0].ToInteger());
                     m_Scripts.push_back(script);
-                    for (std::vector<CGXDLMSVariant>::iterator arr = (*item).Arr[1].Arr.begin(); arr != (*item).Arr[1].Arr.end(); ++arr)
+                    for (std::vector<CGXDLMSVariant>::iterator arr = (*item).Arr()[1].Arr().begin(); arr != (*item).Arr()[1].Arr().end(); ++arr)
                     {
                         CGXDLMSScriptAction* it = new CGXDLMSScriptAction();
-                        SCRIPT_ACTION_TYPE type = (SCRIPT_ACTION_TYPE)(*arr).Arr[0].ToInteger();
+                        SCRIPT_ACTION_TYPE type = (SCRIPT_ACTION_TYPE)(*arr).Arr()[0].ToInteger();
                         it->SetType(type);
-                        DLMS_OBJECT_TYPE ot = (DLMS_OBJECT_TYPE)(*arr).Arr[1].ToInteger();
+                        DLMS_OBJECT_TYPE ot = (DLMS_OBJECT_TYPE)(*arr).Arr()[1].ToInteger();
                         it->SetObjectType(ot);
                         ln.clear();
-                        GXHelpers::GetLogicalName((*arr).Arr[2].byteArr, ln);
+                        GXHelpers::GetLogicalName((*arr).Arr()[2].byteArr, ln);
                         it->SetLogicalName(ln);
-                        it->SetIndex((*arr).Arr[3].ToInteger());
-                        it->SetParameter((*arr).Arr[4]);
+                        it->SetIndex((*arr).Arr()[3].ToInteger());
+                        it->SetParameter((*arr).Arr()[4]);
                         script->GetActions().push_back(it);
                     }
                 }
@@ -262,18 +262,18 @@ int CGXDLMSScriptTable::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEventArg
             else //Read Xemex meter here.
             {
                 CGXDLMSScript* script = new CGXDLMSScript();
-                script->SetID(e.GetValue().Arr[0].ToInteger());
+                script->SetID(e.GetValue().Arr()[0].ToInteger());
                 m_Scripts.push_back(script);
                 CGXDLMSScriptAction *it = new CGXDLMSScriptAction();
-                SCRIPT_ACTION_TYPE type = (SCRIPT_ACTION_TYPE)e.GetValue().Arr[1].Arr[0].ToInteger();
+                SCRIPT_ACTION_TYPE type = (SCRIPT_ACTION_TYPE)e.GetValue().Arr()[1].Arr()[0].ToInteger();
                 it->SetType(type);
-                DLMS_OBJECT_TYPE ot = (DLMS_OBJECT_TYPE)e.GetValue().Arr[1].Arr[1].ToInteger();
+                DLMS_OBJECT_TYPE ot = (DLMS_OBJECT_TYPE)e.GetValue().Arr()[1].Arr()[1].ToInteger();
                 it->SetObjectType(ot);
                 std::string ln;
-                GXHelpers::GetLogicalName(e.GetValue().Arr[1].Arr[2].byteArr, ln);
+                GXHelpers::GetLogicalName(e.GetValue().Arr()[1].Arr()[2].byteArr, ln);
                 it->SetLogicalName(ln);
-                it->SetIndex(e.GetValue().Arr[1].Arr[3].ToInteger());
-                it->SetParameter(e.GetValue().Arr[1].Arr[4]);
+                it->SetIndex(e.GetValue().Arr()[1].Arr()[3].ToInteger());
+                it->SetParameter(e.GetValue().Arr()[1].Arr()[4]);
                 script->GetActions().push_back(it);
             }
         }
@@ -325,12 +325,12 @@ int CGXDLMSSecuritySetup::Invoke(CGXDLMSSettings& settings, CGXDLMSValueEventArg
     }
     else if (e.GetIndex() == 2)
     {
-        for (std::vector<CGXDLMSVariant>::iterator it = e.GetParameters().Arr.begin(); it != e.GetParameters().Arr.end(); ++it)
+        for (std::vector<CGXDLMSVariant>::iterator it = e.GetParameters().Arr().begin(); it != e.GetParameters().Arr().end(); ++it)
         {
-            DLMS_GLOBAL_KEY_TYPE type = (DLMS_GLOBAL_KEY_TYPE)it->Arr[0].ToInteger();
+            DLMS_GLOBAL_KEY_TYPE type = (DLMS_GLOBAL_KEY_TYPE)it->Arr()[0].ToInteger();
             CGXByteBuffer data, reply;
             CGXByteBuffer kek = settings.GetKek();
-            data.Set(it->Arr[1].byteArr, it->Arr[1].GetSize());
+            data.Set(it->Arr()[1].byteArr, it->Arr()[1].GetSize());
             if (CGXDLMSSecureClient::Decrypt(kek, data, reply) != 0 ||
                 reply.GetSize() != 16)
             {
@@ -364,12 +364,12 @@ int CGXDLMSSecuritySetup::Invoke(CGXDLMSSettings& settings, CGXDLMSValueEventArg
 
 int CGXDLMSSecuritySetup::ApplyKeys(CGXDLMSSettings& settings, CGXDLMSValueEventArg& e)
 {
-    for (std::vector<CGXDLMSVariant>::iterator it = e.GetParameters().Arr.begin(); it != e.GetParameters().Arr.end(); ++it)
+    for (std::vector<CGXDLMSVariant>::iterator it = e.GetParameters().Arr().begin(); it != e.GetParameters().Arr().end(); ++it)
     {
-        DLMS_GLOBAL_KEY_TYPE type = (DLMS_GLOBAL_KEY_TYPE)it->Arr[0].ToInteger();
+        DLMS_GLOBAL_KEY_TYPE type = (DLMS_GLOBAL_KEY_TYPE)it->Arr()[0].ToInteger();
         CGXByteBuffer data, reply;
         CGXByteBuffer kek = settings.GetKek();
-        data.Set(it->Arr[1].byteArr, it->Arr[1].GetSize());
+        data.Set(it->Arr()[1].byteArr, it->Arr()[1].GetSize());
         if (CGXDLMSSecureClient::Decrypt(kek, data, reply) != 0 ||
             reply.GetSize() != 16)
         {
@@ -602,18 +602,18 @@ int CGXDLMSSecuritySetup::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEventA
         if (e.GetValue().vt != DLMS_DATA_TYPE_NONE)
         {
             std::string tmp;
-            for (std::vector<CGXDLMSVariant >::iterator it = e.GetValue().Arr.begin(); it != e.GetValue().Arr.end(); ++it)
+            for (std::vector<CGXDLMSVariant >::iterator it = e.GetValue().Arr().begin(); it != e.GetValue().Arr().end(); ++it)
             {
                 CGXDLMSCertificateInfo* info = new CGXDLMSCertificateInfo();
-                info->SetEntity((DLMS_CERTIFICATE_ENTITY)it->Arr[0].ToInteger());
-                info->SetType((DLMS_CERTIFICATE_TYPE)it->Arr[1].ToInteger());
-                tmp = it->Arr[2].ToString();
+                info->SetEntity((DLMS_CERTIFICATE_ENTITY)it->Arr()[0].ToInteger());
+                info->SetType((DLMS_CERTIFICATE_TYPE)it->Arr()[1].ToInteger());
+                tmp = it->Arr()[2].ToString();
                 info->SetSerialNumber(tmp);
-                tmp = it->Arr[3].ToString();
+                tmp = it->Arr()[3].ToString();
                 info->SetIssuer(tmp);
-                tmp = it->Arr[4].ToString();
+                tmp = it->Arr()[4].ToString();
                 info->SetSubject(tmp);
-                tmp = it->Arr[5].ToString();
+                tmp = it->Arr()[5].ToString();
                 info->SetSubjectAltName(tmp);
                 m_Certificates.push_back(info);
             }
@@ -45,10 +45,65 @@
 #include "../include/GXDLMSValueEventCollection.h"
 #include "../include/GXDLMSLNCommandHandler.h"
 #include "../include/GXDLMSSNCommandHandler.h"
+#include <mutex>
+#include <unordered_map>
+
+/////////////////////////////////////////////////////////////////////////////
+//AARE without ciphering and high authentication depends only on the
+//negotiated values. Encoded AARE is shared by all the associations that
+//negotiate the same values.
+/////////////////////////////////////////////////////////////////////////////
+#define MAX_CACHED_AARES 32
+static std::mutex g_CachedAareLock;
+static std::unordered_map<std::string, std::string> g_CachedAares;
+
+static int GenerateCachedAARE(
+    CGXDLMSSettings& settings,
+    CGXByteBuffer& data,
+    DLMS_ASSOCIATION_RESULT result,
+    DLMS_SOURCE_DIAGNOSTIC diagnostic,
+    CGXByteBuffer& error)
+{
+    CGXCipher* cipher = settings.GetCipher();
+    if (error.GetSize() != 0 || settings.GetProtocolVersion() != NULL ||
+        settings.GetAuthentication() > DLMS_AUTHENTICATION_LOW ||
+        (cipher != NULL && cipher->IsCiphered()))
+    {
+        return CGXAPDU::GenerateAARE(settings, data, result, diagnostic, cipher, &error, NULL);
+    }
+    unsigned long conformance = settings.GetNegotiatedConformance();
+    unsigned short pduSize = settings.GetMaxPduSize();
+    unsigned char tmp[] = { settings.GetUseLogicalNameReferencing(),
+        (unsigned char)result, (unsigned char)diagnostic,
+        (unsigned char)(conformance >> 16), (unsigned char)(conformance >> 8), (unsigned char)conformance,
+        (unsigned char)(pduSize >> 8), (unsigned char)pduSize };
+    std::string key((const char*)tmp, sizeof(tmp));
+    {
+        std::lock_guard<std::mutex> lock(g_CachedAareLock);
+        std::unordered_map<std::string, std::string>::iterator it = g_CachedAares.find(key);
+        if (it != g_CachedAares.end())
+        {
+            return data.Set(it->second.data(), (unsigned long)it->second.size());
+        }
+    }
+    int ret;
+    unsigned long offset = data.GetSize();
+    if ((ret = CGXAPDU::GenerateAARE(settings, data, result, diagnostic, cipher, &error, NULL)) != 0)
+    {
+        return ret;
+    }
+    std::lock_guard<std::mutex> lock(g_CachedAareLock);
+    if (g_CachedAares.size() < MAX_CACHED_AARES)
+    {
+        g_CachedAares.emplace(key, std::string((const char*)data.GetData() + offset, data.GetSize() - offset));
+    }
+    return 0;
+}
 
 CGXDLMSServer::CGXDLMSServer(bool logicalNameReferencing,
     DLMS_INTERFACE_TYPE type) : m_Transaction(NULL), m_Settings(true)
 {
+    m_Arena = NULL;
 #ifndef DLMS_IGNORE_IEC_HDLC_SETUP
     m_Hdlc = NULL;
 #endif //DLMS_IGNORE_IEC_HDLC_SETUP
@@ -238,6 +293,21 @@ void CGXDLMSServer::SetUseLogicalNameReferencing(bool value)
     m_Settings.SetUseLogicalNameReferencing(value);
 }
 
+CGXDLMSArena* CGXDLMSServer::GetArena()
+{
+    return m_Arena;
+}
+
+void CGXDLMSServer::SetArena(CGXDLMSArena* value)
+{
+    m_Arena = value;
+}
+
+std::vector<unsigned long>& CGXDLMSServer::GetPreEstablishedClients()
+{
+    return m_PreEstablishedClients;
+}
+
 int CGXDLMSServer::Initialize()
 {
     CGXDLMSObject* associationObject = NULL;
@@ -410,6 +480,61 @@ void CGXDLMSServer::Reset()
     Reset(false);
 }
 
+void CGXDLMSServer::PreEstablish(
+    DLMS_COMMAND command,
+    CGXDLMSConnectionEventArgs& connectionInfo)
+{
+    switch (command)
+    {
+    case DLMS_COMMAND_GET_REQUEST:
+    case DLMS_COMMAND_SET_REQUEST:
+    case DLMS_COMMAND_METHOD_REQUEST:
+    case DLMS_COMMAND_ACCESS_REQUEST:
+    case DLMS_COMMAND_READ_REQUEST:
+    case DLMS_COMMAND_WRITE_REQUEST:
+        break;
+    default:
+        return;
+    }
+    for (std::vector<unsigned long>::iterator it = m_PreEstablishedClients.begin(); it != m_PreEstablishedClients.end(); ++it)
+    {
+        if (*it == m_Settings.GetClientAddress())
+        {
+            m_Settings.SetAuthentication(DLMS_AUTHENTICATION_NONE);
+            m_Settings.SetDLMSVersion(6);
+            m_Settings.SetNegotiatedConformance(m_Settings.GetProposedConformance());
+            m_Settings.SetMaxReceivePDUSize(m_Settings.GetMaxServerPDUSize());
+            UpdateAssociation(DLMS_ASSOCIATION_STATUS_ASSOCIATED);
+            Connected(connectionInfo);
+            m_Settings.SetConnected((DLMS_CONNECTION_STATE)(m_Settings.GetConnected() | DLMS_CONNECTION_STATE_DLMS));
+            //Inactivity time is counted from the first request.
+            m_DataReceived = (long)time(NULL);
+            break;
+        }
+    }
+}
+
+void CGXDLMSServer::UpdateAssociation(DLMS_ASSOCIATION_STATUS status)
+{
+#ifndef DLMS_IGNORE_ASSOCIATION_LOGICAL_NAME
+    unsigned char l[] = { 0,0,40,0,0,255 };
+    CGXDLMSAssociationLogicalName* ln = (CGXDLMSAssociationLogicalName*)m_Settings.GetObjects().FindByLN(DLMS_OBJECT_TYPE_ASSOCIATION_LOGICAL_NAME, l);
+    if (ln != NULL)
+    {
+        if (m_Settings.GetCipher() == NULL || m_Settings.GetCipher()->GetSecurity() == DLMS_SECURITY_NONE)
+        {
+            ln->GetApplicationContextName().SetContextId(DLMS_APPLICATION_CONTEXT_NAME_LOGICAL_NAME);
+        }
+        else
+        {
+            ln->GetApplicationContextName().SetContextId(DLMS_APPLICATION_CONTEXT_NAME_LOGICAL_NAME_WITH_CIPHERING);
+        }
+        ln->GetAuthenticationMechanismName().SetMechanismId(m_Settings.GetAuthentication());
+        ln->SetAssociationStatus(status);
+    }
+#endif //DLMS_IGNORE_ASSOCIATION_LOGICAL_NAME
+}
+
 /**
     * Parse AARQ request that client send and returns AARE request.
     *
@@ -535,51 +660,19 @@ int CGXDLMSServer::HandleAarqRequest(
         }
         if (m_Settings.GetUseLogicalNameReferencing())
         {
-#ifndef DLMS_IGNORE_ASSOCIATION_LOGICAL_NAME
-            unsigned char l[] = { 0,0,40,0,0,255 };
-            CGXDLMSAssociationLogicalName* ln = (CGXDLMSAssociationLogicalName*)m_Settings.GetObjects().FindByLN(DLMS_OBJECT_TYPE_ASSOCIATION_LOGICAL_NAME, l);
-            if (ln != NULL)
-            {
-                if (m_Settings.GetCipher() == NULL || m_Settings.GetCipher()->GetSecurity() == DLMS_SECURITY_NONE)
-                {
-                    ln->GetApplicationContextName().SetContextId(DLMS_APPLICATION_CONTEXT_NAME_LOGICAL_NAME);
-                }
-                else
-                {
-                    ln->GetApplicationContextName().SetContextId(DLMS_APPLICATION_CONTEXT_NAME_LOGICAL_NAME_WITH_CIPHERING);
-                }
-                ln->GetAuthenticationMechanismName().SetMechanismId(m_Settings.GetAuthentication());
-                ln->SetAssociationStatus(DLMS_ASSOCIATION_STATUS_ASSOCIATION_PENDING);
-            }
-#endif //DLMS_IGNORE_ASSOCIATION_LOGICAL_NAME
+            UpdateAssociation(DLMS_ASSOCIATION_STATUS_ASSOCIATION_PENDING);
         }
     }
     else
     {
-#ifndef DLMS_IGNORE_ASSOCIATION_LOGICAL_NAME
-        unsigned char l[] = { 0,0,40,0,0,255 };
-        CGXDLMSAssociationLogicalName* ln = (CGXDLMSAssociationLogicalName*)m_Settings.GetObjects().FindByLN(DLMS_OBJECT_TYPE_ASSOCIATION_LOGICAL_NAME, l);
-        if (ln != NULL)
-        {
-            if (m_Settings.GetCipher() == NULL || m_Settings.GetCipher()->GetSecurity() == DLMS_SECURITY_NONE)
-            {
-                ln->GetApplicationContextName().SetContextId(DLMS_APPLICATION_CONTEXT_NAME_LOGICAL_NAME);
-            }
-            else
-            {
-                ln->GetApplicationContextName().SetContextId(DLMS_APPLICATION_CONTEXT_NAME_LOGICAL_NAME_WITH_CIPHERING);
-            }
-            ln->GetAuthenticationMechanismName().SetMechanismId(m_Settings.GetAuthentication());
-            ln->SetAssociationStatus(DLMS_ASSOCIATION_STATUS_ASSOCIATED);
-        }
-#endif //DLMS_IGNORE_ASSOCIATION_LOGICAL_NAME
+        UpdateAssociation(DLMS_ASSOCIATION_STATUS_ASSOCIATED);
     }
     if (CGXDLMS::UseHdlc(m_Settings.GetInterfaceType()))
     {
         m_ReplyData.Set(LLC_REPLY_BYTES, 3);
     }
     // Generate AARE packet.
-    return CGXAPDU::GenerateAARE(m_Settings, m_ReplyData, result, diagnostic, m_Settings.GetCipher(), &error, NULL);
+    return GenerateCachedAARE(m_Settings, m_ReplyData, result, diagnostic, error);
 }
 
 /**
@@ -1050,12 +1143,26 @@ int CGXDLMSServer::HandleRequest(
     CGXByteBuffer& data,
     CGXByteBuffer& reply)
 {
-    CGXServerReply sr(data);
+    CGXServerReply sr;
+    //Received data is not copied.
+    sr.GetData().Attach(data.GetData(), data.GetSize());
     sr.SetConnectionInfo(connectionInfo);
+    if (reply.GetSize() == 0)
+    {
+        //Reply is generated to the buffer of the caller.
+        sr.GetReply() = std::move(reply);
+    }
     int ret = HandleRequest(sr);
     if (ret == 0)
     {
-        reply.Set(&sr.GetReply());
+        if (reply.GetSize() == 0)
+        {
+            reply = std::move(sr.GetReply());
+        }
+        else
+        {
+            reply.Set(&sr.GetReply());
+        }
     }
     return ret;
 }
@@ -1076,7 +1183,7 @@ int CGXDLMSServer::HandleRequest(
     CGXByteBuffer& reply)
 {
     CGXByteBuffer data;
-    data.Set(buff, size);
+    data.Attach(buff, size);
     return HandleRequest(connectionInfo, data, reply);
 }
 
@@ -1093,7 +1200,37 @@ int CGXDLMSServer::HandleRequest(
         //Server not Initialized.
         return DLMS_ERROR_CODE_NOT_INITIALIZED;
     }
-    m_ReceivedData.Set(&sr.GetData());
+    if (m_ReceivedData.GetSize() == 0)
+    {
+        //Frame is parsed in place if it's received at once.
+        m_ReceivedData.Attach(sr.GetData().GetData(), sr.GetData().GetSize());
+    }
+    else
+    {
+        m_ReceivedData.Set(&sr.GetData());
+    }
+    CGXDLMSArena* previous = CGXDLMSArena::GetCurrent();
+    if (m_Arena != NULL)
+    {
+        CGXDLMSArena::SetCurrent(m_Arena);
+    }
+    ret = HandleReceivedData(sr);
+    //Request data is not valid after this call so attached data is copied.
+    //Payload is copied first because it can be attached to the received data.
+    m_Info.GetData().Detach();
+    m_ReceivedData.Detach();
+    if (m_Arena != NULL)
+    {
+        //Temporary objects of the request are released at once.
+        m_Arena->Reset();
+        CGXDLMSArena::SetCurrent(previous);
+    }
+    return ret;
+}
+
+int CGXDLMSServer::HandleReceivedData(CGXServerReply& sr)
+{
+    int ret;
     CGXByteBuffer& reply = sr.GetReply();
     bool first = m_Settings.GetServerAddress() == 0
         && m_Settings.GetClientAddress() == 0;
@@ -1116,7 +1253,8 @@ int CGXDLMSServer::HandleRequest(
     {
         return 0;
     }
-    m_ReceivedData.Clear();
+    //Memory is not released because payload can be attached to it.
+    m_ReceivedData.SetSize(0);
     if (m_Info.GetCommand() == DLMS_COMMAND_DISCONNECT_REQUEST && m_Settings.GetConnected() == DLMS_CONNECTION_STATE_NONE)
     {
         ret = CGXDLMS::GetHdlcFrame(m_Settings, DLMS_COMMAND_DISCONNECT_MODE, NULL, reply);
@@ -1153,6 +1291,11 @@ int CGXDLMSServer::HandleRequest(
             return CGXDLMS::GetHdlcFrame(m_Settings, m_Settings.GetReceiverReady(), NULL, reply);
         }
     }
+    //Pre-established client doesn't send AARQ.
+    if ((m_Settings.GetConnected() & DLMS_CONNECTION_STATE_DLMS) == 0 && !m_PreEstablishedClients.empty())
+    {
+        PreEstablish(m_Info.GetCommand(), sr.GetConnectionInfo());
+    }
     // Check inactivity time out.
 #ifndef DLMS_IGNORE_IEC_HDLC_SETUP
     if (m_Hdlc != NULL && m_Hdlc->GetInactivityTimeout() != 0)
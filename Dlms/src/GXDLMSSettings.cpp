@@ -521,7 +521,7 @@ void CGXDLMSSettings::SetKek(CGXByteBuffer& value)
 /**
  * @return Long data count.
  */
-unsigned short CGXDLMSSettings::GetCount()
+unsigned long CGXDLMSSettings::GetCount()
 {
     return m_Count;
 }
@@ -530,7 +530,7 @@ unsigned short CGXDLMSSettings::GetCount()
  * @param count
  *            Long data count.
  */
-void CGXDLMSSettings::SetCount(unsigned short value)
+void CGXDLMSSettings::SetCount(unsigned long value)
 {
     m_Count = value;
 }
@@ -538,7 +538,7 @@ void CGXDLMSSettings::SetCount(unsigned short value)
 /**
  * @return Long data index.
  */
-unsigned short CGXDLMSSettings::GetIndex()
+unsigned long CGXDLMSSettings::GetIndex()
 {
     return m_Index;
 }
@@ -547,7 +547,7 @@ unsigned short CGXDLMSSettings::GetIndex()
  * @param index
  *            Long data index
  */
-void CGXDLMSSettings::SetIndex(unsigned short value)
+void CGXDLMSSettings::SetIndex(unsigned long value)
 {
     m_Index = value;
 }
@@ -225,13 +225,13 @@ int CGXDLMSSpecialDaysTable::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEve
         if (e.GetValue().vt == DLMS_DATA_TYPE_ARRAY)
         {
             CGXDLMSVariant tmp;
-            for (std::vector<CGXDLMSVariant>::iterator item = e.GetValue().Arr.begin(); item != e.GetValue().Arr.end(); ++item)
+            for (std::vector<CGXDLMSVariant>::iterator item = e.GetValue().Arr().begin(); item != e.GetValue().Arr().end(); ++item)
             {
                 CGXDLMSSpecialDay *it = new CGXDLMSSpecialDay();
-                it->SetIndex((*item).Arr[0].ToInteger());
-                CGXDLMSClient::ChangeType((*item).Arr[1], DLMS_DATA_TYPE_DATE, tmp);
-                it->SetDate(tmp.dateTime);
-                it->SetDayId((*item).Arr[2].ToInteger());
+                it->SetIndex((*item).Arr()[0].ToInteger());
+                CGXDLMSClient::ChangeType((*item).Arr()[1], DLMS_DATA_TYPE_DATE, tmp);
+                it->SetDate(tmp.dateTime());
+                it->SetDayId((*item).Arr()[2].ToInteger());
                 m_Entries.push_back(it);
             }
         }
@@ -223,16 +223,16 @@ int CGXDLMSTokenGateway::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEventAr
             {
                 return ret;
             }
-            m_Time = tmp.dateTime;
+            m_Time = tmp.dateTime();
         }
         else
         {
-            m_Time = e.GetValue().dateTime;
+            m_Time = e.GetValue().dateTime();
         }
         break;
     case 4:
         m_Descriptions.clear();
-        for (std::vector<CGXDLMSVariant>::iterator it = e.GetValue().Arr.begin(); it != e.GetValue().Arr.end(); ++it)
+        for (std::vector<CGXDLMSVariant>::iterator it = e.GetValue().Arr().begin(); it != e.GetValue().Arr().end(); ++it)
         {
             str.clear();
             str.append((const char*)it->byteArr, it->GetSize());
@@ -243,8 +243,8 @@ int CGXDLMSTokenGateway::SetValue(CGXDLMSSettings& settings, CGXDLMSValueEventAr
         m_DeliveryMethod = (DLMS_TOKEN_DELIVERY)e.GetValue().ToInteger();
         break;
     case 6:
-        m_Status = (DLMS_TOKEN_STATUS_CODE)e.GetValue().Arr[0].ToInteger();
-        m_DataValue = e.GetValue().Arr[1].strVal;
+        m_Status = (DLMS_TOKEN_STATUS_CODE)e.GetValue().Arr()[0].ToInteger();
+        m_DataValue = e.GetValue().Arr()[1].strVal();
         break;
     default:
         return DLMS_ERROR_CODE_READ_WRITE_DENIED;
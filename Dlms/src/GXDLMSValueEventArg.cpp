@@ -35,6 +35,31 @@
 #include "../include/GXDLMSValueEventArg.h"
 #include "../include/GXDLMSSettings.h"
 #include "../include/GXDLMSServer.h"
+#include "../include/GXDLMSArena.h"
+
+void* CGXDLMSValueEventArg::operator new(size_t size)
+{
+    CGXDLMSArena* arena = CGXDLMSArena::GetCurrent();
+    if (arena != NULL)
+    {
+        void* value = arena->Allocate((unsigned long)size);
+        if (value != NULL)
+        {
+            return value;
+        }
+    }
+    return ::operator new(size);
+}
+
+void CGXDLMSValueEventArg::operator delete(void* value)
+{
+    CGXDLMSArena* arena = CGXDLMSArena::GetCurrent();
+    //Memory from the arena is released when arena is reset.
+    if (arena == NULL || !arena->Contains(value))
+    {
+        ::operator delete(value);
+    }
+}
 
 CGXDLMSObject* CGXDLMSValueEventArg::GetTarget()
 {
@@ -63,7 +88,7 @@ CGXDLMSVariant& CGXDLMSValueEventArg::GetValue()
 
 void CGXDLMSValueEventArg::SetValue(CGXDLMSVariant value)
 {
-    m_Value = value;
+    m_Value = std::move(value);
 }
 
 bool CGXDLMSValueEventArg::GetHandled()
@@ -192,28 +217,28 @@ void CGXDLMSValueEventArg::SetSkipMaxPduSize(bool value)
     m_SkipMaxPduSize = value;
 }
 
-unsigned short CGXDLMSValueEventArg::GetRowToPdu()
+unsigned long CGXDLMSValueEventArg::GetRowToPdu()
 {
     return m_RowToPdu;
 }
 
-void CGXDLMSValueEventArg::SetRowToPdu(unsigned short value) {
+void CGXDLMSValueEventArg::SetRowToPdu(unsigned long value) {
     m_RowToPdu = value;
 }
 
-unsigned int CGXDLMSValueEventArg::GetRowEndIndex() {
+unsigned long CGXDLMSValueEventArg::GetRowEndIndex() {
     return m_RowEndIndex;
 }
 
-void CGXDLMSValueEventArg::SetRowEndIndex(unsigned int value) {
+void CGXDLMSValueEventArg::SetRowEndIndex(unsigned long value) {
     m_RowEndIndex = value;
 }
 
-unsigned int CGXDLMSValueEventArg::GetRowBeginIndex() {
+unsigned long CGXDLMSValueEventArg::GetRowBeginIndex() {
     return m_RowBeginIndex;
 }
 
-void CGXDLMSValueEventArg::SetRowBeginIndex(unsigned int value) {
+void CGXDLMSValueEventArg::SetRowBeginIndex(unsigned long value) {
     m_RowBeginIndex = value;
 }
 
@@ -33,11 +33,15 @@
 //---------------------------------------------------------------------------
 #include <assert.h>
 #include <string.h>
+#include <type_traits>
 #include "GXDLMSVariant.h"
 #include "GXErrorCodes.h"
 #include "GXHelpers.h"
 #include "GXBitString.h"
 
+//Vectors move the values when they grow only if move can't throw.
+static_assert(std::is_nothrow_move_constructible<CGXDLMSVariant>::value, "CGXDLMSVariant move must be noexcept.");
+
 int CGXDLMSVariant::Convert(CGXDLMSVariant* item, DLMS_DATA_TYPE type)
 {
     if (item->vt == type)
@@ -53,7 +57,7 @@ int CGXDLMSVariant::Convert(CGXDLMSVariant* item, DLMS_DATA_TYPE type)
             bool empty = true;
             std::stringstream sb;
             sb << "{";
-            for (std::vector<CGXDLMSVariant>::iterator it = tmp.Arr.begin(); it != tmp.Arr.end(); ++it)
+            for (std::vector<CGXDLMSVariant>::iterator it = tmp.Arr().begin(); it != tmp.Arr().end(); ++it)
             {
                 if (!empty)
                 {
@@ -66,7 +70,7 @@ int CGXDLMSVariant::Convert(CGXDLMSVariant* item, DLMS_DATA_TYPE type)
                 sb << it->ToString();
             }
             sb << "}";
-            item->strVal = sb.str();
+            item->strVal() = sb.str();
             item->vt = type;
             return DLMS_ERROR_CODE_OK;
         }
@@ -74,11 +78,11 @@ int CGXDLMSVariant::Convert(CGXDLMSVariant* item, DLMS_DATA_TYPE type)
         {
             if (tmp.boolVal == 0)
             {
-                item->strVal = "False";
+                item->strVal() = "False";
             }
             else
             {
-                item->strVal = "True";
+                item->strVal() = "True";
             }
             item->vt = type;
             return DLMS_ERROR_CODE_OK;
@@ -91,7 +95,7 @@ int CGXDLMSVariant::Convert(CGXDLMSVariant* item, DLMS_DATA_TYPE type)
 #else
             sprintf(buff, "%ld", tmp.lVal);
 #endif
-            item->strVal = buff;
+            item->strVal() = buff;
             item->vt = type;
             return DLMS_ERROR_CODE_OK;
         }
@@ -102,7 +106,7 @@ int CGXDLMSVariant::Convert(CGXDLMSVariant* item, DLMS_DATA_TYPE type)
 #else
             sprintf(buff, "%lu", tmp.ulVal);
 #endif
-            item->strVal = buff;
+            item->strVal() = buff;
             item->vt = type;
             return DLMS_ERROR_CODE_OK;
         }
@@ -113,7 +117,7 @@ int CGXDLMSVariant::Convert(CGXDLMSVariant* item, DLMS_DATA_TYPE type)
 #else
             sprintf(buff, "%d", tmp.cVal);
 #endif
-            item->strVal = buff;
+            item->strVal() = buff;
             item->vt = type;
             return DLMS_ERROR_CODE_OK;
         }
@@ -124,7 +128,7 @@ int CGXDLMSVariant::Convert(CGXDLMSVariant* item, DLMS_DATA_TYPE type)
 #else
             sprintf(buff, "%d", tmp.iVal);
 #endif
-            item->strVal = buff;
+            item->strVal() = buff;
             item->vt = type;
             return DLMS_ERROR_CODE_OK;
         }
@@ -135,7 +139,7 @@ int CGXDLMSVariant::Convert(CGXDLMSVariant* item, DLMS_DATA_TYPE type)
 #else
             sprintf(buff, "%d", tmp.bVal);
 #endif
-            item->strVal = buff;
+            item->strVal() = buff;
             item->vt = type;
             return DLMS_ERROR_CODE_OK;
         }
@@ -146,7 +150,7 @@ int CGXDLMSVariant::Convert(CGXDLMSVariant* item, DLMS_DATA_TYPE type)
 #else
             sprintf(buff, "%d", tmp.uiVal);
 #endif
-            item->strVal = buff;
+            item->strVal() = buff;
             item->vt = type;
             return DLMS_ERROR_CODE_OK;
         }
@@ -162,7 +166,7 @@ int CGXDLMSVariant::Convert(CGXDLMSVariant* item, DLMS_DATA_TYPE type)
 #else
             sprintf(buff, "%lld", tmp.llVal);
 #endif
-            item->strVal = buff;
+            item->strVal() = buff;
             item->vt = type;
             return DLMS_ERROR_CODE_OK;
         }
@@ -177,7 +181,7 @@ int CGXDLMSVariant::Convert(CGXDLMSVariant* item, DLMS_DATA_TYPE type)
 #else
             sprintf(buff, "%llu", tmp.ullVal);
 #endif
-            item->strVal = buff;
+            item->strVal() = buff;
             item->vt = type;
             return DLMS_ERROR_CODE_OK;
         }
@@ -188,7 +192,7 @@ int CGXDLMSVariant::Convert(CGXDLMSVariant* item, DLMS_DATA_TYPE type)
 #else
             sprintf(buff, "%d", tmp.bVal);
 #endif
-            item->strVal = buff;
+            item->strVal() = buff;
             item->vt = type;
             return DLMS_ERROR_CODE_OK;
         }
@@ -209,25 +213,25 @@ int CGXDLMSVariant::Convert(CGXDLMSVariant* item, DLMS_DATA_TYPE type)
                     buff[ret] = 0;
                 }
             }
-            item->strVal = buff;
+            item->strVal() = buff;
             item->vt = type;
             return DLMS_ERROR_CODE_OK;
         }
         if (tmp.vt == DLMS_DATA_TYPE_BIT_STRING)
         {
-            item->strVal = tmp.strVal;
+            item->strVal() = tmp.strVal();
             item->vt = type;
             return DLMS_ERROR_CODE_OK;
         }
         if (tmp.vt == DLMS_DATA_TYPE_DATETIME)
         {
-            item->strVal = tmp.dateTime.ToString();
+            item->strVal() = tmp.dateTime().ToString();
             item->vt = type;
             return DLMS_ERROR_CODE_OK;
         }
         if (tmp.vt == DLMS_DATA_TYPE_OCTET_STRING)
         {
-            item->strVal = GXHelpers::BytesToHex(tmp.byteArr, tmp.GetSize());
+            item->strVal() = GXHelpers::BytesToHex(tmp.byteArr, tmp.GetSize());
             item->vt = type;
             return DLMS_ERROR_CODE_OK;
         }
@@ -238,16 +242,16 @@ int CGXDLMSVariant::Convert(CGXDLMSVariant* item, DLMS_DATA_TYPE type)
         item->Clear();
         if (type == DLMS_DATA_TYPE_BOOLEAN)
         {
-            item->boolVal = tmp.strVal.compare("False") == 0 ? 0 : 1;
+            item->boolVal = tmp.strVal().compare("False") == 0 ? 0 : 1;
             item->vt = type;
             return DLMS_ERROR_CODE_OK;
         }
         if (type == DLMS_DATA_TYPE_INT32)
         {
 #if _MSC_VER > 1000
-            sscanf_s(tmp.strVal.c_str(), "%ld", &item->lVal);
+            sscanf_s(tmp.strVal().c_str(), "%ld", &item->lVal);
 #else
-            sscanf(tmp.strVal.c_str(), "%ld", &item->lVal);
+            sscanf(tmp.strVal().c_str(), "%ld", &item->lVal);
 #endif
             item->vt = type;
             return DLMS_ERROR_CODE_OK;
@@ -255,9 +259,9 @@ int CGXDLMSVariant::Convert(CGXDLMSVariant* item, DLMS_DATA_TYPE type)
         if (type == DLMS_DATA_TYPE_UINT32)
         {
 #if _MSC_VER > 1000
-            sscanf_s(tmp.strVal.c_str(), "%lu", &item->ulVal);
+            sscanf_s(tmp.strVal().c_str(), "%lu", &item->ulVal);
 #else
-            sscanf(tmp.strVal.c_str(), "%lu", &item->ulVal);
+            sscanf(tmp.strVal().c_str(), "%lu", &item->ulVal);
 #endif
             item->vt = type;
             return DLMS_ERROR_CODE_OK;
@@ -265,9 +269,9 @@ int CGXDLMSVariant::Convert(CGXDLMSVariant* item, DLMS_DATA_TYPE type)
         if (type == DLMS_DATA_TYPE_INT8)
         {
 #if _MSC_VER > 1000
-            sscanf_s(tmp.strVal.c_str(), "%c", &item->cVal, 1);
+            sscanf_s(tmp.strVal().c_str(), "%c", &item->cVal, 1);
 #else
-            sscanf(tmp.strVal.c_str(), "%c", &item->cVal);
+            sscanf(tmp.strVal().c_str(), "%c", &item->cVal);
 #endif
             item->vt = type;
             return DLMS_ERROR_CODE_OK;
@@ -275,9 +279,9 @@ int CGXDLMSVariant::Convert(CGXDLMSVariant* item, DLMS_DATA_TYPE type)
         if (type == DLMS_DATA_TYPE_INT16)
         {
 #if _MSC_VER > 1000
-            sscanf_s(tmp.strVal.c_str(), "%hd", &item->iVal);
+            sscanf_s(tmp.strVal().c_str(), "%hd", &item->iVal);
 #else
-            sscanf(tmp.strVal.c_str(), "%hd", &item->iVal);
+            sscanf(tmp.strVal().c_str(), "%hd", &item->iVal);
 #endif
             item->vt = type;
             return DLMS_ERROR_CODE_OK;
@@ -285,10 +289,10 @@ int CGXDLMSVariant::Convert(CGXDLMSVariant* item, DLMS_DATA_TYPE type)
         if (type == DLMS_DATA_TYPE_UINT8)
         {
 #if _MSC_VER > 1000
-            sscanf_s(tmp.strVal.c_str(), "%hhu", &item->bVal);
+            sscanf_s(tmp.strVal().c_str(), "%hhu", &item->bVal);
 #else
             int value;
-            sscanf(tmp.strVal.c_str(), "%d", &value);
+            sscanf(tmp.strVal().c_str(), "%d", &value);
             item->bVal = value & 0xFF;
 #endif
             item->vt = type;
@@ -297,10 +301,10 @@ int CGXDLMSVariant::Convert(CGXDLMSVariant* item, DLMS_DATA_TYPE type)
         if (type == DLMS_DATA_TYPE_UINT16)
         {
 #if _MSC_VER > 1000
-            sscanf_s(tmp.strVal.c_str(), "%hu", &item->uiVal);
+            sscanf_s(tmp.strVal().c_str(), "%hu", &item->uiVal);
 #else
             int value;
-            sscanf(tmp.strVal.c_str(), "%d", &value);
+            sscanf(tmp.strVal().c_str(), "%d", &value);
             item->uiVal = value & 0xFFFF;
 #endif
             item->vt = type;
@@ -310,12 +314,12 @@ int CGXDLMSVariant::Convert(CGXDLMSVariant* item, DLMS_DATA_TYPE type)
         {
 #if defined(_WIN32) || defined(_WIN64)//Windows
 #if _MSC_VER > 1000
-            sscanf_s(tmp.strVal.c_str(), "%lld", &item->llVal);
+            sscanf_s(tmp.strVal().c_str(), "%lld", &item->llVal);
 #else
-            sscanf(tmp.strVal.c_str(), "%I64d", &item->llVal);
+            sscanf(tmp.strVal().c_str(), "%I64d", &item->llVal);
 #endif
 #else
-            sscanf(tmp.strVal.c_str(), "%lld", &item->llVal);
+            sscanf(tmp.strVal().c_str(), "%lld", &item->llVal);
 #endif
             item->vt = type;
             return DLMS_ERROR_CODE_OK;
@@ -324,12 +328,12 @@ int CGXDLMSVariant::Convert(CGXDLMSVariant* item, DLMS_DATA_TYPE type)
         {
 #if defined(_WIN32) || defined(_WIN64)//Windows
 #if _MSC_VER > 1000
-            sscanf_s(tmp.strVal.c_str(), "%llu", &item->ullVal);
+            sscanf_s(tmp.strVal().c_str(), "%llu", &item->ullVal);
 #else
-            sscanf(tmp.strVal.c_str(), "%I64u", &item->ullVal);
+            sscanf(tmp.strVal().c_str(), "%I64u", &item->ullVal);
 #endif
 #else
-            sscanf(tmp.strVal.c_str(), "%llu", &item->ullVal);
+            sscanf(tmp.strVal().c_str(), "%llu", &item->ullVal);
 #endif
 
 #if _MSC_VER > 1000
@@ -341,10 +345,10 @@ int CGXDLMSVariant::Convert(CGXDLMSVariant* item, DLMS_DATA_TYPE type)
         if (type == DLMS_DATA_TYPE_ENUM)
         {
 #if _MSC_VER > 1000
-            sscanf_s(tmp.strVal.c_str(), "%hhu", &item->bVal);
+            sscanf_s(tmp.strVal().c_str(), "%hhu", &item->bVal);
 #else
             int value;
-            sscanf(tmp.strVal.c_str(), "%d", &value);
+            sscanf(tmp.strVal().c_str(), "%d", &value);
             item->bVal = value & 0xFF;
 #endif
             item->vt = type;
@@ -353,9 +357,9 @@ int CGXDLMSVariant::Convert(CGXDLMSVariant* item, DLMS_DATA_TYPE type)
         if (type == DLMS_DATA_TYPE_FLOAT32)
         {
 #if _MSC_VER > 1000
-            sscanf_s(tmp.strVal.c_str(), "%f", &item->fltVal);
+            sscanf_s(tmp.strVal().c_str(), "%f", &item->fltVal);
 #else
-            sscanf(tmp.strVal.c_str(), "%f", &item->fltVal);
+            sscanf(tmp.strVal().c_str(), "%f", &item->fltVal);
 #endif
             item->vt = type;
             return DLMS_ERROR_CODE_OK;
@@ -363,9 +367,9 @@ int CGXDLMSVariant::Convert(CGXDLMSVariant* item, DLMS_DATA_TYPE type)
         if (type == DLMS_DATA_TYPE_FLOAT64)
         {
 #if _MSC_VER > 1000
-            sscanf_s(tmp.strVal.c_str(), "%lf", &item->dblVal);
+            sscanf_s(tmp.strVal().c_str(), "%lf", &item->dblVal);
 #else
-            sscanf(tmp.strVal.c_str(), "%lf", &item->dblVal);
+            sscanf(tmp.strVal().c_str(), "%lf", &item->dblVal);
 #endif
             item->vt = type;
             return DLMS_ERROR_CODE_OK;
@@ -373,7 +377,7 @@ int CGXDLMSVariant::Convert(CGXDLMSVariant* item, DLMS_DATA_TYPE type)
         if (type == DLMS_DATA_TYPE_OCTET_STRING)
         {
             CGXByteBuffer tmp2;
-            GXHelpers::HexToBytes(tmp.strVal, tmp2);
+            GXHelpers::HexToBytes(tmp.strVal(), tmp2);
             item->Add(tmp2.GetData(), tmp2.GetSize());
             item->vt = type;
             return DLMS_ERROR_CODE_OK;
@@ -424,8 +428,21 @@ int CGXDLMSVariant::Convert(CGXDLMSVariant* item, DLMS_DATA_TYPE type)
 
 void CGXDLMSVariant::Clear()
 {
-    Arr.clear();
-    strVal.clear();
+    if (pArr != NULL)
+    {
+        delete pArr;
+        pArr = NULL;
+    }
+    if (pStrVal != NULL)
+    {
+        delete pStrVal;
+        pStrVal = NULL;
+    }
+    if (pDateTime != NULL)
+    {
+        delete pDateTime;
+        pDateTime = NULL;
+    }
     if (vt == DLMS_DATA_TYPE_OCTET_STRING && byteArr != NULL)
     {
         if (size == 0)
@@ -464,13 +481,13 @@ CGXDLMSVariant::CGXDLMSVariant(CGXDLMSVariant* value)
     else if (vt == DLMS_DATA_TYPE_STRING ||
         vt == DLMS_DATA_TYPE_BIT_STRING)
     {
-        this->strVal.append(value->strVal);
+        this->strVal().append(value->strVal());
     }
     else if (vt == DLMS_DATA_TYPE_DATETIME ||
         vt == DLMS_DATA_TYPE_DATE ||
         vt == DLMS_DATA_TYPE_TIME)
     {
-        this->dateTime = value->dateTime;
+        this->dateTime() = value->dateTime();
     }
     else if (vt == DLMS_DATA_TYPE_OCTET_STRING)
     {
@@ -483,9 +500,9 @@ CGXDLMSVariant::CGXDLMSVariant(CGXDLMSVariant* value)
     }
     else if (vt == DLMS_DATA_TYPE_ARRAY || vt == DLMS_DATA_TYPE_STRUCTURE)
     {
-        for (std::vector<CGXDLMSVariant>::iterator it = value->Arr.begin(); it != value->Arr.end(); ++it)
+        for (std::vector<CGXDLMSVariant>::iterator it = value->Arr().begin(); it != value->Arr().end(); ++it)
         {
-            Arr.push_back(*it);
+            Arr().push_back(*it);
         }
     }
     else
@@ -562,7 +579,7 @@ CGXDLMSVariant::CGXDLMSVariant(long value)
 CGXDLMSVariant::CGXDLMSVariant(struct tm value)
 {
     vt = DLMS_DATA_TYPE_DATETIME;
-    dateTime.SetValue(value);
+    dateTime().SetValue(value);
 }
 
 CGXDLMSVariant::CGXDLMSVariant(CGXByteBuffer& value)
@@ -583,19 +600,20 @@ CGXDLMSVariant::CGXDLMSVariant(CGXByteBuffer& value)
 CGXDLMSVariant::CGXDLMSVariant(CGXDate& value)
 {
     vt = DLMS_DATA_TYPE_DATE;
-    dateTime = value;
+    pDateTime = new CGXDateTime(value);
 }
 
 CGXDLMSVariant::CGXDLMSVariant(CGXTime& value)
 {
     vt = DLMS_DATA_TYPE_TIME;
-    dateTime = value;
+    pDateTime = new CGXDateTime(value);
 }
 
 CGXDLMSVariant::CGXDLMSVariant(CGXDateTime& value)
 {
     vt = DLMS_DATA_TYPE_DATETIME;
-    dateTime = value;
+    //Copy constructor is used so current time is not resolved for nothing.
+    pDateTime = new CGXDateTime(value);
 }
 
 CGXDLMSVariant::CGXDLMSVariant(unsigned char value)
@@ -625,7 +643,7 @@ CGXDLMSVariant::CGXDLMSVariant(unsigned long value)
 CGXDLMSVariant::CGXDLMSVariant(std::string value)
 {
     vt = DLMS_DATA_TYPE_STRING;
-    strVal = value;
+    strVal() = value;
 }
 
 CGXDLMSVariant::CGXDLMSVariant(unsigned char* value, int count)
@@ -645,11 +663,21 @@ CGXDLMSVariant::CGXDLMSVariant(unsigned char* value, int count)
 
 CGXDLMSVariant::CGXDLMSVariant(const CGXDLMSVariant& value)
 {
+    Copy(value);
+}
+
+CGXDLMSVariant::CGXDLMSVariant(CGXDLMSVariant&& value) noexcept
+{
+    MoveFrom(value);
+}
+
+void CGXDLMSVariant::Copy(const CGXDLMSVariant& value)
+{
+    vt = value.vt;
+    size = value.size;
     //If Octect String, copy byte buffer.
     if (value.vt == DLMS_DATA_TYPE_OCTET_STRING)
     {
-        vt = value.vt;
-        size = value.size;
         if (size != 0)
         {
             byteArr = (unsigned char*)malloc(size);
@@ -662,31 +690,104 @@ CGXDLMSVariant::CGXDLMSVariant(const CGXDLMSVariant& value)
     }
     else
     {
-        *((dlmsVARIANT*)this) = value;
+        ullVal = value.ullVal;
+    }
+    //Empty values are not copied.
+    if (value.pDateTime != NULL)
+    {
+        pDateTime = new CGXDateTime(*value.pDateTime);
     }
+    if (value.pStrVal != NULL && !value.pStrVal->empty())
+    {
+        pStrVal = new std::string(*value.pStrVal);
+    }
+    if (value.pArr != NULL && !value.pArr->empty())
+    {
+        pArr = new std::vector<CGXDLMSVariant>(*value.pArr);
+    }
+}
+
+void CGXDLMSVariant::MoveFrom(CGXDLMSVariant& value)
+{
+    vt = value.vt;
+    size = value.size;
+    ullVal = value.ullVal;
+    pDateTime = value.pDateTime;
+    pStrVal = value.pStrVal;
+    pArr = value.pArr;
+    value.vt = DLMS_DATA_TYPE_NONE;
+    value.size = 0;
+    value.byteArr = NULL;
+    value.pDateTime = NULL;
+    value.pStrVal = NULL;
+    value.pArr = NULL;
 }
 
 CGXDLMSVariant& CGXDLMSVariant::operator=(const CGXDLMSVariant& value)
 {
-    Clear();
-    //If Octect String, copy byte buffer.
-    if (value.vt == DLMS_DATA_TYPE_OCTET_STRING)
+    if (this != &value)
     {
-        vt = value.vt;
-        size = value.size;
-        if (size != 0)
-        {
-            byteArr = (unsigned char*)malloc(size);
-            memcpy(byteArr, value.byteArr, size);
-        }
+        Clear();
+        Copy(value);
     }
-    else
+    return *this;
+}
+
+CGXDLMSVariant& CGXDLMSVariant::operator=(CGXDLMSVariant&& value) noexcept
+{
+    if (this != &value)
     {
-        *((dlmsVARIANT*)this) = value;
+        Clear();
+        MoveFrom(value);
     }
     return *this;
 }
 
+CGXDateTime& CGXDLMSVariant::dateTime()
+{
+    if (pDateTime == NULL)
+    {
+        pDateTime = new CGXDateTime();
+    }
+    return *pDateTime;
+}
+
+const CGXDateTime& CGXDLMSVariant::dateTime() const
+{
+    static const CGXDateTime EMPTY;
+    return pDateTime == NULL ? EMPTY : *pDateTime;
+}
+
+std::string& CGXDLMSVariant::strVal()
+{
+    if (pStrVal == NULL)
+    {
+        pStrVal = new std::string();
+    }
+    return *pStrVal;
+}
+
+const std::string& CGXDLMSVariant::strVal() const
+{
+    static const std::string EMPTY;
+    return pStrVal == NULL ? EMPTY : *pStrVal;
+}
+
+std::vector<CGXDLMSVariant>& CGXDLMSVariant::Arr()
+{
+    if (pArr == NULL)
+    {
+        pArr = new std::vector<CGXDLMSVariant>();
+    }
+    return *pArr;
+}
+
+const std::vector<CGXDLMSVariant>& CGXDLMSVariant::Arr() const
+{
+    static const std::vector<CGXDLMSVariant> EMPTY;
+    return pArr == NULL ? EMPTY : *pArr;
+}
+
 CGXDLMSVariant& CGXDLMSVariant::operator=(CGXByteBuffer& value)
 {
     Clear();
@@ -703,7 +804,7 @@ CGXDLMSVariant& CGXDLMSVariant::operator=(CGXByteBuffer& value)
 CGXDLMSVariant::CGXDLMSVariant(const char* value)
 {
     vt = DLMS_DATA_TYPE_STRING;
-    strVal.append(value);
+    strVal().append(value);
 }
 
 CGXDLMSVariant::CGXDLMSVariant(unsigned char* pValue, int count, DLMS_DATA_TYPE type)
@@ -723,7 +824,7 @@ CGXDLMSVariant& CGXDLMSVariant::operator=(std::string value)
 {
     Clear();
     vt = DLMS_DATA_TYPE_STRING;
-    strVal.append(value);
+    strVal().append(value);
     return *this;
 }
 
@@ -731,7 +832,7 @@ CGXDLMSVariant& CGXDLMSVariant::operator=(const char* value)
 {
     Clear();
     vt = DLMS_DATA_TYPE_STRING;
-    strVal.append(value);
+    strVal().append(value);
     return *this;
 }
 
@@ -837,7 +938,7 @@ CGXDLMSVariant& CGXDLMSVariant::operator=(struct tm value)
 {
     Clear();
     vt = DLMS_DATA_TYPE_DATETIME;
-    dateTime.SetValue(value);
+    dateTime().SetValue(value);
     return *this;
 }
 
@@ -845,7 +946,7 @@ CGXDLMSVariant& CGXDLMSVariant::operator=(CGXDate& value)
 {
     Clear();
     vt = DLMS_DATA_TYPE_DATE;
-    dateTime = value;
+    pDateTime = new CGXDateTime(value);
     return *this;
 }
 
@@ -853,7 +954,7 @@ CGXDLMSVariant& CGXDLMSVariant::operator=(CGXTime& value)
 {
     Clear();
     vt = DLMS_DATA_TYPE_TIME;
-    dateTime = value;
+    pDateTime = new CGXDateTime(value);
     return *this;
 }
 
@@ -861,7 +962,7 @@ CGXDLMSVariant& CGXDLMSVariant::operator=(CGXDateTime& value)
 {
     Clear();
     vt = DLMS_DATA_TYPE_DATETIME;
-    dateTime = value;
+    pDateTime = new CGXDateTime(value);
     return *this;
 }
 
@@ -1190,12 +1291,12 @@ int CGXDLMSVariant::ChangeType(DLMS_DATA_TYPE newType)
 }
 
 //Get size in bytes.
-int CGXDLMSVariant::GetSize()
+int CGXDLMSVariant::GetSize() const
 {
     if (this->vt == DLMS_DATA_TYPE_STRING ||
         this->vt == DLMS_DATA_TYPE_BIT_STRING)
     {
-        return (int)strVal.size();
+        return (int)strVal().size();
     }
     if (this->vt == DLMS_DATA_TYPE_OCTET_STRING)
     {
@@ -1260,18 +1361,18 @@ int CGXDLMSVariant::GetSize(DLMS_DATA_TYPE vt)
     return nSize;
 }
 
-std::string CGXDLMSVariant::ToString()
+std::string CGXDLMSVariant::ToString() const
 {
-    CGXDLMSVariant tmp(this);
+    CGXDLMSVariant tmp(*this);
     tmp.ChangeType(DLMS_DATA_TYPE_STRING);
-    if (tmp.strVal.length() == 0)
+    if (tmp.strVal().length() == 0)
     {
         return "";
     }
-    return tmp.strVal;
+    return tmp.strVal();
 }
 
-int CGXDLMSVariant::ToInteger()
+int CGXDLMSVariant::ToInteger() const
 {
     if (vt == DLMS_DATA_TYPE_NONE)
     {
@@ -1342,9 +1443,9 @@ int CGXDLMSVariant::ToInteger()
     {
         int val = 0;
 #if _MSC_VER > 1000
-        if (sscanf_s(strVal.c_str(), "%d", &val) == -1)
+        if (sscanf_s(strVal().c_str(), "%d", &val) == -1)
 #else
-        if (sscanf(strVal.c_str(), "%d", &val) == -1)
+        if (sscanf(strVal().c_str(), "%d", &val) == -1)
 #endif
         {
             assert(0);
@@ -1354,7 +1455,7 @@ int CGXDLMSVariant::ToInteger()
     if (vt == DLMS_DATA_TYPE_BIT_STRING)
     {
         int val;
-        CGXBitString bs(strVal);
+        CGXBitString bs(strVal());
         bs.ToInteger(val);
         return val;
     }
@@ -1362,7 +1463,7 @@ int CGXDLMSVariant::ToInteger()
     return 0;
 }
 
-double CGXDLMSVariant::ToDouble()
+double CGXDLMSVariant::ToDouble() const
 {
     if (vt == DLMS_DATA_TYPE_NONE)
     {
@@ -1476,7 +1577,7 @@ int CGXDLMSVariant::GetBytes(CGXByteBuffer& value)
     }
     else if (vt == DLMS_DATA_TYPE_STRING)
     {
-        value.AddString(strVal.c_str());
+        value.AddString(strVal().c_str());
     }
     else if (vt == DLMS_DATA_TYPE_FLOAT32)
     {
@@ -1494,7 +1595,7 @@ int CGXDLMSVariant::GetBytes(CGXByteBuffer& value)
     return 0;
 }
 
-bool CGXDLMSVariant::IsNumber()
+bool CGXDLMSVariant::IsNumber() const
 {
     switch (vt)
     {
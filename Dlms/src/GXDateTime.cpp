@@ -867,6 +867,11 @@ struct tm& CGXDateTime::GetValue()
     return m_Value;
 }
 
+const struct tm& CGXDateTime::GetValue() const
+{
+    return m_Value;
+}
+
 unsigned char CGXDateTime::DaysInMonth(int year, short month)
 {
     if (month == 0 || month == 2 || month == 4 ||
@@ -1329,3 +1334,9 @@ unsigned long CGXDateTime::ToUnixTime()
 {
     return (unsigned long)mktime(&m_Value);
 }
+
+unsigned long CGXDateTime::ToUnixTime() const
+{
+    struct tm tmp = m_Value;
+    return (unsigned long)mktime(&tmp);
+}
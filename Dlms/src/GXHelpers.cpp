@@ -65,7 +65,7 @@ static int GetArray(CGXDLMSSettings* settings, CGXByteBuffer& buff, CGXDataInfo&
             return ret;
         }
         info.SetCount(cnt);
-        value.Arr.reserve(cnt);
+        value.Arr().reserve(cnt);
     }
 #ifndef DLMS_IGNORE_XML_TRANSLATOR
     if (info.GetXml() != NULL)
@@ -107,7 +107,7 @@ static int GetArray(CGXDLMSSettings* settings, CGXByteBuffer& buff, CGXDataInfo&
             if (info2.GetCount() == info2.GetIndex())
             {
                 startIndex = buff.GetPosition();
-                value.Arr.push_back(tmp);
+                value.Arr().push_back(tmp);
             }
         }
     }
@@ -1085,12 +1085,12 @@ int GetUtfString(CGXByteBuffer& buff, CGXDataInfo& info, bool knownType, CGXDLMS
         tmp = new char[len];
         buff.Get((unsigned char*)tmp, len);
         value.vt = DLMS_DATA_TYPE_STRING_UTF8;
-        value.strVal.append(tmp, len);
+        value.strVal().append(tmp, len);
         delete tmp;
 #ifndef DLMS_IGNORE_XML_TRANSLATOR
         if (info.GetXml() != NULL)
         {
-            info.GetXml()->AppendLine(info.GetXml()->GetDataType(info.GetType()), "", value.strVal);
+            info.GetXml()->AppendLine(info.GetXml()->GetDataType(info.GetType()), "", value.strVal());
         }
 #endif //DLMS_IGNORE_XML_TRANSLATOR
     }
@@ -1182,7 +1182,7 @@ int GetOctetString(CGXByteBuffer& buff, CGXDataInfo& info, bool knownType, CGXDL
                         CGXDLMSVariant tmp;
                         if (CGXDLMSClient::ChangeType(value, type, tmp) == 0)
                         {
-                            info.GetXml()->AppendComment(tmp.dateTime.ToString());
+                            info.GetXml()->AppendComment(tmp.dateTime().ToString());
                             isString = false;
                         }
                     }
@@ -1259,7 +1259,7 @@ int GetString(CGXByteBuffer& buff, CGXDataInfo& info, bool knownType, CGXDLMSVar
 #ifndef DLMS_IGNORE_XML_TRANSLATOR
     if (info.GetXml() != NULL)
     {
-        info.GetXml()->AppendLine(info.GetXml()->GetDataType(info.GetType()), "", value.strVal);
+        info.GetXml()->AppendLine(info.GetXml()->GetDataType(info.GetType()), "", value.strVal());
     }
 #endif //DLMS_IGNORE_XML_TRANSLATOR
     return 0;
@@ -1452,14 +1452,14 @@ int GXHelpers::GetCompactArrayItem(
     {
         if (it->vt == DLMS_DATA_TYPE_ARRAY || it->vt == DLMS_DATA_TYPE_STRUCTURE)
         {
-            if ((ret = GetCompactArrayItem(settings, buff, it->Arr, tmp.Arr, 1)) != 0)
+            if ((ret = GetCompactArrayItem(settings, buff, it->Arr(), tmp.Arr(), 1)) != 0)
             {
                 return ret;
             }
         }
         else
         {
-            if ((ret = GetCompactArrayItem(settings, buff, (DLMS_DATA_TYPE)it->bVal, tmp.Arr, 1)) != 0)
+            if ((ret = GetCompactArrayItem(settings, buff, (DLMS_DATA_TYPE)it->bVal, tmp.Arr(), 1)) != 0)
             {
                 return ret;
             }
@@ -1565,7 +1565,7 @@ int GXHelpers::GetDataTypes(
             tmp2.vt = DLMS_DATA_TYPE_ARRAY;
             GetDataTypes(buff, tmp, 1);
             for (int i = 0; i != cnt; ++i) {
-                tmp2.Arr.push_back(tmp[0]);
+                tmp2.Arr().push_back(tmp[0]);
             }
             cols.push_back(tmp2);
         }
@@ -1577,7 +1577,7 @@ int GXHelpers::GetDataTypes(
                 return ret;
             }
             tmp.vt = DLMS_DATA_TYPE_STRUCTURE;
-            GetDataTypes(buff, tmp.Arr, ch);
+            GetDataTypes(buff, tmp.Arr(), ch);
             cols.push_back(tmp);
         }
         else
@@ -1600,7 +1600,7 @@ int GXHelpers::AppendDataTypeAsXml(
 #ifndef DLMS_IGNORE_XML_TRANSLATOR
             info.GetXml()->AppendStartTag(DATA_TYPE_OFFSET + DLMS_DATA_TYPE_ARRAY, "", val);
 #endif //DLMS_IGNORE_XML_TRANSLATOR
-            AppendDataTypeAsXml(it->Arr, info);
+            AppendDataTypeAsXml(it->Arr(), info);
 #ifndef DLMS_IGNORE_XML_TRANSLATOR
             info.GetXml()->AppendEndTag(DATA_TYPE_OFFSET + DLMS_DATA_TYPE_ARRAY);
 #endif //DLMS_IGNORE_XML_TRANSLATOR
@@ -1610,7 +1610,7 @@ int GXHelpers::AppendDataTypeAsXml(
 #ifndef DLMS_IGNORE_XML_TRANSLATOR
             info.GetXml()->AppendStartTag(DATA_TYPE_OFFSET + DLMS_DATA_TYPE_STRUCTURE, "", val);
 #endif //DLMS_IGNORE_XML_TRANSLATOR
-            AppendDataTypeAsXml(it->Arr, info);
+            AppendDataTypeAsXml(it->Arr(), info);
 #ifndef DLMS_IGNORE_XML_TRANSLATOR
             info.GetXml()->AppendEndTag(DATA_TYPE_OFFSET + DLMS_DATA_TYPE_STRUCTURE);
 #endif //DLMS_IGNORE_XML_TRANSLATOR
@@ -1700,7 +1700,7 @@ int GXHelpers::GetCompactArray(
                 CGXDLMSVariant& tmp = cols.at(pos);
                 if (tmp.vt == DLMS_DATA_TYPE_STRUCTURE)
                 {
-                    if ((ret = GetCompactArrayItem(settings, buff, tmp.Arr, row.Arr, 1)) != 0)
+                    if ((ret = GetCompactArrayItem(settings, buff, tmp.Arr(), row.Arr(), 1)) != 0)
                     {
                         return ret;
                     }
@@ -1708,15 +1708,15 @@ int GXHelpers::GetCompactArray(
                 else if (tmp.vt == DLMS_DATA_TYPE_ARRAY)
                 {
                     std::vector<CGXDLMSVariant> tmp2;
-                    if ((ret = GetCompactArrayItem(settings, buff, tmp.Arr, tmp2, 1)) != 0)
+                    if ((ret = GetCompactArrayItem(settings, buff, tmp.Arr(), tmp2, 1)) != 0)
                     {
                         return ret;
                     }
-                    row.Arr.insert(row.Arr.end(), tmp2.at(0).Arr.begin(), tmp2.at(0).Arr.end());
+                    row.Arr().insert(row.Arr().end(), tmp2.at(0).Arr().begin(), tmp2.at(0).Arr().end());
                 }
                 else
                 {
-                    if ((ret = GetCompactArrayItem(settings, buff, (DLMS_DATA_TYPE)tmp.cVal, row.Arr, 1)) != 0)
+                    if ((ret = GetCompactArrayItem(settings, buff, (DLMS_DATA_TYPE)tmp.cVal, row.Arr(), 1)) != 0)
                     {
                         return ret;
                     }
@@ -1727,9 +1727,9 @@ int GXHelpers::GetCompactArray(
                 }
             }
             // If all columns are read.
-            if (row.Arr.size() >= cols.size())
+            if (row.Arr().size() >= cols.size())
             {
-                value.Arr.push_back(row);
+                value.Arr().push_back(row);
             }
             else
             {
@@ -1739,10 +1739,10 @@ int GXHelpers::GetCompactArray(
 #ifndef DLMS_IGNORE_XML_TRANSLATOR
         if (info.GetXml() != NULL && info.GetXml()->GetOutputType() == DLMS_TRANSLATOR_OUTPUT_TYPE_SIMPLE_XML)
         {
-            for (std::vector<CGXDLMSVariant>::iterator row = value.Arr.begin(); row != value.Arr.end(); ++row)
+            for (std::vector<CGXDLMSVariant>::iterator row = value.Arr().begin(); row != value.Arr().end(); ++row)
             {
                 std::ostringstream sb;
-                for (std::vector<CGXDLMSVariant>::iterator it = row->Arr.begin(); it != row->Arr.end(); ++it)
+                for (std::vector<CGXDLMSVariant>::iterator it = row->Arr().begin(); it != row->Arr().end(); ++it)
                 {
                     if (it->vt == DLMS_DATA_TYPE_OCTET_STRING)
                     {
@@ -1751,7 +1751,7 @@ int GXHelpers::GetCompactArray(
                     else if (it->vt == DLMS_DATA_TYPE_ARRAY ||
                         it->vt == DLMS_DATA_TYPE_STRUCTURE)
                     {
-                        for (std::vector<CGXDLMSVariant>::iterator it2 = it->Arr.begin(); it2 != it->Arr.end(); ++it2)
+                        for (std::vector<CGXDLMSVariant>::iterator it2 = it->Arr().begin(); it2 != it->Arr().end(); ++it2)
                         {
                             if (it2->vt == DLMS_DATA_TYPE_OCTET_STRING)
                             {
@@ -1761,7 +1761,7 @@ int GXHelpers::GetCompactArray(
                             {
                                 sb << it2->ToString();
                             }
-                            if (it2 + 1 != it->Arr.end())
+                            if (it2 + 1 != it->Arr().end())
                             {
                                 sb << ';';
                             }
@@ -1771,7 +1771,7 @@ int GXHelpers::GetCompactArray(
                     {
                         sb << it->ToString();
                     }
-                    if (it + 1 != row->Arr.end())
+                    if (it + 1 != row->Arr().end())
                     {
                         sb << ';';
                     }
@@ -1808,18 +1808,18 @@ int GXHelpers::GetCompactArray(
             }
         }
 #endif //DLMS_IGNORE_XML_TRANSLATOR
-        GetCompactArrayItem(settings, buff, dt, value.Arr, len);
+        GetCompactArrayItem(settings, buff, dt, value.Arr(), len);
 #ifndef DLMS_IGNORE_XML_TRANSLATOR
         if (info.GetXml() != NULL && info.GetXml()->GetOutputType() == DLMS_TRANSLATOR_OUTPUT_TYPE_SIMPLE_XML)
         {
             std::string separator = ";";
-            for (std::vector<CGXDLMSVariant>::iterator it = value.Arr.begin(); it != value.Arr.end(); ++it)
+            for (std::vector<CGXDLMSVariant>::iterator it = value.Arr().begin(); it != value.Arr().end(); ++it)
             {
                 str = it->ToString();
                 info.GetXml()->Append(str);
                 info.GetXml()->Append(separator);
             }
-            if (value.Arr.size() != 0)
+            if (value.Arr().size() != 0)
             {
                 info.GetXml()->SetXmlLength(info.GetXml()->GetXmlLength() - 1);
             }
@@ -1960,8 +1960,8 @@ int GXHelpers::GetData(
     */
 static int SetTime(CGXDLMSSettings* settings, CGXByteBuffer& buff, CGXDLMSVariant& value)
 {
-    DATETIME_SKIPS skip = value.dateTime.GetSkip();
-    struct tm dt = value.dateTime.GetValue();
+    DATETIME_SKIPS skip = value.dateTime().GetSkip();
+    struct tm dt = value.dateTime().GetValue();
     if (settings->GetDateTimeSkips() != DATETIME_SKIPS_NONE)
     {
         skip = (DATETIME_SKIPS)(skip | settings->GetDateTimeSkips());
@@ -2013,8 +2013,8 @@ static int SetTime(CGXDLMSSettings* settings, CGXByteBuffer& buff, CGXDLMSVarian
 */
 static int SetDate(CGXDLMSSettings* settings, CGXByteBuffer& buff, CGXDLMSVariant& value)
 {
-    struct tm dt = value.dateTime.GetValue();
-    DATETIME_SKIPS skip = value.dateTime.GetSkip();
+    struct tm dt = value.dateTime().GetValue();
+    DATETIME_SKIPS skip = value.dateTime().GetSkip();
     if (settings->GetDateTimeSkips() != DATETIME_SKIPS_NONE)
     {
         skip = (DATETIME_SKIPS)(skip | settings->GetDateTimeSkips());
@@ -2029,11 +2029,11 @@ static int SetDate(CGXDLMSSettings* settings, CGXByteBuffer& buff, CGXDLMSVarian
         buff.SetUInt16(1900 + dt.tm_year);
     }
     // Add month
-    if ((value.dateTime.GetExtra() & DATE_TIME_EXTRA_INFO_DST_BEGIN) != 0)
+    if ((value.dateTime().GetExtra() & DATE_TIME_EXTRA_INFO_DST_BEGIN) != 0)
     {
         buff.SetUInt8(0xFE);
     }
-    else if ((value.dateTime.GetExtra() & DATE_TIME_EXTRA_INFO_DST_END) != 0)
+    else if ((value.dateTime().GetExtra() & DATE_TIME_EXTRA_INFO_DST_END) != 0)
     {
         buff.SetUInt8(0xFD);
     }
@@ -2046,11 +2046,11 @@ static int SetDate(CGXDLMSSettings* settings, CGXByteBuffer& buff, CGXDLMSVarian
         buff.SetUInt8(dt.tm_mon + 1);
     }
     // Add day
-    if ((value.dateTime.GetExtra() & DATE_TIME_EXTRA_INFO_LAST_DAY) != 0)
+    if ((value.dateTime().GetExtra() & DATE_TIME_EXTRA_INFO_LAST_DAY) != 0)
     {
         buff.SetUInt8(0xFE);
     }
-    else if ((value.dateTime.GetExtra() & DATE_TIME_EXTRA_INFO_LAST_DAY2) != 0)
+    else if ((value.dateTime().GetExtra() & DATE_TIME_EXTRA_INFO_LAST_DAY2) != 0)
     {
         buff.SetUInt8(0xFD);
     }
@@ -2092,8 +2092,8 @@ static int SetDateTime(CGXDLMSSettings* settings, CGXByteBuffer& buff, CGXDLMSVa
 {
     //Add year.
     unsigned short year = 0xFFFF;
-    struct tm dt = value.dateTime.GetValue();
-    DATETIME_SKIPS skip = value.dateTime.GetSkip();
+    struct tm dt = value.dateTime().GetValue();
+    DATETIME_SKIPS skip = value.dateTime().GetSkip();
     if (settings->GetDateTimeSkips() != DATETIME_SKIPS_NONE)
     {
         skip = (DATETIME_SKIPS)(skip | settings->GetDateTimeSkips());
@@ -2104,11 +2104,11 @@ static int SetDateTime(CGXDLMSSettings* settings, CGXByteBuffer& buff, CGXDLMSVa
     }
     buff.SetUInt16(year);
     //Add month
-    if ((value.dateTime.GetExtra() & DATE_TIME_EXTRA_INFO_DST_BEGIN) != 0)
+    if ((value.dateTime().GetExtra() & DATE_TIME_EXTRA_INFO_DST_BEGIN) != 0)
     {
         buff.SetUInt8(0xFE);
     }
-    else if ((value.dateTime.GetExtra() & DATE_TIME_EXTRA_INFO_DST_END) != 0)
+    else if ((value.dateTime().GetExtra() & DATE_TIME_EXTRA_INFO_DST_END) != 0)
     {
         buff.SetUInt8(0xFD);
     }
@@ -2121,11 +2121,11 @@ static int SetDateTime(CGXDLMSSettings* settings, CGXByteBuffer& buff, CGXDLMSVa
         buff.SetUInt8(0xFF);
     }
     //Add day
-    if ((value.dateTime.GetExtra() & DATE_TIME_EXTRA_INFO_LAST_DAY) != 0)
+    if ((value.dateTime().GetExtra() & DATE_TIME_EXTRA_INFO_LAST_DAY) != 0)
     {
         buff.SetUInt8(0xFE);
     }
-    else if ((value.dateTime.GetExtra() & DATE_TIME_EXTRA_INFO_LAST_DAY2) != 0)
+    else if ((value.dateTime().GetExtra() & DATE_TIME_EXTRA_INFO_LAST_DAY2) != 0)
     {
         buff.SetUInt8(0xFD);
     }
@@ -2199,11 +2199,11 @@ static int SetDateTime(CGXDLMSSettings* settings, CGXByteBuffer& buff, CGXDLMSVa
         // Add devitation.
         if (settings != NULL && settings->GetUseUtc2NormalTime())
         {
-            buff.SetUInt16(-value.dateTime.GetDeviation());
+            buff.SetUInt16(-value.dateTime().GetDeviation());
         }
         else
         {
-            buff.SetUInt16(value.dateTime.GetDeviation());
+            buff.SetUInt16(value.dateTime().GetDeviation());
         }
     }
     // Add clock_status
@@ -2214,11 +2214,11 @@ static int SetDateTime(CGXDLMSSettings* settings, CGXByteBuffer& buff, CGXDLMSVa
     }
     else if (dt.tm_isdst)
     {
-        buff.SetUInt8(value.dateTime.GetStatus() | DLMS_CLOCK_STATUS_DAYLIGHT_SAVE_ACTIVE);
+        buff.SetUInt8(value.dateTime().GetStatus() | DLMS_CLOCK_STATUS_DAYLIGHT_SAVE_ACTIVE);
     }
     else
     {
-        buff.SetUInt8(value.dateTime.GetStatus());
+        buff.SetUInt8(value.dateTime().GetStatus());
     }
     return 0;
 }
@@ -2249,8 +2249,8 @@ static int SetBcd(CGXByteBuffer& buff, CGXDLMSVariant& value)
 static int SetArray(CGXDLMSSettings* settings, CGXByteBuffer& buff, CGXDLMSVariant& value)
 {
     int ret;
-    GXHelpers::SetObjectCount((unsigned long)value.Arr.size(), buff);
-    for (std::vector<CGXDLMSVariant>::iterator it = value.Arr.begin(); it != value.Arr.end(); ++it)
+    GXHelpers::SetObjectCount((unsigned long)value.Arr().size(), buff);
+    for (std::vector<CGXDLMSVariant>::iterator it = value.Arr().begin(); it != value.Arr().end(); ++it)
     {
         if ((ret = GXHelpers::SetData(settings, buff, it->vt, *it)) != 0)
         {
@@ -2273,7 +2273,7 @@ static int SetOctetString(CGXByteBuffer& buff, CGXDLMSVariant& value)
     if (value.vt == DLMS_DATA_TYPE_STRING)
     {
         CGXByteBuffer bb;
-        GXHelpers::HexToBytes(value.strVal, bb);
+        GXHelpers::HexToBytes(value.strVal(), bb);
         GXHelpers::SetObjectCount(bb.GetSize(), buff);
         buff.Set(bb.GetData(), bb.GetSize());
     }
@@ -2306,8 +2306,8 @@ static int SetUtfString(CGXByteBuffer& buff, CGXDLMSVariant& value)
 {
     if (value.vt != DLMS_DATA_TYPE_NONE)
     {
-        GXHelpers::SetObjectCount((unsigned long)value.strVal.size(), buff);
-        buff.AddString(value.strVal.c_str());
+        GXHelpers::SetObjectCount((unsigned long)value.strVal().size(), buff);
+        buff.AddString(value.strVal().c_str());
     }
     else
     {
@@ -2400,8 +2400,8 @@ static int SetString(CGXByteBuffer& buff, CGXDLMSVariant& value)
 {
     if (value.vt != DLMS_DATA_TYPE_NONE)
     {
-        GXHelpers::SetObjectCount((unsigned long)value.strVal.size(), buff);
-        buff.AddString(value.strVal.c_str());
+        GXHelpers::SetObjectCount((unsigned long)value.strVal().size(), buff);
+        buff.AddString(value.strVal().c_str());
     }
     else
     {
@@ -2418,9 +2418,9 @@ int GXHelpers::SetBitString(CGXByteBuffer& buff, CGXDLMSVariant& value, bool add
     {
         if (addCount)
         {
-            GXHelpers::SetObjectCount((unsigned long)value.strVal.size(), buff);
+            GXHelpers::SetObjectCount((unsigned long)value.strVal().size(), buff);
         }
-        for (std::string::iterator it = value.strVal.begin(); it != value.strVal.end(); ++it)
+        for (std::string::iterator it = value.strVal().begin(); it != value.strVal().end(); ++it)
         {
             if (*it == '1')
             {
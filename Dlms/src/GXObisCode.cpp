@@ -0,0 +1,54 @@
+//
+// --------------------------------------------------------------------------
+//  Gurux Ltd
+//
+//
+//
+// Filename:        $HeadURL$
+//
+// Version:         $Revision$,
+//                  $Date$
+//                  $Author$
+//
+// Copyright (c) Gurux Ltd
+//
+//---------------------------------------------------------------------------
+//
+//  DESCRIPTION
+//
+// This file is a part of Gurux Device Framework.
+//
+// Gurux Device Framework is Open Source software; you can redistribute it
+// and/or modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; version 2 of the License.
+// Gurux Device Framework is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// More information of Gurux products: http://www.gurux.org
+//
+// This code is licensed under the GNU General Public License v2.
+// Full text may be retrieved at http://www.gnu.org/licenses/gpl-2.0.txt
+//---------------------------------------------------------------------------
+
+
+#include <stdio.h>
+#include "../include/GXObisCode.h"
+
+void CGXObisCode::GetBytes(unsigned char* value) const
+{
+    for (int pos = 5; pos != -1; --pos)
+    {
+        value[5 - pos] = (unsigned char)(m_Value >> (8 * pos));
+    }
+}
+
+std::string CGXObisCode::ToString() const
+{
+    char tmp[24];
+    unsigned char ln[6];
+    GetBytes(ln);
+    snprintf(tmp, sizeof(tmp), "%d.%d.%d.%d.%d.%d", ln[0], ln[1], ln[2], ln[3], ln[4], ln[5]);
+    return tmp;
+}
\ No newline at end of file
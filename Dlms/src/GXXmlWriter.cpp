@@ -440,7 +440,7 @@ int CGXXmlWriter::WriteArray(CGXDLMSVariant& data)
     int ret = 0;
     if (data.vt == DLMS_DATA_TYPE_ARRAY || data.vt == DLMS_DATA_TYPE_STRUCTURE)
     {
-        for (std::vector<CGXDLMSVariant>::iterator it = data.Arr.begin(); it != data.Arr.end(); ++it)
+        for (std::vector<CGXDLMSVariant>::iterator it = data.Arr().begin(); it != data.Arr().end(); ++it)
         {
             if (it->vt == DLMS_DATA_TYPE_OCTET_STRING)
             {
@@ -502,7 +502,7 @@ int CGXXmlWriter::WriteElementObject(const char* name, CGXDLMSVariant& value, DL
         if (value.vt == DLMS_DATA_TYPE_DATETIME)
         {
             std::string str;
-            value.dateTime.ToFormatString("%m/%d/%Y %H:%M:%S", str);
+            value.dateTime().ToFormatString("%m/%d/%Y %H:%M:%S", str);
             fprintf(m_f, "%s", str.c_str());
         }
         else if (value.vt == DLMS_DATA_TYPE_OCTET_STRING)
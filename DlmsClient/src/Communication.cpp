@@ -658,7 +658,7 @@ int CGXCommunication::ReadList(
         }
         if (reply.GetValue().vt == DLMS_DATA_TYPE_ARRAY)
         {
-            values.insert(values.end(), reply.GetValue().Arr.begin(), reply.GetValue().Arr.end());
+            values.insert(values.end(), reply.GetValue().Arr().begin(), reply.GetValue().Arr().end());
         }
         reply.Clear();
     }
@@ -0,0 +1,89 @@
+#include <stdio.h>
+#include <string.h>
+#include "Bench.h"
+#include "GXDLMSServerLN.h"
+#include "GXDLMSAssociationLogicalName.h"
+
+void CGXBench::MakeFrame(const char* apdu, unsigned short source, CGXByteBuffer& frame)
+{
+    CGXByteBuffer bb;
+    bb.SetHexString(apdu);
+    MakeFrame(bb, source, frame);
+}
+
+void CGXBench::MakeFrame(CGXByteBuffer& apdu, unsigned short source, CGXByteBuffer& frame)
+{
+    frame.Clear();
+    //Version.
+    frame.SetUInt16(1);
+    frame.SetUInt16(source);
+    //Logical device.
+    frame.SetUInt16(1);
+    frame.SetUInt16((unsigned short)apdu.GetSize());
+    frame.Set(&apdu);
+}
+
+CGXDLMSServerLN* CGXBench::CreateServer(const char* dataFile, unsigned long long history)
+{
+    strncpy(DATAFILE, dataFile, sizeof(DATAFILE) - 1);
+    strcpy(IMAGEFILE, DATAFILE);
+    char* p = strrchr(IMAGEFILE, '/');
+    strcpy(p == NULL ? IMAGEFILE : p + 1, "empty.bin");
+    CGXDLMSServerLN* server = new CGXDLMSServerLN(new CGXDLMSAssociationLogicalName(), new CGXDLMSIecHdlcSetup());
+    server->SetProfileCapacity(history);
+    server->SetProfileHistory(history);
+    if (server->Init() != 0)
+    {
+        delete server;
+        return NULL;
+    }
+    server->m_Trace = GX_TRACE_LEVEL_OFF;
+    return server;
+}
+
+static void ShowHelp()
+{
+    printf("Benchmarks of the DLMS server.\r\n");
+    printf("bench profile [data file]\r\n");
+    printf("  Latency of profile generic buffer reads with different profile sizes.\r\n");
+    printf("bench fcs [megabytes per size]\r\n");
+    printf("  Check FCS16 and FCS24 against bit by bit versions and show their throughput.\r\n");
+    printf("bench churn [aarq|low|pre|reuse|session] [threads] [associations] [port] [host]\r\n");
+    printf("  Associations per second. Each association is AARQ, GET and RLRQ.\r\n");
+    printf("  Server must be running unless mode is session. In pre mode client 16 must be pre-established.\r\n");
+    printf("bench encode [iterations]\r\n");
+    printf("  Byte buffer growth, short frames, typical GET responses and profile blocks.\r\n");
+    printf("bench gcm [megabytes]\r\n");
+    printf("  Check AES-GCM table and processor instruction implementations against known answers and each other and show their throughput.\r\n");
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        ShowHelp();
+        return 1;
+    }
+    if (strcmp(argv[1], "profile") == 0)
+    {
+        return BenchProfile(argc - 2, argv + 2);
+    }
+    if (strcmp(argv[1], "fcs") == 0)
+    {
+        return BenchFcs(argc - 2, argv + 2);
+    }
+    if (strcmp(argv[1], "churn") == 0)
+    {
+        return BenchChurn(argc - 2, argv + 2);
+    }
+    if (strcmp(argv[1], "encode") == 0)
+    {
+        return BenchEncode(argc - 2, argv + 2);
+    }
+    if (strcmp(argv[1], "gcm") == 0)
+    {
+        return BenchGcm(argc - 2, argv + 2);
+    }
+    ShowHelp();
+    return 1;
+}
@@ -0,0 +1,44 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <chrono>
+#include <string>
+#include "GXByteBuffer.h"
+
+class CGXDLMSServerLN;
+
+/////////////////////////////////////////////////////////////////////////
+//Helpers shared by the benchmarks.
+/////////////////////////////////////////////////////////////////////////
+class CGXBench
+{
+public:
+    //Returns seconds from an arbitrary point. Only differences are used.
+    static double Now()
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    //Add wrapper header in front of the APDU given as hex string.
+    static void MakeFrame(const char* apdu, unsigned short source, CGXByteBuffer& frame);
+
+    //Add wrapper header in front of the APDU.
+    static void MakeFrame(CGXByteBuffer& apdu, unsigned short source, CGXByteBuffer& frame);
+
+    /**
+    * Create server template like DlmsServer does. Tracing is off.
+    *
+    * @param dataFile Profile store file.
+    * @param history Amount of profile history rows.
+    */
+    static CGXDLMSServerLN* CreateServer(const char* dataFile, unsigned long long history);
+};
+
+//Benchmarks. Return zero on success.
+int BenchProfile(int argc, char* argv[]);
+int BenchFcs(int argc, char* argv[]);
+int BenchChurn(int argc, char* argv[]);
+int BenchEncode(int argc, char* argv[]);
+int BenchGcm(int argc, char* argv[]);
+
+#endif //BENCH_H
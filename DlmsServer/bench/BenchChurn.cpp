@@ -0,0 +1,391 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include "Bench.h"
+#include "GXDLMSServerLN.h"
+#include "GXDLMS.h"
+
+//AARQ without authentication and ciphering.
+#define BENCH_AARQ "601DA109060760857405080101BE10040E01000000065F1F0400007E1FFFFF"
+//AARQ with low level authentication. Password is "Gurux".
+#define BENCH_AARQ_LOW "6033A1090607608574050801018A0207808B0760857405080201AC0780054775727578BE10040E01000000065F1F0400007E1FFFFF"
+//Get clock time.
+#define BENCH_GET "C001C100080000010000FF0200"
+//Release request.
+#define BENCH_RLRQ "6203800100"
+
+//How associations are made.
+typedef enum
+{
+    //New connection and AARQ for each association.
+    BENCH_CHURN_AARQ,
+    //New connection and AARQ with low level authentication for each association.
+    BENCH_CHURN_LOW,
+    //New connection for each GET. Client must be pre-established in the server.
+    BENCH_CHURN_PRE,
+    //All associations of the thread are made over one connection.
+    BENCH_CHURN_REUSE,
+    //Session servers are created and used in process without sockets.
+    BENCH_CHURN_SESSION
+} BENCH_CHURN_MODE;
+
+struct CGXChurnFrames
+{
+    CGXByteBuffer aarq;
+    CGXByteBuffer get;
+    CGXByteBuffer rlrq;
+};
+
+static int Connect(const char* host, int port)
+{
+    int s = socket(AF_INET, SOCK_STREAM, 0);
+    if (s == -1)
+    {
+        return -1;
+    }
+    int one = 1;
+    setsockopt(s, IPPROTO_TCP, TCP_NODELAY, (char*)&one, sizeof(one));
+    struct sockaddr_in add = { 0 };
+    add.sin_family = AF_INET;
+    add.sin_port = htons(port);
+    if (inet_pton(AF_INET, host, &add.sin_addr) != 1 ||
+        connect(s, (struct sockaddr*)&add, sizeof(add)) != 0)
+    {
+        close(s);
+        return -1;
+    }
+    return s;
+}
+
+/////////////////////////////////////////////////////////////////////////
+//Send the frame and read one wrapper frame. Returns the first byte of the reply APDU or -1.
+/////////////////////////////////////////////////////////////////////////
+static int Send(int s, CGXByteBuffer& frame)
+{
+    if (send(s, (const char*)frame.GetData(), frame.GetSize(), 0) != (int)frame.GetSize())
+    {
+        return -1;
+    }
+    unsigned char data[2048];
+    int size = 0, len = 8;
+    while (size < len)
+    {
+        int ret = recv(s, (char*)data + size, len - size, 0);
+        if (ret <= 0)
+        {
+            return -1;
+        }
+        size += ret;
+        if (len == 8 && size >= 8)
+        {
+            len = 8 + (data[6] << 8 | data[7]);
+            if (len == 8 || len > (int)sizeof(data))
+            {
+                return -1;
+            }
+        }
+    }
+    return data[8];
+}
+
+/////////////////////////////////////////////////////////////////////////
+//Make associations over TCP. Returns amount of failed associations.
+/////////////////////////////////////////////////////////////////////////
+static int ChurnSocket(
+    BENCH_CHURN_MODE mode,
+    CGXChurnFrames* frames,
+    const char* host,
+    int port,
+    int count)
+{
+    int failed = 0;
+    int s = mode == BENCH_CHURN_REUSE ? Connect(host, port) : -1;
+    for (int pos = 0; pos != count; ++pos)
+    {
+        if (mode != BENCH_CHURN_REUSE && (s = Connect(host, port)) == -1)
+        {
+            return failed + count - pos;
+        }
+        //AARE, get response and RLRE are expected.
+        if ((mode != BENCH_CHURN_PRE && Send(s, frames->aarq) != 0x61) ||
+            Send(s, frames->get) != 0xC4 ||
+            (mode != BENCH_CHURN_PRE && Send(s, frames->rlrq) != 0x63))
+        {
+            ++failed;
+        }
+        if (mode != BENCH_CHURN_REUSE)
+        {
+            close(s);
+        }
+    }
+    if (s != -1 && mode == BENCH_CHURN_REUSE)
+    {
+        close(s);
+    }
+    return failed;
+}
+
+/////////////////////////////////////////////////////////////////////////
+//Encode attribute like it's encoded when it's read.
+/////////////////////////////////////////////////////////////////////////
+static int Encode(CGXDLMSSettings& settings, CGXDLMSObject* obj, int index, CGXByteBuffer& bb)
+{
+    CGXDLMSValueEventArg e(obj, index);
+    int ret = obj->GetValue(settings, e);
+    if (ret == 0 && (ret = e.GetError()) == 0)
+    {
+        if (e.IsByteArray() && e.GetValue().vt == DLMS_DATA_TYPE_OCTET_STRING)
+        {
+            bb.Set(e.GetValue().byteArr, e.GetValue().GetSize());
+        }
+        else
+        {
+            ret = CGXDLMS::AppendData(&settings, obj, index, bb, e.GetValue());
+        }
+    }
+    return ret;
+}
+
+/////////////////////////////////////////////////////////////////////////
+//Returns true if attributes and caches of the objects are encoded the same way.
+/////////////////////////////////////////////////////////////////////////
+static bool IsSame(CGXDLMSSettings& settings, CGXDLMSObject* a, CGXDLMSObject* b)
+{
+    for (int index = 1; index <= a->GetAttributeCount(); ++index)
+    {
+        CGXByteBuffer bb1, bb2;
+        if (Encode(settings, a, index, bb1) != Encode(settings, b, index, bb2) ||
+            bb1.GetSize() != bb2.GetSize() ||
+            memcmp(bb1.GetData(), bb2.GetData(), bb1.GetSize()) != 0 ||
+            a->IsCached(index) != b->IsCached(index))
+        {
+            return false;
+        }
+        CGXByteBuffer* cached1 = a->GetCachedValue(index);
+        CGXByteBuffer* cached2 = b->GetCachedValue(index);
+        if (a->IsCached(index) && (cached1 == NULL || cached2 == NULL ||
+            cached1->GetSize() != bb1.GetSize() || cached2->GetSize() != bb1.GetSize() ||
+            memcmp(cached1->GetData(), bb1.GetData(), bb1.GetSize()) != 0 ||
+            memcmp(cached2->GetData(), bb1.GetData(), bb1.GetSize()) != 0))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/////////////////////////////////////////////////////////////////////////
+//Objects of the template that the session shares.
+/////////////////////////////////////////////////////////////////////////
+static void GetSharedObjects(CGXDLMSServerLN* server, CGXDLMSBase* session, std::vector<CGXDLMSObject*>& shared)
+{
+    for (CGXDLMSObjectCollection::iterator it = session->GetItems().begin(); it != session->GetItems().end(); ++it)
+    {
+        if (std::find(server->GetItems().begin(), server->GetItems().end(), *it) != server->GetItems().end())
+        {
+            shared.push_back(*it);
+        }
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////
+//Session copies shared object before it's written. Copy must be encoded
+//like the shared object and the shared object must not change.
+/////////////////////////////////////////////////////////////////////////
+static int VerifyUnshare(CGXDLMSServerLN* server, std::vector<unsigned long>& changeCounts)
+{
+    int ret = 0;
+    CGXDLMSSettings settings(true);
+    std::vector<CGXDLMSObject*> shared;
+    CGXDLMSBase* session = server->CreateClientServer();
+    GetSharedObjects(server, session, shared);
+    for (std::vector<CGXDLMSObject*>::iterator it = shared.begin(); it != shared.end(); ++it)
+    {
+        changeCounts.push_back((*it)->GetChangeCount());
+        CGXDLMSValueEventArg* e = new CGXDLMSValueEventArg(*it, 2);
+        std::vector<CGXDLMSValueEventArg*> args;
+        args.push_back(e);
+        session->PreWrite(args);
+        std::string ln;
+        (*it)->GetLogicalName(ln);
+        if (e->GetTarget() == *it ||
+            std::find(session->GetItems().begin(), session->GetItems().end(), *it) != session->GetItems().end())
+        {
+            printf("Shared object %s is not copied before it's written.\r\n", ln.c_str());
+            ret = 1;
+        }
+        else if (!IsSame(settings, *it, e->GetTarget()))
+        {
+            printf("Copy of the shared object %s differs.\r\n", ln.c_str());
+            ret = 1;
+        }
+        delete e;
+    }
+    if (shared.empty())
+    {
+        printf("Session doesn't share objects.\r\n");
+        ret = 1;
+    }
+    delete session;
+    return ret;
+}
+
+/////////////////////////////////////////////////////////////////////////
+//Sessions must not change the shared objects.
+/////////////////////////////////////////////////////////////////////////
+static int VerifyShared(CGXDLMSServerLN* server, std::vector<unsigned long>& changeCounts)
+{
+    int ret = 0;
+    std::vector<CGXDLMSObject*> shared;
+    CGXDLMSBase* session = server->CreateClientServer();
+    GetSharedObjects(server, session, shared);
+    for (size_t pos = 0; pos != shared.size(); ++pos)
+    {
+        bool cached = true;
+        for (int index = 1; index <= shared[pos]->GetAttributeCount(); ++index)
+        {
+            if (shared[pos]->IsCached(index) && shared[pos]->GetCachedValue(index) == NULL)
+            {
+                cached = false;
+            }
+        }
+        if (pos >= changeCounts.size() || shared[pos]->GetChangeCount() != changeCounts[pos] || !cached)
+        {
+            std::string ln;
+            shared[pos]->GetLogicalName(ln);
+            printf("Shared object %s is changed by the sessions.\r\n", ln.c_str());
+            ret = 1;
+        }
+    }
+    delete session;
+    return ret;
+}
+
+/////////////////////////////////////////////////////////////////////////
+//Create session servers from the template and make one association with each.
+/////////////////////////////////////////////////////////////////////////
+static int ChurnSession(CGXDLMSServerLN* server, CGXChurnFrames* frames, int count)
+{
+    int failed = 0;
+    CGXByteBuffer reply;
+    for (int pos = 0; pos != count; ++pos)
+    {
+        CGXDLMSBase* session = server->CreateClientServer();
+        reply.SetSize(0);
+        if (session->HandleRequest(frames->aarq, reply) != 0 || reply.GetSize() < 9 || reply.GetData()[8] != 0x61)
+        {
+            ++failed;
+        }
+        reply.SetSize(0);
+        if (session->HandleRequest(frames->get, reply) != 0 || reply.GetSize() < 9 || reply.GetData()[8] != 0xC4)
+        {
+            ++failed;
+        }
+        reply.SetSize(0);
+        session->HandleRequest(frames->rlrq, reply);
+        delete session;
+    }
+    return failed;
+}
+
+/////////////////////////////////////////////////////////////////////////
+//Connection churn. Each thread makes the given amount of associations with
+//AARQ, GET and RLRQ and the associations per second are printed.
+//
+//Usage: bench churn [aarq|low|pre|reuse|session] [threads] [associations] [port] [host]
+/////////////////////////////////////////////////////////////////////////
+int BenchChurn(int argc, char* argv[])
+{
+    BENCH_CHURN_MODE mode = BENCH_CHURN_AARQ;
+    const char* name = argc > 0 ? argv[0] : "aarq";
+    if (strcmp(name, "low") == 0)
+    {
+        mode = BENCH_CHURN_LOW;
+    }
+    else if (strcmp(name, "pre") == 0)
+    {
+        mode = BENCH_CHURN_PRE;
+    }
+    else if (strcmp(name, "reuse") == 0)
+    {
+        mode = BENCH_CHURN_REUSE;
+    }
+    else if (strcmp(name, "session") == 0)
+    {
+        mode = BENCH_CHURN_SESSION;
+    }
+    else if (strcmp(name, "aarq") != 0)
+    {
+        printf("Unknown mode %s.\r\n", name);
+        return 1;
+    }
+    int threads = argc > 1 ? atoi(argv[1]) : 4;
+    int count = argc > 2 ? atoi(argv[2]) : 1000;
+    int port = argc > 3 ? atoi(argv[3]) : 4059;
+    const char* host = argc > 4 ? argv[4] : "127.0.0.1";
+    if (threads < 1 || count < 1)
+    {
+        printf("Invalid thread or association count.\r\n");
+        return 1;
+    }
+    //Low level authentication uses client address 17.
+    unsigned short client = mode == BENCH_CHURN_LOW ? 17 : 16;
+    CGXChurnFrames frames;
+    CGXBench::MakeFrame(mode == BENCH_CHURN_LOW ? BENCH_AARQ_LOW : BENCH_AARQ, client, frames.aarq);
+    CGXBench::MakeFrame(BENCH_GET, client, frames.get);
+    CGXBench::MakeFrame(BENCH_RLRQ, client, frames.rlrq);
+    CGXDLMSServerLN* server = NULL;
+    if (mode == BENCH_CHURN_SESSION && (server = CGXBench::CreateServer("/tmp/DlmsServerBench.bin", 10000)) == NULL)
+    {
+        printf("Failed to create server.\r\n");
+        return 1;
+    }
+    std::vector<unsigned long> changeCounts;
+    if (server != NULL && VerifyUnshare(server, changeCounts) != 0)
+    {
+        delete server;
+        unlink("/tmp/DlmsServerBench.bin");
+        return 1;
+    }
+    std::vector<int> failed(threads, 0);
+    std::vector<std::thread> workers;
+    double start = CGXBench::Now();
+    for (int pos = 0; pos != threads; ++pos)
+    {
+        int* result = &failed[pos];
+        //Each thread has its own copy of the frames.
+        workers.push_back(std::thread([=]() mutable
+        {
+            *result = server != NULL ? ChurnSession(server, &frames, count) :
+                ChurnSocket(mode, &frames, host, port, count);
+        }));
+    }
+    int total = 0;
+    for (int pos = 0; pos != threads; ++pos)
+    {
+        workers[pos].join();
+        total += failed[pos];
+    }
+    double elapsed = CGXBench::Now() - start;
+    if (server != NULL)
+    {
+        if (VerifyShared(server, changeCounts) != 0)
+        {
+            ++total;
+        }
+        delete server;
+        unlink("/tmp/DlmsServerBench.bin");
+    }
+    printf("%s: %d associations in %.3f s, %.0f/s, %.2f us per association, failed %d\r\n", name,
+        threads * count, elapsed, threads * count / elapsed, 1e6 * elapsed / count, total);
+    return total == 0 ? 0 : 1;
+}
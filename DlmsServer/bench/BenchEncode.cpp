@@ -0,0 +1,204 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <vector>
+#include "Bench.h"
+#include "GXDLMSServerLN.h"
+
+//AARQ without authentication and ciphering.
+#define BENCH_AARQ "601DA109060760857405080101BE10040E01000000065F1F0400007E1FFFFF"
+
+/////////////////////////////////////////////////////////////////////////
+//Typical GET requests.
+/////////////////////////////////////////////////////////////////////////
+static const char* BENCH_GETS[][2] =
+{
+    { "logical device name", "C001C1000100002A0000FF0200" },
+    { "register value", "C001C100030101151900FF0200" },
+    { "clock time", "C001C100080000010000FF0200" },
+    { "profile entries in use", "C001C100070100630100FF0700" },
+    { "profile capture objects", "C001C100070100630100FF0300" }
+};
+
+/////////////////////////////////////////////////////////////////////////
+//Build a 64 kB PDU one byte at a time.
+/////////////////////////////////////////////////////////////////////////
+static void AppendBytes(int count)
+{
+    unsigned long sum = 0;
+    double start = CGXBench::Now();
+    for (int pos = 0; pos != count; ++pos)
+    {
+        CGXByteBuffer bb;
+        for (int n = 0; n != 0x10000; ++n)
+        {
+            bb.SetUInt8((unsigned char)n);
+        }
+        sum += bb.GetSize();
+    }
+    double elapsed = CGXBench::Now() - start;
+    printf("%-28s %12.2f us %10.1f MB/s\r\n", "64 kB PDU byte by byte", 1e6 * elapsed / count, sum / elapsed / 1e6);
+}
+
+/////////////////////////////////////////////////////////////////////////
+//Build short frames, copy them and move them to a queue.
+/////////////////////////////////////////////////////////////////////////
+static void ShortFrames(int count)
+{
+    std::vector<CGXByteBuffer> queue;
+    queue.reserve(64);
+    double start = CGXBench::Now();
+    for (int pos = 0; pos != count; ++pos)
+    {
+        CGXByteBuffer bb;
+        //Wrapper header and a short GET response.
+        bb.SetUInt16(1);
+        bb.SetUInt16(1);
+        bb.SetUInt16(16);
+        bb.SetUInt16(9);
+        bb.SetUInt8(0xC4);
+        bb.SetUInt8(1);
+        bb.SetUInt8(0xC1);
+        bb.SetUInt8(0);
+        bb.SetUInt8(6);
+        bb.SetUInt32(pos);
+        CGXByteBuffer copy(bb);
+        queue.push_back(std::move(copy));
+        if (queue.size() == 64)
+        {
+            queue.clear();
+        }
+    }
+    double elapsed = CGXBench::Now() - start;
+    printf("%-28s %12.3f us\r\n", "17 byte frame", 1e6 * elapsed / count);
+}
+
+/////////////////////////////////////////////////////////////////////////
+//Handle the request and return microseconds per request or -1 on error.
+/////////////////////////////////////////////////////////////////////////
+static double Get(CGXDLMSBase* session, CGXByteBuffer& request, int count)
+{
+    CGXByteBuffer reply;
+    double start = CGXBench::Now();
+    for (int pos = 0; pos != count; ++pos)
+    {
+        reply.SetSize(0);
+        //Get response normal with data.
+        if (session->HandleRequest(request, reply) != 0 || reply.GetSize() < 12 ||
+            reply.GetData()[8] != 0xC4 || reply.GetData()[11] != 0)
+        {
+            return -1;
+        }
+    }
+    return 1e6 * (CGXBench::Now() - start) / count;
+}
+
+/////////////////////////////////////////////////////////////////////////
+//Read the whole profile buffer in blocks. Returns read bytes or -1 on error.
+/////////////////////////////////////////////////////////////////////////
+static long ReadBuffer(CGXDLMSBase* session, CGXByteBuffer& request)
+{
+    CGXByteBuffer reply, next, apdu;
+    long size = 0;
+    CGXByteBuffer* frame = &request;
+    while (true)
+    {
+        reply.SetSize(0);
+        if (session->HandleRequest(*frame, reply) != 0 || reply.GetSize() < 12 ||
+            reply.GetData()[8] != 0xC4)
+        {
+            return -1;
+        }
+        size += reply.GetSize();
+        //Get response normal.
+        if (reply.GetData()[9] == 1)
+        {
+            return reply.GetData()[11] == 0 ? size : -1;
+        }
+        //Get response with data block. Stop when the last block is received.
+        if (reply.GetData()[9] != 2 || reply.GetSize() < 17 || reply.GetData()[16] != 0)
+        {
+            return -1;
+        }
+        if (reply.GetData()[11] != 0)
+        {
+            return size;
+        }
+        //Ask the next block.
+        apdu.SetSize(0);
+        apdu.SetUInt8(0xC0);
+        apdu.SetUInt8(2);
+        apdu.SetUInt8(0xC1);
+        apdu.Set(reply.GetData() + 12, 4);
+        CGXBench::MakeFrame(apdu, 16, next);
+        frame = &next;
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////
+//Encoding microbenchmarks. Byte buffer growth, short frames, typical GET
+//responses and profile generic buffer blocks.
+//
+//Usage: bench encode [iterations]
+/////////////////////////////////////////////////////////////////////////
+int BenchEncode(int argc, char* argv[])
+{
+    int count = argc > 0 ? atoi(argv[0]) : 10000;
+    if (count < 1)
+    {
+        printf("Invalid iteration count.\r\n");
+        return 1;
+    }
+    AppendBytes(count / 100 + 1);
+    ShortFrames(count * 100);
+    const char* fileName = "/tmp/DlmsServerBench.bin";
+    CGXDLMSServerLN* server = CGXBench::CreateServer(fileName, 10000);
+    if (server == NULL)
+    {
+        printf("Failed to create server.\r\n");
+        return 1;
+    }
+    CGXDLMSBase* session = server->CreateClientServer();
+    CGXByteBuffer frame, reply;
+    CGXBench::MakeFrame(BENCH_AARQ, 16, frame);
+    int ret = session->HandleRequest(frame, reply);
+    for (int pos = 0; ret == 0 && pos != sizeof(BENCH_GETS) / sizeof(BENCH_GETS[0]); ++pos)
+    {
+        CGXBench::MakeFrame(BENCH_GETS[pos][1], 16, frame);
+        double us = Get(session, frame, count);
+        if (us < 0)
+        {
+            printf("Failed to read %s.\r\n", BENCH_GETS[pos][0]);
+            ret = 1;
+            break;
+        }
+        printf("%-28s %12.2f us\r\n", BENCH_GETS[pos][0], us);
+    }
+    if (ret == 0)
+    {
+        //All 10000 rows of the profile.
+        CGXBench::MakeFrame("C001C100070100630100FF0200", 16, frame);
+        int reads = count / 1000 + 1;
+        long size = 0;
+        double start = CGXBench::Now();
+        for (int pos = 0; pos != reads && size != -1; ++pos)
+        {
+            size = ReadBuffer(session, frame);
+        }
+        double elapsed = CGXBench::Now() - start;
+        if (size == -1)
+        {
+            printf("Failed to read profile buffer.\r\n");
+            ret = 1;
+        }
+        else
+        {
+            printf("%-28s %12.2f us %10.1f MB/s\r\n", "profile buffer 10000 rows",
+                1e6 * elapsed / reads, (double)size * reads / elapsed / 1e6);
+        }
+    }
+    delete session;
+    delete server;
+    unlink(fileName);
+    return ret;
+}
@@ -0,0 +1,141 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "Bench.h"
+#include "GXDLMS.h"
+
+/////////////////////////////////////////////////////////////////////////
+//FCS16 counted one bit at a time. Used to check the table version.
+/////////////////////////////////////////////////////////////////////////
+static unsigned short ReferenceFCS16(const unsigned char* buff, int count)
+{
+    unsigned short fcs16 = 0xFFFF;
+    for (int pos = 0; pos < count; ++pos)
+    {
+        fcs16 ^= buff[pos];
+        for (int bit = 0; bit < 8; ++bit)
+        {
+            fcs16 = (fcs16 & 1) != 0 ? (fcs16 >> 1) ^ 0x8408 : fcs16 >> 1;
+        }
+    }
+    fcs16 = ~fcs16;
+    return ((fcs16 >> 8) & 0xFF) | (fcs16 << 8);
+}
+
+/////////////////////////////////////////////////////////////////////////
+//FCS24 counted one bit at a time like the original implementation.
+/////////////////////////////////////////////////////////////////////////
+static uint32_t ReferenceFCS24(const unsigned char* buff, int count)
+{
+    uint32_t crcreg = 0;
+    for (int pos = 0; pos < count; ++pos)
+    {
+        unsigned char b = buff[pos];
+        for (int bit = 0; bit < 8; ++bit)
+        {
+            crcreg >>= 1;
+            if ((b & 0x80) != 0)
+            {
+                crcreg |= 0x80000000;
+            }
+            if ((crcreg & 0x80) != 0)
+            {
+                crcreg = crcreg ^ 0xD3B6BA00;
+            }
+            b <<= 1;
+        }
+    }
+    return crcreg >> 8;
+}
+
+/////////////////////////////////////////////////////////////////////////
+//Compare FCS16 and FCS24 with the bit by bit versions for all sizes up to
+//the given size and for all start offsets inside one 8 byte block.
+/////////////////////////////////////////////////////////////////////////
+static int Verify(CGXByteBuffer& data, int maxSize)
+{
+    for (int index = 0; index != 8; ++index)
+    {
+        for (int count = 0; count <= maxSize; ++count)
+        {
+            const unsigned char* p = data.GetData() + index;
+            if (CGXDLMS::CountFCS16(data, index, count) != ReferenceFCS16(p, count))
+            {
+                printf("FCS16 differs. Index: %d Count: %d\r\n", index, count);
+                return 1;
+            }
+            if (CGXDLMS::CountFCS24(data.GetData(), index, count) != ReferenceFCS24(p, count))
+            {
+                printf("FCS24 differs. Index: %d Count: %d\r\n", index, count);
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+/////////////////////////////////////////////////////////////////////////
+//Checks that FCS16 and FCS24 match the bit by bit reference and prints
+//their throughput for HDLC frames from 32 bytes to 2 kB.
+//
+//Usage: bench fcs [megabytes per size]
+/////////////////////////////////////////////////////////////////////////
+int BenchFcs(int argc, char* argv[])
+{
+    int megabytes = argc > 0 ? atoi(argv[0]) : 64;
+    if (megabytes < 1)
+    {
+        printf("Invalid amount of data.\r\n");
+        return 1;
+    }
+    int sizes[] = { 32, 64, 128, 256, 512, 1024, 2048 };
+    CGXByteBuffer data;
+    srand(1);
+    for (int pos = 0; pos != 2048 + 8; ++pos)
+    {
+        data.SetUInt8((unsigned char)rand());
+    }
+    if (Verify(data, 2048) != 0)
+    {
+        return 1;
+    }
+    printf("FCS16 and FCS24 match the reference for 0-2048 bytes.\r\n");
+    printf("%6s %14s %14s %14s %14s\r\n", "bytes", "FCS16 MB/s", "ref MB/s", "FCS24 MB/s", "ref MB/s");
+    //Results are summed so the compiler can't remove the calls.
+    unsigned long sum = 0;
+    for (int pos = 0; pos != sizeof(sizes) / sizeof(sizes[0]); ++pos)
+    {
+        int size = sizes[pos];
+        int count = (int)((megabytes * 1000000LL) / size);
+        //Reference versions are slow so they are run with less data.
+        int refCount = count / 8 + 1;
+        double start = CGXBench::Now();
+        for (int n = 0; n != count; ++n)
+        {
+            sum += CGXDLMS::CountFCS16(data, n & 7, size);
+        }
+        double fcs16 = CGXBench::Now() - start;
+        start = CGXBench::Now();
+        for (int n = 0; n != refCount; ++n)
+        {
+            sum += ReferenceFCS16(data.GetData() + (n & 7), size);
+        }
+        double ref16 = CGXBench::Now() - start;
+        start = CGXBench::Now();
+        for (int n = 0; n != count; ++n)
+        {
+            sum += CGXDLMS::CountFCS24(data.GetData(), n & 7, size);
+        }
+        double fcs24 = CGXBench::Now() - start;
+        start = CGXBench::Now();
+        for (int n = 0; n != refCount; ++n)
+        {
+            sum += ReferenceFCS24(data.GetData() + (n & 7), size);
+        }
+        double ref24 = CGXBench::Now() - start;
+        printf("%6d %14.1f %14.1f %14.1f %14.1f\r\n", size,
+            count * (double)size / fcs16 / 1e6, refCount * (double)size / ref16 / 1e6,
+            count * (double)size / fcs24 / 1e6, refCount * (double)size / ref24 / 1e6);
+    }
+    printf("Checksum: %lu\r\n", sum);
+    return 0;
+}
@@ -0,0 +1,304 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Bench.h"
+#include "GXCipher.h"
+
+//System title, keys and frame counter of the Green Book ciphering example.
+#define BENCH_SYSTEM_TITLE "4D4D4D0000BC614E"
+#define BENCH_BLOCK_CIPHER_KEY "000102030405060708090A0B0C0D0E0F"
+#define BENCH_AUTHENTICATION_KEY "D0D1D2D3D4D5D6D7D8D9DADBDCDDDEDF"
+#define BENCH_FRAME_COUNTER 0x01234567
+
+//Plain text of the Green Book example. GET request of the clock time.
+#define BENCH_SHORT_APDU "C0010000080000010000FF0200"
+
+//Bytes from 0 to 69. Several GHASH blocks and a partial last block.
+#define BENCH_LONG_APDU "000102030405060708090A0B0C0D0E0F101112131415161718191A1B1C1D1E1F" \
+    "202122232425262728292A2B2C2D2E2F303132333435363738393A3B3C3D3E3F404142434445"
+
+/////////////////////////////////////////////////////////////////////////
+//GCM known answer. Frame is glo-get-request with the given security.
+/////////////////////////////////////////////////////////////////////////
+struct GX_GCM_VECTOR
+{
+    const char* name;
+    DLMS_SECURITY security;
+    const char* plainText;
+    const char* frame;
+};
+
+//Short frames are from the Green Book. Long frames are counted with OpenSSL.
+static const GX_GCM_VECTOR BENCH_VECTORS[] =
+{
+    {
+        "short authenticated and encrypted", DLMS_SECURITY_AUTHENTICATION_ENCRYPTION, BENCH_SHORT_APDU,
+        "C81E3001234567411312FF935A47566827C467BC7D825C3BE4A77C3FCC056B6B"
+    },
+    {
+        "short authenticated", DLMS_SECURITY_AUTHENTICATION, BENCH_SHORT_APDU,
+        "C81E1001234567C0010000080000010000FF020006725D910F9221D263877516"
+    },
+    {
+        "short encrypted", DLMS_SECURITY_ENCRYPTION, BENCH_SHORT_APDU,
+        "C8122001234567411312FF935A47566827C467BC"
+    },
+    {
+        "long authenticated and encrypted", DLMS_SECURITY_AUTHENTICATION_ENCRYPTION, BENCH_LONG_APDU,
+        "C8573001234567811310FC9F5F4150602E316EB01390F71F725D17633329630B42CF4712A7C6D1"
+        "EA27634067805EE2A18702D395256685CA153E9D1E6B03A43E1C2210C0CD171E800DB8316052"
+        "66F3210B07916E8C5E52CC7C"
+    },
+    {
+        "long authenticated", DLMS_SECURITY_AUTHENTICATION, BENCH_LONG_APDU,
+        "C8571001234567" BENCH_LONG_APDU "77CC0B1D58085008DA1FFFAB"
+    }
+};
+
+/////////////////////////////////////////////////////////////////////////
+//Create cipher with the keys of the known answers.
+/////////////////////////////////////////////////////////////////////////
+static CGXCipher* CreateCipher(CGXByteBuffer& title, CGXByteBuffer& key)
+{
+    CGXByteBuffer authenticationKey;
+    title.SetHexString(std::string(BENCH_SYSTEM_TITLE));
+    key.SetHexString(std::string(BENCH_BLOCK_CIPHER_KEY));
+    authenticationKey.SetHexString(std::string(BENCH_AUTHENTICATION_KEY));
+    CGXCipher* cipher = new CGXCipher(title);
+    cipher->SetBlockCipherKey(key);
+    cipher->SetAuthenticationKey(authenticationKey);
+    return cipher;
+}
+
+/////////////////////////////////////////////////////////////////////////
+//Encrypt and decrypt the known answers. Changed tag must be rejected.
+/////////////////////////////////////////////////////////////////////////
+static int Verify(const char* implementation)
+{
+    int ret = 0;
+    DLMS_SECURITY security;
+    DLMS_SECURITY_SUITE suite;
+    uint64_t invocationCounter;
+    CGXByteBuffer title, key, data, frame;
+    CGXCipher* cipher = CreateCipher(title, key);
+    for (int pos = 0; ret == 0 && pos != sizeof(BENCH_VECTORS) / sizeof(BENCH_VECTORS[0]); ++pos)
+    {
+        const GX_GCM_VECTOR& it = BENCH_VECTORS[pos];
+        data.Clear();
+        data.SetHexString(it.plainText);
+        frame.Clear();
+        frame.SetHexString(it.frame);
+        if (cipher->EncryptInPlace(it.security, BENCH_FRAME_COUNTER, DLMS_COMMAND_GLO_GET_REQUEST,
+            title, key, data, 0) != 0 || data.Available() != frame.GetSize() ||
+            memcmp(data.GetData() + data.GetPosition(), frame.GetData(), frame.GetSize()) != 0)
+        {
+            printf("%s: %s frame differs.\r\n", implementation, it.name);
+            ret = 1;
+            break;
+        }
+        data.Clear();
+        data.SetHexString(it.plainText);
+        if (cipher->DecryptInPlace(title, key, frame, security, suite, invocationCounter) != 0 ||
+            security != it.security || invocationCounter != BENCH_FRAME_COUNTER ||
+            frame.Available() != data.GetSize() ||
+            memcmp(frame.GetData() + frame.GetPosition(), data.GetData(), data.GetSize()) != 0)
+        {
+            printf("%s: %s plain text differs.\r\n", implementation, it.name);
+            ret = 1;
+            break;
+        }
+        if (it.security != DLMS_SECURITY_ENCRYPTION)
+        {
+            frame.Clear();
+            frame.SetHexString(it.frame);
+            frame.GetData()[frame.GetSize() - 1] ^= 1;
+            if (cipher->DecryptInPlace(title, key, frame, security, suite, invocationCounter) != DLMS_ERROR_CODE_INVALID_TAG)
+            {
+                printf("%s: %s frame with changed tag is accepted.\r\n", implementation, it.name);
+                ret = 1;
+            }
+        }
+    }
+    delete cipher;
+    return ret;
+}
+
+/////////////////////////////////////////////////////////////////////////
+//Encrypt and decrypt the known answers with Encrypt and Decrypt.
+/////////////////////////////////////////////////////////////////////////
+static int VerifyEncrypt(const char* implementation)
+{
+    int ret = 0;
+    DLMS_SECURITY security;
+    DLMS_SECURITY_SUITE suite;
+    uint64_t invocationCounter;
+    CGXByteBuffer title, key, data, frame;
+    CGXCipher* cipher = CreateCipher(title, key);
+    for (int pos = 0; ret == 0 && pos != sizeof(BENCH_VECTORS) / sizeof(BENCH_VECTORS[0]); ++pos)
+    {
+        const GX_GCM_VECTOR& it = BENCH_VECTORS[pos];
+        data.Clear();
+        data.SetHexString(it.plainText);
+        frame.Clear();
+        frame.SetHexString(it.frame);
+        if (cipher->Encrypt(it.security, DLMS_COUNT_TYPE_PACKET, BENCH_FRAME_COUNTER,
+            DLMS_COMMAND_GLO_GET_REQUEST, title, key, data, true) != 0 ||
+            data.GetSize() != frame.GetSize() ||
+            memcmp(data.GetData(), frame.GetData(), frame.GetSize()) != 0)
+        {
+            printf("%s: %s frame of Encrypt differs.\r\n", implementation, it.name);
+            ret = 1;
+            break;
+        }
+        data.Clear();
+        data.SetHexString(it.plainText);
+        if (cipher->Decrypt(title, key, frame, security, suite, invocationCounter) != 0 ||
+            security != it.security || invocationCounter != BENCH_FRAME_COUNTER ||
+            frame.Available() != data.GetSize() ||
+            memcmp(frame.GetData() + frame.GetPosition(), data.GetData(), data.GetSize()) != 0)
+        {
+            printf("%s: %s plain text of Decrypt differs.\r\n", implementation, it.name);
+            ret = 1;
+        }
+    }
+    delete cipher;
+    return ret;
+}
+
+/////////////////////////////////////////////////////////////////////////
+//Encrypt the same plain texts with the table and processor instruction
+//implementations. Frames must be equal and each implementation must
+//decrypt the frames of the other one.
+/////////////////////////////////////////////////////////////////////////
+static int CrossCheck()
+{
+    int ret = 0;
+    DLMS_SECURITY security;
+    DLMS_SECURITY_SUITE suite;
+    uint64_t invocationCounter;
+    static const DLMS_SECURITY SECURITIES[] = { DLMS_SECURITY_AUTHENTICATION,
+        DLMS_SECURITY_ENCRYPTION, DLMS_SECURITY_AUTHENTICATION_ENCRYPTION };
+    CGXByteBuffer title, key, plainText, frame[2];
+    CGXCipher* cipher = CreateCipher(title, key);
+    srand(1);
+    for (unsigned long size = 1; ret == 0 && size != 300; ++size)
+    {
+        plainText.Clear();
+        for (unsigned long pos = 0; pos != size; ++pos)
+        {
+            plainText.SetUInt8((unsigned char)rand());
+        }
+        for (int pos = 0; ret == 0 && pos != sizeof(SECURITIES) / sizeof(SECURITIES[0]); ++pos)
+        {
+            //Frame 0 is from the tables and frame 1 from the instructions.
+            for (int mode = 0; ret == 0 && mode != 2; ++mode)
+            {
+                CGXCipher::SetProcessorInstructions(mode != 0);
+                frame[mode].Clear();
+                frame[mode].Set(plainText.GetData(), plainText.GetSize());
+                ret = cipher->Encrypt(SECURITIES[pos], DLMS_COUNT_TYPE_PACKET, (unsigned long)size,
+                    DLMS_COMMAND_GLO_GET_REQUEST, title, key, frame[mode], true);
+            }
+            if (ret != 0 || frame[0].GetSize() != frame[1].GetSize() ||
+                memcmp(frame[0].GetData(), frame[1].GetData(), frame[0].GetSize()) != 0)
+            {
+                printf("Frames of %lu bytes differ. Security: %d.\r\n", size, SECURITIES[pos]);
+                ret = 1;
+                break;
+            }
+            //Decrypt the frame with the other implementation.
+            for (int mode = 0; mode != 2; ++mode)
+            {
+                CGXCipher::SetProcessorInstructions(mode == 0);
+                if (cipher->Decrypt(title, key, frame[mode], security, suite, invocationCounter) != 0 ||
+                    frame[mode].Available() != plainText.GetSize() ||
+                    memcmp(frame[mode].GetData() + frame[mode].GetPosition(), plainText.GetData(), plainText.GetSize()) != 0)
+                {
+                    printf("Plain texts of %lu bytes differ. Security: %d.\r\n", size, SECURITIES[pos]);
+                    ret = 1;
+                    break;
+                }
+            }
+        }
+    }
+    CGXCipher::SetProcessorInstructions(true);
+    delete cipher;
+    return ret;
+}
+
+/////////////////////////////////////////////////////////////////////////
+//Encrypt and decrypt 1 kB APDUs. Returns MB/s.
+/////////////////////////////////////////////////////////////////////////
+static double Throughput(int count)
+{
+    DLMS_SECURITY security;
+    DLMS_SECURITY_SUITE suite;
+    uint64_t invocationCounter;
+    CGXByteBuffer title, key, plainText, data;
+    CGXCipher* cipher = CreateCipher(title, key);
+    for (int pos = 0; pos != 1024; ++pos)
+    {
+        plainText.SetUInt8((unsigned char)pos);
+    }
+    double start = CGXBench::Now();
+    for (int pos = 0; pos != count; ++pos)
+    {
+        data.Clear();
+        data.Set(plainText.GetData(), plainText.GetSize());
+        if (cipher->EncryptInPlace(DLMS_SECURITY_AUTHENTICATION_ENCRYPTION, pos, DLMS_COMMAND_GLO_GET_REQUEST,
+            title, key, data, 0) != 0 ||
+            cipher->DecryptInPlace(title, key, data, security, suite, invocationCounter) != 0)
+        {
+            printf("Ciphering failed.\r\n");
+            break;
+        }
+    }
+    double elapsed = CGXBench::Now() - start;
+    delete cipher;
+    return 2.0 * count * plainText.GetSize() / elapsed / 1e6;
+}
+
+/////////////////////////////////////////////////////////////////////////
+//Checks the table and processor instruction implementations of AES-GCM
+//against known answers and each other and prints their throughput.
+//
+//Usage: bench gcm [megabytes]
+/////////////////////////////////////////////////////////////////////////
+int BenchGcm(int argc, char* argv[])
+{
+    int megabytes = argc > 0 ? atoi(argv[0]) : 64;
+    if (megabytes < 1)
+    {
+        printf("Invalid amount of data.\r\n");
+        return 1;
+    }
+    int count = (int)((megabytes * 1000000LL) / 2048);
+    CGXCipher::SetProcessorInstructions(false);
+    if (Verify("Table") != 0 || VerifyEncrypt("Table") != 0)
+    {
+        return 1;
+    }
+    printf("Table implementation matches the known answers.\r\n");
+    printf("%-14s %10.1f MB/s\r\n", "table", Throughput(count));
+    CGXCipher::SetProcessorInstructions(true);
+    bool aes = CGXCipher::IsAesInstructionsUsable();
+    bool clmul = CGXCipher::IsClmulUsable();
+    printf("AES instructions are %savailable.\r\n", aes ? "" : "not ");
+    printf("Carry-less multiplication is %savailable.\r\n", clmul ? "" : "not ");
+    if (!aes && !clmul)
+    {
+        return 0;
+    }
+    if (Verify("Instructions") != 0 || VerifyEncrypt("Instructions") != 0)
+    {
+        return 1;
+    }
+    printf("Instruction implementation matches the known answers.\r\n");
+    if (CrossCheck() != 0)
+    {
+        return 1;
+    }
+    printf("Instruction implementation matches the table implementation.\r\n");
+    printf("%-14s %10.1f MB/s\r\n", "instructions", Throughput(count));
+    return 0;
+}
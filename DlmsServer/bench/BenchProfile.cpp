@@ -0,0 +1,206 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "Bench.h"
+#include "GXDLMSServerLN.h"
+#include "GXDLMSData.h"
+#include "GXDLMSProfileGeneric.h"
+
+//AARQ without authentication and ciphering.
+#define BENCH_AARQ "601DA109060760857405080101BE10040E01000000065F1F0400007E1FFFFF"
+//Get entries in use of profile generic 1.0.99.1.0.255.
+#define BENCH_ENTRIES_IN_USE "C001C100070100630100FF0700"
+
+/////////////////////////////////////////////////////////////////////////
+//Get request for buffer rows [from, to] of profile generic 1.0.99.1.0.255.
+/////////////////////////////////////////////////////////////////////////
+static void GetEntries(unsigned long from, unsigned long to, CGXByteBuffer& frame)
+{
+    CGXByteBuffer bb;
+    bb.SetHexString(std::string("C001C100070100630100FF020102020406000000000600000000120001120000"));
+    bb.SetUInt32ByIndex(17, from);
+    bb.SetUInt32ByIndex(22, to);
+    CGXBench::MakeFrame(bb, 16, frame);
+}
+
+/////////////////////////////////////////////////////////////////////////
+//Server that lets profile generic add captured rows to its own buffer.
+/////////////////////////////////////////////////////////////////////////
+class CGXRingServer : public CGXDLMSServerLN
+{
+public:
+    CGXRingServer() : CGXDLMSServerLN(new CGXDLMSAssociationLogicalName(), new CGXDLMSIecHdlcSetup())
+    {
+    }
+
+    void PreGet(std::vector<CGXDLMSValueEventArg*>& args)
+    {
+    }
+};
+
+/////////////////////////////////////////////////////////////////////////
+//Capture values from first to last.
+/////////////////////////////////////////////////////////////////////////
+static int CaptureRows(CGXDLMSServer* server, CGXDLMSProfileGeneric& pg, CGXDLMSData& data, int first, int last)
+{
+    int ret = 0;
+    for (int pos = first; ret == 0 && pos <= last; ++pos)
+    {
+        CGXDLMSVariant value = pos;
+        data.SetValue(value);
+        ret = pg.Capture(server);
+    }
+    return ret;
+}
+
+/////////////////////////////////////////////////////////////////////////
+//Change profile entries with SetProfileEntries or by setting attribute 8.
+/////////////////////////////////////////////////////////////////////////
+static int SetEntries(CGXDLMSProfileGeneric& pg, unsigned long value, bool set)
+{
+    if (!set)
+    {
+        pg.SetProfileEntries(value);
+        return 0;
+    }
+    CGXDLMSSettings settings(true);
+    CGXDLMSValueEventArg e(&pg, 8);
+    CGXDLMSVariant tmp = value;
+    e.SetValue(tmp);
+    return pg.SetValue(settings, e);
+}
+
+/////////////////////////////////////////////////////////////////////////
+//Returns true if buffer has the expected values in the expected order.
+/////////////////////////////////////////////////////////////////////////
+static bool IsBuffer(CGXDLMSProfileGeneric& pg, const int* expected, int count, bool reverse)
+{
+    std::vector< std::vector<CGXDLMSVariant> >& rows = pg.GetBuffer();
+    if ((int)rows.size() != count)
+    {
+        return false;
+    }
+    for (int pos = 0; pos != count; ++pos)
+    {
+        if (rows[pos][0].ToInteger() != expected[reverse ? count - 1 - pos : pos])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/////////////////////////////////////////////////////////////////////////
+//Profile entries is changed after the ring is wrapped. Rows must stay in
+//capture order.
+/////////////////////////////////////////////////////////////////////////
+static int VerifyRing()
+{
+    static const int LARGER[] = { 3, 4, 5, 6, 7 };
+    static const int SMALLER[] = { 7, 8 };
+    int ret = 0;
+    CGXRingServer server;
+    for (int pos = 0; ret == 0 && pos != 4; ++pos)
+    {
+        bool lifo = (pos & 1) != 0, set = (pos & 2) != 0;
+        CGXDLMSData data("0.0.96.1.0.255");
+        CGXDLMSProfileGeneric pg("1.0.99.1.0.255");
+        pg.SetSortMethod(lifo ? DLMS_SORT_METHOD_LIFO : DLMS_SORT_METHOD_FIFO);
+        pg.AddCaptureObject(&data, 2, 0);
+        if (SetEntries(pg, 3, set) != 0 ||
+            CaptureRows(&server, pg, data, 1, 5) != 0 ||
+            SetEntries(pg, 5, set) != 0 ||
+            CaptureRows(&server, pg, data, 6, 7) != 0 ||
+            !IsBuffer(pg, LARGER, 5, lifo) ||
+            SetEntries(pg, 2, set) != 0 ||
+            CaptureRows(&server, pg, data, 8, 8) != 0 ||
+            !IsBuffer(pg, SMALLER, 2, lifo))
+        {
+            printf("Profile generic rows are not in capture order. Sort method: %s. Entries are set with %s.\r\n",
+                lifo ? "LIFO" : "FIFO", set ? "SET" : "SetProfileEntries");
+            ret = 1;
+        }
+    }
+    return ret;
+}
+
+/////////////////////////////////////////////////////////////////////////
+//Send the request and return average microseconds per request.
+//Returns -1 if the server reports an error.
+/////////////////////////////////////////////////////////////////////////
+static double Measure(CGXDLMSBase* session, CGXByteBuffer& request, int count)
+{
+    CGXByteBuffer reply;
+    double start = CGXBench::Now();
+    for (int pos = 0; pos != count; ++pos)
+    {
+        reply.SetSize(0);
+        //Get response normal with data.
+        if (session->HandleRequest(request, reply) != 0 || reply.GetSize() < 12 ||
+            reply.GetData()[8] != 0xC4 || reply.GetData()[11] != 0)
+        {
+            return -1;
+        }
+    }
+    return 1e6 * (CGXBench::Now() - start) / count;
+}
+
+/////////////////////////////////////////////////////////////////////////
+//Checks the order of captured rows when profile entries is changed. Reads
+//entries in use, the oldest rows and the newest rows of the profile with
+//growing history. Time per read should stay the same when history grows.
+//
+//Usage: bench profile [data file] [reads]
+/////////////////////////////////////////////////////////////////////////
+int BenchProfile(int argc, char* argv[])
+{
+    const char* fileName = argc > 0 ? argv[0] : "/tmp/DlmsServerBench.bin";
+    int count = argc > 1 ? atoi(argv[1]) : 2000;
+    if (count < 1)
+    {
+        printf("Invalid read count.\r\n");
+        return 1;
+    }
+    if (VerifyRing() != 0)
+    {
+        return 1;
+    }
+    printf("Profile generic ring keeps capture order when entries are changed.\r\n");
+    unsigned long long sizes[] = { 1000, 10000, 100000, 1000000 };
+    CGXByteBuffer aarq, entriesInUse, first, last, reply;
+    CGXBench::MakeFrame(BENCH_AARQ, 16, aarq);
+    CGXBench::MakeFrame(BENCH_ENTRIES_IN_USE, 16, entriesInUse);
+    GetEntries(1, 10, first);
+    printf("%10s %14s %14s %14s\r\n", "rows", "in use us", "first 10 us", "last 10 us");
+    for (int pos = 0; pos != sizeof(sizes) / sizeof(sizes[0]); ++pos)
+    {
+        CGXDLMSServerLN* server = CGXBench::CreateServer(fileName, sizes[pos]);
+        if (server == NULL)
+        {
+            printf("Failed to create server.\r\n");
+            return 1;
+        }
+        CGXDLMSBase* session = server->CreateClientServer();
+        if (session->HandleRequest(aarq, reply) != 0)
+        {
+            printf("Association failed.\r\n");
+            delete session;
+            delete server;
+            return 1;
+        }
+        GetEntries((unsigned long)sizes[pos] - 9, (unsigned long)sizes[pos], last);
+        double inUse = Measure(session, entriesInUse, count);
+        double firstRows = Measure(session, first, count);
+        double lastRows = Measure(session, last, count);
+        delete session;
+        delete server;
+        if (inUse < 0 || firstRows < 0 || lastRows < 0)
+        {
+            printf("Profile read failed.\r\n");
+            return 1;
+        }
+        printf("%10llu %14.2f %14.2f %14.2f\r\n", sizes[pos], inUse, firstRows, lastRows);
+    }
+    unlink(fileName);
+    return 0;
+}
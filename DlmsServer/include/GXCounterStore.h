@@ -0,0 +1,115 @@
+#ifndef GXCOUNTERSTORE_H
+#define GXCOUNTERSTORE_H
+
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/////////////////////////////////////////////////////////////////////////
+//Header at the beginning of the invocation counter file.
+//Header is followed by 64 bit reservation of each meter.
+/////////////////////////////////////////////////////////////////////////
+struct GXCounterStoreHeader
+{
+    //"GXIC"
+    char magic[4];
+    unsigned int version;
+    unsigned int count;
+    unsigned int reserved;
+};
+
+/////////////////////////////////////////////////////////////////////////
+//Invocation counters of the meters that are kept over restarts.
+//
+//Counters are not saved after each frame. The file holds a reservation
+//for each meter and all counters below it may have been used. After a
+//restart counters continue from the reservation so they are never
+//reused. Reservation is moved ahead in large ranges before the sessions
+//reach it. Reservations of all meters that are waiting are written by
+//one thread with one sync, so the cost of the sync is shared.
+//
+//Each session leases a block of counters. Concurrent sessions of the
+//same meter use different blocks. Unused part of the block is returned
+//when the session ends if nobody has leased after it.
+/////////////////////////////////////////////////////////////////////////
+class CGXCounterStore
+{
+    //Next counter that is not leased.
+    std::vector<unsigned long long> m_Next;
+    //Reservation that is saved to the file.
+    std::vector<unsigned long long> m_Durable;
+    //Reservation that is waiting to be saved.
+    std::vector<unsigned long long> m_Requested;
+    //Meters whose reservation is waiting to be saved.
+    std::vector<int> m_Dirty;
+    //Amount of counters that one session leases at once.
+    unsigned long long m_Lease;
+    //Amount of counters that reservation is moved ahead.
+    unsigned long long m_Range;
+    //File descriptor or -1 if counters are kept only in memory.
+    int m_File;
+    bool m_Stop;
+    std::mutex m_Lock;
+    //Signaled when reservations are requested.
+    std::condition_variable m_Requests;
+    //Signaled when reservations are saved.
+    std::condition_variable m_Saved;
+    std::thread m_Writer;
+
+    //Move reservation ahead if needed and wait until the limit is saved.
+    void Reserve(std::unique_lock<std::mutex>& lock, int index, unsigned long long limit);
+
+    //Lease counters from next free counter and wait until they are reserved.
+    void Lease(
+        std::unique_lock<std::mutex>& lock,
+        int index,
+        unsigned long long& counter,
+        unsigned long long& limit);
+
+    //Write requested reservations to the file.
+    void Run();
+public:
+    CGXCounterStore();
+
+    ~CGXCounterStore();
+
+    /**
+    * Open counters.
+    *
+    * @param fileName Counter file or NULL if counters are kept only in memory.
+    * @param count Meter count. File is grown if it has less meters. Meters
+    * after the count are kept in the file.
+    * @param range Amount of counters that reservation is moved ahead.
+    */
+    int Open(const char* fileName, int count, unsigned long long range);
+
+    //Amount of meters in the file. This can be more than the opened count.
+    int GetCount();
+
+    /**
+    * Lease counters for a session.
+    *
+    * @param index Meter index.
+    * @param counter Counter that session continues from. It's incremented before it's used.
+    * @param limit Session can use counters up to this.
+    */
+    void Acquire(int index, unsigned long long& counter, unsigned long long& limit);
+
+    /**
+    * Lease more counters when session has used its lease.
+    * Counter is changed if the next block is leased by other session.
+    */
+    void Extend(int index, unsigned long long& counter, unsigned long long& limit);
+
+    /**
+    * Return unused counters of the session.
+    *
+    * @param counter Last counter that session has used.
+    * @param limit Limit of the session lease.
+    */
+    void Release(int index, unsigned long long counter, unsigned long long limit);
+};
+
+#endif //GXCOUNTERSTORE_H
@@ -37,12 +37,28 @@
 #include "GXDLMSSecureServer.h"
 #include "GXDLMSSecuritySetup.h"
 #include "GXByteBuffer.h"
+#include "GXMeterFleet.h"
+#include "GXCounterStore.h"
+#include "GXProfileStore.h"
+#include "GXProfileCursor.h"
+#include "GXDLMSArena.h"
 #include <queue>
 #include <mutex>
 
 extern char DATAFILE[FILENAME_MAX];
 extern char IMAGEFILE[FILENAME_MAX];
 
+/////////////////////////////////////////////////////////////////////////
+//How accepted connections are served.
+/////////////////////////////////////////////////////////////////////////
+typedef enum
+{
+    //Each accepted socket is served by its own detached thread.
+    GX_SERVER_MODE_THREAD_PER_CONNECTION = 0,
+    //Nonblocking sockets are multiplexed over a fixed number of epoll event loops.
+    GX_SERVER_MODE_EVENT_LOOP = 1
+} GX_SERVER_MODE;
+
 class CGXDLMSBase : public CGXDLMSSecureServer
 {
     int SendPush(CGXDLMSPushSetup* target);
@@ -54,6 +70,80 @@ private:
     CGXDLMSAssociationShortName* m_sn;
     CGXDLMSTcpUdpSetup* m_wrapper;
     CGXDLMSIecHdlcSetup* m_hdlc;
+    GX_SERVER_MODE m_ServerMode;
+    int m_EventLoopThreads;
+    //Server whose resolved values client sessions reuse. NULL for the template itself.
+    CGXDLMSBase* m_Template;
+    //Local IP address. Resolved only once by the template.
+    std::string m_IpAddress;
+    //Simulated meters or NULL if server is a single meter.
+    CGXMeterFleet* m_Fleet;
+    //Fleet meter that this session is serving or -1.
+    int m_Meter;
+    //Keys of the served meter when the session started to use it.
+    CGXMeterKeys m_MeterKeys;
+    //Invocation counters of the meters. Owned by the caller.
+    CGXCounterStore* m_Counters;
+    //Meter whose invocation counters this session has leased or -1.
+    int m_CounterIndex;
+    //Session can use invocation counters up to this.
+    unsigned long long m_CounterLimit;
+    //Profile generic rows of the served meter. Owned by the template or the fleet.
+    CGXProfileStore* m_Store;
+    //Profile generic buffer is read from the store with this.
+    CGXProfileCursor m_Cursor;
+    //Maximum amount of profile generic rows.
+    unsigned long long m_ProfileCapacity;
+    //Amount of synthetic profile generic history rows.
+    unsigned long long m_ProfileHistory;
+    //Capture period of profile generic in seconds.
+    int m_ProfilePeriod;
+    //Are temporary objects of the requests allocated from the session arena.
+    bool m_UseArena;
+    //Arena of the session. Reset after each request.
+    CGXDLMSArena m_Arena;
+    //Objects that sessions don't change until client writes them or invokes
+    //their methods. Template owns them and sessions share them.
+    //Shared objects are read only after the template is initialized. Template
+    //doesn't serve requests and it encodes their cached attributes before
+    //sessions are created. Sessions read them only with GetValue,
+    //GetDataType, GetAccess and the encoded caches, and they copy them with
+    //Unshare before they are written or their methods are invoked.
+    CGXDLMSObjectCollection m_SharedObjects;
+
+    //Build new object of the given type with the default values.
+    //Only these types are shared. Their GetValue doesn't change the object.
+    //Check this before a new type is added.
+    CGXDLMSObject* CreateSharedObject(CGXDLMSObjectCollection& items, DLMS_OBJECT_TYPE type);
+
+    //Add object that is built once by the template and shared with the sessions.
+    CGXDLMSObject* AddSharedObject(DLMS_OBJECT_TYPE type);
+
+    //Copy shared target to the session before client changes it.
+    //Copy is built like the shared object was and its cached attributes are encoded.
+    void Unshare(CGXDLMSValueEventArg* e);
+
+    //Remove the objects of the template from the session before they are released.
+    void ReleaseSharedObjects();
+
+    //Open profile store and start it with synthetic history that ends at the current period.
+    int CreateProfileData(CGXProfileStore* store, const char* fileName, long long seed);
+
+    //Save meter state that is kept between the sessions.
+    void ReleaseMeter();
+
+    //Lease invocation counters of the meter for this session.
+    void AcquireCounters(int index);
+
+    //Return unused invocation counters of the session.
+    void ReleaseCounters();
+
+    //Continue ciphering from the leased counter. Cipher refuses counters after the lease.
+    void UseCounters(unsigned long long counter);
+
+    int StartThreadPerConnection();
+
+    int StartEventLoop();
 public:
     GX_TRACE_LEVEL m_Trace;
     std::mutex m_mutex;
@@ -68,6 +158,19 @@ public:
     {
         m_ServerSocket = -1;
         m_ReceiverThread = -1;
+        m_ServerMode = GX_SERVER_MODE_THREAD_PER_CONNECTION;
+        m_EventLoopThreads = 1;
+        m_Template = NULL;
+        m_Fleet = NULL;
+        m_Meter = -1;
+        m_Counters = NULL;
+        m_CounterIndex = -1;
+        m_CounterLimit = 0;
+        m_Store = NULL;
+        m_ProfileCapacity = 10000;
+        m_ProfileHistory = 10000;
+        m_ProfilePeriod = 3600;
+        m_UseArena = false;
         m_ln = ln;
         m_sn = NULL;
         m_wrapper = NULL;
@@ -88,6 +191,19 @@ public:
     {
         m_ServerSocket = -1;
         m_ReceiverThread = -1;
+        m_ServerMode = GX_SERVER_MODE_THREAD_PER_CONNECTION;
+        m_EventLoopThreads = 1;
+        m_Template = NULL;
+        m_Fleet = NULL;
+        m_Meter = -1;
+        m_Counters = NULL;
+        m_CounterIndex = -1;
+        m_CounterLimit = 0;
+        m_Store = NULL;
+        m_ProfileCapacity = 10000;
+        m_ProfileHistory = 10000;
+        m_ProfilePeriod = 3600;
+        m_UseArena = false;
         m_ln = ln;
         m_sn = NULL;
         m_wrapper = wrapper;
@@ -105,6 +221,19 @@ public:
     {
         m_ServerSocket = -1;
         m_ReceiverThread = -1;
+        m_ServerMode = GX_SERVER_MODE_THREAD_PER_CONNECTION;
+        m_EventLoopThreads = 1;
+        m_Template = NULL;
+        m_Fleet = NULL;
+        m_Meter = -1;
+        m_Counters = NULL;
+        m_CounterIndex = -1;
+        m_CounterLimit = 0;
+        m_Store = NULL;
+        m_ProfileCapacity = 10000;
+        m_ProfileHistory = 10000;
+        m_ProfilePeriod = 3600;
+        m_UseArena = false;
         m_ln = NULL;
         m_sn = sn;
         m_wrapper = NULL;
@@ -122,6 +251,19 @@ public:
     {
         m_ServerSocket = -1;
         m_ReceiverThread = -1;
+        m_ServerMode = GX_SERVER_MODE_THREAD_PER_CONNECTION;
+        m_EventLoopThreads = 1;
+        m_Template = NULL;
+        m_Fleet = NULL;
+        m_Meter = -1;
+        m_Counters = NULL;
+        m_CounterIndex = -1;
+        m_CounterLimit = 0;
+        m_Store = NULL;
+        m_ProfileCapacity = 10000;
+        m_ProfileHistory = 10000;
+        m_ProfilePeriod = 3600;
+        m_UseArena = false;
         m_ln = NULL;
         m_sn = sn;
         m_wrapper = wrapper;
@@ -134,7 +276,14 @@ public:
     /////////////////////////////////////////////////////////////////////////
     ~CGXDLMSBase(void)
     {
+        ReleaseMeter();
+        ReleaseCounters();
         StopServer();
+        if (m_Template == NULL)
+        {
+            delete m_Store;
+        }
+        ReleaseSharedObjects();
     }
 
     bool IsConnected();
@@ -145,6 +294,58 @@ public:
 
     int StopServer();
 
+    GX_SERVER_MODE GetServerMode();
+
+    void SetServerMode(GX_SERVER_MODE value);
+
+    //Number of epoll event loop threads used in GX_SERVER_MODE_EVENT_LOOP.
+    int GetEventLoopThreads();
+
+    void SetEventLoopThreads(int value);
+
+    //Are temporary objects of the requests allocated from a per session arena.
+    bool GetUseArena();
+
+    void SetUseArena(bool value);
+
+    //Maximum amount of profile generic rows kept for each meter.
+    unsigned long long GetProfileCapacity();
+
+    void SetProfileCapacity(unsigned long long value);
+
+    //Amount of profile generic history rows that each meter has at startup.
+    unsigned long long GetProfileHistory();
+
+    void SetProfileHistory(unsigned long long value);
+
+    //Seconds between profile generic history rows.
+    int GetProfilePeriod();
+
+    void SetProfilePeriod(int value);
+
+    CGXMeterFleet* GetFleet();
+
+    //Serve meters of the fleet. Sessions are routed by server address or port.
+    void SetFleet(CGXMeterFleet* value);
+
+    //Change identity, keys and profile data to the fleet meter.
+    int BindMeter(int index);
+
+    CGXCounterStore* GetCounters();
+
+    //Invocation counters are leased from the store and they are kept over restarts.
+    void SetCounters(CGXCounterStore* value);
+
+    //Lease more invocation counters if session is running out of them.
+    //This is called before the request is handled so that requests are
+    //not refused because the cipher has reached the end of the lease.
+    void ReserveCounters();
+
+    //Create server instance that serves one accepted client.
+    //Objects are built from the values this server has already resolved.
+    //Objects that client doesn't change are shared with this server.
+    CGXDLMSBase* CreateClientServer();
+
     int Init(int port, GX_TRACE_LEVEL trace);
     int Init();
     void InitializeObjects();
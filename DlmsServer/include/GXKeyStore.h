@@ -0,0 +1,98 @@
+#ifndef GXKEYSTORE_H
+#define GXKEYSTORE_H
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+/////////////////////////////////////////////////////////////////////////
+//Identity and keys of one meter. Saved as is to the key store file.
+/////////////////////////////////////////////////////////////////////////
+struct CGXMeterKeys
+{
+    unsigned int serialNumber;
+    //Wrapper or HDLC server address that selects this meter.
+    unsigned short serverAddress;
+    unsigned short reserved;
+    unsigned char systemTitle[8];
+    unsigned char blockCipherKey[16];
+    unsigned char authenticationKey[16];
+    //Dedicated key is not used if it's all zeros.
+    unsigned char dedicatedKey[16];
+    unsigned char kek[16];
+};
+
+/////////////////////////////////////////////////////////////////////////
+//Header at the beginning of the key store file.
+/////////////////////////////////////////////////////////////////////////
+struct GXKeyStoreHeader
+{
+    //"GXKS"
+    char magic[4];
+    unsigned int version;
+    unsigned int count;
+    unsigned int recordSize;
+};
+
+/////////////////////////////////////////////////////////////////////////
+//Keys of the meters. Meter is found by server address from open
+//addressing hash table. Table is built when keys are set and it's not
+//changed after that.
+//
+//Identity of the meter never changes but keys can be updated. Each record
+//has a sequence number that is odd while the record is written. Readers
+//copy the record and retry if the sequence changed, so reads don't take
+//locks. Updates are serialized with a lock.
+/////////////////////////////////////////////////////////////////////////
+class CGXKeyStore
+{
+    std::vector<CGXMeterKeys> m_Keys;
+    std::vector<unsigned int> m_Sequences;
+    //Meter index + 1 or zero if slot is empty.
+    std::vector<unsigned int> m_ByServerAddress;
+    //Updated keys are written to this file. Empty if keys are only in memory.
+    std::string m_FileName;
+    std::mutex m_Lock;
+public:
+    /**
+    * Set keys and build the lookup table. Keys are moved from the vector.
+    * Server addresses and system titles must be unique.
+    */
+    int Set(std::vector<CGXMeterKeys>& keys);
+
+    /**
+    * Load keys from the file. Updated keys are saved to the same file.
+    */
+    int Load(const char* fileName);
+
+    /**
+    * Save keys to the file. Updated keys are saved to the same file after this.
+    */
+    int Save(const char* fileName);
+
+    int GetCount();
+
+    /**
+    * Copy identity and keys of the meter.
+    *
+    * @param index Meter index.
+    * @param value Keys are copied here.
+    */
+    void GetKeys(int index, CGXMeterKeys& value);
+
+    /**
+    * Save the keys that a session has changed. Keys that are same in
+    * bound and value are not written, so changes that other sessions
+    * have saved meanwhile are kept.
+    *
+    * @param index Meter index.
+    * @param bound Keys when the session started to use the meter.
+    * @param value Keys of the session.
+    */
+    int Update(int index, const CGXMeterKeys& bound, const CGXMeterKeys& value);
+
+    //Returns meter index or -1 if there is no meter with given address.
+    int FindByServerAddress(unsigned long serverAddress);
+};
+
+#endif //GXKEYSTORE_H
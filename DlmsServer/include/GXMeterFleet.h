@@ -0,0 +1,107 @@
+#ifndef GXMETERFLEET_H
+#define GXMETERFLEET_H
+
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "GXByteBuffer.h"
+#include "GXProfileStore.h"
+#include "GXKeyStore.h"
+
+/////////////////////////////////////////////////////////////////////////
+//Mutable state of the meters that share one lock.
+//Meter i belongs to shard i % shard count.
+/////////////////////////////////////////////////////////////////////////
+struct CGXFleetShard
+{
+    std::mutex lock;
+    //Profile data of the meter or NULL if meter is not used yet.
+    std::vector<CGXProfileStore*> store;
+    //Is profile data of the meter being created without the lock.
+    std::vector<bool> creating;
+    //Signaled when profile data of a meter is created.
+    std::condition_variable created;
+};
+
+/////////////////////////////////////////////////////////////////////////
+//Logical meters simulated by one server process.
+//Meter identities and keys are in the key store and they are read without locks.
+/////////////////////////////////////////////////////////////////////////
+class CGXMeterFleet
+{
+    CGXKeyStore m_Keys;
+    std::vector<CGXFleetShard*> m_Shards;
+    unsigned short m_BasePort;
+    std::string m_DataDirectory;
+
+    int CreateShards(unsigned short basePort, int shardCount);
+public:
+    CGXMeterFleet();
+
+    ~CGXMeterFleet();
+
+    /**
+    * Create meters. Serial numbers and server addresses are assigned in order.
+    * System title is "GRX" and serial number. The last four bytes of
+    * the given keys are replaced with serial number.
+    *
+    * @param count Meter count.
+    * @param firstSerialNumber Serial number of the first meter.
+    * @param firstServerAddress Server address of the first meter.
+    * @param basePort Port of the first meter or zero if meters are not found by port.
+    * @param blockCipherKey Block cipher key template.
+    * @param authenticationKey Authentication key template.
+    * @param kek Key encryption key template.
+    * @param shardCount Amount of locks that meter state is split to.
+    */
+    int Create(
+        int count,
+        unsigned long firstSerialNumber,
+        unsigned short firstServerAddress,
+        unsigned short basePort,
+        CGXByteBuffer& blockCipherKey,
+        CGXByteBuffer& authenticationKey,
+        CGXByteBuffer& kek,
+        int shardCount);
+
+    /**
+    * Load meters from the key store file.
+    *
+    * @param fileName Key store file.
+    * @param basePort Port of the first meter or zero if meters are not found by port.
+    * @param shardCount Amount of locks that meter state is split to.
+    */
+    int Load(const char* fileName, unsigned short basePort, int shardCount);
+
+    int GetCount();
+
+    //Identities and keys of the meters.
+    CGXKeyStore& GetKeys();
+
+    //Port that selects the meter. Zero if meter is found only by address.
+    unsigned short GetPort(int index);
+
+    //Returns meter index or -1 if there is no meter with given address.
+    int FindByServerAddress(unsigned long serverAddress);
+
+    //Returns meter index or -1 if there is no meter listening given port.
+    int FindByPort(unsigned short port);
+
+    unsigned short GetBasePort();
+
+    //Directory where meter profile data is saved.
+    std::string& GetDataDirectory();
+
+    void SetDataDirectory(const std::string& value);
+
+    //Profile data file of the meter.
+    std::string GetDataFile(int index);
+
+    CGXFleetShard& GetShard(int index);
+
+    //Position of the meter inside of its shard.
+    int GetShardIndex(int index);
+};
+
+#endif //GXMETERFLEET_H
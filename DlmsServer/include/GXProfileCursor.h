@@ -0,0 +1,33 @@
+#ifndef GXPROFILECURSOR_H
+#define GXPROFILECURSOR_H
+
+#include "IGXDLMSProfileCursor.h"
+#include "GXProfileStore.h"
+
+/////////////////////////////////////////////////////////////////////////
+//Encodes rows of the profile store straight to the reply.
+//First column is the capture time and it's sent as date time.
+//Only the selected columns are read from the record.
+/////////////////////////////////////////////////////////////////////////
+class CGXProfileCursor : public IGXDLMSProfileCursor
+{
+    CGXProfileStore* m_Store;
+public:
+    CGXProfileCursor();
+
+    //Store where rows are read.
+    CGXProfileStore* GetStore();
+
+    void SetStore(CGXProfileStore* value);
+
+    int GetRows(
+        CGXDLMSSettings& settings,
+        std::vector<DLMS_DATA_TYPE>& types,
+        std::vector<int>& columns,
+        unsigned long index,
+        unsigned long count,
+        CGXByteBuffer& data,
+        unsigned long& rows);
+};
+
+#endif //GXPROFILECURSOR_H
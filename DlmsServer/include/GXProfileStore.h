@@ -0,0 +1,183 @@
+#ifndef GXPROFILESTORE_H
+#define GXPROFILESTORE_H
+
+#include <stddef.h>
+#include <mutex>
+
+typedef enum
+{
+    //Capture times are not in ascending order and range can't be searched.
+    GX_PROFILE_STORE_FLAGS_UNSORTED = 0x1
+} GX_PROFILE_STORE_FLAGS;
+
+/////////////////////////////////////////////////////////////////////////
+//Header at the beginning of the profile store file.
+/////////////////////////////////////////////////////////////////////////
+struct GXProfileStoreHeader
+{
+    //"GXPS"
+    char magic[4];
+    unsigned int version;
+    unsigned int columnCount;
+    //GX_PROFILE_STORE_FLAGS.
+    unsigned int flags;
+    //Maximum amount of rows. History rows are counted too.
+    unsigned long long capacity;
+    //Amount of records in use.
+    unsigned long long count;
+    //Position of the oldest record when store is used as a ring.
+    unsigned long long first;
+    //Capture time of the history row zero.
+    long long historyStart;
+    //Seconds between history rows.
+    long long historyPeriod;
+    //Value of the history row N is seed + N + 1.
+    long long historySeed;
+    //Number of the oldest history row in use.
+    unsigned long long historyFirst;
+    //Amount of history rows in use. They are before the records.
+    unsigned long long historyCount;
+};
+
+/////////////////////////////////////////////////////////////////////////
+//Profile generic rows saved as fixed size binary records to a memory
+//mapped file. Records are kept in a ring. When store is full the oldest
+//record is overwritten. Record N is found at offset
+//header + ((first + N) % capacity) * record size.
+//
+//Count and ring position are updated on append and saved in the header
+//so they are never counted from the records.
+//
+//Store can start with synthetic history. History rows are not written to
+//the file. They are computed from the start time, period and seed when
+//they are read, so history can be any length. Appended records come after
+//the history and when store is full the oldest history row is removed
+//first.
+//
+//Each column is a 64-bit signed integer. The first column is the capture
+//time in seconds as returned by mktime.
+//
+//Appends are serialized with a lock. Readers do not take the lock. The
+//store has a sequence number that is odd while rows or the header are
+//changed. Readers copy what they need and retry if the sequence changed,
+//so they never see a half written row or a row moved by the ring.
+//
+//Records are normally appended in time order. Time range is then found
+//with binary search. If older time is appended store is marked unsorted
+//and ranges are searched linearly until it's cleared.
+/////////////////////////////////////////////////////////////////////////
+class CGXProfileStore
+{
+    int m_File;
+    GXProfileStoreHeader* m_Header;
+    long long* m_Records;
+    size_t m_MappedSize;
+    std::mutex m_Lock;
+    //Odd while the store is changed.
+    unsigned int m_Sequence;
+
+    //Start change of the store. Lock must be held.
+    void BeginWrite();
+
+    //End change of the store.
+    void EndWrite();
+
+    //Sequence number when store is not changed.
+    unsigned int BeginRead();
+
+    //Returns true if store was not changed after BeginRead.
+    bool EndRead(unsigned int sequence);
+
+    //Capture time of the row.
+    long long GetTime(
+        unsigned long long index,
+        unsigned long long historyCount,
+        unsigned long long first);
+
+    //Returns amount of rows which capture time is before the given time.
+    //If orEqual is set rows captured exactly at the given time are counted too.
+    unsigned long long Bound(
+        unsigned long long count,
+        unsigned long long historyCount,
+        unsigned long long first,
+        long long time,
+        bool orEqual);
+public:
+    CGXProfileStore();
+
+    ~CGXProfileStore();
+
+    /**
+    * Open store. Store is created if file doesn't exist or it's layout
+    * is different.
+    *
+    * @param fileName Store file name.
+    * @param columnCount Amount of columns in each record.
+    * @param capacity Maximum amount of rows.
+    */
+    int Open(
+        const char* fileName,
+        unsigned int columnCount,
+        unsigned long long capacity);
+
+    void Close();
+
+    bool IsOpen();
+
+    unsigned int GetColumnCount();
+
+    unsigned long long GetCapacity();
+
+    //Amount of rows in use. History rows are counted too.
+    unsigned long long GetCount();
+
+    /**
+    * Get columns of the row. Index is zero based and the oldest row is at
+    * index zero.
+    *
+    * @param index Row index.
+    * @param values Column values are copied here.
+    * @return False if there is no row with given index.
+    */
+    bool GetRecord(unsigned long long index, long long* values);
+
+    /**
+    * Find records inside of the time range.
+    *
+    * @param from Start time.
+    * @param to End time.
+    * @param begin Amount of records before the range.
+    * @param end Amount of records before the end of the range.
+    */
+    void FindRange(
+        long long from,
+        long long to,
+        unsigned long long& begin,
+        unsigned long long& end);
+
+    //Add record to the end of the store. The oldest record is removed if
+    //store is full.
+    int Append(const long long* values);
+
+    /**
+    * Remove all rows and start with synthetic history.
+    *
+    * @param start Capture time of the first history row.
+    * @param period Seconds between history rows.
+    * @param count Amount of history rows.
+    * @param seed Value of the first history row is seed + 1.
+    */
+    int SetHistory(
+        long long start,
+        long long period,
+        unsigned long long count,
+        long long seed);
+
+    //Remove all rows.
+    void Clear();
+
+    //Write changed pages to the disk.
+    int Flush();
+};
+
+#endif //GXPROFILESTORE_H
@@ -117,11 +117,17 @@ int main(int argc, char* argv[])
     *p = '\0';
     strcpy(IMAGEFILE, DATAFILE);
     strcat(IMAGEFILE, "/empty.bin");
-    strcat(DATAFILE, "/data.csv");
+    strcat(DATAFILE, "/data.bin");
 
     int ret = 0;
     
     LNServer = new CGXDLMSServerLN(new CGXDLMSAssociationLogicalName(), new CGXDLMSIecHdlcSetup());
+    LNServer->SetProfileCapacity(strtoull(config.getValue("PROFILE", "Capacity", "10000").c_str(), NULL, 10));
+    LNServer->SetProfileHistory(strtoull(config.getValue("PROFILE", "History", "10000").c_str(), NULL, 10));
+    LNServer->SetProfilePeriod(atoi(config.getValue("PROFILE", "Period", "3600").c_str()));
+    CGXByteBuffer kek;
+    kek.SetHexString(config.getValue("DLMS", "Kek", "31313131313131313131313131313131"));
+    LNServer->SetKek(kek);
 
     if ((ret = LNServer->Init()) != 0)
     {
@@ -142,8 +148,84 @@ int main(int argc, char* argv[])
     printf("Master key (KEK) title: %s\r\n", LNServer->GetKek().ToString().c_str());
     fflush(stdout);
 
+    //Simulate many meters in one process.
+    int meterCount = atoi(config.getValue("FLEET", "MeterCount", "0").c_str());
+    if (meterCount > 0)
+    {
+        CGXByteBuffer blockCipherKey, authenticationKey;
+        blockCipherKey.SetHexString(config.getValue("FLEET", "BlockCipherKey", "000102030405060708090A0B0C0D0E0F"));
+        authenticationKey.SetHexString(config.getValue("FLEET", "AuthenticationKey", "D0D1D2D3D4D5D6D7D8D9DADBDCDDDEDF"));
+        int shards = (int)std::thread::hardware_concurrency();
+        shards = shards < 1 ? 1 : shards;
+        unsigned short basePort = (unsigned short)atoi(config.getValue("FLEET", "BasePort", "0").c_str());
+        std::string keyFile = config.getValue("FLEET", "KeyFile", "");
+        CGXMeterFleet* fleet = new CGXMeterFleet();
+        //Keys are generated when the key file is used first time.
+        std::error_code ec;
+        if (!keyFile.empty() && std::filesystem::exists(keyFile, ec))
+        {
+            if ((ret = fleet->Load(keyFile.c_str(), basePort, shards)) != 0)
+            {
+                printf("Failed to load meter keys from %s.\r\n", keyFile.c_str());
+                return ret;
+            }
+        }
+        else
+        {
+            if ((ret = fleet->Create(meterCount,
+                strtoul(config.getValue("FLEET", "FirstSerialNumber", "100000").c_str(), NULL, 10),
+                (unsigned short)atoi(config.getValue("FLEET", "FirstServerAddress", "1").c_str()),
+                basePort, blockCipherKey, authenticationKey, kek, shards)) != 0)
+            {
+                printf("Invalid fleet configuration.\r\n");
+                return ret;
+            }
+            if (!keyFile.empty() && (ret = fleet->GetKeys().Save(keyFile.c_str())) != 0)
+            {
+                printf("Failed to save meter keys to %s.\r\n", keyFile.c_str());
+                return ret;
+            }
+        }
+        std::filesystem::path meters = std::filesystem::path(DATAFILE).parent_path() / "meters";
+        std::filesystem::create_directories(meters, ec);
+        fleet->SetDataDirectory(meters.string());
+        LNServer->SetFleet(fleet);
+        printf("Simulating %d meters. Data directory: %s\r\n", fleet->GetCount(), meters.c_str());
+    }
+
+    //Invocation counters of the meters are kept over restarts if counter file is given.
+    CGXCounterStore* counters = new CGXCounterStore();
+    std::string counterFile = config.getValue("DLMS", "InvocationCounterFile", "");
+    if ((ret = counters->Open(counterFile.empty() ? NULL : counterFile.c_str(),
+        LNServer->GetFleet() != NULL ? LNServer->GetFleet()->GetCount() : 1,
+        strtoull(config.getValue("DLMS", "InvocationCounterRange", "65536").c_str(), NULL, 10))) != 0)
+    {
+        printf("Failed to open invocation counters %s.\r\n", counterFile.c_str());
+        return ret;
+    }
+    LNServer->SetCounters(counters);
+
+    //Connections are served either by a thread per connection or by epoll event loops.
+    if (config.getValue("DLMS", "ServerMode", "thread") == "epoll")
+    {
+        LNServer->SetServerMode(GX_SERVER_MODE_EVENT_LOOP);
+        LNServer->SetEventLoopThreads(atoi(config.getValue("DLMS", "EventLoopThreads", "1").c_str()));
+        printf("Serving connections with %d event loop(s).\r\n", LNServer->GetEventLoopThreads());
+    }
+
+    //Temporary objects of the requests can be allocated from a per session arena.
+    LNServer->SetUseArena(config.getValue("DLMS", "RequestArena", "0") == "1");
+
+    //Listed client addresses can send requests without AARQ.
+    std::stringstream preEstablished(config.getValue("DLMS", "PreEstablishedClients", ""));
+    std::string address;
+    while (std::getline(preEstablished, address, ','))
+    {
+        LNServer->GetPreEstablishedClients().push_back(strtoul(address.c_str(), NULL, 10));
+    }
+
     printf("Press Ctrl + C to close application.\r\n");
-    LNServer->StartServer(4059);
+    LNServer->StartServer(atoi(config.getValue("DLMS", "ServicePort", "4059").c_str()));
     
     return 0;
 }
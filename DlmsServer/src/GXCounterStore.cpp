@@ -0,0 +1,233 @@
+#include <string.h>
+#include <stdio.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include "../include/GXCounterStore.h"
+#include "GXErrorCodes.h"
+
+//Counter file version. Files with other version are not loaded.
+#define GX_COUNTER_STORE_VERSION 1
+
+CGXCounterStore::CGXCounterStore()
+{
+    m_Lease = 1;
+    m_Range = 1;
+    m_File = -1;
+    m_Stop = false;
+}
+
+CGXCounterStore::~CGXCounterStore()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_Lock);
+        m_Stop = true;
+    }
+    m_Requests.notify_one();
+    if (m_Writer.joinable())
+    {
+        m_Writer.join();
+    }
+    if (m_File != -1)
+    {
+        close(m_File);
+    }
+}
+
+int CGXCounterStore::Open(const char* fileName, int count, unsigned long long range)
+{
+    if (count < 1 || range < 2 || m_File != -1 || !m_Next.empty())
+    {
+        return DLMS_ERROR_CODE_INVALID_PARAMETER;
+    }
+    m_Range = range;
+    //Session leases are small compared to the reservation so several
+    //sessions can lease before the reservation is moved.
+    m_Lease = range / 256 == 0 ? 1 : range / 256;
+    m_Next.assign(count, 0);
+    m_Requested.assign(count, 0);
+    if (fileName == NULL)
+    {
+        //Counters in memory are never waited.
+        m_Durable.assign(count, ~0ULL);
+        return 0;
+    }
+    if ((m_File = open(fileName, O_RDWR | O_CREAT, 0644)) == -1)
+    {
+        return DLMS_ERROR_CODE_HARDWARE_FAULT;
+    }
+    GXCounterStoreHeader header;
+    ssize_t size = pread(m_File, &header, sizeof(header), 0);
+    if (size == sizeof(header))
+    {
+        //Counters that may have been used are not forgotten because of a broken file.
+        if (memcmp(header.magic, "GXIC", 4) != 0 || header.version != GX_COUNTER_STORE_VERSION)
+        {
+            return DLMS_ERROR_CODE_INVALID_PARAMETER;
+        }
+    }
+    else if (size != 0)
+    {
+        return DLMS_ERROR_CODE_INVALID_PARAMETER;
+    }
+    else
+    {
+        header.count = 0;
+    }
+    //Reservations of the meters that are not used now are kept so they are
+    //not lost if meter count is increased again.
+    size_t records = header.count > (unsigned int)count ? header.count : count;
+    m_Durable.assign(records, 0);
+    if (header.count != 0 &&
+        pread(m_File, &m_Durable[0], header.count * sizeof(unsigned long long), sizeof(header)) !=
+        (ssize_t)(header.count * sizeof(unsigned long long)))
+    {
+        return DLMS_ERROR_CODE_HARDWARE_FAULT;
+    }
+    //Counters continue from the reservation because counters below it may have been used.
+    m_Next = m_Durable;
+    m_Requested = m_Durable;
+    if (header.count < (unsigned int)count)
+    {
+        //File is only grown. New meters start from zero.
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, "GXIC", 4);
+        header.version = GX_COUNTER_STORE_VERSION;
+        header.count = (unsigned int)records;
+        size_t length = records * sizeof(unsigned long long);
+        if (pwrite(m_File, &header, sizeof(header), 0) != sizeof(header) ||
+            pwrite(m_File, &m_Durable[0], length, sizeof(header)) != (ssize_t)length ||
+            fdatasync(m_File) != 0)
+        {
+            return DLMS_ERROR_CODE_HARDWARE_FAULT;
+        }
+    }
+    m_Writer = std::thread(&CGXCounterStore::Run, this);
+    return 0;
+}
+
+int CGXCounterStore::GetCount()
+{
+    return (int)m_Next.size();
+}
+
+void CGXCounterStore::Reserve(std::unique_lock<std::mutex>& lock, int index, unsigned long long limit)
+{
+    if (m_File == -1)
+    {
+        return;
+    }
+    //Reservation is moved when half of it is used so sessions don't usually wait.
+    if (m_Requested[index] < limit + m_Range / 2)
+    {
+        m_Requested[index] = limit + m_Range;
+        m_Dirty.push_back(index);
+        m_Requests.notify_one();
+    }
+    while (m_Durable[index] < limit)
+    {
+        m_Saved.wait(lock);
+    }
+}
+
+void CGXCounterStore::Lease(
+    std::unique_lock<std::mutex>& lock,
+    int index,
+    unsigned long long& counter,
+    unsigned long long& limit)
+{
+    counter = m_Next[index];
+    limit = counter + m_Lease;
+    m_Next[index] = limit;
+    Reserve(lock, index, limit);
+}
+
+void CGXCounterStore::Acquire(int index, unsigned long long& counter, unsigned long long& limit)
+{
+    std::unique_lock<std::mutex> lock(m_Lock);
+    Lease(lock, index, counter, limit);
+}
+
+void CGXCounterStore::Extend(int index, unsigned long long& counter, unsigned long long& limit)
+{
+    std::unique_lock<std::mutex> lock(m_Lock);
+    if (m_Next[index] == limit)
+    {
+        //Nobody has leased after this session so the lease continues.
+        limit += m_Lease;
+        m_Next[index] = limit;
+        Reserve(lock, index, limit);
+    }
+    else
+    {
+        Lease(lock, index, counter, limit);
+    }
+}
+
+void CGXCounterStore::Release(int index, unsigned long long counter, unsigned long long limit)
+{
+    std::lock_guard<std::mutex> lock(m_Lock);
+    if (m_Next[index] == limit && counter < limit)
+    {
+        m_Next[index] = counter;
+    }
+}
+
+void CGXCounterStore::Run()
+{
+    std::vector<int> batch;
+    std::vector<unsigned long long> values;
+    std::unique_lock<std::mutex> lock(m_Lock);
+    while (!m_Stop)
+    {
+        if (m_Dirty.empty())
+        {
+            m_Requests.wait(lock);
+            continue;
+        }
+        //Everything that was requested while the previous batch was saved is saved together.
+        batch.swap(m_Dirty);
+        m_Dirty.clear();
+        std::sort(batch.begin(), batch.end());
+        batch.erase(std::unique(batch.begin(), batch.end()), batch.end());
+        values.resize(batch.size());
+        for (size_t pos = 0; pos != batch.size(); ++pos)
+        {
+            values[pos] = m_Requested[batch[pos]];
+        }
+        lock.unlock();
+        bool ok = true;
+        //Consecutive meters are written with one call.
+        for (size_t pos = 0; ok && pos != batch.size();)
+        {
+            size_t end = pos + 1;
+            while (end != batch.size() && batch[end] == batch[end - 1] + 1)
+            {
+                ++end;
+            }
+            off_t offset = sizeof(GXCounterStoreHeader) + (off_t)batch[pos] * sizeof(unsigned long long);
+            size_t length = (end - pos) * sizeof(unsigned long long);
+            ok = pwrite(m_File, &values[pos], length, offset) == (ssize_t)length;
+            pos = end;
+        }
+        ok = ok && fdatasync(m_File) == 0;
+        lock.lock();
+        if (!ok)
+        {
+            //Sessions keep waiting until the reservation is saved.
+            printf("Failed to save invocation counters.\r\n");
+            m_Dirty.insert(m_Dirty.end(), batch.begin(), batch.end());
+            m_Requests.wait_for(lock, std::chrono::seconds(1));
+            continue;
+        }
+        for (size_t pos = 0; pos != batch.size(); ++pos)
+        {
+            if (m_Durable[batch[pos]] < values[pos])
+            {
+                m_Durable[batch[pos]] = values[pos];
+            }
+        }
+        m_Saved.notify_all();
+    }
+}
@@ -39,6 +39,10 @@
 #include <netinet/in.h>
 #include <netdb.h>
 #include <pthread.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <sys/epoll.h>
+#include <algorithm>
 
 typedef int SOCKET;
 #define INVALID_SOCKET  (SOCKET)(~0) // Evaluates to -1
@@ -53,11 +57,84 @@ int imageSize;
 static std::string FIRMWARE_VERSION = "Gurux FW 0.0.1";
 static std::string pendingFirmwareVersion;
 
+// Logical names that are compared or searched while requests are handled.
+static constexpr CGXObisCode FIRMWARE_VERSION_LN("1.0.0.2.0.255");
+static constexpr CGXObisCode DEVICE_ID_LN("0.0.42.0.0.255");
+static constexpr CGXObisCode SERIAL_NUMBER_LN("1.1.0.0.0.255");
+static constexpr CGXObisCode SERIAL_NUMBER_VALUE_LN("1.1.0.0.1.255");
+static constexpr CGXObisCode CURRENT_ASSOCIATION_LN("0.0.40.0.0.255");
+
 struct ClientData {
     SOCKET socket;
     CGXDLMSBase* server;
+    //Server that accepted the connection.
+    CGXDLMSBase* listener;
 };
 static void* HandleClient(void* arg);
+unsigned long GetProfileGenericDataCount(CGXProfileStore* store);
+
+/////////////////////////////////////////////////////////////////////////////
+//Socket registered to an event loop.
+/////////////////////////////////////////////////////////////////////////////
+struct EventLoopHandle {
+    //Is socket listening new connections.
+    bool listener;
+    SOCKET socket;
+};
+
+/////////////////////////////////////////////////////////////////////////////
+//Listening socket of an event loop.
+/////////////////////////////////////////////////////////////////////////////
+struct EventLoopListener : EventLoopHandle {
+    //Fleet meter that connections to this socket are served as or -1.
+    int meter;
+};
+
+/////////////////////////////////////////////////////////////////////////////
+//Connection served by an event loop.
+/////////////////////////////////////////////////////////////////////////////
+struct EventLoopSession : EventLoopHandle {
+    CGXDLMSBase* server;
+    //Received bytes waiting for HandleRequest.
+    CGXByteBuffer received;
+    //Reply bytes that socket did not accept yet.
+    CGXByteBuffer pending;
+    //Reply of the last request. Kept so it's not allocated for every request.
+    CGXByteBuffer reply;
+    //Is EPOLLOUT registered for the socket.
+    bool writing;
+};
+
+struct EventLoopData {
+    CGXDLMSBase* server;
+    int epoll;
+};
+
+/////////////////////////////////////////////////////////////////////////////
+//Open nonblocking listening socket for the fleet meter port.
+/////////////////////////////////////////////////////////////////////////////
+static SOCKET OpenListener(unsigned short port)
+{
+    SOCKET s = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
+    if (s == INVALID_SOCKET)
+    {
+        return INVALID_SOCKET;
+    }
+    int fFlag = 1;
+    sockaddr_in add = {};
+    add.sin_port = htons(port);
+    add.sin_addr.s_addr = htonl(INADDR_ANY);
+    add.sin_family = AF_INET;
+    if (setsockopt(s, SOL_SOCKET, SO_REUSEADDR, (char*)&fFlag, sizeof(fFlag)) == -1 ||
+        ::bind(s, (sockaddr*)&add, sizeof(add)) == -1 ||
+        listen(s, SOMAXCONN) == -1)
+    {
+        close(s);
+        return INVALID_SOCKET;
+    }
+    return s;
+}
+static void* EventLoop(void* arg);
 
 int CGXDLMSBase::StartServer(int port)
 {
@@ -90,6 +167,42 @@ int CGXDLMSBase::StartServer(int port)
         //bind;
         return -1;
     }
+    if (m_ServerMode == GX_SERVER_MODE_EVENT_LOOP)
+    {
+        return StartEventLoop();
+    }
+    return StartThreadPerConnection();
+}
+
+CGXDLMSBase* CGXDLMSBase::CreateClientServer()
+{
+    // Create a new server instance for this client to avoid shared state issues
+    CGXDLMSAssociationLogicalName* ln = new CGXDLMSAssociationLogicalName();
+    CGXDLMSTcpUdpSetup* wrapper = new CGXDLMSTcpUdpSetup();
+    CGXDLMSBase* clientServer = new CGXDLMSBase(ln, wrapper);
+    clientServer->m_Trace = m_Trace;
+    if (m_UseArena)
+    {
+        clientServer->m_UseArena = true;
+        clientServer->SetArena(&clientServer->m_Arena);
+    }
+    //Session reuses IP address, KEK and profile data of this server.
+    clientServer->m_Template = m_Template != NULL ? m_Template : this;
+    clientServer->m_Fleet = clientServer->m_Template->m_Fleet;
+    clientServer->m_Counters = clientServer->m_Template->m_Counters;
+    clientServer->GetPreEstablishedClients() = clientServer->m_Template->GetPreEstablishedClients();
+    clientServer->InitializeObjects(); // Add the objects to the new server
+    //Fleet sessions lease counters when the meter is selected.
+    if (clientServer->m_Fleet == NULL)
+    {
+        clientServer->AcquireCounters(0);
+    }
+    return clientServer;
+}
+
+int CGXDLMSBase::StartThreadPerConnection()
+{
+    int ret;
     if ((ret = listen(m_ServerSocket, 1)) == -1)
     {
         //socket listen failed.
@@ -107,20 +220,10 @@ int CGXDLMSBase::StartServer(int port)
         {
             continue;
         }
-        // Create a new server instance for this client to avoid shared state issues
-        CGXDLMSAssociationLogicalName* ln = new CGXDLMSAssociationLogicalName();
-        CGXDLMSTcpUdpSetup* wrapper = new CGXDLMSTcpUdpSetup();
-        CGXDLMSBase* clientServer = new CGXDLMSBase(ln, wrapper);
-        clientServer->m_Trace = m_Trace;
-        clientServer->InitializeObjects(); // Add the objects to the new server
-        // Copy KEK and other settings if needed
-        CGXByteBuffer kek;
-        kek.AddString("1111111111111111");
-        clientServer->SetKek(kek);
-
         ClientData* data = new ClientData();
         data->socket = socket;
-        data->server = clientServer;
+        data->server = CreateClientServer();
+        data->listener = this;
         pthread_t thread;
         pthread_create(&thread, NULL, HandleClient, data);
         pthread_detach(thread);
@@ -128,6 +231,289 @@ int CGXDLMSBase::StartServer(int port)
     return ret;
 }
 
+int CGXDLMSBase::StartEventLoop()
+{
+    int ret;
+    if ((ret = listen(m_ServerSocket, SOMAXCONN)) == -1)
+    {
+        //socket listen failed.
+        return -1;
+    }
+    fcntl(m_ServerSocket, F_SETFL, fcntl(m_ServerSocket, F_GETFL, 0) | O_NONBLOCK);
+    std::vector<EventLoopListener> listeners(1);
+    listeners[0].listener = true;
+    listeners[0].socket = m_ServerSocket;
+    listeners[0].meter = -1;
+    //Each fleet meter can also be reached from its own port.
+    if (m_Fleet != NULL && m_Fleet->GetBasePort() != 0)
+    {
+        listeners.resize(1 + m_Fleet->GetCount());
+        for (int pos = 0; pos != m_Fleet->GetCount(); ++pos)
+        {
+            EventLoopListener& l = listeners[1 + pos];
+            l.listener = true;
+            l.meter = pos;
+            if ((l.socket = OpenListener(m_Fleet->GetPort(pos))) == INVALID_SOCKET)
+            {
+                printf("Failed to listen port %d.\r\n", m_Fleet->GetPort(pos));
+            }
+        }
+    }
+    int count = m_EventLoopThreads < 1 ? 1 : m_EventLoopThreads;
+    std::vector<EventLoopData> loops(count);
+    std::vector<pthread_t> threads;
+    for (int pos = 0; pos != count && ret == 0; ++pos)
+    {
+        loops[pos].server = this;
+        loops[pos].epoll = epoll_create1(0);
+        if (loops[pos].epoll == -1)
+        {
+            ret = -1;
+            break;
+        }
+        //Every loop waits the listening sockets. EPOLLEXCLUSIVE wakes only one of them per connection.
+        for (std::vector<EventLoopListener>::iterator it = listeners.begin(); it != listeners.end(); ++it)
+        {
+            if (it->socket == INVALID_SOCKET)
+            {
+                continue;
+            }
+            epoll_event ev = {};
+            ev.events = EPOLLIN | EPOLLEXCLUSIVE;
+            ev.data.ptr = &*it;
+            if (epoll_ctl(loops[pos].epoll, EPOLL_CTL_ADD, it->socket, &ev) == -1)
+            {
+                ret = -1;
+                break;
+            }
+        }
+    }
+    if (ret == 0)
+    {
+        //First loop is run in the caller's thread.
+        for (int pos = 1; pos < count; ++pos)
+        {
+            pthread_t thread;
+            if (pthread_create(&thread, NULL, EventLoop, &loops[pos]) == 0)
+            {
+                threads.push_back(thread);
+            }
+        }
+        EventLoop(&loops[0]);
+        for (std::vector<pthread_t>::iterator it = threads.begin(); it != threads.end(); ++it)
+        {
+            pthread_join(*it, NULL);
+        }
+    }
+    for (std::vector<EventLoopData>::iterator it = loops.begin(); it != loops.end(); ++it)
+    {
+        if (it->epoll != -1)
+        {
+            close(it->epoll);
+        }
+    }
+    for (std::vector<EventLoopListener>::iterator it = listeners.begin() + 1; it != listeners.end(); ++it)
+    {
+        if (it->socket != INVALID_SOCKET)
+        {
+            close(it->socket);
+        }
+    }
+    return ret;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//Remove session from the event loop and release it.
+/////////////////////////////////////////////////////////////////////////////
+static void CloseSession(int epoll, EventLoopSession* session)
+{
+    epoll_ctl(epoll, EPOLL_CTL_DEL, session->socket, NULL);
+    close(session->socket);
+    delete session->server;
+    delete session;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//Send pending reply bytes. Returns false if connection is broken.
+/////////////////////////////////////////////////////////////////////////////
+static bool FlushSession(int epoll, EventLoopSession* session)
+{
+    while (session->pending.GetSize() != session->pending.GetPosition())
+    {
+        ssize_t ret = send(session->socket,
+            (const char*)session->pending.GetData() + session->pending.GetPosition(),
+            session->pending.GetSize() - session->pending.GetPosition(), MSG_NOSIGNAL);
+        if (ret == -1)
+        {
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+            {
+                break;
+            }
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return false;
+        }
+        session->pending.SetPosition(session->pending.GetPosition() + (unsigned long)ret);
+    }
+    bool done = session->pending.GetSize() == session->pending.GetPosition();
+    if (done)
+    {
+        session->pending.SetSize(0);
+    }
+    //Wait until socket is writable only while there is something to send.
+    if (done == session->writing)
+    {
+        epoll_event ev = {};
+        ev.events = done ? EPOLLIN : EPOLLIN | EPOLLOUT;
+        ev.data.ptr = session;
+        if (epoll_ctl(epoll, EPOLL_CTL_MOD, session->socket, &ev) == -1)
+        {
+            return false;
+        }
+        session->writing = !done;
+    }
+    return true;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//Read everything available and handle it. Returns false if connection is closed.
+/////////////////////////////////////////////////////////////////////////////
+static bool ReadSession(int epoll, EventLoopSession* session)
+{
+    CGXDLMSBase* server = session->server;
+    CGXByteBuffer& bb = session->received;
+    CGXByteBuffer& reply = session->reply;
+    ssize_t ret;
+    for (;;)
+    {
+        if (bb.Capacity() - bb.GetSize() < 512)
+        {
+            bb.Capacity(bb.GetSize() + 2048);
+        }
+        ret = recv(session->socket, (char*)bb.GetData() + bb.GetSize(), bb.Capacity() - bb.GetSize(), 0);
+        if (ret == -1)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+            {
+                break;
+            }
+        }
+        //If client is closed the connection or error has occurred.
+        if (ret <= 0)
+        {
+            std::lock_guard<std::mutex> lock(server->m_mutex);
+            server->Reset();
+            return false;
+        }
+        bb.SetSize(bb.GetSize() + (unsigned long)ret);
+    }
+    if (bb.GetSize() == 0)
+    {
+        return true;
+    }
+    if (server->m_Trace == GX_TRACE_LEVEL_VERBOSE)
+    {
+        printf("RX:\t%s\r\n", bb.ToHexString().c_str());
+    }
+    {
+        std::lock_guard<std::mutex> lock(server->m_mutex);
+        server->ReserveCounters();
+        if (server->HandleRequest(bb, reply) != 0)
+        {
+            return false;
+        }
+    }
+    bb.SetSize(0);
+    if (reply.GetSize() != 0)
+    {
+        if (server->m_Trace == GX_TRACE_LEVEL_VERBOSE)
+        {
+            printf("TX:\t%s\r\n", reply.ToHexString().c_str());
+        }
+        session->pending.Set(&reply);
+        reply.SetSize(0);
+        return FlushSession(epoll, session);
+    }
+    return true;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//Accept all pending connections to the event loop.
+/////////////////////////////////////////////////////////////////////////////
+static void AcceptSessions(EventLoopData* loop, EventLoopListener* listener)
+{
+    for (;;)
+    {
+        SOCKET socket = accept4(listener->socket, NULL, NULL, SOCK_NONBLOCK);
+        if (socket == INVALID_SOCKET)
+        {
+            //EAGAIN when all connections are accepted or other loop was faster.
+            break;
+        }
+        EventLoopSession* session = new EventLoopSession();
+        session->listener = false;
+        session->socket = socket;
+        session->server = loop->server->CreateClientServer();
+        session->received.Capacity(2048);
+        session->writing = false;
+        session->server->Reset();
+        if (listener->meter != -1)
+        {
+            session->server->BindMeter(listener->meter);
+        }
+        epoll_event ev = {};
+        ev.events = EPOLLIN;
+        ev.data.ptr = session;
+        if (epoll_ctl(loop->epoll, EPOLL_CTL_ADD, socket, &ev) == -1)
+        {
+            close(socket);
+            delete session->server;
+            delete session;
+        }
+    }
+}
+
+void* EventLoop(void* arg)
+{
+    EventLoopData* loop = (EventLoopData*)arg;
+    epoll_event events[64];
+    while (loop->server->IsConnected())
+    {
+        //Wake up once a second to notice that server is stopped.
+        int cnt = epoll_wait(loop->epoll, events, 64, 1000);
+        for (int pos = 0; pos < cnt; ++pos)
+        {
+            EventLoopHandle* handle = (EventLoopHandle*)events[pos].data.ptr;
+            if (handle->listener)
+            {
+                AcceptSessions(loop, (EventLoopListener*)handle);
+                continue;
+            }
+            EventLoopSession* session = (EventLoopSession*)handle;
+            bool alive = true;
+            if ((events[pos].events & (EPOLLIN | EPOLLERR | EPOLLHUP)) != 0)
+            {
+                alive = ReadSession(loop->epoll, session);
+            }
+            if (alive && (events[pos].events & EPOLLOUT) != 0)
+            {
+                alive = FlushSession(loop->epoll, session);
+            }
+            if (!alive)
+            {
+                CloseSession(loop->epoll, session);
+            }
+        }
+    }
+    return NULL;
+}
+
 void* HandleClient(void* arg) 
 {
     ClientData* data = (ClientData*)arg;
@@ -160,7 +546,8 @@ void* HandleClient(void* arg)
     snprintf(tmp, 10, "%d", add.sin_port);
     senderInfo.append(tmp);
 
-    while (server->IsConnected()) 
+    //Client server is not listening itself. Serve until the accepting server is stopped.
+    while (data->listener->IsConnected()) 
     {
         //If client is left wait for next client.
         if ((ret = recv(socket, (char*)bb.GetData() + bb.GetSize(), bb.Capacity() - bb.GetSize(), 0)) == -1) 
@@ -191,6 +578,7 @@ void* HandleClient(void* arg)
 
         {
             std::lock_guard<std::mutex> lock(server->m_mutex);
+            server->ReserveCounters();
             if (server->HandleRequest(bb, reply) != 0) 
             {
                 break;
@@ -215,7 +603,7 @@ void* HandleClient(void* arg)
                 }
                 break;
             }
-            reply.Clear();
+            reply.SetSize(0);
         }
     }
 
@@ -225,6 +613,36 @@ void* HandleClient(void* arg)
     return NULL;
 }
 
+unsigned long long CGXDLMSBase::GetProfileCapacity()
+{
+    return m_ProfileCapacity;
+}
+
+void CGXDLMSBase::SetProfileCapacity(unsigned long long value)
+{
+    m_ProfileCapacity = value;
+}
+
+unsigned long long CGXDLMSBase::GetProfileHistory()
+{
+    return m_ProfileHistory;
+}
+
+void CGXDLMSBase::SetProfileHistory(unsigned long long value)
+{
+    m_ProfileHistory = value;
+}
+
+int CGXDLMSBase::GetProfilePeriod()
+{
+    return m_ProfilePeriod;
+}
+
+void CGXDLMSBase::SetProfilePeriod(int value)
+{
+    m_ProfilePeriod = value;
+}
+
 bool CGXDLMSBase::IsConnected()
 {
     return m_ServerSocket != INVALID_SOCKET;
@@ -235,6 +653,36 @@ int CGXDLMSBase::GetSocket()
     return (int)m_ServerSocket;
 }
 
+GX_SERVER_MODE CGXDLMSBase::GetServerMode()
+{
+    return m_ServerMode;
+}
+
+void CGXDLMSBase::SetServerMode(GX_SERVER_MODE value)
+{
+    m_ServerMode = value;
+}
+
+int CGXDLMSBase::GetEventLoopThreads()
+{
+    return m_EventLoopThreads;
+}
+
+void CGXDLMSBase::SetEventLoopThreads(int value)
+{
+    m_EventLoopThreads = value;
+}
+
+bool CGXDLMSBase::GetUseArena()
+{
+    return m_UseArena;
+}
+
+void CGXDLMSBase::SetUseArena(bool value)
+{
+    m_UseArena = value;
+}
+
 int CGXDLMSBase::StopServer()
 {
     if (IsConnected())
@@ -377,6 +825,11 @@ void AddActivityCalendar(CGXDLMSObjectCollection& items)
     pActivity->GetDayProfileTablePassive().push_back(passive);
     CGXDateTime dt(CGXDateTime::Now());
     pActivity->SetTime(dt);
+    //Calendars are encoded only when they are changed.
+    for (int pos = 2; pos <= pActivity->GetAttributeCount(); ++pos)
+    {
+        pActivity->SetCached(pos, true);
+    }
     items.push_back(pActivity);
 }
 
@@ -394,6 +847,11 @@ void AddOpticalPortSetup(CGXDLMSObjectCollection& items)
     pOptical->SetPassword1("Gurux1");
     pOptical->SetPassword2("Gurux2");
     pOptical->SetPassword5("Gurux5");
+    //Setup is encoded only when it's changed.
+    for (int pos = 2; pos <= pOptical->GetAttributeCount(); ++pos)
+    {
+        pOptical->SetCached(pos, true);
+    }
     items.push_back(pOptical);
 }
 
@@ -412,6 +870,10 @@ void AddDemandRegister(CGXDLMSObjectCollection& items)
     pDr->SetCaptureTime(CGXDateTime::Now());
     pDr->SetPeriod(10);
     pDr->SetNumberOfPeriods(1);
+    //Scaler and unit, period and number of periods are encoded only when they are changed.
+    pDr->SetCached(4, true);
+    pDr->SetCached(8, true);
+    pDr->SetCached(9, true);
     items.push_back(pDr);
 }
 
@@ -523,14 +985,85 @@ CGXDLMSIp4Setup* AddIp4Setup(CGXDLMSObjectCollection& items, std::string& addres
     return pIp4;
 }
 
+int CGXDLMSBase::CreateProfileData(CGXProfileStore* store, const char* fileName, long long seed)
+{
+    int ret;
+    if (m_ProfilePeriod <= 0)
+    {
+        return DLMS_ERROR_CODE_INVALID_PARAMETER;
+    }
+    // In example profile generic we have two columns.
+    // Date time and integer value.
+    if ((ret = store->Open(fileName, 2, m_ProfileCapacity)) != 0)
+    {
+        printf("Failed to open profile store %s.\r\n", fileName);
+        return ret;
+    }
+    // History rows are not written. They are computed when they are read.
+    long long now = CGXDateTime::Now().ToUnixTime();
+    long long last = now - now % m_ProfilePeriod;
+    return store->SetHistory(last - (long long)(m_ProfileHistory - 1) * m_ProfilePeriod,
+        m_ProfilePeriod, m_ProfileHistory, seed);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//Encode cached attributes like they are encoded when they are read.
+//Attribute is not cached if it can't be encoded.
+/////////////////////////////////////////////////////////////////////////////
+static void EncodeCachedValues(CGXDLMSSettings& settings, CGXDLMSObject* obj)
+{
+    for (int index = 1; index <= obj->GetAttributeCount(); ++index)
+    {
+        if (!obj->IsCached(index))
+        {
+            continue;
+        }
+        CGXDLMSValueEventArg e(obj, index);
+        CGXByteBuffer bb;
+        int ret = obj->GetValue(settings, e);
+        CGXDLMSVariant& value = e.GetValue();
+        if (ret == 0 && e.GetError() == 0)
+        {
+            if (e.IsByteArray() && value.vt == DLMS_DATA_TYPE_OCTET_STRING)
+            {
+                bb.Set(value.byteArr, value.GetSize());
+            }
+            else
+            {
+                ret = CGXDLMS::AppendData(&settings, obj, index, bb, value);
+            }
+        }
+        if (ret == 0 && e.GetError() == 0)
+        {
+            obj->SetCachedValue(index, bb);
+        }
+        else
+        {
+            obj->SetCached(index, false);
+        }
+    }
+}
+
 void CGXDLMSBase::InitializeObjects()
 {
-    CGXByteBuffer kek;
-    kek.AddString("1111111111111111");
-    SetKek(kek);
-    //Get local IP address.
-    std::string address;
-    GetIpAddress(address);
+    if (m_Template == NULL)
+    {
+        //Get local IP address.
+        GetIpAddress(m_IpAddress);
+        m_Store = new CGXProfileStore();
+        CreateProfileData(m_Store, DATAFILE, 0);
+    }
+    else
+    {
+        //Client sessions share the profile store and resolved values of the template.
+        SetKek(m_Template->GetKek());
+        m_IpAddress = m_Template->m_IpAddress;
+        m_ProfileCapacity = m_Template->m_ProfileCapacity;
+        m_ProfileHistory = m_Template->m_ProfileHistory;
+        m_ProfilePeriod = m_Template->m_ProfilePeriod;
+        m_Store = m_Template->m_Store;
+    }
+    std::string address = m_IpAddress;
 
     unsigned long sn = 123456;
     CGXDLMSData* ldn = AddLogicalDeviceName(GetItems(), sn);
@@ -543,6 +1076,8 @@ void CGXDLMSBase::InitializeObjects()
     CGXDLMSRegister* pRegister = new CGXDLMSRegister("1.1.21.25.0.255");
     //Set access right. Client can't change Device name.
     pRegister->SetAccess(2, DLMS_ACCESS_MODE_READ);
+    //Scaler and unit is encoded only when it's changed.
+    pRegister->SetCached(3, true);
     GetItems().push_back(pRegister);
     //Add default clock. Clock's Logical Name is 0.0.1.0.0.255.
     CGXDLMSClock* pClock = new CGXDLMSClock();
@@ -568,42 +1103,34 @@ void CGXDLMSBase::InitializeObjects()
     capture = new CGXDLMSCaptureObject(2, 0);
     profileGeneric->GetCaptureObjects().push_back(std::pair<CGXDLMSObject*, CGXDLMSCaptureObject*>(pRegister, capture));
     GetItems().push_back(profileGeneric);
-
-    // Create 10 000 rows for profile generic file.
-    // In example profile generic we have two columns.
-    // Date time and integer value.
-    int rowCount = 10000;
-    CGXDateTime tm = CGXDateTime::Now();
-    tm.AddMinutes(-tm.GetValue().tm_min);
-    tm.AddSeconds(-tm.GetValue().tm_sec);
-    tm.AddHours(-(rowCount - 1));
-
-    FILE* f = fopen(DATAFILE, "w");
-
-    for (int pos = 0; pos != rowCount; ++pos)
+    //Rows are encoded from the store when buffer is read.
+    m_Cursor.SetStore(m_Store);
+    profileGeneric->SetCursor(&m_Cursor);
+    //Maximum row count.
+    profileGeneric->SetEntriesInUse(GetProfileGenericDataCount(m_Store));
+    profileGeneric->SetProfileEntries(m_ProfileCapacity);
+    //Capture objects, capture period, sort method, sort object and
+    //profile entries are encoded only when they are changed.
+    for (int pos = 3; pos <= 6; ++pos)
     {
-        fprintf(f, "%s;%d\n", tm.ToString().c_str(), pos + 1);
-        tm.AddHours(1);
+        profileGeneric->SetCached(pos, true);
     }
-    fclose(f);
-    //Maximum row count.
-    profileGeneric->SetEntriesInUse(rowCount);
-    profileGeneric->SetProfileEntries(rowCount);
+    profileGeneric->SetCached(8, true);
 
     ///////////////////////////////////////////////////////////////////////
     //Add Auto connect object.
-    AddAutoConnect(GetItems());
+    AddSharedObject(DLMS_OBJECT_TYPE_AUTO_CONNECT);
 
     ///////////////////////////////////////////////////////////////////////
     //Add Activity Calendar object.
-    AddActivityCalendar(GetItems());
+    AddSharedObject(DLMS_OBJECT_TYPE_ACTIVITY_CALENDAR);
 
     ///////////////////////////////////////////////////////////////////////
     //Add Optical Port Setup object.
-    AddOpticalPortSetup(GetItems());
+    AddSharedObject(DLMS_OBJECT_TYPE_IEC_LOCAL_PORT_SETUP);
     ///////////////////////////////////////////////////////////////////////
     //Add Demand Register object.
-    AddDemandRegister(GetItems());
+    AddSharedObject(DLMS_OBJECT_TYPE_DEMAND_REGISTER);
 
     ///////////////////////////////////////////////////////////////////////
     //Add Register Monitor object.
@@ -611,26 +1138,26 @@ void CGXDLMSBase::InitializeObjects()
 
     ///////////////////////////////////////////////////////////////////////
     //Add action schedule object.
-    AddActionSchedule(GetItems());
+    AddSharedObject(DLMS_OBJECT_TYPE_ACTION_SCHEDULE);
 
     ///////////////////////////////////////////////////////////////////////
     //Add SAP Assignment object.
-    AddSapAssignment(GetItems());
+    AddSharedObject(DLMS_OBJECT_TYPE_SAP_ASSIGNMENT);
 
     ///////////////////////////////////////////////////////////////////////
     //Add Auto Answer object.
-    AddAutoAnswer(GetItems());
+    AddSharedObject(DLMS_OBJECT_TYPE_AUTO_ANSWER);
 
     ///////////////////////////////////////////////////////////////////////
     //Add Modem Configuration object.
-    AddModemConfiguration(GetItems());
+    AddSharedObject(DLMS_OBJECT_TYPE_MODEM_CONFIGURATION);
 
     ///////////////////////////////////////////////////////////////////////
     //Add Mac Address Setup object.
-    AddMacAddressSetup(GetItems());
+    AddSharedObject(DLMS_OBJECT_TYPE_MAC_ADDRESS_SETUP);
     ///////////////////////////////////////////////////////////////////////
     //Add IP4 Setup object.
-    CGXDLMSIp4Setup* pIp4 = AddIp4Setup(GetItems(), address);
+    CGXDLMSObject* pIp4 = AddSharedObject(DLMS_OBJECT_TYPE_IP4_SETUP);
 
     ///////////////////////////////////////////////////////////////////////
     //Add Push Setup object.
@@ -649,20 +1176,166 @@ void CGXDLMSBase::InitializeObjects()
 
     ///////////////////////////////////////////////////////////////////////
     //Add image transfer object.
-    CGXDLMSImageTransfer* image = new CGXDLMSImageTransfer();
-    GetItems().push_back(image);
+    AddSharedObject(DLMS_OBJECT_TYPE_IMAGE_TRANSFER);
     ///////////////////////////////////////////////////////////////////////
     //Add script table object.
-    CGXDLMSScriptTable* st = new CGXDLMSScriptTable();
-    GetItems().push_back(st);
+    AddSharedObject(DLMS_OBJECT_TYPE_SCRIPT_TABLE);
 
     ///////////////////////////////////////////////////////////////////////
     //Add Schedule object.
-    CGXDLMSSchedule* schedule = new CGXDLMSSchedule();
-    GetItems().push_back(schedule);
+    AddSharedObject(DLMS_OBJECT_TYPE_SCHEDULE);
     ///////////////////////////////////////////////////////////////////////
     //Server must initialize after all objects are added.
     Initialize();
+    if (m_Template == NULL)
+    {
+        //Values of the shared objects are encoded before sessions read them
+        //so sessions don't update the caches of the shared objects.
+        for (CGXDLMSObjectCollection::iterator it = m_SharedObjects.begin(); it != m_SharedObjects.end(); ++it)
+        {
+            EncodeCachedValues(m_Settings, *it);
+        }
+    }
+}
+
+CGXDLMSObject* CGXDLMSBase::CreateSharedObject(CGXDLMSObjectCollection& items, DLMS_OBJECT_TYPE type)
+{
+    std::string address = m_IpAddress;
+    switch (type)
+    {
+    case DLMS_OBJECT_TYPE_AUTO_CONNECT:
+        AddAutoConnect(items);
+        break;
+    case DLMS_OBJECT_TYPE_ACTIVITY_CALENDAR:
+        AddActivityCalendar(items);
+        break;
+    case DLMS_OBJECT_TYPE_IEC_LOCAL_PORT_SETUP:
+        AddOpticalPortSetup(items);
+        break;
+    case DLMS_OBJECT_TYPE_DEMAND_REGISTER:
+        AddDemandRegister(items);
+        break;
+    case DLMS_OBJECT_TYPE_ACTION_SCHEDULE:
+        AddActionSchedule(items);
+        break;
+    case DLMS_OBJECT_TYPE_SAP_ASSIGNMENT:
+        AddSapAssignment(items);
+        break;
+    case DLMS_OBJECT_TYPE_AUTO_ANSWER:
+        AddAutoAnswer(items);
+        break;
+    case DLMS_OBJECT_TYPE_MODEM_CONFIGURATION:
+        AddModemConfiguration(items);
+        break;
+    case DLMS_OBJECT_TYPE_MAC_ADDRESS_SETUP:
+        AddMacAddressSetup(items);
+        break;
+    case DLMS_OBJECT_TYPE_IP4_SETUP:
+        AddIp4Setup(items, address);
+        break;
+    case DLMS_OBJECT_TYPE_IMAGE_TRANSFER:
+        items.push_back(new CGXDLMSImageTransfer());
+        break;
+    case DLMS_OBJECT_TYPE_SCRIPT_TABLE:
+        items.push_back(new CGXDLMSScriptTable());
+        break;
+    case DLMS_OBJECT_TYPE_SCHEDULE:
+        items.push_back(new CGXDLMSSchedule());
+        break;
+    default:
+        return NULL;
+    }
+    return items.back();
+}
+
+CGXDLMSObject* CGXDLMSBase::AddSharedObject(DLMS_OBJECT_TYPE type)
+{
+    if (m_Template != NULL)
+    {
+        for (CGXDLMSObjectCollection::iterator it = m_Template->m_SharedObjects.begin(); it != m_Template->m_SharedObjects.end(); ++it)
+        {
+            if ((*it)->GetObjectType() == type)
+            {
+                GetItems().push_back(*it);
+                m_SharedObjects.push_back(*it);
+                return *it;
+            }
+        }
+    }
+    CGXDLMSObject* obj = CreateSharedObject(GetItems(), type);
+    if (m_Template == NULL)
+    {
+        m_SharedObjects.push_back(obj);
+    }
+    return obj;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//Objects are replaced by position so the order of the objects is kept.
+/////////////////////////////////////////////////////////////////////////////
+static void ReplaceObject(CGXDLMSObjectCollection& items, CGXDLMSObject* oldValue, CGXDLMSObject* newValue)
+{
+    CGXDLMSObjectCollection::iterator it = std::find(items.begin(), items.end(), oldValue);
+    if (it != items.end())
+    {
+        *it = newValue;
+    }
+}
+
+void CGXDLMSBase::Unshare(CGXDLMSValueEventArg* e)
+{
+    CGXDLMSObject* shared = e->GetTarget();
+    CGXDLMSObjectCollection::iterator it = std::find(m_SharedObjects.begin(), m_SharedObjects.end(), shared);
+    //Template doesn't copy its own objects.
+    if (m_Template == NULL || it == m_SharedObjects.end())
+    {
+        return;
+    }
+    //Shared object is never changed so the copy is built again from the
+    //same values of the template. Copy has its own encoded caches.
+    CGXDLMSObjectCollection items;
+    CGXDLMSObject* obj = CreateSharedObject(items, shared->GetObjectType());
+    if (obj == NULL)
+    {
+        return;
+    }
+    EncodeCachedValues(m_Settings, obj);
+    m_SharedObjects.erase(it);
+    ReplaceObject(GetItems(), shared, obj);
+    if (m_ln != NULL)
+    {
+        ReplaceObject(m_ln->GetObjectList(), shared, obj);
+    }
+    //Push setup sends the values of the session's objects.
+    for (CGXDLMSObjectCollection::iterator pos = GetItems().begin(); pos != GetItems().end(); ++pos)
+    {
+        if ((*pos)->GetObjectType() == DLMS_OBJECT_TYPE_PUSH_SETUP)
+        {
+            std::vector<std::pair<CGXDLMSObject*, CGXDLMSCaptureObject> >& list = ((CGXDLMSPushSetup*)*pos)->GetPushObjectList();
+            for (std::vector<std::pair<CGXDLMSObject*, CGXDLMSCaptureObject> >::iterator p = list.begin(); p != list.end(); ++p)
+            {
+                if (p->first == shared)
+                {
+                    p->first = obj;
+                }
+            }
+        }
+    }
+    e->SetTarget(obj);
+}
+
+void CGXDLMSBase::ReleaseSharedObjects()
+{
+    if (m_Template != NULL && !m_SharedObjects.empty())
+    {
+        CGXDLMSObjectCollection& items = GetItems();
+        CGXDLMSObjectCollection& shared = m_SharedObjects;
+        items.erase(std::remove_if(items.begin(), items.end(), [&shared](CGXDLMSObject* obj)
+        {
+            return std::find(shared.begin(), shared.end(), obj) != shared.end();
+        }), items.end());
+        m_SharedObjects.clear();
+    }
 }
 
 /*
@@ -695,55 +1368,6 @@ CGXDLMSObject* CGXDLMSBase::FindObject(
     return NULL;
 }
 
-/**
-* Return data using start and end indexes.
-*
-* @param p
-*            ProfileGeneric
-* @param index
-* @param count
-* @return Add data Rows
-*/
-void GetProfileGenericDataByEntry(CGXDLMSProfileGeneric* p, long index, long count)
-{
-    int len, month = 0, day = 0, year = 0, hour = 0, minute = 0, second = 0, value = 0;
-    // Clear old data. It's already serialized.
-    p->GetBuffer().clear();
-    if (count != 0)
-    {
-        FILE* f = fopen(DATAFILE, "r");
-
-        if (f != NULL)
-        {
-            while ((len = fscanf(f, "%d/%d/%d %d:%d:%d;%d", &month, &day, &year, &hour, &minute, &second, &value)) != -1)
-            {
-                // Skip row
-                if (index > 0)
-                {
-                    --index;
-                }
-                else if (len == 7)
-                {
-                    if (p->GetBuffer().size() == count)
-                    {
-                        break;
-                    }
-                    CGXDateTime tm(2000 + year, month, day, hour, minute, second, 0, 0x8000);
-                    std::vector<CGXDLMSVariant> row;
-                    row.push_back(tm);
-                    row.push_back(value);
-                    p->GetBuffer().push_back(row);
-                }
-                if (p->GetBuffer().size() == count)
-                {
-                    break;
-                }
-            }
-            fclose(f);
-        }
-    }
-}
-
 /**
 * Find start index and row count using start and end date time.
 *
@@ -756,66 +1380,42 @@ void GetProfileGenericDataByEntry(CGXDLMSProfileGeneric* p, long index, long cou
 * @param count
 *            Item count.
 */
-void GetProfileGenericDataByRange(CGXDLMSValueEventArg* e)
+void GetProfileGenericDataByRange(CGXDLMSValueEventArg* e, CGXProfileStore* store)
 {
-    int len, month = 0, day = 0, year = 0, hour = 0, minute = 0, second = 0, value = 0;
+    const CGXDLMSVariant& parameters = e->GetParameters();
     CGXDLMSVariant start, end;
+    const CGXDLMSVariant& from = start;
+    const CGXDLMSVariant& to = end;
     CGXByteBuffer bb;
-    bb.Set(e->GetParameters().Arr[1].byteArr, e->GetParameters().Arr[1].size);
-    CGXDLMSClient::ChangeType(bb, DLMS_DATA_TYPE_DATETIME, start);
+    bb.Set(parameters.Arr()[1].byteArr, parameters.Arr()[1].size);
+    if (CGXDLMSClient::ChangeType(bb, DLMS_DATA_TYPE_DATETIME, start) != 0)
+    {
+        return;
+    }
     bb.Clear();
-    bb.Set(e->GetParameters().Arr[2].byteArr, e->GetParameters().Arr[2].size);
-    CGXDLMSClient::ChangeType(bb, DLMS_DATA_TYPE_DATETIME, end);
-
-    FILE* f = fopen(DATAFILE, "r");
-
-    if (f != NULL)
+    bb.Set(parameters.Arr()[2].byteArr, parameters.Arr()[2].size);
+    if (CGXDLMSClient::ChangeType(bb, DLMS_DATA_TYPE_DATETIME, end) != 0)
     {
-        while ((len = fscanf(f, "%d/%d/%d %d:%d:%d;%d", &month, &day, &year, &hour, &minute, &second, &value)) != -1)
-        {
-            CGXDateTime tm(2000 + year, month, day, hour, minute, second, 0, 0x8000);
-            if (tm.CompareTo(end.dateTime) > 0)
-            {
-                // If all data is read.
-                break;
-            }
-            if (tm.CompareTo(start.dateTime) < 0)
-            {
-                // If we have not find first item.
-                e->SetRowBeginIndex(e->GetRowBeginIndex() + 1);
-            }
-            e->SetRowEndIndex(e->GetRowEndIndex() + 1);
-        }
-        fclose(f);
+        return;
     }
+    unsigned long long first, last;
+    // Rows are in time order so indexes are found with binary search.
+    store->FindRange(from.dateTime().ToUnixTime(), to.dateTime().ToUnixTime(), first, last);
+    e->SetRowBeginIndex(e->GetRowBeginIndex() + (unsigned long)first);
+    e->SetRowEndIndex(e->GetRowEndIndex() + (unsigned long)last);
 }
 
 /**
-* Get row count.
+* Get row count. Count is kept in the store header so this is not
+* depending on the amount of the rows.
 *
 * @return
 */
-int GetProfileGenericDataCount() {
-    int rows = 0;
-    int ch;
-
-    FILE* f = fopen(DATAFILE, "r");
-
-    if (f != NULL)
-    {
-        while ((ch = fgetc(f)) != EOF)
-        {
-            if (ch == '\n')
-            {
-                ++rows;
-            }
-        }
-        fclose(f);
-    }
-    return rows;
+unsigned long GetProfileGenericDataCount(CGXProfileStore* store)
+{
+    return (unsigned long)store->GetCount();
 }
 
-
 /////////////////////////////////////////////////////////////////////////////
 //
 /////////////////////////////////////////////////////////////////////////////
@@ -825,7 +1425,6 @@ void CGXDLMSBase::PreRead(std::vector<CGXDLMSValueEventArg*>& args)
     CGXDLMSObject* pObj;
     int ret, index;
     DLMS_OBJECT_TYPE type;
-    std::string ln;
     for (std::vector<CGXDLMSValueEventArg*>::iterator it = args.begin(); it != args.end(); ++it)
     {
         //Let framework handle Logical Name read.
@@ -836,7 +1435,6 @@ void CGXDLMSBase::PreRead(std::vector<CGXDLMSValueEventArg*>& args)
         //Get attribute index.
         index = (*it)->GetIndex();
         pObj = (*it)->GetTarget();
-        pObj->GetLogicalName(ln);
         //Get target type.
         type = pObj->GetObjectType();
         if (type == DLMS_OBJECT_TYPE_PROFILE_GENERIC)
@@ -846,7 +1444,7 @@ void CGXDLMSBase::PreRead(std::vector<CGXDLMSValueEventArg*>& args)
             if (index == 7)
             {
                 // If client wants to know EntriesInUse.
-                p->SetEntriesInUse(GetProfileGenericDataCount());
+                p->SetEntriesInUse(GetProfileGenericDataCount(m_Store));
             }
             else if (index == 2)
             {
@@ -856,38 +1454,36 @@ void CGXDLMSBase::PreRead(std::vector<CGXDLMSValueEventArg*>& args)
                 {
                     if ((*it)->GetSelector() == 0)
                     {
-                        (*it)->SetRowEndIndex(GetProfileGenericDataCount());
+                        (*it)->SetRowEndIndex(GetProfileGenericDataCount(m_Store));
                     }
                     else if ((*it)->GetSelector() == 1)
                     {
-                        // Read by entry.
-                        GetProfileGenericDataByRange((*it));
+                        // Read by range.
+                        GetProfileGenericDataByRange((*it), m_Store);
                     }
                     else if ((*it)->GetSelector() == 2)
                     {
-                        // Read by range.
-                        unsigned int begin = (*it)->GetParameters().Arr[0].ulVal;
-                        (*it)->SetRowBeginIndex(begin);
-                        (*it)->SetRowEndIndex((*it)->GetParameters().Arr[1].ulVal);
+                        // Read by entry. Entries are one based and zero
+                        // to entry means the last entry.
+                        const CGXDLMSVariant& parameters = (*it)->GetParameters();
+                        unsigned long from = parameters.Arr()[0].ulVal;
+                        unsigned long to = parameters.Arr()[1].ulVal;
+                        unsigned long cnt = GetProfileGenericDataCount(m_Store);
                         // If client wants to read more data what we have.
-                        unsigned int cnt = GetProfileGenericDataCount();
-                        if ((*it)->GetRowEndIndex() > cnt)
+                        if (to == 0 || to > cnt)
+                        {
+                            to = cnt;
+                        }
+                        unsigned long begin = from == 0 ? 0 : from - 1;
+                        if (begin > to)
                         {
-                            (*it)->SetRowEndIndex(cnt);
-                            if ((*it)->GetRowEndIndex() < 0)
-                            {
-                                (*it)->SetRowEndIndex(0);
-                            }
+                            begin = to;
                         }
+                        (*it)->SetRowBeginIndex(begin);
+                        (*it)->SetRowEndIndex(to);
                     }
                 }
-                long count = (*it)->GetRowEndIndex() - (*it)->GetRowBeginIndex() + 1;
-                // Read only rows that can fit to one PDU.
-                if ((*it)->GetRowEndIndex() - (*it)->GetRowBeginIndex() > (*it)->GetRowToPdu())
-                {
-                    count = (*it)->GetRowToPdu();
-                }
-                GetProfileGenericDataByEntry(p, (*it)->GetRowBeginIndex(), count);
+                // Rows that fit to one PDU are encoded by the profile cursor.
             }
             continue;
         }
@@ -899,6 +1495,11 @@ void CGXDLMSBase::PreRead(std::vector<CGXDLMSValueEventArg*>& args)
         {
             continue;
         }
+        //Cached attributes are static.
+        if (pObj->IsCached(index))
+        {
+            continue;
+        }
         DLMS_DATA_TYPE ui, dt;
         (*it)->GetTarget()->GetUIDataType(index, ui);
         (*it)->GetTarget()->GetDataType(index, dt);
@@ -909,7 +1510,7 @@ void CGXDLMSBase::PreRead(std::vector<CGXDLMSValueEventArg*>& args)
             ((CGXDLMSClock*)pObj)->SetTime(tm);
             continue;
         }
-        else if (type == DLMS_OBJECT_TYPE_DATA && ln == "1.0.0.2.0.255" && index == 2)
+        else if (type == DLMS_OBJECT_TYPE_DATA && index == 2 && pObj->GetObisCode() == FIRMWARE_VERSION_LN)
         {
             // Override firmware version with the current static value
             CGXDLMSVariant fwValue;
@@ -972,6 +1573,7 @@ void CGXDLMSBase::PreWrite(std::vector<CGXDLMSValueEventArg*>& args)
     std::string ln;
     for (std::vector<CGXDLMSValueEventArg*>::iterator it = args.begin(); it != args.end(); ++it)
     {
+        Unshare(*it);
         if (m_Trace > GX_TRACE_LEVEL_WARNING)
         {
             (*it)->GetTarget()->GetLogicalName(ln);
@@ -994,23 +1596,24 @@ time_t imageActionStartTime;
 void HandleImageTransfer(CGXDLMSValueEventArg* e)
 {
     CGXDLMSImageTransfer* i = (CGXDLMSImageTransfer*)e->GetTarget();
+    const CGXDLMSVariant& parameters = e->GetParameters();
     //Image name and size to transfer
     FILE* f;
     if (e->GetIndex() == 1)
     {
         i->SetImageTransferStatus(DLMS_IMAGE_TRANSFER_STATUS_NOT_INITIATED);
-        if (e->GetParameters().Arr.size() != 3)
+        if (parameters.Arr().size() != 3)
         {
             e->SetError(DLMS_ERROR_CODE_UNMATCH_TYPE);
             return;
         }
-        imageSize = e->GetParameters().Arr[1].ToInteger();
-        pendingFirmwareVersion = e->GetParameters().Arr[2].ToString();
+        imageSize = parameters.Arr()[1].ToInteger();
+        pendingFirmwareVersion = parameters.Arr()[2].ToString();
         char* p = strrchr(IMAGEFILE, '\\');
         ++p;
         *p = '\0';
 
-        strncat(IMAGEFILE, (char*)e->GetParameters().Arr[0].byteArr, (int)e->GetParameters().Arr[0].GetSize());
+        strncat(IMAGEFILE, (char*)parameters.Arr()[0].byteArr, (int)parameters.Arr()[0].GetSize());
         strcat(IMAGEFILE, ".bin");
 
         printf("Updating image %s Size: %d\n", IMAGEFILE, imageSize);
@@ -1028,7 +1631,7 @@ void HandleImageTransfer(CGXDLMSValueEventArg* e)
     //Transfers one block of the Image to the server
     else if (e->GetIndex() == 2)
     {
-        if (e->GetParameters().Arr.size() != 2)
+        if (parameters.Arr().size() != 2)
         {
             e->SetError(DLMS_ERROR_CODE_UNMATCH_TYPE);
             return;
@@ -1044,9 +1647,9 @@ void HandleImageTransfer(CGXDLMSValueEventArg* e)
             return;
         }
 
-        int ret = fwrite(e->GetParameters().Arr[1].byteArr, 1, (int)e->GetParameters().Arr[1].GetSize(), f);
+        int ret = fwrite(parameters.Arr()[1].byteArr, 1, (int)parameters.Arr()[1].GetSize(), f);
         fclose(f);
-        if (ret != e->GetParameters().Arr[1].GetSize())
+        if (ret != parameters.Arr()[1].GetSize())
         {
             e->SetError(DLMS_ERROR_CODE_UNMATCH_TYPE);
         }
@@ -1189,6 +1792,7 @@ void CGXDLMSBase::PreAction(std::vector<CGXDLMSValueEventArg*>& args)
 {
     for (std::vector<CGXDLMSValueEventArg*>::iterator it = args.begin(); it != args.end(); ++it)
     {
+        Unshare(*it);
         if ((*it)->GetTarget()->GetObjectType() == DLMS_OBJECT_TYPE_IMAGE_TRANSFER)
         {
             HandleImageTransfer(*it);
@@ -1204,71 +1808,56 @@ void CGXDLMSBase::PreAction(std::vector<CGXDLMSValueEventArg*>& args)
     }
 }
 
-void Capture(CGXDLMSProfileGeneric* pg)
+void Capture(CGXDLMSProfileGeneric* pg, CGXProfileStore* store)
 {
     std::vector<std::string> values;
-    std::string value;
-    unsigned char first = 1;
-    int cnt = GetProfileGenericDataCount();
-
-    FILE* f;
-
-    f = fopen(DATAFILE, "a");
+    std::vector<long long> record;
+    long long cnt = store->GetCount();
 
     for (std::vector<std::pair<CGXDLMSObject*, CGXDLMSCaptureObject*> >::iterator it = pg->GetCaptureObjects().begin();
         it != pg->GetCaptureObjects().end(); ++it)
     {
-        if (first)
-        {
-            first = 0;
-        }
-        else
-        {
-            fprintf(f, ";");
-                values.clear();
-        }
         if (it->first->GetObjectType() == DLMS_OBJECT_TYPE_CLOCK && it->second->GetAttributeIndex() == 2)
         {
-            value = CGXDateTime::Now().ToString();
+            record.push_back(CGXDateTime::Now().ToUnixTime());
         }
         else
         {
             // TODO: Read value here example from the meter if it's not
             // updated automatically.
+            values.clear();
             it->first->GetValues(values);
-            value = values.at(it->second->GetAttributeIndex() - 1);
+            std::string& value = values.at(it->second->GetAttributeIndex() - 1);
             if (value == "")
             {
-                char tmp[20];
                 // Generate random value here.
-                sprintf(tmp, "%d", ++cnt);
-
-                value = tmp;
+                record.push_back(++cnt);
             }
-        }
-        fprintf(f, "%s", value.c_str());
+            else
+            {
+                record.push_back(strtoll(value.c_str(), NULL, 10));
             }
-    fprintf(f, "\n");
-    fclose(f);
         }
+    }
+    if (record.size() == store->GetColumnCount() && store->Append(&record[0]) == 0)
+    {
+        pg->SetEntriesInUse((unsigned long)store->GetCount());
+    }
+}
 
-void HandleProfileGenericActions(CGXDLMSValueEventArg* it)
+void HandleProfileGenericActions(CGXDLMSValueEventArg* it, CGXProfileStore* store)
 {
-    CGXDLMSProfileGeneric* pg = (CGXDLMSProfileGeneric*)it->GetTarget();
     if (it->GetIndex() == 1)
     {
-        FILE* f;
         // Profile generic clear is called. Clear data.
-
-        f = fopen(DATAFILE, "w");
-
-        fclose(f);
+        store->Clear();
+        ((CGXDLMSProfileGeneric*)it->GetTarget())->SetEntriesInUse(0);
     }
     else if (it->GetIndex() == 2)
     {
         // Profile generic Capture is called.
     }
-    }
+}
 
 /////////////////////////////////////////////////////////////////////////////
 //
@@ -1279,7 +1868,7 @@ void CGXDLMSBase::PostAction(std::vector<CGXDLMSValueEventArg*>& args)
     {
         if ((*it)->GetTarget()->GetObjectType() == DLMS_OBJECT_TYPE_PROFILE_GENERIC)
         {
-            HandleProfileGenericActions(*it);
+            HandleProfileGenericActions(*it, m_Store);
         }
 
         if ((*it)->GetTarget()->GetObjectType() == DLMS_OBJECT_TYPE_SECURITY_SETUP)
@@ -1299,9 +1888,237 @@ bool CGXDLMSBase::IsTarget(
     unsigned long int serverAddress,
     unsigned long clientAddress)
 {
+    if (m_Fleet == NULL)
+    {
+        return true;
+    }
+    //Meter is selected by the port that client connected.
+    if (m_Meter != -1 && m_Fleet->GetPort(m_Meter) != 0)
+    {
+        return true;
+    }
+    int index = m_Fleet->FindByServerAddress(serverAddress);
+    if (index == -1)
+    {
+        return false;
+    }
+    return index == m_Meter || BindMeter(index) == 0;
+}
+
+CGXMeterFleet* CGXDLMSBase::GetFleet()
+{
+    return m_Fleet;
+}
+
+void CGXDLMSBase::SetFleet(CGXMeterFleet* value)
+{
+    m_Fleet = value;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//Update serial number to the objects that show it.
+/////////////////////////////////////////////////////////////////////////////
+static void UpdateSerialNumber(CGXDLMSObjectCollection& items, unsigned long sn)
+{
+    char buff[17];
+    sprintf(buff, "GRX%.13lu", sn);
+    CGXDLMSVariant id;
+    id.Add((const char*)buff, 16);
+    CGXDLMSData* d = (CGXDLMSData*)items.FindByLN(DLMS_OBJECT_TYPE_DATA, DEVICE_ID_LN);
+    if (d != NULL)
+    {
+        d->SetValue(id);
+    }
+    if ((d = (CGXDLMSData*)items.FindByLN(DLMS_OBJECT_TYPE_DATA, SERIAL_NUMBER_LN)) != NULL)
+    {
+        d->SetValue(id);
+    }
+    if ((d = (CGXDLMSData*)items.FindByLN(DLMS_OBJECT_TYPE_DATA, SERIAL_NUMBER_VALUE_LN)) != NULL)
+    {
+        CGXDLMSVariant id2(sn);
+        d->SetValue(id2);
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//Dedicated key is not used if it's all zeros.
+/////////////////////////////////////////////////////////////////////////////
+static bool IsEmptyKey(const unsigned char* key)
+{
+    for (int pos = 0; pos != 16; ++pos)
+    {
+        if (key[pos] != 0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//Copy key if it's changed. Returns true if key was changed.
+/////////////////////////////////////////////////////////////////////////////
+static bool UpdateKey(unsigned char* target, CGXByteBuffer& value)
+{
+    if (value.GetSize() != 16 || memcmp(target, value.GetData(), 16) == 0)
+    {
+        return false;
+    }
+    memcpy(target, value.GetData(), 16);
     return true;
 }
 
+int CGXDLMSBase::BindMeter(int index)
+{
+    if (m_Fleet == NULL || index < 0 || index >= m_Fleet->GetCount())
+    {
+        return DLMS_ERROR_CODE_INVALID_PARAMETER;
+    }
+    ReleaseMeter();
+    CGXMeterKeys& meter = m_MeterKeys;
+    m_Fleet->GetKeys().GetKeys(index, meter);
+    CGXByteBuffer bb;
+    bb.Set(meter.systemTitle, sizeof(meter.systemTitle));
+    GetCiphering()->SetSystemTitle(bb);
+    for (CGXDLMSObjectCollection::iterator it = GetItems().begin(); it != GetItems().end(); ++it)
+    {
+        if ((*it)->GetObjectType() == DLMS_OBJECT_TYPE_SECURITY_SETUP)
+        {
+            ((CGXDLMSSecuritySetup*)*it)->SetServerSystemTitle(bb);
+        }
+    }
+    bb.Clear();
+    bb.Set(meter.blockCipherKey, sizeof(meter.blockCipherKey));
+    GetCiphering()->SetBlockCipherKey(bb);
+    bb.Clear();
+    bb.Set(meter.authenticationKey, sizeof(meter.authenticationKey));
+    GetCiphering()->SetAuthenticationKey(bb);
+    bb.Clear();
+    bb.Set(meter.kek, sizeof(meter.kek));
+    SetKek(bb);
+    //Dedicated key is used only if the meter has one.
+    bb.Clear();
+    if (!IsEmptyKey(meter.dedicatedKey))
+    {
+        bb.Set(meter.dedicatedKey, sizeof(meter.dedicatedKey));
+    }
+    GetCiphering()->SetDedicatedKey(bb);
+    UpdateSerialNumber(GetItems(), meter.serialNumber);
+    m_Meter = index;
+    AcquireCounters(index);
+    //Profile data of the meter is created when the meter is used first time.
+    //It's created without the lock so other meters of the shard are not
+    //waited. Sessions of the same meter wait until it's ready.
+    CGXFleetShard& shard = m_Fleet->GetShard(index);
+    int pos = m_Fleet->GetShardIndex(index);
+    std::unique_lock<std::mutex> lock(shard.lock);
+    while (shard.store[pos] == NULL && shard.creating[pos])
+    {
+        shard.created.wait(lock);
+    }
+    if (shard.store[pos] == NULL)
+    {
+        shard.creating[pos] = true;
+        lock.unlock();
+        CGXProfileStore* store = new CGXProfileStore();
+        CreateProfileData(store, m_Fleet->GetDataFile(index).c_str(), meter.serialNumber);
+        lock.lock();
+        shard.store[pos] = store;
+        shard.creating[pos] = false;
+        shard.created.notify_all();
+    }
+    m_Store = shard.store[pos];
+    lock.unlock();
+    m_Cursor.SetStore(m_Store);
+    if (m_Trace > GX_TRACE_LEVEL_WARNING)
+    {
+        printf("Serving meter %u.\r\n", meter.serialNumber);
+    }
+    return 0;
+}
+
+void CGXDLMSBase::ReleaseMeter()
+{
+    if (m_Fleet != NULL && m_Meter != -1)
+    {
+        //Keys that client has changed with the security setup are saved.
+        //They are compared to the keys that were bound so keys that other
+        //sessions of the same meter have changed are not overwritten.
+        CGXMeterKeys meter = m_MeterKeys;
+        if (UpdateKey(meter.blockCipherKey, GetCiphering()->GetBlockCipherKey()) |
+            UpdateKey(meter.authenticationKey, GetCiphering()->GetAuthenticationKey()) |
+            UpdateKey(meter.kek, GetKek()))
+        {
+            if (m_Fleet->GetKeys().Update(m_Meter, m_MeterKeys, meter) != 0)
+            {
+                printf("Failed to save keys of meter %u.\r\n", meter.serialNumber);
+            }
+        }
+        ReleaseCounters();
+        m_Meter = -1;
+    }
+}
+
+void CGXDLMSBase::AcquireCounters(int index)
+{
+    if (m_Counters != NULL && index < m_Counters->GetCount())
+    {
+        unsigned long long counter;
+        m_Counters->Acquire(index, counter, m_CounterLimit);
+        UseCounters(counter);
+        m_CounterIndex = index;
+    }
+}
+
+//Invocation counter is sent with 32 bits. The last value is not used so the counter never wraps.
+#define GX_COUNTER_MAX 0xFFFFFFFFULL
+
+void CGXDLMSBase::UseCounters(unsigned long long counter)
+{
+    CGXCipher* cipher = GetCiphering();
+    cipher->SetInvocationCounter((unsigned long)(counter < GX_COUNTER_MAX ? counter : GX_COUNTER_MAX));
+    cipher->SetInvocationCounterLimit(m_CounterLimit < GX_COUNTER_MAX ? m_CounterLimit : GX_COUNTER_MAX);
+}
+
+void CGXDLMSBase::ReleaseCounters()
+{
+    if (m_CounterIndex != -1)
+    {
+        m_Counters->Release(m_CounterIndex, GetCiphering()->GetInvocationCounter(), m_CounterLimit);
+        m_CounterIndex = -1;
+    }
+}
+
+CGXCounterStore* CGXDLMSBase::GetCounters()
+{
+    return m_Counters;
+}
+
+void CGXDLMSBase::SetCounters(CGXCounterStore* value)
+{
+    m_Counters = value;
+}
+
+//Request usually ciphers a few frames. Counters are leased before they run
+//out. If request needs more, cipher refuses to use counters after the lease.
+#define GX_COUNTER_MARGIN 16
+
+void CGXDLMSBase::ReserveCounters()
+{
+    if (m_CounterIndex != -1)
+    {
+        unsigned long long counter = GetCiphering()->GetInvocationCounter();
+        if (counter + GX_COUNTER_MARGIN >= m_CounterLimit && counter < GX_COUNTER_MAX)
+        {
+            while (counter + GX_COUNTER_MARGIN >= m_CounterLimit)
+            {
+                m_Counters->Extend(m_CounterIndex, counter, m_CounterLimit);
+            }
+            UseCounters(counter);
+        }
+    }
+}
+
 DLMS_SOURCE_DIAGNOSTIC CGXDLMSBase::ValidateAuthentication(
     DLMS_AUTHENTICATION authentication,
     CGXByteBuffer& password)
@@ -1315,19 +2132,18 @@ DLMS_SOURCE_DIAGNOSTIC CGXDLMSBase::ValidateAuthentication(
     if (authentication == DLMS_AUTHENTICATION_LOW)
     {
         CGXByteBuffer expected;
-        std::string name = "0.0.40.0.0.255";
         if (GetUseLogicalNameReferencing())
         {
             CGXDLMSAssociationLogicalName* ln =
                 (CGXDLMSAssociationLogicalName*)GetItems().FindByLN(
-                    DLMS_OBJECT_TYPE_ASSOCIATION_LOGICAL_NAME, name);
+                    DLMS_OBJECT_TYPE_ASSOCIATION_LOGICAL_NAME, CURRENT_ASSOCIATION_LN);
             expected = ln->GetSecret();
         }
         else
         {
             CGXDLMSAssociationShortName* sn =
                 (CGXDLMSAssociationShortName*)GetItems().FindByLN(
-                    DLMS_OBJECT_TYPE_ASSOCIATION_SHORT_NAME, name);
+                    DLMS_OBJECT_TYPE_ASSOCIATION_SHORT_NAME, CURRENT_ASSOCIATION_LN);
             expected = sn->GetSecret();
         }
         if (expected.GetSize() == password.GetSize() && expected.Compare(password.GetData(), password.GetSize()))
@@ -1429,7 +2245,7 @@ void CGXDLMSBase::PreGet(
         if ((*it)->GetTarget()->GetObjectType() == DLMS_OBJECT_TYPE_PROFILE_GENERIC)
         {
             CGXDLMSProfileGeneric* pg = (CGXDLMSProfileGeneric*)(*it)->GetTarget();
-            Capture(pg);
+            Capture(pg, m_Store);
             (*it)->SetHandled(true);
         }
     }
@@ -0,0 +1,225 @@
+#include <string.h>
+#include <stdio.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "../include/GXKeyStore.h"
+#include "GXErrorCodes.h"
+
+//Store layout version. Files with other version are not loaded.
+#define GX_KEY_STORE_VERSION 1
+
+/////////////////////////////////////////////////////////////////////////////
+//Hash tables are at least twice the meter count so probe chains stay short.
+/////////////////////////////////////////////////////////////////////////////
+static size_t GetTableSize(size_t count)
+{
+    size_t size = 16;
+    while (size < 2 * count)
+    {
+        size *= 2;
+    }
+    return size;
+}
+
+static size_t HashServerAddress(unsigned long serverAddress)
+{
+    return (size_t)((serverAddress * 0x9E3779B97F4A7C15ULL) >> 32);
+}
+
+static size_t HashSystemTitle(const unsigned char* systemTitle)
+{
+    //FNV-1a.
+    unsigned long long hash = 0xCBF29CE484222325ULL;
+    for (int pos = 0; pos != 8; ++pos)
+    {
+        hash = (hash ^ systemTitle[pos]) * 0x100000001B3ULL;
+    }
+    return (size_t)(hash ^ (hash >> 32));
+}
+
+int CGXKeyStore::Set(std::vector<CGXMeterKeys>& keys)
+{
+    size_t size = GetTableSize(keys.size());
+    std::vector<unsigned int> byServerAddress(size, 0), bySystemTitle(size, 0);
+    for (size_t pos = 0; pos != keys.size(); ++pos)
+    {
+        size_t slot = HashServerAddress(keys[pos].serverAddress) & (size - 1);
+        while (byServerAddress[slot] != 0)
+        {
+            if (keys[byServerAddress[slot] - 1].serverAddress == keys[pos].serverAddress)
+            {
+                return DLMS_ERROR_CODE_INVALID_PARAMETER;
+            }
+            slot = (slot + 1) & (size - 1);
+        }
+        byServerAddress[slot] = (unsigned int)pos + 1;
+        //Same system title and key would reuse initialization vectors.
+        slot = HashSystemTitle(keys[pos].systemTitle) & (size - 1);
+        while (bySystemTitle[slot] != 0)
+        {
+            if (memcmp(keys[bySystemTitle[slot] - 1].systemTitle, keys[pos].systemTitle, 8) == 0)
+            {
+                return DLMS_ERROR_CODE_INVALID_PARAMETER;
+            }
+            slot = (slot + 1) & (size - 1);
+        }
+        bySystemTitle[slot] = (unsigned int)pos + 1;
+    }
+    m_Keys.swap(keys);
+    m_Sequences.assign(m_Keys.size(), 0);
+    m_ByServerAddress.swap(byServerAddress);
+    m_FileName.clear();
+    return 0;
+}
+
+int CGXKeyStore::Load(const char* fileName)
+{
+    int ret;
+    FILE* f = fopen(fileName, "rb");
+    if (f == NULL)
+    {
+        return DLMS_ERROR_CODE_HARDWARE_FAULT;
+    }
+    GXKeyStoreHeader header;
+    std::vector<CGXMeterKeys> keys;
+    if (fread(&header, sizeof(header), 1, f) != 1 ||
+        memcmp(header.magic, "GXKS", 4) != 0 ||
+        header.version != GX_KEY_STORE_VERSION ||
+        header.recordSize != sizeof(CGXMeterKeys))
+    {
+        fclose(f);
+        return DLMS_ERROR_CODE_INVALID_PARAMETER;
+    }
+    keys.resize(header.count);
+    if (header.count != 0 && fread(&keys[0], sizeof(CGXMeterKeys), header.count, f) != header.count)
+    {
+        fclose(f);
+        return DLMS_ERROR_CODE_INVALID_PARAMETER;
+    }
+    fclose(f);
+    if ((ret = Set(keys)) != 0)
+    {
+        return ret;
+    }
+    m_FileName = fileName;
+    return 0;
+}
+
+int CGXKeyStore::Save(const char* fileName)
+{
+    //Keys are written to a temporary file first so a partial file is never loaded.
+    std::string tmp = std::string(fileName) + ".tmp";
+    FILE* f = fopen(tmp.c_str(), "wb");
+    if (f == NULL)
+    {
+        return DLMS_ERROR_CODE_HARDWARE_FAULT;
+    }
+    std::lock_guard<std::mutex> lock(m_Lock);
+    GXKeyStoreHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, "GXKS", 4);
+    header.version = GX_KEY_STORE_VERSION;
+    header.count = (unsigned int)m_Keys.size();
+    header.recordSize = sizeof(CGXMeterKeys);
+    bool ok = fwrite(&header, sizeof(header), 1, f) == 1 &&
+        (m_Keys.empty() || fwrite(&m_Keys[0], sizeof(CGXMeterKeys), m_Keys.size(), f) == m_Keys.size());
+    if (fclose(f) != 0 || !ok || rename(tmp.c_str(), fileName) != 0)
+    {
+        remove(tmp.c_str());
+        return DLMS_ERROR_CODE_HARDWARE_FAULT;
+    }
+    m_FileName = fileName;
+    return 0;
+}
+
+int CGXKeyStore::GetCount()
+{
+    return (int)m_Keys.size();
+}
+
+void CGXKeyStore::GetKeys(int index, CGXMeterKeys& value)
+{
+    unsigned int* sequence = &m_Sequences[index];
+    for (;;)
+    {
+        unsigned int start = __atomic_load_n(sequence, __ATOMIC_ACQUIRE);
+        if ((start & 1) == 0)
+        {
+            memcpy(&value, &m_Keys[index], sizeof(CGXMeterKeys));
+            __atomic_thread_fence(__ATOMIC_ACQUIRE);
+            if (__atomic_load_n(sequence, __ATOMIC_RELAXED) == start)
+            {
+                break;
+            }
+        }
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//Copy key if session has changed it.
+/////////////////////////////////////////////////////////////////////////////
+static void UpdateKey(unsigned char* target, const unsigned char* bound, const unsigned char* value)
+{
+    if (memcmp(bound, value, 16) != 0)
+    {
+        memcpy(target, value, 16);
+    }
+}
+
+int CGXKeyStore::Update(int index, const CGXMeterKeys& bound, const CGXMeterKeys& value)
+{
+    if (index < 0 || index >= (int)m_Keys.size())
+    {
+        return DLMS_ERROR_CODE_INVALID_PARAMETER;
+    }
+    std::lock_guard<std::mutex> lock(m_Lock);
+    CGXMeterKeys keys = m_Keys[index];
+    if (keys.serverAddress != value.serverAddress ||
+        memcmp(keys.systemTitle, value.systemTitle, 8) != 0)
+    {
+        return DLMS_ERROR_CODE_INVALID_PARAMETER;
+    }
+    UpdateKey(keys.blockCipherKey, bound.blockCipherKey, value.blockCipherKey);
+    UpdateKey(keys.authenticationKey, bound.authenticationKey, value.authenticationKey);
+    UpdateKey(keys.kek, bound.kek, value.kek);
+    unsigned int* sequence = &m_Sequences[index];
+    unsigned int start = *sequence;
+    __atomic_store_n(sequence, start + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    memcpy(&m_Keys[index], &keys, sizeof(CGXMeterKeys));
+    __atomic_store_n(sequence, start + 2, __ATOMIC_RELEASE);
+    if (!m_FileName.empty())
+    {
+        //Only the changed record is written.
+        int f = open(m_FileName.c_str(), O_WRONLY);
+        off_t offset = sizeof(GXKeyStoreHeader) + (off_t)index * sizeof(CGXMeterKeys);
+        bool ok = f != -1 && pwrite(f, &keys, sizeof(CGXMeterKeys), offset) == sizeof(CGXMeterKeys);
+        if (f != -1)
+        {
+            close(f);
+        }
+        if (!ok)
+        {
+            return DLMS_ERROR_CODE_HARDWARE_FAULT;
+        }
+    }
+    return 0;
+}
+
+int CGXKeyStore::FindByServerAddress(unsigned long serverAddress)
+{
+    if (m_Keys.empty())
+    {
+        return -1;
+    }
+    size_t mask = m_ByServerAddress.size() - 1;
+    for (size_t slot = HashServerAddress(serverAddress) & mask; m_ByServerAddress[slot] != 0; slot = (slot + 1) & mask)
+    {
+        unsigned int index = m_ByServerAddress[slot] - 1;
+        if (m_Keys[index].serverAddress == serverAddress)
+        {
+            return (int)index;
+        }
+    }
+    return -1;
+}
@@ -0,0 +1,165 @@
+#include <string.h>
+#include <stdio.h>
+#include "../include/GXMeterFleet.h"
+
+CGXMeterFleet::CGXMeterFleet()
+{
+    m_BasePort = 0;
+}
+
+CGXMeterFleet::~CGXMeterFleet()
+{
+    for (std::vector<CGXFleetShard*>::iterator it = m_Shards.begin(); it != m_Shards.end(); ++it)
+    {
+        for (std::vector<CGXProfileStore*>::iterator s = (*it)->store.begin(); s != (*it)->store.end(); ++s)
+        {
+            delete *s;
+        }
+        delete *it;
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//Copy key template and replace last four bytes with serial number.
+/////////////////////////////////////////////////////////////////////////////
+static void MakeKey(CGXByteBuffer& source, unsigned long serialNumber, unsigned char* target)
+{
+    memset(target, 0, 16);
+    memcpy(target, source.GetData(), source.GetSize() < 16 ? source.GetSize() : 16);
+    target[12] = (unsigned char)(serialNumber >> 24);
+    target[13] = (unsigned char)(serialNumber >> 16);
+    target[14] = (unsigned char)(serialNumber >> 8);
+    target[15] = (unsigned char)serialNumber;
+}
+
+int CGXMeterFleet::CreateShards(unsigned short basePort, int shardCount)
+{
+    int count = m_Keys.GetCount();
+    if (shardCount < 1 || (basePort != 0 && (unsigned long)basePort + count > 0x10000))
+    {
+        return DLMS_ERROR_CODE_INVALID_PARAMETER;
+    }
+    m_BasePort = basePort;
+    for (int pos = 0; pos != shardCount; ++pos)
+    {
+        CGXFleetShard* shard = new CGXFleetShard();
+        int size = count / shardCount + (pos < count % shardCount ? 1 : 0);
+        shard->store.resize(size, NULL);
+        shard->creating.resize(size, false);
+        m_Shards.push_back(shard);
+    }
+    return 0;
+}
+
+int CGXMeterFleet::Create(
+    int count,
+    unsigned long firstSerialNumber,
+    unsigned short firstServerAddress,
+    unsigned short basePort,
+    CGXByteBuffer& blockCipherKey,
+    CGXByteBuffer& authenticationKey,
+    CGXByteBuffer& kek,
+    int shardCount)
+{
+    int ret;
+    if (count < 0 || (unsigned long)firstServerAddress + count > 0x10000)
+    {
+        return DLMS_ERROR_CODE_INVALID_PARAMETER;
+    }
+    std::vector<CGXMeterKeys> keys(count);
+    for (int pos = 0; pos != count; ++pos)
+    {
+        CGXMeterKeys& m = keys[pos];
+        memset(&m, 0, sizeof(m));
+        m.serialNumber = (unsigned int)(firstSerialNumber + pos);
+        m.serverAddress = (unsigned short)(firstServerAddress + pos);
+        //Flag ID of the manufacturer and serial number.
+        memcpy(m.systemTitle, "GRX", 3);
+        m.systemTitle[4] = (unsigned char)(m.serialNumber >> 24);
+        m.systemTitle[5] = (unsigned char)(m.serialNumber >> 16);
+        m.systemTitle[6] = (unsigned char)(m.serialNumber >> 8);
+        m.systemTitle[7] = (unsigned char)m.serialNumber;
+        MakeKey(blockCipherKey, m.serialNumber, m.blockCipherKey);
+        MakeKey(authenticationKey, m.serialNumber, m.authenticationKey);
+        MakeKey(kek, m.serialNumber, m.kek);
+    }
+    if ((ret = m_Keys.Set(keys)) != 0)
+    {
+        return ret;
+    }
+    return CreateShards(basePort, shardCount);
+}
+
+int CGXMeterFleet::Load(const char* fileName, unsigned short basePort, int shardCount)
+{
+    int ret;
+    if ((ret = m_Keys.Load(fileName)) != 0)
+    {
+        return ret;
+    }
+    return CreateShards(basePort, shardCount);
+}
+
+int CGXMeterFleet::GetCount()
+{
+    return m_Keys.GetCount();
+}
+
+CGXKeyStore& CGXMeterFleet::GetKeys()
+{
+    return m_Keys;
+}
+
+unsigned short CGXMeterFleet::GetPort(int index)
+{
+    return m_BasePort == 0 ? 0 : (unsigned short)(m_BasePort + index);
+}
+
+int CGXMeterFleet::FindByServerAddress(unsigned long serverAddress)
+{
+    return m_Keys.FindByServerAddress(serverAddress);
+}
+
+int CGXMeterFleet::FindByPort(unsigned short port)
+{
+    if (m_BasePort == 0 || port < m_BasePort ||
+        port - m_BasePort >= m_Keys.GetCount())
+    {
+        return -1;
+    }
+    return port - m_BasePort;
+}
+
+unsigned short CGXMeterFleet::GetBasePort()
+{
+    return m_BasePort;
+}
+
+std::string& CGXMeterFleet::GetDataDirectory()
+{
+    return m_DataDirectory;
+}
+
+void CGXMeterFleet::SetDataDirectory(const std::string& value)
+{
+    m_DataDirectory = value;
+}
+
+std::string CGXMeterFleet::GetDataFile(int index)
+{
+    char tmp[32];
+    CGXMeterKeys keys;
+    m_Keys.GetKeys(index, keys);
+    snprintf(tmp, sizeof(tmp), "/%u.bin", keys.serialNumber);
+    return m_DataDirectory + tmp;
+}
+
+CGXFleetShard& CGXMeterFleet::GetShard(int index)
+{
+    return *m_Shards[index % m_Shards.size()];
+}
+
+int CGXMeterFleet::GetShardIndex(int index)
+{
+    return index / (int)m_Shards.size();
+}
@@ -0,0 +1,155 @@
+#include <time.h>
+#include "../include/GXProfileCursor.h"
+#include "GXHelpers.h"
+#include "GXDLMSArena.h"
+
+CGXProfileCursor::CGXProfileCursor()
+{
+    m_Store = NULL;
+}
+
+CGXProfileStore* CGXProfileCursor::GetStore()
+{
+    return m_Store;
+}
+
+void CGXProfileCursor::SetStore(CGXProfileStore* value)
+{
+    m_Store = value;
+}
+
+/**
+* Convert capture time of the stored record to date time.
+*/
+static CGXDateTime ToDateTime(long long value)
+{
+    time_t t = (time_t)value;
+    struct tm tm;
+    localtime_r(&t, &tm);
+    return CGXDateTime(1900 + tm.tm_year, 1 + tm.tm_mon, tm.tm_mday, tm.tm_hour, tm.tm_min, tm.tm_sec, 0, 0x8000);
+}
+
+/**
+* Convert stored value to the data type of the column. If the type is not
+* known value is sent as 32 bit integer if it fits and otherwise as 64 bit.
+*/
+static DLMS_DATA_TYPE ToVariant(long long value, DLMS_DATA_TYPE type, CGXDLMSVariant& target)
+{
+    switch (type)
+    {
+    case DLMS_DATA_TYPE_BOOLEAN:
+        target = value != 0;
+        break;
+    case DLMS_DATA_TYPE_INT8:
+        target = (char)value;
+        break;
+    case DLMS_DATA_TYPE_UINT8:
+    case DLMS_DATA_TYPE_ENUM:
+        target = (unsigned char)value;
+        break;
+    case DLMS_DATA_TYPE_INT16:
+        target = (short)value;
+        break;
+    case DLMS_DATA_TYPE_UINT16:
+        target = (unsigned short)value;
+        break;
+    case DLMS_DATA_TYPE_INT32:
+        target = (int)value;
+        break;
+    case DLMS_DATA_TYPE_UINT32:
+        target = (unsigned int)value;
+        break;
+    case DLMS_DATA_TYPE_UINT64:
+        target = (unsigned long long)value;
+        break;
+    case DLMS_DATA_TYPE_FLOAT32:
+        target = (float)value;
+        break;
+    case DLMS_DATA_TYPE_FLOAT64:
+        target = (double)value;
+        break;
+    case DLMS_DATA_TYPE_INT64:
+        target = value;
+        break;
+    default:
+        if (value >= -2147483647LL - 1 && value <= 2147483647LL)
+        {
+            target = (int)value;
+            return DLMS_DATA_TYPE_INT32;
+        }
+        target = value;
+        return DLMS_DATA_TYPE_INT64;
+    }
+    return type;
+}
+
+int CGXProfileCursor::GetRows(
+    CGXDLMSSettings& settings,
+    std::vector<DLMS_DATA_TYPE>& types,
+    std::vector<int>& columns,
+    unsigned long index,
+    unsigned long count,
+    CGXByteBuffer& data,
+    unsigned long& rows)
+{
+    int ret;
+    rows = 0;
+    if (m_Store == NULL)
+    {
+        return DLMS_ERROR_CODE_NOT_INITIALIZED;
+    }
+    unsigned int columnCount = m_Store->GetColumnCount();
+    if (types.size() != columnCount)
+    {
+        return DLMS_ERROR_CODE_INVALID_PARAMETER;
+    }
+    for (std::vector<int>::iterator col = columns.begin(); col != columns.end(); ++col)
+    {
+        if (*col < 0 || *col >= (int)columnCount)
+        {
+            return DLMS_ERROR_CODE_INVALID_PARAMETER;
+        }
+    }
+    //Record is a temporary of the request.
+    std::vector<long long> buffer;
+    CGXDLMSArena* arena = CGXDLMSArena::GetCurrent();
+    long long* record = arena == NULL ? NULL : (long long*)arena->Allocate(columnCount * sizeof(long long));
+    if (record == NULL)
+    {
+        buffer.resize(columnCount);
+        record = &buffer[0];
+    }
+    //Capture time is allocated only once.
+    CGXDLMSVariant tm;
+    tm.vt = DLMS_DATA_TYPE_DATETIME;
+    for (; rows != count; ++rows)
+    {
+        if (!m_Store->GetRecord(index + rows, record))
+        {
+            break;
+        }
+        data.SetUInt8(DLMS_DATA_TYPE_STRUCTURE);
+        GXHelpers::SetObjectCount((unsigned long)columns.size(), data);
+        for (std::vector<int>::iterator col = columns.begin(); col != columns.end(); ++col)
+        {
+            if (*col == 0)
+            {
+                tm.dateTime() = ToDateTime(record[0]);
+                if ((ret = GXHelpers::SetData(&settings, data, types[0] == DLMS_DATA_TYPE_NONE ? DLMS_DATA_TYPE_DATETIME : types[0], tm)) != 0)
+                {
+                    return ret;
+                }
+            }
+            else
+            {
+                CGXDLMSVariant value;
+                DLMS_DATA_TYPE type = ToVariant(record[*col], types[*col], value);
+                if ((ret = GXHelpers::SetData(&settings, data, type, value)) != 0)
+                {
+                    return ret;
+                }
+            }
+        }
+    }
+    return 0;
+}
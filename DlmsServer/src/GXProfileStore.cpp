@@ -0,0 +1,384 @@
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "../include/GXProfileStore.h"
+#include "GXErrorCodes.h"
+
+//Store layout version. Old stores are recreated when this changes.
+#define GX_PROFILE_STORE_VERSION 3
+
+CGXProfileStore::CGXProfileStore()
+{
+    m_File = -1;
+    m_Header = NULL;
+    m_Records = NULL;
+    m_MappedSize = 0;
+    m_Sequence = 0;
+}
+
+CGXProfileStore::~CGXProfileStore()
+{
+    Close();
+}
+
+int CGXProfileStore::Open(
+    const char* fileName,
+    unsigned int columnCount,
+    unsigned long long capacity)
+{
+    if (columnCount == 0 || capacity == 0)
+    {
+        return DLMS_ERROR_CODE_INVALID_PARAMETER;
+    }
+    Close();
+    if ((m_File = open(fileName, O_RDWR | O_CREAT, 0644)) == -1)
+    {
+        return DLMS_ERROR_CODE_HARDWARE_FAULT;
+    }
+    size_t size = sizeof(GXProfileStoreHeader) + capacity * columnCount * sizeof(long long);
+    GXProfileStoreHeader header;
+    bool valid = read(m_File, &header, sizeof(header)) == sizeof(header) &&
+        memcmp(header.magic, "GXPS", 4) == 0 &&
+        header.version == GX_PROFILE_STORE_VERSION &&
+        header.columnCount == columnCount &&
+        header.capacity == capacity &&
+        header.count <= capacity &&
+        header.first < capacity &&
+        header.historyCount + header.count <= capacity;
+    if (!valid)
+    {
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, "GXPS", 4);
+        header.version = GX_PROFILE_STORE_VERSION;
+        header.columnCount = columnCount;
+        header.capacity = capacity;
+        //Records are not written so file stays sparse until they are used.
+        if (ftruncate(m_File, 0) != 0 ||
+            pwrite(m_File, &header, sizeof(header), 0) != sizeof(header))
+        {
+            Close();
+            return DLMS_ERROR_CODE_HARDWARE_FAULT;
+        }
+    }
+    if (ftruncate(m_File, size) != 0)
+    {
+        Close();
+        return DLMS_ERROR_CODE_HARDWARE_FAULT;
+    }
+    void* p = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, m_File, 0);
+    if (p == MAP_FAILED)
+    {
+        Close();
+        return DLMS_ERROR_CODE_OUTOFMEMORY;
+    }
+    m_MappedSize = size;
+    m_Header = (GXProfileStoreHeader*)p;
+    m_Records = (long long*)(m_Header + 1);
+    return 0;
+}
+
+void CGXProfileStore::Close()
+{
+    if (m_Header != NULL)
+    {
+        munmap(m_Header, m_MappedSize);
+        m_Header = NULL;
+        m_Records = NULL;
+        m_MappedSize = 0;
+    }
+    if (m_File != -1)
+    {
+        close(m_File);
+        m_File = -1;
+    }
+}
+
+void CGXProfileStore::BeginWrite()
+{
+    __atomic_store_n(&m_Sequence, m_Sequence + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+}
+
+void CGXProfileStore::EndWrite()
+{
+    __atomic_store_n(&m_Sequence, m_Sequence + 1, __ATOMIC_RELEASE);
+}
+
+unsigned int CGXProfileStore::BeginRead()
+{
+    unsigned int sequence;
+    while (((sequence = __atomic_load_n(&m_Sequence, __ATOMIC_ACQUIRE)) & 1) != 0)
+    {
+    }
+    return sequence;
+}
+
+bool CGXProfileStore::EndRead(unsigned int sequence)
+{
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    return __atomic_load_n(&m_Sequence, __ATOMIC_RELAXED) == sequence;
+}
+
+bool CGXProfileStore::IsOpen()
+{
+    return m_Header != NULL;
+}
+
+unsigned int CGXProfileStore::GetColumnCount()
+{
+    return m_Header == NULL ? 0 : m_Header->columnCount;
+}
+
+unsigned long long CGXProfileStore::GetCapacity()
+{
+    return m_Header == NULL ? 0 : m_Header->capacity;
+}
+
+unsigned long long CGXProfileStore::GetCount()
+{
+    if (m_Header == NULL)
+    {
+        return 0;
+    }
+    unsigned int sequence;
+    unsigned long long count;
+    do
+    {
+        sequence = BeginRead();
+        count = __atomic_load_n(&m_Header->historyCount, __ATOMIC_RELAXED) +
+            __atomic_load_n(&m_Header->count, __ATOMIC_RELAXED);
+    } while (!EndRead(sequence));
+    return count;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//Returns record in the given ring position.
+/////////////////////////////////////////////////////////////////////////////
+static long long* GetSlot(
+    long long* records,
+    unsigned int columnCount,
+    unsigned long long capacity,
+    unsigned long long first,
+    unsigned long long index)
+{
+    index += first;
+    if (index >= capacity)
+    {
+        index -= capacity;
+    }
+    return records + index * columnCount;
+}
+
+long long CGXProfileStore::GetTime(
+    unsigned long long index,
+    unsigned long long historyCount,
+    unsigned long long first)
+{
+    if (index < historyCount)
+    {
+        return m_Header->historyStart + (long long)(m_Header->historyFirst + index) * m_Header->historyPeriod;
+    }
+    return *GetSlot(m_Records, m_Header->columnCount, m_Header->capacity, first, index - historyCount);
+}
+
+bool CGXProfileStore::GetRecord(unsigned long long index, long long* values)
+{
+    if (m_Header == NULL)
+    {
+        return false;
+    }
+    unsigned int columnCount = m_Header->columnCount;
+    unsigned int sequence;
+    bool found;
+    do
+    {
+        sequence = BeginRead();
+        unsigned long long historyCount = __atomic_load_n(&m_Header->historyCount, __ATOMIC_RELAXED);
+        found = index < historyCount + __atomic_load_n(&m_Header->count, __ATOMIC_RELAXED);
+        if (!found)
+        {
+            continue;
+        }
+        if (index < historyCount)
+        {
+            //History rows are computed from the row number.
+            unsigned long long row = __atomic_load_n(&m_Header->historyFirst, __ATOMIC_RELAXED) + index;
+            values[0] = m_Header->historyStart + (long long)row * m_Header->historyPeriod;
+            for (unsigned int col = 1; col < columnCount; ++col)
+            {
+                values[col] = m_Header->historySeed + (long long)row + 1;
+            }
+        }
+        else
+        {
+            memcpy(values, GetSlot(m_Records, columnCount, m_Header->capacity,
+                __atomic_load_n(&m_Header->first, __ATOMIC_RELAXED), index - historyCount),
+                columnCount * sizeof(long long));
+        }
+    } while (!EndRead(sequence));
+    return found;
+}
+
+unsigned long long CGXProfileStore::Bound(
+    unsigned long long count,
+    unsigned long long historyCount,
+    unsigned long long first,
+    long long time,
+    bool orEqual)
+{
+    unsigned long long low = 0, high = count;
+    while (low < high)
+    {
+        unsigned long long mid = low + (high - low) / 2;
+        long long value = GetTime(mid, historyCount, first);
+        if (value < time || (orEqual && value == time))
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+void CGXProfileStore::FindRange(
+    long long from,
+    long long to,
+    unsigned long long& begin,
+    unsigned long long& end)
+{
+    begin = end = 0;
+    if (m_Header == NULL)
+    {
+        return;
+    }
+    unsigned int sequence;
+    do
+    {
+        sequence = BeginRead();
+        begin = end = 0;
+        unsigned long long historyCount = __atomic_load_n(&m_Header->historyCount, __ATOMIC_RELAXED);
+        unsigned long long count = historyCount + __atomic_load_n(&m_Header->count, __ATOMIC_RELAXED);
+        unsigned long long first = __atomic_load_n(&m_Header->first, __ATOMIC_RELAXED);
+        if ((__atomic_load_n(&m_Header->flags, __ATOMIC_RELAXED) & GX_PROFILE_STORE_FLAGS_UNSORTED) == 0)
+        {
+            begin = Bound(count, historyCount, first, from, false);
+            end = Bound(count, historyCount, first, to, true);
+            continue;
+        }
+        for (unsigned long long pos = 0; pos != count; ++pos)
+        {
+            long long tm = GetTime(pos, historyCount, first);
+            if (tm > to)
+            {
+                // If all data is read.
+                break;
+            }
+            if (tm < from)
+            {
+                // If we have not find first item.
+                ++begin;
+            }
+            ++end;
+        }
+    } while (!EndRead(sequence));
+}
+
+int CGXProfileStore::Append(const long long* values)
+{
+    if (m_Header == NULL)
+    {
+        return DLMS_ERROR_CODE_NOT_INITIALIZED;
+    }
+    std::lock_guard<std::mutex> lock(m_Lock);
+    unsigned int columnCount = m_Header->columnCount;
+    unsigned long long capacity = m_Header->capacity;
+    unsigned long long count = m_Header->count;
+    unsigned long long first = m_Header->first;
+    unsigned long long historyCount = m_Header->historyCount;
+    unsigned int flags = m_Header->flags;
+    if (historyCount + count != 0 && values[0] < GetTime(historyCount + count - 1, historyCount, first))
+    {
+        //Clock is moved backwards.
+        flags |= GX_PROFILE_STORE_FLAGS_UNSORTED;
+    }
+    BeginWrite();
+    __atomic_store_n(&m_Header->flags, flags, __ATOMIC_RELAXED);
+    if (count == capacity)
+    {
+        //Overwrite the oldest record.
+        memcpy(GetSlot(m_Records, columnCount, capacity, first, 0),
+            values, columnCount * sizeof(long long));
+        __atomic_store_n(&m_Header->first, first + 1 == capacity ? 0 : first + 1, __ATOMIC_RELAXED);
+    }
+    else
+    {
+        memcpy(GetSlot(m_Records, columnCount, capacity, first, count),
+            values, columnCount * sizeof(long long));
+        __atomic_store_n(&m_Header->count, count + 1, __ATOMIC_RELAXED);
+        if (historyCount + count == capacity)
+        {
+            //Remove the oldest history row.
+            __atomic_store_n(&m_Header->historyFirst, m_Header->historyFirst + 1, __ATOMIC_RELAXED);
+            __atomic_store_n(&m_Header->historyCount, historyCount - 1, __ATOMIC_RELAXED);
+        }
+    }
+    EndWrite();
+    return 0;
+}
+
+int CGXProfileStore::SetHistory(
+    long long start,
+    long long period,
+    unsigned long long count,
+    long long seed)
+{
+    if (m_Header == NULL)
+    {
+        return DLMS_ERROR_CODE_NOT_INITIALIZED;
+    }
+    if (period <= 0)
+    {
+        return DLMS_ERROR_CODE_INVALID_PARAMETER;
+    }
+    std::lock_guard<std::mutex> lock(m_Lock);
+    BeginWrite();
+    m_Header->count = 0;
+    m_Header->first = 0;
+    m_Header->flags = 0;
+    m_Header->historyStart = start;
+    m_Header->historyPeriod = period;
+    m_Header->historySeed = seed;
+    //Only the newest rows are kept if history is longer than the store.
+    m_Header->historyFirst = count > m_Header->capacity ? count - m_Header->capacity : 0;
+    m_Header->historyCount = count - m_Header->historyFirst;
+    EndWrite();
+    return 0;
+}
+
+void CGXProfileStore::Clear()
+{
+    if (m_Header != NULL)
+    {
+        std::lock_guard<std::mutex> lock(m_Lock);
+        BeginWrite();
+        m_Header->count = 0;
+        m_Header->historyCount = 0;
+        m_Header->first = 0;
+        m_Header->flags = 0;
+        EndWrite();
+    }
+}
+
+int CGXProfileStore::Flush()
+{
+    if (m_Header != NULL && msync(m_Header, m_MappedSize, MS_ASYNC) != 0)
+    {
+        return DLMS_ERROR_CODE_HARDWARE_FAULT;
+    }
+    return 0;
+}